@@ -0,0 +1,92 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_ALIAS_ANALYSIS_ENGINE_ALIASQUERYCACHE_H_
+#define NOELLE_SRC_CORE_ALIAS_ANALYSIS_ENGINE_ALIASQUERYCACHE_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "llvm/Analysis/MemoryLocation.h"
+
+namespace arcana::noelle {
+
+/*
+ * Memoization of the answers of an alias analysis.
+ *
+ * Queries are canonicalized before being looked up:
+ * - pointer casts are stripped from the pointers of memory locations, and
+ * - alias queries are unordered pairs (alias(a, b) == alias(b, a)).
+ *
+ * Answers are grouped by the function that issued the query (nullptr for
+ * program-wide analyses), so they can be invalidated when a function changes.
+ */
+class AliasQueryCache {
+public:
+  AliasQueryCache();
+
+  AliasResult alias(const Function *f,
+                    const MemoryLocation &loc1,
+                    const MemoryLocation &loc2,
+                    std::function<AliasResult(void)> computeAnswer);
+
+  AliasResult alias(const Function *f,
+                    const Value *v1,
+                    const Value *v2,
+                    std::function<AliasResult(void)> computeAnswer);
+
+  ModRefInfo getModRefInfo(const Function *f,
+                           const CallBase *call,
+                           const MemoryLocation &loc,
+                           std::function<ModRefInfo(void)> computeAnswer);
+
+  ModRefInfo getModRefInfo(const Function *f,
+                           const CallBase *call1,
+                           const CallBase *call2,
+                           std::function<ModRefInfo(void)> computeAnswer);
+
+  void invalidate(const Function *f);
+
+  void clear(void);
+
+  uint64_t getNumberOfHits(void) const;
+
+  uint64_t getNumberOfMisses(void) const;
+
+  void printStatistics(raw_ostream &stream, const std::string &prefix) const;
+
+private:
+  struct FunctionQueries {
+    DenseMap<std::pair<MemoryLocation, MemoryLocation>, AliasResult> aliases;
+    DenseMap<std::pair<const CallBase *, MemoryLocation>, ModRefInfo>
+        callToLocation;
+    DenseMap<std::pair<const CallBase *, const CallBase *>, ModRefInfo>
+        callToCall;
+  };
+
+  std::unordered_map<const Function *, FunctionQueries> queries;
+  uint64_t hits;
+  uint64_t misses;
+
+  static MemoryLocation canonicalize(const MemoryLocation &loc);
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_ALIAS_ANALYSIS_ENGINE_ALIASQUERYCACHE_H_
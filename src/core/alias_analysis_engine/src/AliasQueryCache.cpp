@@ -0,0 +1,181 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/AliasQueryCache.hpp"
+
+namespace arcana::noelle {
+
+AliasQueryCache::AliasQueryCache() : hits{ 0 }, misses{ 0 } {
+  return;
+}
+
+MemoryLocation AliasQueryCache::canonicalize(const MemoryLocation &loc) {
+  if (loc.Ptr == nullptr) {
+    return loc;
+  }
+
+  return loc.getWithNewPtr(loc.Ptr->stripPointerCasts());
+}
+
+AliasResult AliasQueryCache::alias(
+    const Function *f,
+    const MemoryLocation &loc1,
+    const MemoryLocation &loc2,
+    std::function<AliasResult(void)> computeAnswer) {
+
+  /*
+   * Canonicalize the query.
+   */
+  auto l1 = AliasQueryCache::canonicalize(loc1);
+  auto l2 = AliasQueryCache::canonicalize(loc2);
+  auto swapped = std::less<const Value *>{}(l2.Ptr, l1.Ptr);
+  if (swapped) {
+    std::swap(l1, l2);
+  }
+  auto key = std::make_pair(l1, l2);
+
+  /*
+   * Check if we have already answered this query.
+   * The offset of a partial alias is the one of the second location relative
+   * to the first one, so its sign flips when the query has been swapped.
+   */
+  auto &aliases = this->queries[f].aliases;
+  auto it = aliases.find(key);
+  if (it != aliases.end()) {
+    this->hits++;
+    auto answer = it->second;
+    answer.swap(swapped);
+    return answer;
+  }
+
+  /*
+   * Compute the answer.
+   */
+  this->misses++;
+  auto answer = computeAnswer();
+  auto canonicalAnswer = answer;
+  canonicalAnswer.swap(swapped);
+  aliases.insert(std::make_pair(key, canonicalAnswer));
+
+  return answer;
+}
+
+AliasResult AliasQueryCache::alias(
+    const Function *f,
+    const Value *v1,
+    const Value *v2,
+    std::function<AliasResult(void)> computeAnswer) {
+  return this->alias(f,
+                     MemoryLocation::getBeforeOrAfter(v1),
+                     MemoryLocation::getBeforeOrAfter(v2),
+                     computeAnswer);
+}
+
+ModRefInfo AliasQueryCache::getModRefInfo(
+    const Function *f,
+    const CallBase *call,
+    const MemoryLocation &loc,
+    std::function<ModRefInfo(void)> computeAnswer) {
+
+  /*
+   * Check if we have already answered this query.
+   */
+  auto key = std::make_pair(call, AliasQueryCache::canonicalize(loc));
+  auto &callToLocation = this->queries[f].callToLocation;
+  auto it = callToLocation.find(key);
+  if (it != callToLocation.end()) {
+    this->hits++;
+    return it->second;
+  }
+
+  /*
+   * Compute the answer.
+   */
+  this->misses++;
+  auto answer = computeAnswer();
+  callToLocation.insert(std::make_pair(key, answer));
+
+  return answer;
+}
+
+ModRefInfo AliasQueryCache::getModRefInfo(
+    const Function *f,
+    const CallBase *call1,
+    const CallBase *call2,
+    std::function<ModRefInfo(void)> computeAnswer) {
+
+  /*
+   * Check if we have already answered this query.
+   * Notice that mod/ref queries between calls are not symmetric.
+   */
+  auto key = std::make_pair(call1, call2);
+  auto &callToCall = this->queries[f].callToCall;
+  auto it = callToCall.find(key);
+  if (it != callToCall.end()) {
+    this->hits++;
+    return it->second;
+  }
+
+  /*
+   * Compute the answer.
+   */
+  this->misses++;
+  auto answer = computeAnswer();
+  callToCall.insert(std::make_pair(key, answer));
+
+  return answer;
+}
+
+void AliasQueryCache::invalidate(const Function *f) {
+  this->queries.erase(f);
+
+  return;
+}
+
+void AliasQueryCache::clear(void) {
+  this->queries.clear();
+
+  return;
+}
+
+uint64_t AliasQueryCache::getNumberOfHits(void) const {
+  return this->hits;
+}
+
+uint64_t AliasQueryCache::getNumberOfMisses(void) const {
+  return this->misses;
+}
+
+void AliasQueryCache::printStatistics(raw_ostream &stream,
+                                      const std::string &prefix) const {
+  auto total = this->hits + this->misses;
+  stream << prefix << "Queries: " << total << "\n";
+  stream << prefix << "  Hits: " << this->hits << "\n";
+  stream << prefix << "  Misses: " << this->misses << "\n";
+  if (total > 0) {
+    stream << prefix << "  Hit rate: " << ((this->hits * 100) / total)
+           << "%\n";
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
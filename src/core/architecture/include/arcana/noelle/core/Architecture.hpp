@@ -26,16 +26,66 @@
 
 namespace arcana::noelle {
 
+/*
+ * Description of the machine the generated code will run on.
+ *
+ * The topology is discovered once from sysfs, the affinity mask of the
+ * process, and the CPU quotas of its cgroup and of the ancestors of it.
+ * A file given with -noelle-architecture-file overrides any of the values
+ * (e.g., when cross-compiling). Each line of that file is "<key> <value>",
+ * where the keys are logical_cores, physical_cores, smt_siblings,
+ * numa_nodes, sockets, cache_line_bytes, l1_cache_bytes, l2_cache_bytes,
+ * and llc_bytes. Lines starting with '#' are ignored. Values must be
+ * positive, and cache_line_bytes must be a power of two of at least 8.
+ */
 class Architecture {
 public:
   Architecture();
 
+  /*
+   * Cores the current process can use.
+   */
   static uint32_t getNumberOfLogicalCores(void);
 
   static uint32_t getNumberOfPhysicalCores(void);
 
+  /*
+   * Hardware threads per physical core.
+   */
+  static uint32_t getNumberOfSMTSiblings(void);
+
+  static uint32_t getNumberOfNUMANodes(void);
+
+  static uint32_t getNumberOfSockets(void);
+
   static int32_t getCacheLineBytes(void);
 
+  /*
+   * Sizes of the data caches private to a core (L1, L2) and of the last
+   * level cache.
+   */
+  static uint64_t getL1CacheBytes(void);
+
+  static uint64_t getL2CacheBytes(void);
+
+  static uint64_t getLastLevelCacheBytes(void);
+
+  /*
+   * Parse the content of a file given with -noelle-architecture-file.
+   * Return the value of each key in @description, or std::nullopt if a line
+   * is malformed (@error then describes why).
+   */
+  static std::optional<std::map<std::string, uint64_t>>
+  parseArchitectureDescription(StringRef description, std::string &error);
+
+  /*
+   * Return the directories that can hold the CPU quota of the process, given
+   * the content of /proc/self/cgroup. They are the directories of its cgroup
+   * (v2, and v1 for the cpu controller) followed by the ones of the ancestors
+   * of it.
+   */
+  static std::vector<std::string> getCgroupDirectories(StringRef procCgroup);
+
 private:
 };
 
@@ -19,24 +19,472 @@
  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include <fstream>
+#include <sched.h>
+
 #include "arcana/noelle/core/Architecture.hpp"
 
 namespace arcana::noelle {
 
+static cl::opt<std::string> ArchitectureFile(
+    "noelle-architecture-file",
+    cl::init(""),
+    cl::desc("File describing the target machine, overriding the topology "
+             "discovered on the host"));
+
+namespace {
+
+struct Topology {
+  uint32_t logicalCores = 0;
+  uint32_t physicalCores = 0;
+  uint32_t smtSiblings = 1;
+  uint32_t numaNodes = 1;
+  uint32_t sockets = 1;
+  int32_t cacheLineBytes = 64;
+  uint64_t l1CacheBytes = 32 * 1024;
+  uint64_t l2CacheBytes = 256 * 1024;
+  uint64_t llcBytes = 8 * 1024 * 1024;
+};
+
+} // namespace
+
+static bool readFirstLine(const std::string &fileName, std::string &line) {
+  std::ifstream file(fileName);
+  if (!file.is_open()) {
+    return false;
+  }
+  if (!std::getline(file, line)) {
+    return false;
+  }
+
+  return true;
+}
+
+static bool readInteger(const std::string &fileName, int64_t &value) {
+  std::string line;
+  if (!readFirstLine(fileName, line)) {
+    return false;
+  }
+
+  return !StringRef(line).trim().getAsInteger(10, value);
+}
+
+/*
+ * Parse sizes like "48K" or "32768K" used by sysfs for caches.
+ */
+static bool readSize(const std::string &fileName, uint64_t &bytes) {
+  std::string line;
+  if (!readFirstLine(fileName, line)) {
+    return false;
+  }
+  auto text = StringRef(line).trim();
+  uint64_t multiplier = 1;
+  if (text.endswith("K")) {
+    multiplier = 1024;
+  } else if (text.endswith("M")) {
+    multiplier = 1024 * 1024;
+  } else if (text.endswith("G")) {
+    multiplier = 1024 * 1024 * 1024;
+  }
+  if (multiplier > 1) {
+    text = text.drop_back();
+  }
+  uint64_t value;
+  if (text.getAsInteger(10, value)) {
+    return false;
+  }
+  bytes = value * multiplier;
+
+  return true;
+}
+
+/*
+ * Fetch the CPUs the current process is allowed to run on.
+ */
+static std::vector<uint32_t> getAllowedCPUs(void) {
+  std::vector<uint32_t> cpus;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+    return cpus;
+  }
+  for (auto cpu = 0u; cpu < CPU_SETSIZE; cpu++) {
+    if (CPU_ISSET(cpu, &set)) {
+      cpus.push_back(cpu);
+    }
+  }
+
+  return cpus;
+}
+
+/*
+ * Fetch the number of cores granted by the CPU quota of a cgroup directory,
+ * if any.
+ */
+static uint32_t getCoresOfCPUQuota(const std::string &cgroupDir) {
+
+  /*
+   * cgroup v2.
+   */
+  std::string line;
+  if (readFirstLine(cgroupDir + "/cpu.max", line)) {
+    auto fields = StringRef(line).trim().split(' ');
+    int64_t quota, period;
+    if ((fields.first != "max") && !fields.first.getAsInteger(10, quota)
+        && !fields.second.getAsInteger(10, period) && (quota > 0)
+        && (period > 0)) {
+      return divideCeil(quota, period);
+    }
+    return 0;
+  }
+
+  /*
+   * cgroup v1.
+   */
+  int64_t quota, period;
+  if (readInteger(cgroupDir + "/cpu.cfs_quota_us", quota)
+      && readInteger(cgroupDir + "/cpu.cfs_period_us", period)
+      && (quota > 0) && (period > 0)) {
+    return divideCeil(quota, period);
+  }
+
+  return 0;
+}
+
+/*
+ * Fetch the number of cores granted by the tightest CPU quota among the
+ * cgroup of the process and its ancestors, if any.
+ */
+static uint32_t getCoresOfCPUQuota(void) {
+  std::string procCgroup;
+  std::ifstream file("/proc/self/cgroup");
+  if (file.is_open()) {
+    std::stringstream content;
+    content << file.rdbuf();
+    procCgroup = content.str();
+  }
+
+  uint32_t cores = 0;
+  for (const auto &cgroupDir :
+       Architecture::getCgroupDirectories(procCgroup)) {
+    auto quotaCores = getCoresOfCPUQuota(cgroupDir);
+    if ((quotaCores > 0) && ((cores == 0) || (quotaCores < cores))) {
+      cores = quotaCores;
+    }
+  }
+
+  return cores;
+}
+
+static bool isValidCacheLineBytes(uint64_t bytes) {
+  return (bytes >= 8)
+         && (bytes <= (uint64_t)std::numeric_limits<int32_t>::max())
+         && isPowerOf2_64(bytes);
+}
+
+static void discoverCPUs(Topology &t) {
+  const std::string cpuDir = "/sys/devices/system/cpu/cpu";
+
+  /*
+   * Count the logical cores the process can use.
+   */
+  auto allowedCPUs = getAllowedCPUs();
+  t.logicalCores = allowedCPUs.size();
+  if (t.logicalCores == 0) {
+    t.logicalCores = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  /*
+   * Group the allowed logical cores into physical cores and sockets.
+   */
+  std::set<std::pair<int64_t, int64_t>> physicalCores;
+  std::set<int64_t> sockets;
+  for (auto cpu : allowedCPUs) {
+    auto topologyDir = cpuDir + std::to_string(cpu) + "/topology/";
+    int64_t package, core;
+    if (!readInteger(topologyDir + "physical_package_id", package)
+        || !readInteger(topologyDir + "core_id", core)) {
+      physicalCores.clear();
+      break;
+    }
+    physicalCores.insert({ package, core });
+    sockets.insert(package);
+  }
+  if (physicalCores.empty()) {
+
+    /*
+     * The topology is unknown: assume two hardware threads per core.
+     */
+    t.physicalCores = std::max(1u, t.logicalCores / 2);
+  } else {
+    t.physicalCores = physicalCores.size();
+    t.sockets = sockets.size();
+  }
+  t.smtSiblings = std::max(1u, t.logicalCores / t.physicalCores);
+
+  /*
+   * Honor the CPU quota of the cgroup.
+   */
+  auto quotaCores = getCoresOfCPUQuota();
+  if (quotaCores > 0) {
+    t.logicalCores = std::min(t.logicalCores, quotaCores);
+    t.physicalCores = std::min(t.physicalCores, quotaCores);
+  }
+
+  return;
+}
+
+static void discoverNUMANodes(Topology &t) {
+  uint32_t nodes = 0;
+  std::string cpus;
+  while (readFirstLine("/sys/devices/system/node/node" + std::to_string(nodes)
+                           + "/cpulist",
+                       cpus)) {
+    nodes++;
+  }
+  if (nodes > 0) {
+    t.numaNodes = nodes;
+  }
+
+  return;
+}
+
+static void discoverCaches(Topology &t) {
+
+  /*
+   * Iterate over the caches of the first CPU.
+   */
+  const std::string cacheDir = "/sys/devices/system/cpu/cpu0/cache/index";
+  int64_t maxLevel = 0;
+  for (auto index = 0u;; index++) {
+    auto dir = cacheDir + std::to_string(index) + "/";
+    int64_t level;
+    std::string type;
+    uint64_t bytes;
+    if (!readInteger(dir + "level", level) || !readFirstLine(dir + "type", type)
+        || !readSize(dir + "size", bytes)) {
+      break;
+    }
+    if (StringRef(type).trim() == "Instruction") {
+      continue;
+    }
+
+    int64_t lineBytes;
+    if ((level == 1) && readInteger(dir + "coherency_line_size", lineBytes)
+        && (lineBytes > 0) && isValidCacheLineBytes(lineBytes)) {
+      t.cacheLineBytes = lineBytes;
+    }
+    if (level == 1) {
+      t.l1CacheBytes = bytes;
+    } else if (level == 2) {
+      t.l2CacheBytes = bytes;
+    }
+    if (level >= maxLevel) {
+      maxLevel = level;
+      t.llcBytes = bytes;
+    }
+  }
+
+  return;
+}
+
+static void readArchitectureFile(const std::string &fileName, Topology &t) {
+  std::ifstream file(fileName);
+  if (!file.is_open()) {
+    errs() << "NOELLE: Architecture: cannot open " << fileName << "\n";
+    abort();
+  }
+  std::stringstream content;
+  content << file.rdbuf();
+
+  /*
+   * Parse the description of the architecture.
+   */
+  std::string error;
+  auto values =
+      Architecture::parseArchitectureDescription(content.str(), error);
+  if (!values) {
+    errs() << "NOELLE: Architecture: " << error << " in " << fileName << "\n";
+    abort();
+  }
+
+  /*
+   * Override the discovered topology.
+   */
+  for (const auto &[key, value] : *values) {
+    if (key == "logical_cores") {
+      t.logicalCores = value;
+    } else if (key == "physical_cores") {
+      t.physicalCores = value;
+    } else if (key == "smt_siblings") {
+      t.smtSiblings = value;
+    } else if (key == "numa_nodes") {
+      t.numaNodes = value;
+    } else if (key == "sockets") {
+      t.sockets = value;
+    } else if (key == "cache_line_bytes") {
+      t.cacheLineBytes = value;
+    } else if (key == "l1_cache_bytes") {
+      t.l1CacheBytes = value;
+    } else if (key == "l2_cache_bytes") {
+      t.l2CacheBytes = value;
+    } else if (key == "llc_bytes") {
+      t.llcBytes = value;
+    }
+  }
+
+  return;
+}
+
+static const Topology &getTopology(void) {
+  static Topology topology = []() {
+    Topology t;
+    discoverCPUs(t);
+    discoverNUMANodes(t);
+    discoverCaches(t);
+    if (!ArchitectureFile.empty()) {
+      readArchitectureFile(ArchitectureFile, t);
+    }
+    return t;
+  }();
+
+  return topology;
+}
+
 Architecture::Architecture() {
   return;
 }
 
 uint32_t Architecture::getNumberOfLogicalCores(void) {
-  return std::thread::hardware_concurrency();
+  return getTopology().logicalCores;
 }
 
 uint32_t Architecture::getNumberOfPhysicalCores(void) {
-  return getNumberOfLogicalCores() / 2;
+  return getTopology().physicalCores;
+}
+
+uint32_t Architecture::getNumberOfSMTSiblings(void) {
+  return getTopology().smtSiblings;
+}
+
+uint32_t Architecture::getNumberOfNUMANodes(void) {
+  return getTopology().numaNodes;
+}
+
+uint32_t Architecture::getNumberOfSockets(void) {
+  return getTopology().sockets;
 }
 
 int32_t Architecture::getCacheLineBytes(void) {
-  return 64;
+  return getTopology().cacheLineBytes;
+}
+
+uint64_t Architecture::getL1CacheBytes(void) {
+  return getTopology().l1CacheBytes;
+}
+
+uint64_t Architecture::getL2CacheBytes(void) {
+  return getTopology().l2CacheBytes;
+}
+
+uint64_t Architecture::getLastLevelCacheBytes(void) {
+  return getTopology().llcBytes;
+}
+
+std::optional<std::map<std::string, uint64_t>> Architecture::
+    parseArchitectureDescription(StringRef description, std::string &error) {
+  const std::set<StringRef> keys{ "logical_cores",  "physical_cores",
+                                  "smt_siblings",   "numa_nodes",
+                                  "sockets",        "cache_line_bytes",
+                                  "l1_cache_bytes", "l2_cache_bytes",
+                                  "llc_bytes" };
+
+  std::map<std::string, uint64_t> values;
+  SmallVector<StringRef, 16> lines;
+  description.split(lines, '\n');
+  for (auto line : lines) {
+    auto text = line.trim();
+    if (text.empty() || text.startswith("#")) {
+      continue;
+    }
+    auto fields = text.split(' ');
+    auto key = fields.first.trim();
+    uint64_t value;
+    if (fields.second.trim().getAsInteger(10, value) || (value == 0)) {
+      error = "bad line \"" + text.str() + "\"";
+      return std::nullopt;
+    }
+    if (keys.find(key) == keys.end()) {
+      error = "unknown key \"" + key.str() + "\"";
+      return std::nullopt;
+    }
+
+    /*
+     * A cache line smaller than 8 bytes cannot hold a single value, so
+     * private copies laid out one per cache line would overlap.
+     */
+    if ((key == "cache_line_bytes") && !isValidCacheLineBytes(value)) {
+      error = "cache_line_bytes must be a power of two of at least 8 (got "
+              + std::to_string(value) + ")";
+      return std::nullopt;
+    }
+
+    values[key.str()] = value;
+  }
+
+  return values;
+}
+
+std::vector<std::string> Architecture::getCgroupDirectories(
+    StringRef procCgroup) {
+  std::vector<std::string> dirs;
+
+  /*
+   * Each line of /proc/self/cgroup is "<id>:<controllers>:<path>".
+   * The v2 hierarchy has id 0 and no controllers.
+   */
+  SmallVector<StringRef, 16> lines;
+  procCgroup.split(lines, '\n');
+  for (auto line : lines) {
+    SmallVector<StringRef, 3> fields;
+    line.trim().split(fields, ':', 2);
+    if (fields.size() != 3) {
+      continue;
+    }
+    std::string mountPoint;
+    if ((fields[0] == "0") && fields[1].empty()) {
+      mountPoint = "/sys/fs/cgroup";
+    } else {
+      SmallVector<StringRef, 4> controllers;
+      fields[1].split(controllers, ',');
+      if (!is_contained(controllers, "cpu")) {
+        continue;
+      }
+      mountPoint = "/sys/fs/cgroup/cpu";
+    }
+
+    /*
+     * Add the directory of the cgroup and the ones of its ancestors.
+     */
+    auto path = fields[2].rtrim('/');
+    while (true) {
+      dirs.push_back(mountPoint + path.str());
+      if (path.empty()) {
+        break;
+      }
+      path = path.substr(0, path.rfind('/'));
+    }
+  }
+
+  /*
+   * Fall back to the root of the hierarchies.
+   */
+  if (dirs.empty()) {
+    dirs.push_back("/sys/fs/cgroup");
+    dirs.push_back("/sys/fs/cgroup/cpu");
+  }
+
+  return dirs;
 }
 
 } // namespace arcana::noelle
@@ -11,7 +11,9 @@ namespace llvm {
 // holds for a pair with indices (i,j) (i.e., R(i,j) = 0/1)
 // BitMatrix is intended for a dense, asymmetric relation R.
 struct BitMatrix {
-  BitMatrix(uint32_t n = 1) : N(n), bv(n * n) {}
+  BitMatrix(uint32_t n = 1) {
+    resize(n);
+  }
 
   // Returns the size of BitVector
   uint32_t count() const;
@@ -28,15 +30,24 @@ struct BitMatrix {
 
   // Computes the transitive closure.
   // For example, given a adjacency matrix, it converts it to a connectivity
-  // matrix, where (i,j) is set if there is a directed path from i to j
+  // matrix, where (i,j) is set if there is a directed path from i to j.
+  // Acyclic relations are closed in reverse topological order with one row
+  // union per edge; cyclic ones fall back to a word-parallel Warshall.
   void transitiveClosure();
 
   // Emits to fout the BitMatrix
   void dump(raw_ostream &fout) const;
 
 private:
+  typedef uint64_t Word;
+  static const uint32_t BitsPerWord = 64;
+
   uint32_t N;
-  BitVector bv;
+
+  // Number of words of a row; rows start at word boundaries
+  uint32_t wordsPerRow;
+
+  std::vector<Word> words;
 
   // For a given row returns the first col that is set.
   // Returns -1 if none found.
@@ -46,9 +57,21 @@ private:
   // Returns -1 if none found.
   int32_t nextSuccessor(uint32_t row, uint32_t prev) const;
 
-  // Returns the index corresponding to a pair (row.col)
-  // i.e., idx = row * N + col
-  uint32_t idx(uint32_t row, uint32_t col) const;
+  // Returns the columns set in row
+  std::vector<uint32_t> successors(uint32_t row) const;
+
+  // Computes row[dst] |= row[src] one word at a time
+  void unionRows(uint32_t dst, uint32_t src);
+
+  // Returns the first word of row
+  Word *rowBegin(uint32_t row);
+  const Word *rowBegin(uint32_t row) const;
+
+  // Returns the index of the word that holds (row,col)
+  size_t wordIdx(uint32_t row, uint32_t col) const;
+
+  // Computes the transitive closure of a relation that may have cycles
+  void transitiveClosureWarshall();
 };
 
 } // namespace llvm
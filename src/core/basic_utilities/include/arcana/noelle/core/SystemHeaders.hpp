@@ -43,12 +43,18 @@
  * LLVM headers.
  */
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/IR/InstrTypes.h"
 #include <llvm/ADT/StringRef.h>
 #include "llvm/ADT/iterator_range.h"
 #include "llvm/ADT/SCCIterator.h"
 #include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/SparseBitVector.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/PointerIntPair.h"
+#include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/Pass.h"
 #include "llvm/IR/Function.h"
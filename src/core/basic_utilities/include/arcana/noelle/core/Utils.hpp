@@ -55,6 +55,22 @@ public:
                             IRBuilder<> &builder);
 
   static Value *injectPrint(const std::string &toPrint, IRBuilder<> &builder);
+
+  /*
+   * Return a hash of the body of @F.
+   *
+   * The hash covers the opcodes, the types, and the operands of the
+   * instructions, including the contents of the constants they use. It does
+   * not depend on the addresses of the values, so it can be compared across
+   * runs of the compiler.
+   */
+  static uint64_t computeFingerprint(Function &F);
+
+  /*
+   * Return a hash of the type, the linkage, and the contents of the
+   * initializer of @G.
+   */
+  static uint64_t computeFingerprint(GlobalVariable &G);
 };
 
 template <class T>
@@ -4,111 +4,157 @@ namespace llvm {
 
 void BitMatrix::resize(uint32_t n) {
   N = n;
-  bv.clear();
-  bv.resize(n * n);
+  wordsPerRow = (n + BitsPerWord - 1) / BitsPerWord;
+  words.clear();
+  words.resize(((size_t)n) * wordsPerRow, 0);
 }
 
-uint32_t BitMatrix::idx(uint32_t row, uint32_t col) const {
+size_t BitMatrix::wordIdx(uint32_t row, uint32_t col) const {
   assert(row < N);
   assert(col < N);
-  return row * N + col;
+  return ((size_t)row) * wordsPerRow + (col / BitsPerWord);
+}
+
+BitMatrix::Word *BitMatrix::rowBegin(uint32_t row) {
+  return words.data() + ((size_t)row) * wordsPerRow;
+}
+
+const BitMatrix::Word *BitMatrix::rowBegin(uint32_t row) const {
+  return words.data() + ((size_t)row) * wordsPerRow;
 }
 
 uint32_t BitMatrix::count() const {
-  return bv.count();
+  uint32_t c = 0;
+  for (auto w : words) {
+    c += countPopulation(w);
+  }
+
+  return c;
 }
 
 void BitMatrix::set(uint32_t row, uint32_t col, bool v) {
-  const uint32_t i = idx(row, col);
+  const Word mask = ((Word)1) << (col % BitsPerWord);
+  auto &w = words[wordIdx(row, col)];
 
   if (v) {
-    bv.set(i);
+    w |= mask;
   } else {
-    bv.reset(i);
+    w &= ~mask;
   }
 }
 
 bool BitMatrix::test(uint32_t row, uint32_t col) const {
-  const uint32_t i = idx(row, col);
+  const Word mask = ((Word)1) << (col % BitsPerWord);
 
-  return bv.test(i);
+  return (words[wordIdx(row, col)] & mask) != 0;
 }
 
 int32_t BitMatrix::firstSuccessor(uint32_t row) const {
-  const uint32_t rowBegin = N * row;
-  int32_t next = -1;
-
-  if (0 == rowBegin) {
-    next = bv.find_first();
-  } else {
-    next = bv.find_next(rowBegin - 1);
+  const Word *r = rowBegin(row);
+  for (uint32_t i = 0; i < wordsPerRow; ++i) {
+    if (r[i] != 0) {
+      return i * BitsPerWord + countTrailingZeros(r[i]);
+    }
   }
 
-  if (-1 == next) {
+  return -1;
+}
+
+int32_t BitMatrix::nextSuccessor(uint32_t row, uint32_t prev) const {
+  const uint32_t col = prev + 1;
+  if (col >= N) {
     return -1;
   }
 
-  const uint32_t rowEnd = rowBegin + N;
-  if (((uint32_t)next) >= rowEnd) {
-    return -1;
+  // Check the rest of the word that contains prev+1
+  const Word *r = rowBegin(row);
+  uint32_t i = col / BitsPerWord;
+  const Word w = r[i] & (~((Word)0) << (col % BitsPerWord));
+  if (w != 0) {
+    return i * BitsPerWord + countTrailingZeros(w);
   }
 
-  return next - rowBegin;
+  // Check the next words
+  for (++i; i < wordsPerRow; ++i) {
+    if (r[i] != 0) {
+      return i * BitsPerWord + countTrailingZeros(r[i]);
+    }
+  }
+
+  return -1;
 }
 
-int32_t BitMatrix::nextSuccessor(uint32_t row, uint32_t prev) const {
-  int32_t next = bv.find_next(N * row + prev);
-  if (-1 == next) {
-    return -1;
+std::vector<uint32_t> BitMatrix::successors(uint32_t row) const {
+  std::vector<uint32_t> s;
+  const Word *r = rowBegin(row);
+  for (uint32_t i = 0; i < wordsPerRow; ++i) {
+    for (Word w = r[i]; w != 0; w &= w - 1) {
+      s.push_back(i * BitsPerWord + countTrailingZeros(w));
+    }
   }
 
-  const uint32_t rowBegin = N * row;
-  const uint32_t rowEnd = rowBegin + N;
-  if (((uint32_t)next) >= rowEnd) {
-    return -1;
+  return s;
+}
+
+void BitMatrix::unionRows(uint32_t dst, uint32_t src) {
+  Word *__restrict d = rowBegin(dst);
+  const Word *__restrict s = rowBegin(src);
+
+  if (d == s) {
+    return;
   }
 
-  return next - rowBegin;
+  // This loop is vectorized by the compiler when the target allows it
+  for (uint32_t i = 0; i < wordsPerRow; ++i) {
+    d[i] |= s[i];
+  }
 }
 
 void BitMatrix::transitiveClosure() {
-  uint32_t nAdd = 0;
 
-  typedef std::list<uint32_t> Worklist;
-  Worklist worklist;
+  // Compute a topological order of the relation (Kahn's algorithm)
+  std::vector<uint32_t> inDegree(N, 0);
   for (uint32_t i = 0; i < N; ++i) {
-    worklist.push_back(i);
+    for (auto j : successors(i)) {
+      ++inDegree[j];
+    }
+  }
+  std::vector<uint32_t> order;
+  order.reserve(N);
+  for (uint32_t i = 0; i < N; ++i) {
+    if (inDegree[i] == 0) {
+      order.push_back(i);
+    }
+  }
+  for (uint32_t next = 0; next < order.size(); ++next) {
+    for (auto j : successors(order[next])) {
+      if (--inDegree[j] == 0) {
+        order.push_back(j);
+      }
+    }
   }
 
-  while (!worklist.empty()) {
-    uint32_t i = worklist.front();
-    worklist.pop_front();
-
-    bool changedI = false;
-
-    // (i->j)
-    for (int32_t j = firstSuccessor(i); j != -1; j = nextSuccessor(i, j)) {
-      // bit-wise or row[i] |= row[j]
+  // Cycles (self loops included) need the general algorithm
+  if (order.size() != N) {
+    transitiveClosureWarshall();
+    return;
+  }
 
-      // (j->k)
-      for (int32_t k = firstSuccessor(j); k != -1; k = nextSuccessor(j, k)) {
-        // but not (i->k)
-        if (!test(i, k)) {
-          changedI = true;
-          ++nAdd;
-          set(i, k);
-        }
-      }
+  // Visit nodes in reverse topological order: when i is visited, the rows of
+  // its successors are already closed, so row[i] is the union of them.
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    const uint32_t i = *it;
+    for (auto j : successors(i)) {
+      unionRows(i, j);
     }
+  }
+}
 
-    if (changedI) {
-      for (uint32_t p = 0; p < N; ++p) {
-        if (test(p, i)) {
-          if (std::find(worklist.begin(), worklist.end(), p)
-              == worklist.end()) {
-            worklist.push_back(p);
-          }
-        }
+void BitMatrix::transitiveClosureWarshall() {
+  for (uint32_t k = 0; k < N; ++k) {
+    for (uint32_t i = 0; i < N; ++i) {
+      if (test(i, k)) {
+        unionRows(i, k);
       }
     }
   }
@@ -22,6 +22,7 @@
 #include "arcana/noelle/core/Utils.hpp"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/InlineAsm.h"
 
 namespace arcana::noelle {
 
@@ -304,4 +305,221 @@ Value *Utils::injectPrint(const std::string &toPrint, IRBuilder<> &builder) {
   return callToPrintf;
 }
 
+namespace {
+
+/*
+ * FNV-1a hash of IR entities.
+ *
+ * Values local to the function being hashed are identified by their position
+ * (see localIDs), while constants are hashed by content.
+ */
+class FingerprintBuilder {
+public:
+  std::unordered_map<Value *, uint64_t> localIDs;
+
+  uint64_t getHash(void) const {
+    return this->hash;
+  }
+
+  void mix(uint64_t v) {
+    this->hash ^= v;
+    this->hash *= 1099511628211ULL;
+  }
+
+  void mixName(StringRef name) {
+    this->mix(name.size());
+    for (auto c : name) {
+      this->mix(static_cast<uint8_t>(c));
+    }
+  }
+
+  void mixAPInt(const APInt &value) {
+    this->mix(value.getBitWidth());
+    for (unsigned i = 0; i < value.getNumWords(); i++) {
+      this->mix(value.getRawData()[i]);
+    }
+  }
+
+  void mixType(Type *t) {
+    this->mix(t->getTypeID());
+    if (t->isIntegerTy()) {
+      this->mix(t->getIntegerBitWidth());
+
+    } else if (auto pt = dyn_cast<PointerType>(t)) {
+      this->mix(pt->getAddressSpace());
+      if (!pt->isOpaque()) {
+        this->mixType(pt->getNonOpaquePointerElementType());
+      }
+
+    } else if (auto at = dyn_cast<ArrayType>(t)) {
+      this->mix(at->getNumElements());
+      this->mixType(at->getElementType());
+
+    } else if (auto vt = dyn_cast<VectorType>(t)) {
+      this->mix(vt->getElementCount().getKnownMinValue());
+      this->mixType(vt->getElementType());
+
+    } else if (auto st = dyn_cast<StructType>(t)) {
+
+      /*
+       * Named structures are identified by their name to avoid recursing on
+       * recursive types.
+       */
+      if (st->hasName()) {
+        this->mixName(st->getName());
+      } else {
+        this->mix(st->isPacked());
+        this->mix(st->getNumElements());
+        for (auto elementType : st->elements()) {
+          this->mixType(elementType);
+        }
+      }
+
+    } else if (auto ft = dyn_cast<FunctionType>(t)) {
+      this->mix(ft->isVarArg());
+      this->mixType(ft->getReturnType());
+      this->mix(ft->getNumParams());
+      for (auto paramType : ft->params()) {
+        this->mixType(paramType);
+      }
+    }
+  }
+
+  void mixValue(Value *v) {
+    auto it = this->localIDs.find(v);
+    if (it != this->localIDs.end()) {
+      this->mix(1);
+      this->mix(it->second);
+
+    } else if (auto g = dyn_cast<GlobalValue>(v)) {
+      this->mix(2);
+      this->mixName(g->getName());
+
+    } else if (auto c = dyn_cast<ConstantInt>(v)) {
+      this->mix(3);
+      this->mixAPInt(c->getValue());
+
+    } else if (auto c = dyn_cast<ConstantFP>(v)) {
+      this->mix(4);
+      this->mixType(c->getType());
+      this->mixAPInt(c->getValueAPF().bitcastToAPInt());
+
+    } else if (auto c = dyn_cast<ConstantDataSequential>(v)) {
+      this->mix(5);
+      this->mixType(c->getType());
+      this->mixName(c->getRawDataValues());
+
+    } else if (auto c = dyn_cast<ConstantExpr>(v)) {
+      this->mix(6);
+      this->mix(c->getOpcode());
+      this->mixType(c->getType());
+      if (c->isCompare()) {
+        this->mix(c->getPredicate());
+      }
+      if (auto gep = dyn_cast<GEPOperator>(c)) {
+        this->mixType(gep->getSourceElementType());
+        this->mix(gep->isInBounds());
+      }
+      if (c->hasIndices()) {
+        for (auto index : c->getIndices()) {
+          this->mix(index);
+        }
+      }
+      this->mix(c->getNumOperands());
+      for (auto op : c->operand_values()) {
+        this->mixValue(op);
+      }
+
+    } else if (auto c = dyn_cast<ConstantAggregate>(v)) {
+      this->mix(7);
+      this->mixType(c->getType());
+      this->mix(c->getNumOperands());
+      for (auto op : c->operand_values()) {
+        this->mixValue(op);
+      }
+
+    } else if (auto a = dyn_cast<InlineAsm>(v)) {
+      this->mix(8);
+      this->mixType(a->getFunctionType());
+      this->mixName(a->getAsmString());
+      this->mixName(a->getConstraintString());
+
+    } else {
+
+      /*
+       * Null pointers, zero initializers, undef, poison, and the other values
+       * without content are identified by their kind and their type.
+       */
+      this->mix(9);
+      this->mix(v->getValueID());
+      this->mixType(v->getType());
+    }
+  }
+
+private:
+  uint64_t hash = 14695981039346656037ULL;
+};
+
+} // namespace
+
+uint64_t Utils::computeFingerprint(Function &F) {
+  FingerprintBuilder fingerprint;
+
+  /*
+   * Number the arguments, the basic blocks, and the instructions of @F.
+   */
+  uint64_t localID = 0;
+  for (auto &arg : F.args()) {
+    fingerprint.localIDs[&arg] = localID++;
+  }
+  for (auto &BB : F) {
+    fingerprint.localIDs[&BB] = localID++;
+    for (auto &inst : BB) {
+      fingerprint.localIDs[&inst] = localID++;
+    }
+  }
+
+  /*
+   * Hash the body.
+   */
+  fingerprint.mix(F.arg_size());
+  for (auto &arg : F.args()) {
+    fingerprint.mixType(arg.getType());
+  }
+  for (auto &BB : F) {
+    fingerprint.mix(BB.size());
+    for (auto &inst : BB) {
+      fingerprint.mix(inst.getOpcode());
+      fingerprint.mixType(inst.getType());
+      if (auto cmp = dyn_cast<CmpInst>(&inst)) {
+        fingerprint.mix(cmp->getPredicate());
+      } else if (auto alloca = dyn_cast<AllocaInst>(&inst)) {
+        fingerprint.mixType(alloca->getAllocatedType());
+      } else if (auto gep = dyn_cast<GetElementPtrInst>(&inst)) {
+        fingerprint.mixType(gep->getSourceElementType());
+      }
+      fingerprint.mix(inst.getNumOperands());
+      for (auto op : inst.operand_values()) {
+        fingerprint.mixValue(op);
+      }
+    }
+  }
+
+  return fingerprint.getHash();
+}
+
+uint64_t Utils::computeFingerprint(GlobalVariable &G) {
+  FingerprintBuilder fingerprint;
+
+  fingerprint.mixType(G.getValueType());
+  fingerprint.mix(G.isConstant());
+  fingerprint.mix(G.getLinkage());
+  fingerprint.mix(G.hasInitializer());
+  if (G.hasInitializer()) {
+    fingerprint.mixValue(G.getInitializer());
+  }
+
+  return fingerprint.getHash();
+}
+
 } // namespace arcana::noelle
@@ -30,6 +30,12 @@ class CFGTransformer {
 public:
   CFGTransformer();
 
+  /*
+   * Set the function to invoke every time the transformer modifies a
+   * function.
+   */
+  void setFunctionModifiedCallback(std::function<void(Function *)> callback);
+
   BasicBlock *branchToANewBasicBlockAndBack(
       Instruction *splitPoint,
       std::string newBasicBlockName,
@@ -45,6 +51,7 @@ public:
           addConditionalBranch);
 
 private:
+  std::function<void(Function *)> functionModified;
 };
 
 } // namespace arcana::noelle
@@ -23,7 +23,14 @@
 
 namespace arcana::noelle {
 
-CFGTransformer::CFGTransformer() {
+CFGTransformer::CFGTransformer() : functionModified{} {
+  return;
+}
+
+void CFGTransformer::setFunctionModifiedCallback(
+    std::function<void(Function *)> callback) {
+  this->functionModified = callback;
+
   return;
 }
 
@@ -80,6 +87,13 @@ void CFGTransformer::branchToTargetBasicBlockAndBack(
    */
   addConditionalBranch(&targetBB, newLastBB);
 
+  /*
+   * Notify that the function has been modified.
+   */
+  if (this->functionModified) {
+    this->functionModified(bb->getParent());
+  }
+
   return;
 }
 
@@ -32,7 +32,9 @@ public:
                             uint32_t maxCores,
                             bool arePRVGsNonDeterministic,
                             bool areFloatRealNumbers,
-                            bool hoistLoopsToMain);
+                            bool hoistLoopsToMain,
+                            uint64_t maxArrayReductionBytes,
+                            bool packReadOnlyEnvironmentVariables);
 
   uint32_t getMaximumNumberOfCores(void) const;
 
@@ -42,12 +44,26 @@ public:
 
   bool shouldLoopsBeHoistToMain(void) const;
 
+  /*
+   * Return the maximum size (in bytes) of an array that can be reduced by
+   * privatizing it per worker (0 disables array reductions).
+   */
+  uint64_t getMaximumSizeOfArrayReductions(void) const;
+
+  /*
+   * Return true if the read-only variables of loop environments should be
+   * packed next to each other by default (see LoopEnvironmentLayout).
+   */
+  bool shouldReadOnlyEnvironmentVariablesBePacked(void) const;
+
 private:
   Module &program;
   uint32_t _maxCores;
   bool _arePRVGsNonDeterministic;
   bool _areFloatRealNumbers;
   bool _hoistLoopsToMain;
+  uint64_t _maxArrayReductionBytes;
+  bool _packReadOnlyEnvironmentVariables;
 };
 
 } // namespace arcana::noelle
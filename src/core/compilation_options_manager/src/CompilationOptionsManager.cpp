@@ -28,12 +28,16 @@ CompilationOptionsManager::CompilationOptionsManager(
     uint32_t maxCores,
     bool arePRVGsNonDeterministic,
     bool areFloatRealNumbers,
-    bool hoistLoopsToMain)
+    bool hoistLoopsToMain,
+    uint64_t maxArrayReductionBytes,
+    bool packReadOnlyEnvironmentVariables)
   : program{ m },
     _maxCores{ maxCores },
     _arePRVGsNonDeterministic{ arePRVGsNonDeterministic },
     _areFloatRealNumbers{ areFloatRealNumbers },
-    _hoistLoopsToMain{ hoistLoopsToMain } {
+    _hoistLoopsToMain{ hoistLoopsToMain },
+    _maxArrayReductionBytes{ maxArrayReductionBytes },
+    _packReadOnlyEnvironmentVariables{ packReadOnlyEnvironmentVariables } {
   return;
 }
 
@@ -53,4 +57,14 @@ bool CompilationOptionsManager::shouldLoopsBeHoistToMain(void) const {
   return this->_hoistLoopsToMain;
 }
 
+uint64_t CompilationOptionsManager::getMaximumSizeOfArrayReductions(
+    void) const {
+  return this->_maxArrayReductionBytes;
+}
+
+bool CompilationOptionsManager::shouldReadOnlyEnvironmentVariablesBePacked(
+    void) const {
+  return this->_packReadOnlyEnvironmentVariables;
+}
+
 } // namespace arcana::noelle
@@ -0,0 +1,280 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_DATAFLOW_BITVECTORDATAFLOWRESULT_H_
+#define NOELLE_SRC_CORE_DATAFLOW_BITVECTORDATAFLOWRESULT_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/DataFlowResult.hpp"
+#include "arcana/noelle/core/InstructionNumbering.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Operations on the rows (i.e., sets of instruction IDs) of a bit-vector
+ * data-flow result.
+ * They are provided for both llvm::BitVector (dense rows) and
+ * llvm::SparseBitVector (sparse rows).
+ */
+namespace DataFlowRow {
+
+inline void initialize(BitVector &row, uint32_t universeSize, bool full) {
+  row.clear();
+  row.resize(universeSize, full);
+}
+
+inline void initialize(SparseBitVector<> &row,
+                       uint32_t universeSize,
+                       bool full) {
+  row.clear();
+  if (full) {
+    for (auto id = 0u; id < universeSize; id++) {
+      row.set(id);
+    }
+  }
+}
+
+inline void set(BitVector &row, uint32_t universeSize, uint32_t id) {
+  if (row.size() < universeSize) {
+    row.resize(universeSize);
+  }
+  row.set(id);
+}
+
+inline void set(SparseBitVector<> &row, uint32_t, uint32_t id) {
+  row.set(id);
+}
+
+inline void reset(BitVector &row, uint32_t id) {
+  if (id < row.size()) {
+    row.reset(id);
+  }
+}
+
+inline void reset(SparseBitVector<> &row, uint32_t id) {
+  row.reset(id);
+}
+
+inline bool test(const BitVector &row, uint32_t id) {
+  return (id < row.size()) && row.test(id);
+}
+
+inline bool test(const SparseBitVector<> &row, uint32_t id) {
+  return row.test(id);
+}
+
+inline bool empty(const BitVector &row) {
+  return row.none();
+}
+
+inline bool empty(const SparseBitVector<> &row) {
+  return row.empty();
+}
+
+inline uint32_t count(const BitVector &row) {
+  return row.count();
+}
+
+inline uint32_t count(const SparseBitVector<> &row) {
+  return row.count();
+}
+
+inline void unionWith(BitVector &row, const BitVector &other) {
+  row |= other;
+}
+
+inline void unionWith(SparseBitVector<> &row, const SparseBitVector<> &other) {
+  row |= other;
+}
+
+inline void intersectWith(BitVector &row, const BitVector &other) {
+  row &= other;
+}
+
+inline void intersectWith(SparseBitVector<> &row,
+                          const SparseBitVector<> &other) {
+  row &= other;
+}
+
+inline void subtract(BitVector &row, const BitVector &other) {
+  row.reset(other);
+}
+
+inline void subtract(SparseBitVector<> &row, const SparseBitVector<> &other) {
+  row.intersectWithComplement(other);
+}
+
+inline auto members(const BitVector &row) {
+  return row.set_bits();
+}
+
+inline const SparseBitVector<> &members(const SparseBitVector<> &row) {
+  return row;
+}
+
+} // namespace DataFlowRow
+
+/*
+ * The meet operator of a bit-vector data-flow analysis.
+ */
+enum class DataFlowMeet { Union, Intersection };
+
+/*
+ * Result of a data-flow analysis where the elements of the sets are the
+ * instructions of a single function.
+ *
+ * Instructions are identified by the dense IDs of an InstructionNumbering and
+ * GEN/KILL/IN/OUT are stored as one bit-vector row per instruction.
+ * The std::set based API of DataFlowResult is still available: sets are
+ * materialized on demand from the rows the first time they are requested.
+ * Hence, such sets reflect the rows at the time of their first request.
+ * As in DataFlowResult, the sets of instructions of other functions are empty.
+ */
+template <typename RowT>
+class BitVectorDataFlowResult : public DataFlowResult {
+public:
+  /*
+   * Methods
+   */
+  BitVectorDataFlowResult(Function *f)
+    : numbering{ f },
+      gens(numbering.getNumberOfInstructions()),
+      kills(numbering.getNumberOfInstructions()),
+      ins(numbering.getNumberOfInstructions()),
+      outs(numbering.getNumberOfInstructions()) {
+    return;
+  }
+
+  const InstructionNumbering &getNumbering(void) const {
+    return this->numbering;
+  }
+
+  uint32_t getID(Instruction *inst) const {
+    return this->numbering.getID(inst);
+  }
+
+  Instruction *getInstruction(uint32_t id) const {
+    return this->numbering.getInstruction(id);
+  }
+
+  uint32_t getNumberOfInstructions(void) const {
+    return this->numbering.getNumberOfInstructions();
+  }
+
+  RowT &GENBits(Instruction *inst) {
+    return this->gens[this->getID(inst)];
+  }
+
+  RowT &KILLBits(Instruction *inst) {
+    return this->kills[this->getID(inst)];
+  }
+
+  RowT &INBits(Instruction *inst) {
+    return this->ins[this->getID(inst)];
+  }
+
+  RowT &OUTBits(Instruction *inst) {
+    return this->outs[this->getID(inst)];
+  }
+
+  void addToGEN(Instruction *inst, Instruction *element) {
+    DataFlowRow::set(this->GENBits(inst),
+                     this->getNumberOfInstructions(),
+                     this->getID(element));
+  }
+
+  void addToKILL(Instruction *inst, Instruction *element) {
+    DataFlowRow::set(this->KILLBits(inst),
+                     this->getNumberOfInstructions(),
+                     this->getID(element));
+  }
+
+  bool isInIN(Instruction *inst, Instruction *element) {
+    if (!this->numbering.isNumbered(inst)
+        || !this->numbering.isNumbered(element)) {
+      return false;
+    }
+    return DataFlowRow::test(this->INBits(inst), this->getID(element));
+  }
+
+  bool isInOUT(Instruction *inst, Instruction *element) {
+    if (!this->numbering.isNumbered(inst)
+        || !this->numbering.isNumbered(element)) {
+      return false;
+    }
+    return DataFlowRow::test(this->OUTBits(inst), this->getID(element));
+  }
+
+  std::set<Value *> &GEN(Instruction *inst) override {
+    return this->materialize(inst, this->gens, DataFlowResult::GEN(inst));
+  }
+
+  std::set<Value *> &KILL(Instruction *inst) override {
+    return this->materialize(inst, this->kills, DataFlowResult::KILL(inst));
+  }
+
+  std::set<Value *> &IN(Instruction *inst) override {
+    return this->materialize(inst, this->ins, DataFlowResult::IN(inst));
+  }
+
+  std::set<Value *> &OUT(Instruction *inst) override {
+    return this->materialize(inst, this->outs, DataFlowResult::OUT(inst));
+  }
+
+private:
+  InstructionNumbering numbering;
+  std::vector<RowT> gens;
+  std::vector<RowT> kills;
+  std::vector<RowT> ins;
+  std::vector<RowT> outs;
+  std::unordered_set<std::set<Value *> *> materializedSets;
+
+  std::set<Value *> &materialize(Instruction *inst,
+                                 std::vector<RowT> &rows,
+                                 std::set<Value *> &s) {
+
+    /*
+     * Check if the set has already been materialized, or if there is no row
+     * for @inst (e.g., it belongs to another function).
+     */
+    if ((this->materializedSets.count(&s) > 0)
+        || !this->numbering.isNumbered(inst)) {
+      return s;
+    }
+    this->materializedSets.insert(&s);
+
+    /*
+     * Materialize the set from its row.
+     */
+    for (auto id : DataFlowRow::members(rows[this->getID(inst)])) {
+      s.insert(this->getInstruction(id));
+    }
+
+    return s;
+  }
+};
+
+using DenseDataFlowResult = BitVectorDataFlowResult<BitVector>;
+using SparseDataFlowResult = BitVectorDataFlowResult<SparseBitVector<>>;
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_DATAFLOW_BITVECTORDATAFLOWRESULT_H_
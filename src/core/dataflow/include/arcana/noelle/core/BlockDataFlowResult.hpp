@@ -0,0 +1,280 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_DATAFLOW_BLOCKDATAFLOWRESULT_H_
+#define NOELLE_SRC_CORE_DATAFLOW_BLOCKDATAFLOWRESULT_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/DataFlowResult.hpp"
+#include "arcana/noelle/core/BitVectorDataFlowResult.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Result of a bit-vector data-flow analysis that keeps the fixed point only at
+ * the basic block granularity.
+ *
+ * GEN and KILL are stored as lists of instruction IDs per instruction, and a
+ * single row is stored per basic block: the value that enters the basic block
+ * following the direction of the analysis.
+ * IN and OUT of an instruction are derived on demand by scanning the
+ * instructions of its basic block, so queries cost O(size of the basic block)
+ * instead of the O(instructions^2) bits that BitVectorDataFlowResult takes.
+ *
+ * The std::set based API of DataFlowResult is still available: sets are
+ * materialized on demand the first time they are requested.
+ * As in DataFlowResult, the sets of instructions of other functions are empty.
+ */
+template <typename RowT>
+class BlockDataFlowResult : public DataFlowResult {
+public:
+  /*
+   * Methods
+   */
+  BlockDataFlowResult(Function *f, bool isForward)
+    : numbering{ f },
+      isForward{ isForward },
+      gens(numbering.getNumberOfInstructions()),
+      kills(numbering.getNumberOfInstructions()) {
+    return;
+  }
+
+  const InstructionNumbering &getNumbering(void) const {
+    return this->numbering;
+  }
+
+  uint32_t getID(Instruction *inst) const {
+    return this->numbering.getID(inst);
+  }
+
+  Instruction *getInstruction(uint32_t id) const {
+    return this->numbering.getInstruction(id);
+  }
+
+  uint32_t getNumberOfInstructions(void) const {
+    return this->numbering.getNumberOfInstructions();
+  }
+
+  bool isForwardAnalysis(void) const {
+    return this->isForward;
+  }
+
+  void addToGEN(Instruction *inst, Instruction *element) {
+    this->gens[this->getID(inst)].push_back(this->getID(element));
+  }
+
+  void addToKILL(Instruction *inst, Instruction *element) {
+    this->kills[this->getID(inst)].push_back(this->getID(element));
+  }
+
+  ArrayRef<uint32_t> GENIDs(Instruction *inst) const {
+    return this->gens[this->getID(inst)];
+  }
+
+  ArrayRef<uint32_t> KILLIDs(Instruction *inst) const {
+    return this->kills[this->getID(inst)];
+  }
+
+  /*
+   * The value that enters @bb following the direction of the analysis (i.e.,
+   * the value at the beginning of @bb for forward analyses and at its end for
+   * backward ones).
+   */
+  RowT &EntryBits(BasicBlock *bb) {
+    return this->entries[bb];
+  }
+
+  bool isInIN(Instruction *inst, Instruction *element) const {
+    if (!this->numbering.isNumbered(inst)
+        || !this->numbering.isNumbered(element)) {
+      return false;
+    }
+    auto id = this->getID(element);
+    return this->isForward ? this->isInBefore(inst, id)
+                           : this->isInAfter(inst, id);
+  }
+
+  bool isInOUT(Instruction *inst, Instruction *element) const {
+    if (!this->numbering.isNumbered(inst)
+        || !this->numbering.isNumbered(element)) {
+      return false;
+    }
+    auto id = this->getID(element);
+    return this->isForward ? this->isInAfter(inst, id)
+                           : this->isInBefore(inst, id);
+  }
+
+  RowT INBits(Instruction *inst) const {
+    return this->isForward ? this->computeBefore(inst)
+                           : this->computeAfter(inst);
+  }
+
+  RowT OUTBits(Instruction *inst) const {
+    return this->isForward ? this->computeAfter(inst)
+                           : this->computeBefore(inst);
+  }
+
+  std::set<Value *> &GEN(Instruction *inst) override {
+    auto &s = DataFlowResult::GEN(inst);
+    if (this->numbering.isNumbered(inst)
+        && this->materializedSets.insert(&s).second) {
+      for (auto id : this->GENIDs(inst)) {
+        s.insert(this->getInstruction(id));
+      }
+    }
+    return s;
+  }
+
+  std::set<Value *> &KILL(Instruction *inst) override {
+    auto &s = DataFlowResult::KILL(inst);
+    if (this->numbering.isNumbered(inst)
+        && this->materializedSets.insert(&s).second) {
+      for (auto id : this->KILLIDs(inst)) {
+        s.insert(this->getInstruction(id));
+      }
+    }
+    return s;
+  }
+
+  std::set<Value *> &IN(Instruction *inst) override {
+    auto &s = DataFlowResult::IN(inst);
+    if (this->numbering.isNumbered(inst)
+        && this->materializedSets.insert(&s).second) {
+      for (auto id : DataFlowRow::members(this->INBits(inst))) {
+        s.insert(this->getInstruction(id));
+      }
+    }
+    return s;
+  }
+
+  std::set<Value *> &OUT(Instruction *inst) override {
+    auto &s = DataFlowResult::OUT(inst);
+    if (this->numbering.isNumbered(inst)
+        && this->materializedSets.insert(&s).second) {
+      for (auto id : DataFlowRow::members(this->OUTBits(inst))) {
+        s.insert(this->getInstruction(id));
+      }
+    }
+    return s;
+  }
+
+private:
+  InstructionNumbering numbering;
+  bool isForward;
+  std::vector<SmallVector<uint32_t, 1>> gens;
+  std::vector<SmallVector<uint32_t, 1>> kills;
+  DenseMap<BasicBlock *, RowT> entries;
+  std::unordered_set<std::set<Value *> *> materializedSets;
+
+  /*
+   * Check if @id belongs to the value that enters @bb.
+   * Basic blocks without a row (e.g., never reached by the analysis) enter
+   * with the empty set.
+   */
+  bool isInEntry(BasicBlock *bb, uint32_t id) const {
+    auto it = this->entries.find(bb);
+    if (it == this->entries.end()) {
+      return false;
+    }
+
+    return DataFlowRow::test(it->second, id);
+  }
+
+  Instruction *getPreviousInFlow(Instruction *inst) const {
+    return this->isForward ? inst->getPrevNode() : inst->getNextNode();
+  }
+
+  /*
+   * Check if @id belongs to the value just after @inst following the direction
+   * of the analysis.
+   * The instructions are scanned back to the entry of the basic block until
+   * one of them generates or kills @id.
+   */
+  bool isInAfter(Instruction *inst, uint32_t id) const {
+    for (auto current = inst; current != nullptr;
+         current = this->getPreviousInFlow(current)) {
+      auto currentID = this->getID(current);
+      if (is_contained(this->gens[currentID], id)) {
+        return true;
+      }
+      if (is_contained(this->kills[currentID], id)) {
+        return false;
+      }
+    }
+
+    return this->isInEntry(inst->getParent(), id);
+  }
+
+  bool isInBefore(Instruction *inst, uint32_t id) const {
+    auto previous = this->getPreviousInFlow(inst);
+    if (previous == nullptr) {
+      return this->isInEntry(inst->getParent(), id);
+    }
+
+    return this->isInAfter(previous, id);
+  }
+
+  void applyTransferFunction(Instruction *inst, RowT &row) const {
+    auto id = this->getID(inst);
+    for (auto killedID : this->kills[id]) {
+      DataFlowRow::reset(row, killedID);
+    }
+    for (auto generatedID : this->gens[id]) {
+      DataFlowRow::set(row, this->getNumberOfInstructions(), generatedID);
+    }
+  }
+
+  RowT computeBefore(Instruction *inst) const {
+    auto bb = inst->getParent();
+    RowT row = this->entries.lookup(bb);
+    if (this->isForward) {
+      for (auto &current : *bb) {
+        if (&current == inst) {
+          break;
+        }
+        this->applyTransferFunction(&current, row);
+      }
+    } else {
+      for (auto &current : reverse(*bb)) {
+        if (&current == inst) {
+          break;
+        }
+        this->applyTransferFunction(&current, row);
+      }
+    }
+
+    return row;
+  }
+
+  RowT computeAfter(Instruction *inst) const {
+    auto row = this->computeBefore(inst);
+    this->applyTransferFunction(inst, row);
+
+    return row;
+  }
+};
+
+using DenseBlockDataFlowResult = BlockDataFlowResult<BitVector>;
+using SparseBlockDataFlowResult = BlockDataFlowResult<SparseBitVector<>>;
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_DATAFLOW_BLOCKDATAFLOWRESULT_H_
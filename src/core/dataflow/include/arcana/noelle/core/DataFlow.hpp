@@ -24,7 +24,10 @@
 
 #include "arcana/noelle/core/SystemHeaders.hpp"
 
+#include "arcana/noelle/core/InstructionNumbering.hpp"
 #include "arcana/noelle/core/DataFlowResult.hpp"
+#include "arcana/noelle/core/BitVectorDataFlowResult.hpp"
+#include "arcana/noelle/core/BlockDataFlowResult.hpp"
 #include "arcana/noelle/core/DataFlowEngine.hpp"
 #include "arcana/noelle/core/DataFlowAnalysis.hpp"
 
@@ -24,6 +24,8 @@
 
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/DataFlowResult.hpp"
+#include "arcana/noelle/core/BitVectorDataFlowResult.hpp"
+#include "arcana/noelle/core/BlockDataFlowResult.hpp"
 
 namespace arcana::noelle {
 
@@ -41,6 +43,21 @@ public:
       std::function<bool(Instruction *i)> filter);
 
   DataFlowResult *getFullSets(Function *f);
+
+  DenseDataFlowResult *runDenseReachableAnalysis(
+      Function *f,
+      std::function<bool(Instruction *i)> filter);
+
+  /*
+   * Reachability analysis that keeps its fixed point only at the basic block
+   * granularity (see BlockDataFlowResult).
+   * An instruction j is reachable from i if j is in OUT(i) (see isInOUT).
+   */
+  DenseBlockDataFlowResult *runBlockReachableAnalysis(
+      Function *f,
+      std::function<bool(Instruction *i)> filter);
+
+  DenseDataFlowResult *getDenseFullSets(Function *f);
 };
 
 } // namespace arcana::noelle
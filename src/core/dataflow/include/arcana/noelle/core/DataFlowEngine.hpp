@@ -24,6 +24,8 @@
 
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/DataFlowResult.hpp"
+#include "arcana/noelle/core/BitVectorDataFlowResult.hpp"
+#include "arcana/noelle/core/BlockDataFlowResult.hpp"
 
 namespace arcana::noelle {
 
@@ -88,6 +90,57 @@ public:
                          std::set<Value *> &OUT,
                          DataFlowResult *df)> computeOUT);
 
+  /*
+   * Bit-vector engine.
+   *
+   * The transfer function of every instruction is OUT = GEN U (IN - KILL) for
+   * forward analyses and IN = GEN U (OUT - KILL) for backward ones.
+   * GEN and KILL of an instruction are set by @computeGENAndKILL through
+   * addToGEN/addToKILL (or GENBits/KILLBits) of the result given as input.
+   * The fixed point is computed at the basic block granularity with word-wide
+   * operations over a reverse-post-order worklist; then, the per-instruction
+   * IN and OUT rows are derived with a single scan of each basic block.
+   */
+  template <typename RowT>
+  BitVectorDataFlowResult<RowT> *applyForwardOnBitVectors(
+      Function *f,
+      DataFlowMeet meet,
+      std::function<void(Instruction *, BitVectorDataFlowResult<RowT> *)>
+          computeGENAndKILL);
+
+  template <typename RowT>
+  BitVectorDataFlowResult<RowT> *applyBackwardOnBitVectors(
+      Function *f,
+      DataFlowMeet meet,
+      std::function<void(Instruction *, BitVectorDataFlowResult<RowT> *)>
+          computeGENAndKILL);
+
+  /*
+   * Bit-vector engine that keeps the fixed point only at the basic block
+   * granularity (see BlockDataFlowResult).
+   *
+   * The equations are the ones of the bit-vector engine above.
+   * Control flow edges for which @isEdgeIgnored returns true (given the source
+   * and the destination of the edge in the CFG) do not propagate values.
+   */
+  template <typename RowT>
+  BlockDataFlowResult<RowT> *applyForwardOnBlocks(
+      Function *f,
+      DataFlowMeet meet,
+      std::function<void(Instruction *, BlockDataFlowResult<RowT> *)>
+          computeGENAndKILL,
+      std::function<bool(BasicBlock *, BasicBlock *)> isEdgeIgnored =
+          nullptr);
+
+  template <typename RowT>
+  BlockDataFlowResult<RowT> *applyBackwardOnBlocks(
+      Function *f,
+      DataFlowMeet meet,
+      std::function<void(Instruction *, BlockDataFlowResult<RowT> *)>
+          computeGENAndKILL,
+      std::function<bool(BasicBlock *, BasicBlock *)> isEdgeIgnored =
+          nullptr);
+
 protected:
   void computeGENAndKILL(
       Function *f,
@@ -125,6 +178,23 @@ private:
           getOutSetOfInst,
       std::function<BasicBlock::iterator(BasicBlock *)> getEndIterator,
       std::function<void(BasicBlock::iterator &)> incrementIterator);
+
+  template <typename RowT>
+  BitVectorDataFlowResult<RowT> *applyGeneralizedBitVectorAnalysis(
+      Function *f,
+      DataFlowMeet meet,
+      bool isForward,
+      std::function<void(Instruction *, BitVectorDataFlowResult<RowT> *)>
+          computeGENAndKILL);
+
+  template <typename RowT>
+  BlockDataFlowResult<RowT> *applyGeneralizedBlockAnalysis(
+      Function *f,
+      DataFlowMeet meet,
+      bool isForward,
+      std::function<void(Instruction *, BlockDataFlowResult<RowT> *)>
+          computeGENAndKILL,
+      std::function<bool(BasicBlock *, BasicBlock *)> isEdgeIgnored);
 };
 
 } // namespace arcana::noelle
@@ -33,12 +33,14 @@ public:
    */
   DataFlowResult();
 
-  std::set<Value *> &GEN(Instruction *inst);
-  std::set<Value *> &KILL(Instruction *inst);
-  std::set<Value *> &IN(Instruction *inst);
-  std::set<Value *> &OUT(Instruction *inst);
+  virtual std::set<Value *> &GEN(Instruction *inst);
+  virtual std::set<Value *> &KILL(Instruction *inst);
+  virtual std::set<Value *> &IN(Instruction *inst);
+  virtual std::set<Value *> &OUT(Instruction *inst);
 
-private:
+  virtual ~DataFlowResult();
+
+protected:
   std::map<Instruction *, std::set<Value *>> gens;
   std::map<Instruction *, std::set<Value *>> kills;
   std::map<Instruction *, std::set<Value *>> ins;
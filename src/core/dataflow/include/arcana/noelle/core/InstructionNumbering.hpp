@@ -0,0 +1,60 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_DATAFLOW_INSTRUCTIONNUMBERING_H_
+#define NOELLE_SRC_CORE_DATAFLOW_INSTRUCTIONNUMBERING_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Dense numbering of the instructions of a function.
+ *
+ * Instructions are numbered from 0 following the layout of the function (basic
+ * blocks in order, instructions in order within each basic block).
+ */
+class InstructionNumbering {
+public:
+  /*
+   * Methods
+   */
+  InstructionNumbering(Function *f);
+
+  Function *getFunction(void) const;
+
+  uint32_t getNumberOfInstructions(void) const;
+
+  bool isNumbered(Instruction *inst) const;
+
+  uint32_t getID(Instruction *inst) const;
+
+  Instruction *getInstruction(uint32_t id) const;
+
+private:
+  Function *f;
+  std::vector<Instruction *> instructions;
+  DenseMap<Instruction *, uint32_t> ids;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_DATAFLOW_INSTRUCTIONNUMBERING_H_
@@ -46,15 +46,64 @@ DataFlowResult *DataFlowAnalysis::runReachableAnalysis(
     Function *f,
     std::function<bool(Instruction *i)> filter) {
 
+  /*
+   * Run the analysis at the basic block granularity.
+   * The result derives the std::set based sets of the instructions on demand.
+   */
+  auto dfr = this->runBlockReachableAnalysis(f, filter);
+
+  return dfr;
+}
+
+DenseBlockDataFlowResult *DataFlowAnalysis::runBlockReachableAnalysis(
+    Function *f,
+    std::function<bool(Instruction *i)> filter) {
+
+  /*
+   * Allocate the engine
+   */
+  auto dfa = DataFlowEngine{};
+
+  /*
+   * Define the data-flow equations:
+   * OUT[i] = U IN[s] for every successor s of i
+   * IN[i] = GEN[i] U OUT[i]
+   */
+  auto computeGENAndKILL = [filter](Instruction *i,
+                                    DenseBlockDataFlowResult *df) {
+    if (!filter(i)) {
+      return;
+    }
+    df->addToGEN(i, i);
+
+    return;
+  };
+
+  /*
+   * Run the data flow analysis.
+   */
+  auto df = dfa.applyBackwardOnBlocks<BitVector>(f,
+                                                 DataFlowMeet::Union,
+                                                 computeGENAndKILL);
+
+  return df;
+}
+
+DenseDataFlowResult *DataFlowAnalysis::runDenseReachableAnalysis(
+    Function *f,
+    std::function<bool(Instruction *i)> filter) {
+
   /*
    * Allocate the engine
    */
   auto dfa = DataFlowEngine{};
 
   /*
-   * Define the data-flow equations
+   * Define the data-flow equations:
+   * OUT[i] = U IN[s] for every successor s of i
+   * IN[i] = GEN[i] U OUT[i]
    */
-  auto computeGEN = [filter](Instruction *i, DataFlowResult *df) {
+  auto computeGENAndKILL = [filter](Instruction *i, DenseDataFlowResult *df) {
     /*
      * Check if the instruction should be considered.
      */
@@ -65,40 +114,29 @@ DataFlowResult *DataFlowAnalysis::runReachableAnalysis(
     /*
      * Add the instruction to the GEN set.
      */
-    auto &gen = df->GEN(i);
-    gen.insert(i);
+    df->addToGEN(i, i);
 
     return;
   };
-  auto computeKILL = [](Instruction *, DataFlowResult *) { return; };
-  auto computeOUT = [](Instruction *inst,
-                       Instruction *succ,
-                       std::set<Value *> &OUT,
-                       DataFlowResult *df) {
-    auto &inS = df->IN(succ);
-    OUT.insert(inS.begin(), inS.end());
-    return;
-  };
-  auto computeIN =
-      [](Instruction *inst, std::set<Value *> &IN, DataFlowResult *df) {
-        auto &genI = df->GEN(inst);
-        auto &outI = df->OUT(inst);
-
-        /*
-         * IN[i] = GEN[i] U OUT[i]
-         */
-        IN.insert(genI.begin(), genI.end());
-        IN.insert(outI.begin(), outI.end());
-
-        return;
-      };
 
   /*
    * Run the data flow analysis needed to identify the instructions that could
    * be executed from a given point.
    */
-  auto df =
-      dfa.applyBackward(f, computeGEN, computeKILL, computeIN, computeOUT);
+  auto df = dfa.applyBackwardOnBitVectors<BitVector>(f,
+                                                     DataFlowMeet::Union,
+                                                     computeGENAndKILL);
+
+  return df;
+}
+
+DenseDataFlowResult *DataFlowAnalysis::getDenseFullSets(Function *f) {
+  auto df = new DenseDataFlowResult(f);
+  auto n = df->getNumberOfInstructions();
+  for (auto &inst : instructions(*f)) {
+    DataFlowRow::initialize(df->INBits(&inst), n, true);
+    DataFlowRow::initialize(df->OUTBits(&inst), n, true);
+  }
 
   return df;
 }
@@ -0,0 +1,444 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "llvm/ADT/PostOrderIterator.h"
+#include "arcana/noelle/core/DataFlowEngine.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Order the basic blocks following the direction of the analysis.
+ * Forward analyses use the reverse post-order of the CFG, backward analyses
+ * use its reverse.
+ * Basic blocks that cannot be reached from the entry are appended at the end
+ * of the reverse post-order.
+ */
+static std::vector<BasicBlock *> getBasicBlocksInFlowOrder(Function *f,
+                                                           bool isForward) {
+  std::vector<BasicBlock *> order;
+  std::unordered_set<BasicBlock *> ordered;
+  ReversePostOrderTraversal<Function *> rpot(f);
+  for (auto bb : rpot) {
+    order.push_back(bb);
+    ordered.insert(bb);
+  }
+  for (auto &bb : *f) {
+    if (ordered.count(&bb) == 0) {
+      order.push_back(&bb);
+    }
+  }
+  if (!isForward) {
+    std::reverse(order.begin(), order.end());
+  }
+
+  return order;
+}
+
+/*
+ * Compute the fixed point at the basic block granularity.
+ *
+ * @blockGEN and @blockKILL summarize the transfer functions of the basic
+ * blocks of @order. The values that enter and exit from the basic blocks
+ * following the direction of the analysis are returned in @blockEntry and
+ * @blockExit.
+ */
+template <typename RowT>
+static void computeFixedPointOfBasicBlocks(
+    const std::vector<BasicBlock *> &order,
+    uint32_t n,
+    DataFlowMeet meet,
+    bool isForward,
+    const std::vector<RowT> &blockGEN,
+    const std::vector<RowT> &blockKILL,
+    std::function<bool(BasicBlock *, BasicBlock *)> isEdgeIgnored,
+    std::vector<RowT> &blockEntry,
+    std::vector<RowT> &blockExit) {
+  auto blocks = static_cast<uint32_t>(order.size());
+  DenseMap<BasicBlock *, uint32_t> positions;
+  for (auto i = 0u; i < blocks; i++) {
+    positions[order[i]] = i;
+  }
+  auto isIgnored = [&isEdgeIgnored](BasicBlock *src, BasicBlock *dst) {
+    return (isEdgeIgnored != nullptr) && isEdgeIgnored(src, dst);
+  };
+  auto getFlowPredecessors = [isForward, &isIgnored](BasicBlock *bb) {
+    std::vector<BasicBlock *> l;
+    if (isForward) {
+      for (auto predBB : predecessors(bb)) {
+        if (!isIgnored(predBB, bb)) {
+          l.push_back(predBB);
+        }
+      }
+    } else {
+      for (auto succBB : successors(bb)) {
+        if (!isIgnored(bb, succBB)) {
+          l.push_back(succBB);
+        }
+      }
+    }
+    return l;
+  };
+  auto getFlowSuccessors = [isForward, &isIgnored](BasicBlock *bb) {
+    std::vector<BasicBlock *> l;
+    if (isForward) {
+      for (auto succBB : successors(bb)) {
+        if (!isIgnored(bb, succBB)) {
+          l.push_back(succBB);
+        }
+      }
+    } else {
+      for (auto predBB : predecessors(bb)) {
+        if (!isIgnored(predBB, bb)) {
+          l.push_back(predBB);
+        }
+      }
+    }
+    return l;
+  };
+
+  /*
+   * Initialize the values at the boundaries of the basic blocks.
+   * Values flowing out of basic blocks start from the top of the lattice (the
+   * empty set for may analyses and the full set for must analyses).
+   */
+  auto isMust = (meet == DataFlowMeet::Intersection);
+  blockEntry.resize(blocks);
+  blockExit.resize(blocks);
+  for (auto i = 0u; i < blocks; i++) {
+    DataFlowRow::initialize(blockEntry[i], n, false);
+    DataFlowRow::initialize(blockExit[i], n, isMust);
+  }
+
+  /*
+   * Compute the fixed point.
+   * The working list always returns the pending basic block that comes first
+   * in the order computed above.
+   */
+  BitVector workingList(blocks, true);
+  for (auto pos = workingList.find_first(); pos != -1;
+       pos = workingList.find_first()) {
+    workingList.reset(pos);
+    auto bb = order[pos];
+
+    /*
+     * Compute the value that enters the basic block by applying the meet
+     * operator to the values that exit from its predecessors.
+     */
+    auto &entry = blockEntry[pos];
+    auto flowPredecessors = getFlowPredecessors(bb);
+    if (!flowPredecessors.empty()) {
+      DataFlowRow::initialize(entry, n, isMust);
+      for (auto predBB : flowPredecessors) {
+        auto &predExit = blockExit[positions[predBB]];
+        if (isMust) {
+          DataFlowRow::intersectWith(entry, predExit);
+        } else {
+          DataFlowRow::unionWith(entry, predExit);
+        }
+      }
+    }
+
+    /*
+     * Apply the transfer function of the basic block.
+     */
+    RowT newExit = entry;
+    DataFlowRow::subtract(newExit, blockKILL[pos]);
+    DataFlowRow::unionWith(newExit, blockGEN[pos]);
+
+    /*
+     * Propagate changes.
+     */
+    if (newExit == blockExit[pos]) {
+      continue;
+    }
+    blockExit[pos] = std::move(newExit);
+    for (auto succBB : getFlowSuccessors(bb)) {
+      workingList.set(positions[succBB]);
+    }
+  }
+
+  return;
+}
+
+template <typename RowT>
+BitVectorDataFlowResult<RowT> *DataFlowEngine::applyForwardOnBitVectors(
+    Function *f,
+    DataFlowMeet meet,
+    std::function<void(Instruction *, BitVectorDataFlowResult<RowT> *)>
+        computeGENAndKILL) {
+  return this->applyGeneralizedBitVectorAnalysis<RowT>(f,
+                                                       meet,
+                                                       true,
+                                                       computeGENAndKILL);
+}
+
+template <typename RowT>
+BitVectorDataFlowResult<RowT> *DataFlowEngine::applyBackwardOnBitVectors(
+    Function *f,
+    DataFlowMeet meet,
+    std::function<void(Instruction *, BitVectorDataFlowResult<RowT> *)>
+        computeGENAndKILL) {
+  return this->applyGeneralizedBitVectorAnalysis<RowT>(f,
+                                                       meet,
+                                                       false,
+                                                       computeGENAndKILL);
+}
+
+template <typename RowT>
+BitVectorDataFlowResult<RowT> *DataFlowEngine::
+    applyGeneralizedBitVectorAnalysis(
+        Function *f,
+        DataFlowMeet meet,
+        bool isForward,
+        std::function<void(Instruction *, BitVectorDataFlowResult<RowT> *)>
+            computeGENAndKILL) {
+  assert(f != nullptr);
+
+  /*
+   * Allocate the result and compute the GENs and KILLs.
+   */
+  auto df = new BitVectorDataFlowResult<RowT>(f);
+  auto n = df->getNumberOfInstructions();
+  for (auto &inst : instructions(*f)) {
+    computeGENAndKILL(&inst, df);
+  }
+
+  /*
+   * Order the basic blocks following the direction of the analysis.
+   */
+  auto order = getBasicBlocksInFlowOrder(f, isForward);
+  auto getFlowInstructions = [isForward](BasicBlock *bb) {
+    std::vector<Instruction *> l;
+    for (auto &inst : *bb) {
+      l.push_back(&inst);
+    }
+    if (!isForward) {
+      std::reverse(l.begin(), l.end());
+    }
+    return l;
+  };
+
+  /*
+   * Summarize the GEN and KILL of each basic block by composing the transfer
+   * functions of its instructions following the direction of the analysis.
+   */
+  auto blocks = static_cast<uint32_t>(order.size());
+  std::vector<RowT> blockGEN(blocks);
+  std::vector<RowT> blockKILL(blocks);
+  for (auto i = 0u; i < blocks; i++) {
+    auto &G = blockGEN[i];
+    auto &K = blockKILL[i];
+    DataFlowRow::initialize(G, n, false);
+    DataFlowRow::initialize(K, n, false);
+    for (auto inst : getFlowInstructions(order[i])) {
+      DataFlowRow::subtract(G, df->KILLBits(inst));
+      DataFlowRow::unionWith(G, df->GENBits(inst));
+      DataFlowRow::unionWith(K, df->KILLBits(inst));
+    }
+  }
+
+  /*
+   * Compute the fixed point.
+   */
+  std::vector<RowT> blockEntry;
+  std::vector<RowT> blockExit;
+  computeFixedPointOfBasicBlocks<RowT>(order,
+                                       n,
+                                       meet,
+                                       isForward,
+                                       blockGEN,
+                                       blockKILL,
+                                       nullptr,
+                                       blockEntry,
+                                       blockExit);
+
+  /*
+   * Derive the IN and OUT rows of the instructions.
+   */
+  for (auto i = 0u; i < blocks; i++) {
+    RowT current = blockEntry[i];
+    for (auto inst : getFlowInstructions(order[i])) {
+      auto &before = isForward ? df->INBits(inst) : df->OUTBits(inst);
+      auto &after = isForward ? df->OUTBits(inst) : df->INBits(inst);
+      before = current;
+      DataFlowRow::subtract(current, df->KILLBits(inst));
+      DataFlowRow::unionWith(current, df->GENBits(inst));
+      after = current;
+    }
+  }
+
+  return df;
+}
+
+template <typename RowT>
+BlockDataFlowResult<RowT> *DataFlowEngine::applyForwardOnBlocks(
+    Function *f,
+    DataFlowMeet meet,
+    std::function<void(Instruction *, BlockDataFlowResult<RowT> *)>
+        computeGENAndKILL,
+    std::function<bool(BasicBlock *, BasicBlock *)> isEdgeIgnored) {
+  return this->applyGeneralizedBlockAnalysis<RowT>(f,
+                                                   meet,
+                                                   true,
+                                                   computeGENAndKILL,
+                                                   isEdgeIgnored);
+}
+
+template <typename RowT>
+BlockDataFlowResult<RowT> *DataFlowEngine::applyBackwardOnBlocks(
+    Function *f,
+    DataFlowMeet meet,
+    std::function<void(Instruction *, BlockDataFlowResult<RowT> *)>
+        computeGENAndKILL,
+    std::function<bool(BasicBlock *, BasicBlock *)> isEdgeIgnored) {
+  return this->applyGeneralizedBlockAnalysis<RowT>(f,
+                                                   meet,
+                                                   false,
+                                                   computeGENAndKILL,
+                                                   isEdgeIgnored);
+}
+
+template <typename RowT>
+BlockDataFlowResult<RowT> *DataFlowEngine::applyGeneralizedBlockAnalysis(
+    Function *f,
+    DataFlowMeet meet,
+    bool isForward,
+    std::function<void(Instruction *, BlockDataFlowResult<RowT> *)>
+        computeGENAndKILL,
+    std::function<bool(BasicBlock *, BasicBlock *)> isEdgeIgnored) {
+  assert(f != nullptr);
+
+  /*
+   * Allocate the result and compute the GENs and KILLs.
+   */
+  auto df = new BlockDataFlowResult<RowT>(f, isForward);
+  auto n = df->getNumberOfInstructions();
+  for (auto &inst : instructions(*f)) {
+    computeGENAndKILL(&inst, df);
+  }
+
+  /*
+   * Summarize the GEN and KILL of each basic block by composing the transfer
+   * functions of its instructions following the direction of the analysis.
+   */
+  auto order = getBasicBlocksInFlowOrder(f, isForward);
+  auto blocks = static_cast<uint32_t>(order.size());
+  std::vector<RowT> blockGEN(blocks);
+  std::vector<RowT> blockKILL(blocks);
+  for (auto i = 0u; i < blocks; i++) {
+    auto &G = blockGEN[i];
+    auto &K = blockKILL[i];
+    DataFlowRow::initialize(G, n, false);
+    DataFlowRow::initialize(K, n, false);
+    auto summarize = [df, n, &G, &K](Instruction *inst) {
+      for (auto id : df->KILLIDs(inst)) {
+        DataFlowRow::reset(G, id);
+        DataFlowRow::set(K, n, id);
+      }
+      for (auto id : df->GENIDs(inst)) {
+        DataFlowRow::set(G, n, id);
+      }
+    };
+    if (isForward) {
+      for (auto &inst : *order[i]) {
+        summarize(&inst);
+      }
+    } else {
+      for (auto &inst : reverse(*order[i])) {
+        summarize(&inst);
+      }
+    }
+  }
+
+  /*
+   * Compute the fixed point and keep only the values that enter the basic
+   * blocks.
+   */
+  std::vector<RowT> blockEntry;
+  std::vector<RowT> blockExit;
+  computeFixedPointOfBasicBlocks<RowT>(order,
+                                       n,
+                                       meet,
+                                       isForward,
+                                       blockGEN,
+                                       blockKILL,
+                                       isEdgeIgnored,
+                                       blockEntry,
+                                       blockExit);
+  for (auto i = 0u; i < blocks; i++) {
+    df->EntryBits(order[i]) = std::move(blockEntry[i]);
+  }
+
+  return df;
+}
+
+template BitVectorDataFlowResult<BitVector> *DataFlowEngine::
+    applyForwardOnBitVectors<BitVector>(
+        Function *,
+        DataFlowMeet,
+        std::function<void(Instruction *,
+                           BitVectorDataFlowResult<BitVector> *)>);
+template BitVectorDataFlowResult<BitVector> *DataFlowEngine::
+    applyBackwardOnBitVectors<BitVector>(
+        Function *,
+        DataFlowMeet,
+        std::function<void(Instruction *,
+                           BitVectorDataFlowResult<BitVector> *)>);
+template BitVectorDataFlowResult<SparseBitVector<>> *DataFlowEngine::
+    applyForwardOnBitVectors<SparseBitVector<>>(
+        Function *,
+        DataFlowMeet,
+        std::function<void(Instruction *,
+                           BitVectorDataFlowResult<SparseBitVector<>> *)>);
+template BitVectorDataFlowResult<SparseBitVector<>> *DataFlowEngine::
+    applyBackwardOnBitVectors<SparseBitVector<>>(
+        Function *,
+        DataFlowMeet,
+        std::function<void(Instruction *,
+                           BitVectorDataFlowResult<SparseBitVector<>> *)>);
+template BlockDataFlowResult<BitVector> *DataFlowEngine::applyForwardOnBlocks<
+    BitVector>(Function *,
+               DataFlowMeet,
+               std::function<void(Instruction *,
+                                  BlockDataFlowResult<BitVector> *)>,
+               std::function<bool(BasicBlock *, BasicBlock *)>);
+template BlockDataFlowResult<BitVector> *DataFlowEngine::applyBackwardOnBlocks<
+    BitVector>(Function *,
+               DataFlowMeet,
+               std::function<void(Instruction *,
+                                  BlockDataFlowResult<BitVector> *)>,
+               std::function<bool(BasicBlock *, BasicBlock *)>);
+template BlockDataFlowResult<SparseBitVector<>> *DataFlowEngine::
+    applyForwardOnBlocks<SparseBitVector<>>(
+        Function *,
+        DataFlowMeet,
+        std::function<void(Instruction *,
+                           BlockDataFlowResult<SparseBitVector<>> *)>,
+        std::function<bool(BasicBlock *, BasicBlock *)>);
+template BlockDataFlowResult<SparseBitVector<>> *DataFlowEngine::
+    applyBackwardOnBlocks<SparseBitVector<>>(
+        Function *,
+        DataFlowMeet,
+        std::function<void(Instruction *,
+                           BlockDataFlowResult<SparseBitVector<>> *)>,
+        std::function<bool(BasicBlock *, BasicBlock *)>);
+
+} // namespace arcana::noelle
@@ -51,4 +51,8 @@ std::set<Value *> &DataFlowResult::OUT(Instruction *inst) {
   return s;
 }
 
+DataFlowResult::~DataFlowResult() {
+  return;
+}
+
 } // namespace arcana::noelle
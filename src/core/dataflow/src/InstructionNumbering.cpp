@@ -0,0 +1,66 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/InstructionNumbering.hpp"
+
+namespace arcana::noelle {
+
+InstructionNumbering::InstructionNumbering(Function *f) : f{ f } {
+  assert(f != nullptr);
+
+  /*
+   * Assign an ID to every instruction following the layout of the function.
+   */
+  for (auto &inst : llvm::instructions(*f)) {
+    auto id = static_cast<uint32_t>(this->instructions.size());
+    this->instructions.push_back(&inst);
+    this->ids[&inst] = id;
+  }
+
+  return;
+}
+
+Function *InstructionNumbering::getFunction(void) const {
+  return this->f;
+}
+
+uint32_t InstructionNumbering::getNumberOfInstructions(void) const {
+  return static_cast<uint32_t>(this->instructions.size());
+}
+
+bool InstructionNumbering::isNumbered(Instruction *inst) const {
+  return this->ids.find(inst) != this->ids.end();
+}
+
+uint32_t InstructionNumbering::getID(Instruction *inst) const {
+  auto it = this->ids.find(inst);
+  assert(it != this->ids.end());
+
+  return it->second;
+}
+
+Instruction *InstructionNumbering::getInstruction(uint32_t id) const {
+  assert(id < this->instructions.size());
+
+  return this->instructions[id];
+}
+
+} // namespace arcana::noelle
@@ -34,17 +34,42 @@
 
 namespace arcana::noelle {
 
+/*
+ * A dependence graph owns its nodes and edges.
+ * They are bump-allocated from a per-graph arena and destroyed in bulk when
+ * the graph is cleared or destroyed.
+ * The graph keeps them in vectors: the position of a node within the nodes of
+ * the graph is its dense ID, and values are mapped to IDs. Removing a node or
+ * an edge moves the last one into its position, so the vectors stay dense and
+ * iteration follows the order of insertion until something is removed.
+ * Every edge takes a slot of the same size, whatever its kind. Hence, the
+ * slots of removed nodes and edges are recycled by later allocations, and the
+ * memory of a graph that keeps being mutated stays bounded by its peak size.
+ *
+ * A graph can instead be a view of another one (see addSharedNode and
+ * addSharedEdge): it then references the nodes and edges of the other graph,
+ * which must outlive the view, and it never creates or destroys any of them.
+ * The adjacency of a shared node is the one it has in the other graph, so it
+ * can include edges that are not part of the view: the methods of this class
+ * skip them, while code that walks the edges of a node itself must check them
+ * with isInGraph. Nodes and edges cannot be removed from a view, and changing
+ * the attributes of an edge of a view changes the other graph.
+ */
 template <class T>
 class DG {
 public:
   DG();
+  DG(const DG<T> &other) = delete;
+  ~DG();
 
-  using nodes_iterator = typename std::set<DGNode<T> *>::iterator;
-  using nodes_const_iterator = typename std::set<DGNode<T> *>::const_iterator;
-  using edges_iterator = typename std::set<DGEdge<T, T> *>::iterator;
+  using nodes_iterator = typename std::vector<DGNode<T> *>::iterator;
+  using nodes_const_iterator =
+      typename std::vector<DGNode<T> *>::const_iterator;
+  using edges_iterator = typename std::vector<DGEdge<T, T> *>::iterator;
   using edges_const_iterator =
-      typename std::set<DGEdge<T, T> *>::const_iterator;
-  using node_map_iterator = typename std::map<T *, DGNode<T> *>::iterator;
+      typename std::vector<DGEdge<T, T> *>::const_iterator;
+  using node_map_iterator =
+      typename std::vector<std::pair<T *, DGNode<T> *>>::iterator;
   typedef std::map<DGEdge<T, T> *, uint32_t> DepIdReverseMap_t;
 
   /*
@@ -71,22 +96,22 @@ public:
   }
 
   node_map_iterator begin_internal_node_map() {
-    auto n = internalNodeMap.begin();
+    auto n = internalNodes.begin();
     return n;
   }
 
   node_map_iterator end_internal_node_map() {
-    auto n = internalNodeMap.end();
+    auto n = internalNodes.end();
     return n;
   }
 
   node_map_iterator begin_external_node_map() {
-    auto n = externalNodeMap.begin();
+    auto n = externalNodes.begin();
     return n;
   }
 
   node_map_iterator end_external_node_map() {
-    auto n = externalNodeMap.end();
+    auto n = externalNodes.end();
     return n;
   }
 
@@ -121,11 +146,31 @@ public:
   bool isExternal(T *theT) const;
   bool isInGraph(T *theT) const;
 
+  /*
+   * Return the dense ID of the node of @theT within this graph (i.e., its
+   * position within getNodes()), or std::nullopt if @theT is not in the
+   * graph.
+   * IDs change when nodes are removed.
+   */
+  std::optional<uint32_t> getNodeID(T *theT) const;
+
+  /*
+   * Check if @edge, which is connected to a node of this graph, is one of its
+   * edges. This is always the case unless the graph is a view.
+   */
+  bool isInGraph(DGEdge<T, T> *edge) const;
+
   uint64_t numNodes(void) const;
   uint64_t numInternalNodes(void) const;
   uint64_t numExternalNodes(void) const;
   uint64_t numEdges(void) const;
 
+  /*
+   * Return a number that changes every time a node or an edge is added to or
+   * removed from this graph.
+   */
+  uint64_t getVersion(void) const;
+
   /*
    * Iterator ranges
    */
@@ -137,10 +182,10 @@ public:
   }
 
   iterator_range<node_map_iterator> internalNodePairs(void) {
-    return make_range(internalNodeMap.begin(), internalNodeMap.end());
+    return make_range(internalNodes.begin(), internalNodes.end());
   }
   iterator_range<node_map_iterator> externalNodePairs(void) {
-    return make_range(externalNodeMap.begin(), externalNodeMap.end());
+    return make_range(externalNodes.begin(), externalNodes.end());
   }
 
   /*
@@ -163,6 +208,14 @@ public:
   std::unordered_set<DGEdge<T, T> *> fetchEdges(DGNode<T> *From, DGNode<T> *To);
   DGEdge<T, T> *copyAddEdge(DGEdge<T, T> &edgeToCopy);
 
+  /*
+   * Allocate an edge that is owned by this graph without being one of its
+   * edges (e.g., a sub-edge of one of them).
+   * It is destroyed when the graph is cleared or destroyed.
+   */
+  template <class Edge, class... Args>
+  Edge *addDetachedEdge(Args &&...args);
+
   /*
    * Deal with the id for each edge and the corresponding map for debugging
    */
@@ -195,37 +248,233 @@ public:
   raw_ostream &print(raw_ostream &stream);
 
   static std::vector<DGEdge<T, T> *> sortDependences(
-      const std::set<DGEdge<T, T> *> &set);
+      const std::vector<DGEdge<T, T> *> &edges);
 
 protected:
-  int32_t nodeIdCounter;
-  std::set<DGNode<T> *> allNodes;
-  std::set<DGEdge<T, T> *> allEdges;
+  /*
+   * Nodes indexed by their ID, and edges.
+   * The position of an edge within allEdges is stored in the edge (see
+   * DGEdge::graphSlot) by the graph that owns it.
+   */
+  std::vector<DGNode<T> *> allNodes;
+  std::vector<DGEdge<T, T> *> allEdges;
   DGNode<T> *entryNode;
-  std::map<T *, DGNode<T> *> internalNodeMap;
-  std::map<T *, DGNode<T> *> externalNodeMap;
+  bool ownsNodesAndEdges;
+  uint64_t version;
+
+  /*
+   * Internal and external nodes, as returned by internalNodePairs() and
+   * externalNodePairs().
+   * For each node ID, nodeKinds stores whether the node is internal and its
+   * position within internalNodes or externalNodes.
+   */
+  std::vector<std::pair<T *, DGNode<T> *>> internalNodes;
+  std::vector<std::pair<T *, DGNode<T> *>> externalNodes;
+  std::vector<uint32_t> nodeKinds;
+  DenseMap<T *, uint32_t> nodeIDs;
+
+  /*
+   * Edges of the other graph that are part of this view, if this graph is a
+   * view.
+   */
+  DenseSet<DGEdge<T, T> *> sharedEdges;
+
   std::shared_ptr<DepIdReverseMap_t> depLookupMap;
+
+  /*
+   * Add to this graph a node or an edge that belongs to another graph.
+   * After the first call, this graph is a view of the other one.
+   */
+  void addSharedNode(DGNode<T> *node, bool inclusion);
+  void addSharedEdge(DGEdge<T, T> *edge);
+
+private:
+  static constexpr size_t edgeSlotSize =
+      std::max({ sizeof(VariableDependence<T, T>),
+                 sizeof(MayMemoryDependence<T, T>),
+                 sizeof(MustMemoryDependence<T, T>),
+                 sizeof(ControlDependence<T, T>),
+                 sizeof(UndefinedDependence<T, T>) });
+  static constexpr size_t edgeSlotAlignment =
+      std::max({ alignof(VariableDependence<T, T>),
+                 alignof(MayMemoryDependence<T, T>),
+                 alignof(MustMemoryDependence<T, T>),
+                 alignof(ControlDependence<T, T>),
+                 alignof(UndefinedDependence<T, T>) });
+
+  BumpPtrAllocatorImpl<MallocAllocator, 1024> arena;
+  std::vector<void *> freeNodeSlots;
+  std::vector<void *> freeEdgeSlots;
+  std::vector<DGEdge<T, T> *> detachedEdges;
+
+  template <class Element, class... Args>
+  Element *allocate(Args &&...args);
+  void release(DGNode<T> *node);
+  void release(DGEdge<T, T> *edge);
+  void linkEdge(DGEdge<T, T> *edge);
+  void unlinkEdgeFromGraph(DGEdge<T, T> *edge);
+  void insertNode(DGNode<T> *node, bool inclusion);
+  void eraseNode(T *theT);
+
+  static uint32_t encodeNodeKind(uint32_t position, bool inclusion) {
+    return (position << 1) | (inclusion ? 1 : 0);
+  }
 };
 
 /*
  * DG<T> class method implementations
  */
 template <class T>
-DG<T>::DG() : nodeIdCounter{ 0 },
+DG<T>::DG() : entryNode{ nullptr },
+              ownsNodesAndEdges{ true },
+              version{ 0 },
               depLookupMap{ nullptr } {
 
   return;
 }
 
+template <class T>
+DG<T>::~DG() {
+  this->clear();
+
+  return;
+}
+
+template <class T>
+template <class Element, class... Args>
+Element *DG<T>::allocate(Args &&...args) {
+  assert(this->ownsNodesAndEdges && "A view cannot create nodes or edges");
+
+  /*
+   * Reuse the slot of a node or an edge that has been removed, if any.
+   */
+  constexpr auto isNode = std::is_same_v<Element, DGNode<T>>;
+  static_assert(isNode || std::is_base_of_v<DGEdge<T, T>, Element>);
+  static_assert(isNode || (sizeof(Element) <= edgeSlotSize));
+  auto &freeSlots = isNode ? this->freeNodeSlots : this->freeEdgeSlots;
+  void *memory = nullptr;
+  if (!freeSlots.empty()) {
+    memory = freeSlots.back();
+    freeSlots.pop_back();
+  } else if (isNode) {
+    memory = this->arena.template Allocate<DGNode<T>>();
+  } else {
+    memory = this->arena.Allocate(edgeSlotSize, Align(edgeSlotAlignment));
+  }
+
+  return new (memory) Element(std::forward<Args>(args)...);
+}
+
+template <class T>
+void DG<T>::release(DGNode<T> *node) {
+  std::destroy_at(node);
+  this->freeNodeSlots.push_back(node);
+
+  return;
+}
+
+template <class T>
+void DG<T>::release(DGEdge<T, T> *edge) {
+  std::destroy_at(edge);
+  this->freeEdgeSlots.push_back(edge);
+
+  return;
+}
+
+template <class T>
+void DG<T>::linkEdge(DGEdge<T, T> *edge) {
+  edge->graphSlot = allEdges.size();
+  allEdges.push_back(edge);
+  this->version++;
+  edge->getSrcNode()->addOutgoingEdge(edge);
+  edge->getDstNode()->addIncomingEdge(edge);
+
+  return;
+}
+
+template <class T>
+void DG<T>::insertNode(DGNode<T> *node, bool inclusion) {
+  auto theT = node->getT();
+  auto &kindNodes = inclusion ? internalNodes : externalNodes;
+  nodeIDs[theT] = allNodes.size();
+  nodeKinds.push_back(encodeNodeKind(kindNodes.size(), inclusion));
+  kindNodes.push_back(std::make_pair(theT, node));
+  allNodes.push_back(node);
+  this->version++;
+
+  return;
+}
+
+template <class T>
+void DG<T>::eraseNode(T *theT) {
+  auto nodeI = nodeIDs.find(theT);
+  assert(nodeI != nodeIDs.end());
+  auto id = nodeI->second;
+  nodeIDs.erase(nodeI);
+  this->version++;
+
+  /*
+   * Move the last node of the same kind into the position of the node.
+   */
+  auto kind = nodeKinds[id];
+  auto inclusion = (kind & 1) != 0;
+  auto position = kind >> 1;
+  auto &kindNodes = inclusion ? internalNodes : externalNodes;
+  auto lastOfKind = kindNodes.back();
+  kindNodes[position] = lastOfKind;
+  kindNodes.pop_back();
+  if (lastOfKind.first != theT) {
+    nodeKinds[nodeIDs[lastOfKind.first]] = encodeNodeKind(position, inclusion);
+  }
+
+  /*
+   * Move the last node into the ID of the node.
+   */
+  auto lastNode = allNodes.back();
+  allNodes[id] = lastNode;
+  nodeKinds[id] = nodeKinds.back();
+  allNodes.pop_back();
+  nodeKinds.pop_back();
+  if (lastNode->getT() != theT) {
+    nodeIDs[lastNode->getT()] = id;
+    if (this->ownsNodesAndEdges) {
+      lastNode->ID = id;
+    }
+  }
+
+  return;
+}
+
 template <class T>
 DGNode<T> *DG<T>::addNode(T *theT, bool inclusion) {
-  auto node = new DGNode<T>(nodeIdCounter++, theT);
-  allNodes.insert(node);
-  auto &map = inclusion ? internalNodeMap : externalNodeMap;
-  map[theT] = node;
+  auto node = this->allocate<DGNode<T>>(allNodes.size(), theT);
+  this->insertNode(node, inclusion);
   return node;
 }
 
+template <class T>
+void DG<T>::addSharedNode(DGNode<T> *node, bool inclusion) {
+  assert((this->ownsNodesAndEdges == false) || this->allNodes.empty());
+  this->ownsNodesAndEdges = false;
+  if (this->isInGraph(node->getT())) {
+    return;
+  }
+  this->insertNode(node, inclusion);
+
+  return;
+}
+
+template <class T>
+void DG<T>::addSharedEdge(DGEdge<T, T> *edge) {
+  assert(this->ownsNodesAndEdges == false);
+  if (sharedEdges.insert(edge).second) {
+    allEdges.push_back(edge);
+    this->version++;
+  }
+
+  return;
+}
+
 template <class T>
 DGNode<T> *DG<T>::getEntryNode() const {
   return entryNode;
@@ -239,17 +488,36 @@ void DG<T>::setEntryNode(DGNode<T> *node) {
 
 template <class T>
 bool DG<T>::isInternal(T *theT) const {
-  return internalNodeMap.find(theT) != internalNodeMap.end();
+  auto nodeI = nodeIDs.find(theT);
+  return (nodeI != nodeIDs.end()) && ((nodeKinds[nodeI->second] & 1) != 0);
 }
 
 template <class T>
 bool DG<T>::isExternal(T *theT) const {
-  return externalNodeMap.find(theT) != externalNodeMap.end();
+  auto nodeI = nodeIDs.find(theT);
+  return (nodeI != nodeIDs.end()) && ((nodeKinds[nodeI->second] & 1) == 0);
 }
 
 template <class T>
 bool DG<T>::isInGraph(T *theT) const {
-  return isInternal(theT) || isExternal(theT);
+  return nodeIDs.find(theT) != nodeIDs.end();
+}
+
+template <class T>
+std::optional<uint32_t> DG<T>::getNodeID(T *theT) const {
+  auto nodeI = nodeIDs.find(theT);
+  if (nodeI == nodeIDs.end()) {
+    return std::nullopt;
+  }
+  return nodeI->second;
+}
+
+template <class T>
+bool DG<T>::isInGraph(DGEdge<T, T> *edge) const {
+  if (this->ownsNodesAndEdges) {
+    return true;
+  }
+  return sharedEdges.find(edge) != sharedEdges.end();
 }
 
 template <class T>
@@ -261,16 +529,14 @@ DGNode<T> *DG<T>::fetchOrAddNode(T *theT, bool inclusion) {
 
 template <class T>
 DGNode<T> *DG<T>::fetchNode(T *theT) {
-  auto nodeI = internalNodeMap.find(theT);
-  return (nodeI != internalNodeMap.end()) ? nodeI->second
-                                          : externalNodeMap[theT];
+  auto nodeI = nodeIDs.find(theT);
+  return (nodeI != nodeIDs.end()) ? allNodes[nodeI->second] : nullptr;
 }
 
 template <class T>
 const DGNode<T> *DG<T>::fetchConstNode(T *theT) const {
-  auto nodeI = internalNodeMap.find(theT);
-  return (nodeI != internalNodeMap.end()) ? nodeI->second
-                                          : externalNodeMap.find(theT)->second;
+  auto nodeI = nodeIDs.find(theT);
+  return (nodeI != nodeIDs.end()) ? allNodes[nodeI->second] : nullptr;
 }
 
 template <class T>
@@ -279,10 +545,8 @@ DGEdge<T, T> *DG<T>::addVariableDataDependenceEdge(T *from,
                                                    DataDependenceType t) {
   auto fromNode = this->fetchNode(from);
   auto toNode = this->fetchNode(to);
-  auto edge = new VariableDependence<T, T>(fromNode, toNode, t);
-  allEdges.insert(edge);
-  fromNode->addOutgoingEdge(edge);
-  toNode->addIncomingEdge(edge);
+  auto edge = this->allocate<VariableDependence<T, T>>(fromNode, toNode, t);
+  this->linkEdge(edge);
   return edge;
 }
 
@@ -295,15 +559,13 @@ DGEdge<T, T> *DG<T>::addMemoryDataDependenceEdge(T *from,
   auto toNode = this->fetchNode(to);
   DGEdge<T, T> *edge = nullptr;
   if (isMust) {
-    edge = new MustMemoryDependence<T, T>(fromNode, toNode, t);
+    edge = this->allocate<MustMemoryDependence<T, T>>(fromNode, toNode, t);
   } else {
-    edge = new MayMemoryDependence<T, T>(fromNode, toNode, t);
+    edge = this->allocate<MayMemoryDependence<T, T>>(fromNode, toNode, t);
   }
   assert(edge != nullptr);
 
-  allEdges.insert(edge);
-  fromNode->addOutgoingEdge(edge);
-  toNode->addIncomingEdge(edge);
+  this->linkEdge(edge);
   return edge;
 }
 
@@ -311,10 +573,8 @@ template <class T>
 DGEdge<T, T> *DG<T>::addControlDependenceEdge(T *from, T *to) {
   auto fromNode = this->fetchNode(from);
   auto toNode = this->fetchNode(to);
-  auto edge = new ControlDependence<T, T>(fromNode, toNode);
-  allEdges.insert(edge);
-  fromNode->addOutgoingEdge(edge);
-  toNode->addIncomingEdge(edge);
+  auto edge = this->allocate<ControlDependence<T, T>>(fromNode, toNode);
+  this->linkEdge(edge);
   return edge;
 }
 
@@ -322,10 +582,17 @@ template <class T>
 DGEdge<T, T> *DG<T>::addUndefinedDependenceEdge(T *from, T *to) {
   auto fromNode = this->fetchNode(from);
   auto toNode = this->fetchNode(to);
-  auto edge = new UndefinedDependence<T, T>(fromNode, toNode);
-  allEdges.insert(edge);
-  fromNode->addOutgoingEdge(edge);
-  toNode->addIncomingEdge(edge);
+  auto edge = this->allocate<UndefinedDependence<T, T>>(fromNode, toNode);
+  this->linkEdge(edge);
+  return edge;
+}
+
+template <class T>
+template <class Edge, class... Args>
+Edge *DG<T>::addDetachedEdge(Args &&...args) {
+  auto edge = this->allocate<Edge>(std::forward<Args>(args)...);
+  this->detachedEdges.push_back(edge);
+
   return edge;
 }
 
@@ -335,6 +602,9 @@ std::unordered_set<DGEdge<T, T> *> DG<T>::fetchEdges(DGNode<T> *From,
   std::unordered_set<DGEdge<T, T> *> edgeSet;
 
   for (auto &edge : From->getOutgoingEdges()) {
+    if (!this->isInGraph(edge)) {
+      continue;
+    }
     if (edge->getDstNode() == To) {
       edgeSet.insert(edge);
     }
@@ -348,20 +618,19 @@ DGEdge<T, T> *DG<T>::copyAddEdge(DGEdge<T, T> &edgeToCopy) {
   DGEdge<T, T> *edge = nullptr;
   if (isa<ControlDependence<T, T>>(&edgeToCopy)) {
     auto edgeToCopyAsCD = cast<ControlDependence<T, T>>(&edgeToCopy);
-    edge = new ControlDependence<T, T>(*edgeToCopyAsCD);
+    edge = this->allocate<ControlDependence<T, T>>(*edgeToCopyAsCD);
   } else {
     if (isa<VariableDependence<T, T>>(&edgeToCopy)) {
       auto edgeToCopyAsVD = cast<VariableDependence<T, T>>(&edgeToCopy);
-      edge = new VariableDependence<T, T>(*edgeToCopyAsVD);
+      edge = this->allocate<VariableDependence<T, T>>(*edgeToCopyAsVD);
     } else if (isa<MayMemoryDependence<T, T>>(&edgeToCopy)) {
       auto edgeToCopyAsMD = cast<MayMemoryDependence<T, T>>(&edgeToCopy);
-      edge = new MayMemoryDependence<T, T>(*edgeToCopyAsMD);
+      edge = this->allocate<MayMemoryDependence<T, T>>(*edgeToCopyAsMD);
     } else {
       auto edgeToCopyAsMD = cast<MustMemoryDependence<T, T>>(&edgeToCopy);
-      edge = new MustMemoryDependence<T, T>(*edgeToCopyAsMD);
+      edge = this->allocate<MustMemoryDependence<T, T>>(*edgeToCopyAsMD);
     }
   }
-  allEdges.insert(edge);
 
   /*
    * Point copy of edge to equivalent nodes in this graph
@@ -371,8 +640,7 @@ DGEdge<T, T> *DG<T>::copyAddEdge(DGEdge<T, T> &edgeToCopy) {
   edge->setSrcNode(fromNode);
   edge->setDstNode(toNode);
 
-  fromNode->addOutgoingEdge(edge);
-  toNode->addIncomingEdge(edge);
+  this->linkEdge(edge);
   return edge;
 }
 
@@ -390,6 +658,8 @@ std::unordered_set<DGNode<T> *> DG<T>::getTopLevelNodes(bool onlyInternal) {
 
     bool noOtherIncoming = true;
     for (auto incomingE : node->getIncomingEdges()) {
+      if (!this->isInGraph(incomingE))
+        continue;
       bool edgeToSelf = (incomingE->getSrcNode() == node);
       bool edgeToExternal = onlyInternal && isExternal(incomingE->getSrc());
       noOtherIncoming &= edgeToSelf || edgeToExternal;
@@ -408,6 +678,8 @@ std::unordered_set<DGNode<T> *> DG<T>::getLeafNodes(bool onlyInternal) {
     for (auto selfNodePair : internalNodePairs()) {
       bool noChildNode = true;
       for (auto edge : selfNodePair.second->getOutgoingEdges()) {
+        if (!this->isInGraph(edge))
+          continue;
         noChildNode &= (edge->getDstNode() == selfNodePair.second);
       }
       if (noChildNode)
@@ -417,6 +689,8 @@ std::unordered_set<DGNode<T> *> DG<T>::getLeafNodes(bool onlyInternal) {
     for (auto selfNode : allNodes) {
       bool noChildNode = true;
       for (auto edge : selfNode->getOutgoingEdges()) {
+        if (!this->isInGraph(edge))
+          continue;
         noChildNode &= (edge->getDstNode() == selfNode);
       }
       if (noChildNode)
@@ -457,9 +731,11 @@ std::vector<std::unordered_set<DGNode<T> *> *> DG<T>::getDisconnectedSubgraphs(
       };
 
       for (auto edge : currentNode->getOutgoingEdges())
-        checkToVisitNode(edge->getDstNode());
+        if (this->isInGraph(edge))
+          checkToVisitNode(edge->getDstNode());
       for (auto edge : currentNode->getIncomingEdges())
-        checkToVisitNode(edge->getSrcNode());
+        if (this->isInGraph(edge))
+          checkToVisitNode(edge->getSrcNode());
     }
 
     connectedComponents.push_back(component);
@@ -472,7 +748,8 @@ template <class T>
 std::unordered_set<DGNode<T> *> DG<T>::getNextDepthNodes(DGNode<T> *node) {
   std::unordered_set<DGNode<T> *> incomingNodes;
   for (auto edge : node->getOutgoingEdges())
-    incomingNodes.insert(edge->getDstNode());
+    if (this->isInGraph(edge))
+      incomingNodes.insert(edge->getDstNode());
 
   std::unordered_set<DGNode<T> *> nextDepthNodes;
   for (auto incoming : incomingNodes) {
@@ -482,6 +759,8 @@ std::unordered_set<DGNode<T> *> DG<T>::getNextDepthNodes(DGNode<T> *node) {
      */
     bool isNextDepth = true;
     for (auto incomingE : incoming->getIncomingEdges()) {
+      if (!this->isInGraph(incomingE))
+        continue;
       isNextDepth &=
           (incomingNodes.find(incomingE->getSrcNode()) == incomingNodes.end());
     }
@@ -497,7 +776,8 @@ template <class T>
 std::unordered_set<DGNode<T> *> DG<T>::getPreviousDepthNodes(DGNode<T> *node) {
   std::unordered_set<DGNode<T> *> outgoingNodes;
   for (auto edge : node->getIncomingEdges())
-    outgoingNodes.insert(edge->getSrcNode());
+    if (this->isInGraph(edge))
+      outgoingNodes.insert(edge->getSrcNode());
 
   std::unordered_set<DGNode<T> *> previousDepthNodes;
   for (auto outgoing : outgoingNodes) {
@@ -507,6 +787,8 @@ std::unordered_set<DGNode<T> *> DG<T>::getPreviousDepthNodes(DGNode<T> *node) {
      */
     bool isPrevDepth = true;
     for (auto outgoingE : outgoing->getOutgoingEdges()) {
+      if (!this->isInGraph(outgoingE))
+        continue;
       isPrevDepth &=
           (outgoingNodes.find(outgoingE->getDstNode()) == outgoingNodes.end());
     }
@@ -520,10 +802,17 @@ std::unordered_set<DGNode<T> *> DG<T>::getPreviousDepthNodes(DGNode<T> *node) {
 
 template <class T>
 void DG<T>::removeNode(DGNode<T> *node) {
-  auto theT = node->getT();
-  auto &map = isInternal(theT) ? internalNodeMap : externalNodeMap;
-  map.erase(theT);
-  allNodes.erase(node);
+
+  /*
+   * The adjacency of the nodes of a view belongs to the graph the view has
+   * been built from, so a view cannot forget about a node consistently.
+   */
+  if (!this->ownsNodesAndEdges) {
+    errs() << "DG: Error = nodes cannot be removed from a view of a graph\n";
+    abort();
+  }
+
+  this->eraseNode(node->getT());
 
   /*
    * Collect edges to operate on before doing deletes
@@ -546,19 +835,39 @@ void DG<T>::removeNode(DGNode<T> *node) {
   for (auto edge : outgoingFromNode)
     edge->getDstNode()->removeConnectedNode(node);
   for (auto edge : allToAndFromNode) {
-    allEdges.erase(edge);
-    delete edge;
+    this->unlinkEdgeFromGraph(edge);
+    this->release(edge);
   }
-
-  delete node;
+  this->release(node);
 }
 
 template <class T>
 void DG<T>::removeEdge(DGEdge<T, T> *edge) {
+  if (!this->ownsNodesAndEdges) {
+    errs() << "DG: Error = edges cannot be removed from a view of a graph\n";
+    abort();
+  }
   edge->getSrcNode()->removeConnectedEdge(edge);
   edge->getDstNode()->removeConnectedEdge(edge);
-  allEdges.erase(edge);
-  delete edge;
+  this->unlinkEdgeFromGraph(edge);
+  this->release(edge);
+}
+
+template <class T>
+void DG<T>::unlinkEdgeFromGraph(DGEdge<T, T> *edge) {
+
+  /*
+   * Move the last edge into the position of @edge.
+   */
+  auto slot = edge->graphSlot;
+  assert((slot < allEdges.size()) && (allEdges[slot] == edge));
+  auto lastEdge = allEdges.back();
+  allEdges[slot] = lastEdge;
+  lastEdge->graphSlot = slot;
+  allEdges.pop_back();
+  this->version++;
+
+  return;
 }
 
 template <class T>
@@ -578,6 +887,8 @@ void DG<T>::copyNodesIntoNewGraph(DG<T> &newGraph,
    */
   for (auto node : nodesToPartition) {
     for (auto edgeToCopy : node->getOutgoingEdges()) {
+      if (!this->isInGraph(edgeToCopy))
+        continue;
       auto incomingT = edgeToCopy->getDstNode()->getT();
       if (!newGraph.isInGraph(incomingT))
         continue;
@@ -588,20 +899,44 @@ void DG<T>::copyNodesIntoNewGraph(DG<T> &newGraph,
 
 template <class T>
 void DG<T>::clear(void) {
+
+  /*
+   * Nodes and edges referenced by a view are destroyed by their own graph.
+   */
+  if (this->ownsNodesAndEdges) {
+    for (auto edge : allEdges) {
+      std::destroy_at(edge);
+    }
+    for (auto edge : detachedEdges) {
+      std::destroy_at(edge);
+    }
+    for (auto node : allNodes) {
+      std::destroy_at(node);
+    }
+    this->arena.Reset();
+  }
+  freeNodeSlots.clear();
+  freeEdgeSlots.clear();
+  detachedEdges.clear();
+
   allNodes.clear();
   allEdges.clear();
   entryNode = nullptr;
-  internalNodeMap.clear();
-  externalNodeMap.clear();
+  internalNodes.clear();
+  externalNodes.clear();
+  nodeKinds.clear();
+  nodeIDs.clear();
+  sharedEdges.clear();
+  this->version++;
 }
 
 template <class T>
 raw_ostream &DG<T>::print(raw_ostream &stream) {
   stream << "Total node count: " << allNodes.size() << "\n";
-  stream << "Internal node count: " << internalNodeMap.size() << "\n";
+  stream << "Internal node count: " << internalNodes.size() << "\n";
   for (auto pair : internalNodePairs())
     pair.second->print(stream) << "\n";
-  stream << "External node count: " << externalNodeMap.size() << "\n";
+  stream << "External node count: " << externalNodes.size() << "\n";
   for (auto pair : externalNodePairs())
     pair.second->print(stream) << "\n";
   stream << "Edge count: " << allEdges.size() << "\n";
@@ -631,13 +966,13 @@ inline std::string DGNode<Instruction>::toString(void) const {
 
 template <class T>
 std::vector<DGEdge<T, T> *> DG<T>::sortDependences(
-    const std::set<DGEdge<T, T> *> &set) {
+    const std::vector<DGEdge<T, T> *> &edges) {
   std::vector<DGEdge<T, T> *> v;
 
   /*
    * Fetch all edges.
    */
-  for (auto edge : set) {
+  for (auto edge : edges) {
     assert(edge != nullptr);
     v.push_back(edge);
   }
@@ -687,12 +1022,12 @@ uint64_t DG<T>::numNodes(void) const {
 
 template <class T>
 uint64_t DG<T>::numInternalNodes(void) const {
-  return internalNodeMap.size();
+  return internalNodes.size();
 }
 
 template <class T>
 uint64_t DG<T>::numExternalNodes(void) const {
-  return externalNodeMap.size();
+  return externalNodes.size();
 }
 
 template <class T>
@@ -700,6 +1035,11 @@ uint64_t DG<T>::numEdges(void) const {
   return allEdges.size();
 }
 
+template <class T>
+uint64_t DG<T>::getVersion(void) const {
+  return this->version;
+}
+
 } // namespace arcana::noelle
 
 #endif // NOELLE_SRC_CORE_DG_DGBASE_H_
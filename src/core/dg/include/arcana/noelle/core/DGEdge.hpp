@@ -27,6 +27,9 @@
 
 namespace arcana::noelle {
 
+template <class T>
+class DG;
+
 /*
  * This is the top of the class hierarchy that organizes dependences.
  *
@@ -100,9 +103,25 @@ protected:
   DGEdge(const DGEdge<T, SubT> &edgeToCopy);
 
 private:
+  friend class DGNode<T>;
+  friend class DG<T>;
+
   DGNode<T> *from;
   DGNode<T> *to;
   std::unordered_set<DGEdge<SubT, SubT> *> *subEdges;
+
+  /*
+   * Positions of this edge within the outgoing edges of its source and the
+   * incoming edges of its destination.
+   */
+  uint32_t srcSlot;
+  uint32_t dstSlot;
+
+  /*
+   * Position of this edge within the edges of the graph that owns it.
+   */
+  uint32_t graphSlot;
+
   DependenceKind kind;
   bool isLoopCarried;
 };
@@ -112,6 +131,9 @@ DGEdge<T, SubT>::DGEdge(DependenceKind k, DGNode<T> *src, DGNode<T> *dst)
   : from{ src },
     to{ dst },
     subEdges{ nullptr },
+    srcSlot{ 0 },
+    dstSlot{ 0 },
+    graphSlot{ 0 },
     kind{ k },
     isLoopCarried(false) {
   return;
@@ -119,7 +141,10 @@ DGEdge<T, SubT>::DGEdge(DependenceKind k, DGNode<T> *src, DGNode<T> *dst)
 
 template <class T, class SubT>
 DGEdge<T, SubT>::DGEdge(const DGEdge<T, SubT> &edgeToCopy)
-  : subEdges{ nullptr } {
+  : subEdges{ nullptr },
+    srcSlot{ 0 },
+    dstSlot{ 0 },
+    graphSlot{ 0 } {
 
   /*
    * Copy the vertices.
@@ -69,6 +69,9 @@ public:
         wrapped->end_outgoing_edges()
       };
       for (auto edge : allOutgoingEdges) {
+        if (!graph->isInGraph(edge)) {
+          continue;
+        }
         auto unwrappedOtherNode = edge->getDstNode();
         if (nodeToWrapperMap.find(unwrappedOtherNode)
             != nodeToWrapperMap.end()) {
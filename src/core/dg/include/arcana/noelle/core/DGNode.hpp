@@ -29,6 +29,9 @@ namespace arcana::noelle {
 template <class T, class SubT>
 class DGEdge;
 
+template <class T>
+class DG;
+
 template <class T>
 class DGNode {
 public:
@@ -37,9 +40,9 @@ public:
   T *getT(void) const;
 
   using nodes_iterator = typename std::vector<DGNode<T> *>::iterator;
-  using edges_iterator = typename std::unordered_set<DGEdge<T, T> *>::iterator;
-  using edges_const_iterator =
-      typename std::unordered_set<DGEdge<T, T> *>::const_iterator;
+  using edges_t = SmallVector<DGEdge<T, T> *, 2>;
+  using edges_iterator = typename edges_t::iterator;
+  using edges_const_iterator = typename edges_t::const_iterator;
 
   edges_iterator begin_outgoing_edges() {
     return outgoingEdges.begin();
@@ -96,10 +99,26 @@ public:
   raw_ostream &print(raw_ostream &stream);
 
 protected:
+  /*
+   * The ID is the position of the node within the graph that owns it (see
+   * DG::getNodeID).
+   */
   int32_t ID;
   T *theT;
-  std::unordered_set<DGEdge<T, T> *> outgoingEdges;
-  std::unordered_set<DGEdge<T, T> *> incomingEdges;
+
+  /*
+   * Each edge remembers its position within these vectors (see
+   * DGEdge::srcSlot and DGEdge::dstSlot) so it can be removed in constant
+   * time.
+   */
+  edges_t outgoingEdges;
+  edges_t incomingEdges;
+
+private:
+  friend class DG<T>;
+
+  void removeEdgeAt(edges_t &edges, uint32_t slot, bool outgoing);
+  static uint32_t &slotOf(DGEdge<T, T> *edge, bool outgoing);
 };
 
 template <class T>
@@ -121,20 +140,46 @@ raw_ostream &DGNode<T>::print(raw_ostream &stream) {
 
 template <class T>
 void DGNode<T>::addIncomingEdge(DGEdge<T, T> *edge) {
-  this->incomingEdges.insert(edge);
+  edge->dstSlot = this->incomingEdges.size();
+  this->incomingEdges.push_back(edge);
 }
 
 template <class T>
 void DGNode<T>::addOutgoingEdge(DGEdge<T, T> *edge) {
-  this->outgoingEdges.insert(edge);
+  edge->srcSlot = this->outgoingEdges.size();
+  this->outgoingEdges.push_back(edge);
+}
+
+template <class T>
+uint32_t &DGNode<T>::slotOf(DGEdge<T, T> *edge, bool outgoing) {
+  return outgoing ? edge->srcSlot : edge->dstSlot;
+}
+
+template <class T>
+void DGNode<T>::removeEdgeAt(edges_t &edges, uint32_t slot, bool outgoing) {
+
+  /*
+   * Move the last edge into the slot to remove.
+   */
+  auto lastEdge = edges.back();
+  edges[slot] = lastEdge;
+  slotOf(lastEdge, outgoing) = slot;
+  edges.pop_back();
+
+  return;
 }
 
 template <class T>
 void DGNode<T>::removeConnectedEdge(DGEdge<T, T> *edge) {
-  if (outgoingEdges.find(edge) != outgoingEdges.end()) {
-    outgoingEdges.erase(edge);
-  } else {
-    incomingEdges.erase(edge);
+  auto srcSlot = edge->srcSlot;
+  if ((srcSlot < outgoingEdges.size()) && (outgoingEdges[srcSlot] == edge)) {
+    this->removeEdgeAt(outgoingEdges, srcSlot, true);
+    return;
+  }
+
+  auto dstSlot = edge->dstSlot;
+  if ((dstSlot < incomingEdges.size()) && (incomingEdges[dstSlot] == edge)) {
+    this->removeEdgeAt(incomingEdges, dstSlot, false);
   }
 
   return;
@@ -142,25 +187,31 @@ void DGNode<T>::removeConnectedEdge(DGEdge<T, T> *edge) {
 
 template <class T>
 void DGNode<T>::removeConnectedNode(DGNode<T> *node) {
-  std::unordered_set<DGEdge<T, T> *> outgoingEdgesToRemove{};
+
+  /*
+   * Compact the vectors in place, renumbering the slots of the edges kept.
+   */
+  uint32_t kept = 0;
   for (auto edge : outgoingEdges) {
     if (edge->getDstNode() == node) {
-      outgoingEdgesToRemove.insert(edge);
+      continue;
     }
+    edge->srcSlot = kept;
+    outgoingEdges[kept++] = edge;
   }
-  for (auto edge : outgoingEdgesToRemove) {
-    outgoingEdges.erase(edge);
-  }
+  outgoingEdges.resize(kept);
 
-  std::unordered_set<DGEdge<T, T> *> incomingEdgesToRemove{};
+  kept = 0;
   for (auto edge : incomingEdges) {
     if (edge->getSrcNode() == node) {
-      incomingEdgesToRemove.insert(edge);
+      continue;
     }
+    edge->dstSlot = kept;
+    incomingEdges[kept++] = edge;
   }
-  for (auto edge : incomingEdgesToRemove) {
-    incomingEdges.erase(edge);
-  }
+  incomingEdges.resize(kept);
+
+  return;
 }
 
 template <class T>
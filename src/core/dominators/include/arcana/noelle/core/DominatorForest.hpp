@@ -40,6 +40,8 @@ public:
 
   DominatorNode *getNode(BasicBlock *B) const;
 
+  std::set<BasicBlock *> getBasicBlocks(void) const;
+
   bool dominates(Instruction *I, Instruction *J) const;
   bool dominates(BasicBlock *B1, BasicBlock *B2) const;
   bool dominates(DominatorNode *node1, DominatorNode *node2) const;
@@ -80,6 +82,8 @@ private:
 
   void cloneLLVMNodes(std::set<DTAliases::Node *> &nodesToClone);
 
+  void computeDFSIntervals(void);
+
   void addDescendants(DominatorNode *n, std::set<BasicBlock *> &ds) const;
 };
 
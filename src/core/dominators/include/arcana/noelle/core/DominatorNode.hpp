@@ -49,6 +49,13 @@ private:
   BasicBlock *B;
   uint32_t level;
 
+  /*
+   * Pre/post-order numbers of the node in a depth-first visit of its forest.
+   * A node dominates another one iff its interval encloses the other's one.
+   */
+  uint32_t dfsIn;
+  uint32_t dfsOut;
+
   DominatorNode *parent;
   std::vector<DominatorNode *> children;
 };
@@ -32,7 +32,19 @@ public:
   DominatorSummary(DominatorTree &DT, PostDominatorTree &PDT);
   DominatorSummary(DominatorSummary &DS, std::set<BasicBlock *> &bbSubset);
 
+  /*
+   * Return a copy of "this" that can outlive it.
+   * The copy is made the first time it is requested and then returned by all
+   * later calls, so all users of "this" share the same copy.
+   * Changes made to "this" after the copy has been made are not reflected in
+   * the copy.
+   */
+  std::shared_ptr<DominatorSummary> getSharedCopy(void);
+
   DominatorForest DT, PDT;
+
+private:
+  std::shared_ptr<DominatorSummary> sharedCopy;
 };
 
 } // namespace arcana::noelle
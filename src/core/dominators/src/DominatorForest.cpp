@@ -39,12 +39,14 @@ DominatorForest::DominatorForest(std::set<DTAliases::Node *> nodeSubset)
   : nodes{},
     bbNodeMap{} {
   this->cloneLLVMNodes(nodeSubset);
+  this->computeDFSIntervals();
   return;
 }
 
 DominatorForest::DominatorForest(DominatorForest &DTS,
                                  std::set<BasicBlock *> &bbSubset)
   : DominatorForest{ filterNodes(DTS.nodes, bbSubset) } {
+  this->post = DTS.post;
   return;
 }
 
@@ -52,6 +54,7 @@ DominatorForest::DominatorForest(std::set<DominatorNode *> nodeSubset)
   : nodes{},
     bbNodeMap{} {
   this->cloneNodes<DominatorNode>(nodeSubset);
+  this->computeDFSIntervals();
   return;
 }
 
@@ -64,10 +67,19 @@ DominatorForest::~DominatorForest() {
 
 void DominatorForest::transferToClones(
     std::unordered_map<BasicBlock *, BasicBlock *> &bbCloneMap) {
+
+  /*
+   * Only the blocks change: the shape of the forest, and therefore the DFS
+   * intervals of its nodes, stay the same.
+   */
+  this->bbNodeMap.clear();
   for (auto node : nodes) {
     assert(bbCloneMap.find(node->B) != bbCloneMap.end());
     node->B = bbCloneMap[node->B];
+    this->bbNodeMap[node->B] = node;
   }
+
+  return;
 }
 
 template <typename TreeType>
@@ -171,11 +183,62 @@ void DominatorForest::cloneNodes(std::set<NodeType *> &nodesToClone) {
   }
 }
 
+void DominatorForest::computeDFSIntervals(void) {
+
+  /*
+   * Number the nodes of every tree of the forest in a depth-first visit.
+   * Each node gets the interval [dfsIn, dfsOut] that encloses the intervals
+   * of all its descendants.
+   */
+  uint32_t counter = 0;
+  std::vector<std::pair<DominatorNode *, uint32_t>> stack;
+  for (auto root : this->nodes) {
+    if (root->parent != nullptr) {
+      continue;
+    }
+
+    root->dfsIn = counter++;
+    stack.push_back(std::make_pair(root, 0));
+    while (!stack.empty()) {
+      auto &top = stack.back();
+      auto node = top.first;
+
+      /*
+       * Check if all children of the node have been visited.
+       */
+      if (top.second == node->children.size()) {
+        node->dfsOut = counter++;
+        stack.pop_back();
+        continue;
+      }
+
+      /*
+       * Visit the next child.
+       */
+      auto child = node->children[top.second];
+      top.second++;
+      child->dfsIn = counter++;
+      stack.push_back(std::make_pair(child, 0));
+    }
+  }
+
+  return;
+}
+
 DominatorNode *DominatorForest::getNode(BasicBlock *B) const {
   auto nodeIter = bbNodeMap.find(B);
   return nodeIter == bbNodeMap.end() ? nullptr : nodeIter->second;
 }
 
+std::set<BasicBlock *> DominatorForest::getBasicBlocks(void) const {
+  std::set<BasicBlock *> blocks;
+  for (auto &pair : this->bbNodeMap) {
+    blocks.insert(pair.first);
+  }
+
+  return blocks;
+}
+
 bool DominatorForest::dominates(Instruction *I, Instruction *J) const {
   auto B1 = I->getParent();
   auto B2 = J->getParent();
@@ -186,41 +249,35 @@ bool DominatorForest::dominates(Instruction *I, Instruction *J) const {
   if (B1 == B2) {
 
     /*
-     * Define the first and second instruction.
-     */
-    auto firstOne = I;
-    auto secondOne = J;
-
-    /*
-     * Check the dominance relation between I and J
+     * Check the dominance relation between I and J.
+     *
+     * The order of instructions within a block is answered by the ordinal
+     * numbers LLVM caches in every basic block; they are renumbered lazily
+     * whenever the block changes.
      */
-    while (firstOne != nullptr) {
-      if (firstOne == secondOne) {
-
-        /*
-         * The secondOne instruction is found after the first one.
-         * Hence, I dominates J.
-         * Also, J postdominates I.
-         */
-        if (this->post) {
+    if ((I == J) || I->comesBefore(J)) {
 
-          /*
-           * I does not post-dominate J.
-           */
-          return false;
-        }
+      /*
+       * The J instruction is found after I.
+       * Hence, I dominates J.
+       * Also, J postdominates I.
+       */
+      if (this->post) {
 
         /*
-         * I dominates J
+         * I does not post-dominate J.
          */
-        return true;
+        return false;
       }
 
-      firstOne = firstOne->getNextNode();
+      /*
+       * I dominates J
+       */
+      return true;
     }
 
     /*
-     * The secondOne instruction has not been found after the first one.
+     * The J instruction is found before I.
      * Hence, J dominates I.
      * Also, I post-dominates J.
      */
@@ -275,20 +332,12 @@ bool DominatorForest::strictlyDominates(BasicBlock *B1, BasicBlock *B2) const {
 
 bool DominatorForest::dominates(DominatorNode *node1,
                                 DominatorNode *node2) const {
-  std::queue<DominatorNode *> worklist;
-  worklist.push(node1);
-  while (!worklist.empty()) {
-    auto node = worklist.front();
-    worklist.pop();
-
-    if (node == node2) {
-      return true;
-    }
-    for (auto child : node->children)
-      worklist.push(child);
-  }
 
-  return false;
+  /*
+   * node1 dominates node2 iff the DFS interval of node1 encloses the one of
+   * node2.
+   */
+  return (node1->dfsIn <= node2->dfsIn) && (node2->dfsOut <= node1->dfsOut);
 }
 
 std::set<DominatorNode *> DominatorForest::dominates(
@@ -418,19 +467,11 @@ DominatorNode *DominatorForest::findNearestCommonDominator(
     DominatorNode *node1,
     DominatorNode *node2) const {
 
-  /*
-   * Helpers to determine whether a node n dominates node2
-   */
-  auto dominatorsOf2 = this->dominates(node2);
-  auto dominates2 = [&](DominatorNode *node) -> bool {
-    return dominatorsOf2.find(node) != dominatorsOf2.end();
-  };
-
   /*
    * Traversal of parents of node1 to find common dominator
    */
   DominatorNode *node = node1;
-  while (node && !dominates2(node))
+  while (node && !this->dominates(node, node2))
     node = node->parent;
   return node;
 }
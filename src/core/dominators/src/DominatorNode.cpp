@@ -26,6 +26,8 @@ namespace arcana::noelle {
 DominatorNode::DominatorNode(const DTAliases::Node &node)
   : B{ node.getBlock() },
     level{ node.getLevel() },
+    dfsIn{ 0 },
+    dfsOut{ 0 },
     parent{ nullptr },
     children{} {
 
@@ -35,6 +37,8 @@ DominatorNode::DominatorNode(const DTAliases::Node &node)
 DominatorNode::DominatorNode(const DominatorNode &node)
   : B{ node.getBlock() },
     level{ node.getLevel() },
+    dfsIn{ 0 },
+    dfsOut{ 0 },
     parent{ nullptr },
     children{} {
 
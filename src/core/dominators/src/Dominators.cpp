@@ -34,4 +34,21 @@ DominatorSummary::DominatorSummary(DominatorSummary &ds,
   : DT{ ds.DT, bbSubset },
     PDT{ ds.PDT, bbSubset } {}
 
+std::shared_ptr<DominatorSummary> DominatorSummary::getSharedCopy(void) {
+  if (this->sharedCopy == nullptr) {
+
+    /*
+     * The post-dominator forest also includes the virtual exit node, which is
+     * represented by the null block.
+     */
+    auto blocks = this->PDT.getBasicBlocks();
+    for (auto bb : this->DT.getBasicBlocks()) {
+      blocks.insert(bb);
+    }
+    this->sharedCopy = std::make_shared<DominatorSummary>(*this, blocks);
+  }
+
+  return this->sharedCopy;
+}
+
 } // namespace arcana::noelle
@@ -129,6 +129,62 @@ public:
 
   double getAverageTotalInstructionsPerIteration(LoopStructure *loop) const;
 
+  /*
+   * Return true if the trip counts of @loop have been profiled (see
+   * noelle-prof-coverage -trip-counts).
+   *
+   * The trip count of an invocation is the number of times the header of the
+   * loop has been executed by it.
+   */
+  bool hasTripCountHistogram(LoopStructure *loop) const;
+
+  /*
+   * Return the number of invocations of @loop whose trip count falls in each
+   * log2 bucket: bucket 0 counts trip count 0, and bucket b > 0 counts trip
+   * counts in [2^(b-1), 2^b).
+   *
+   * Only invocations that left the loop through one of its exit edges, a
+   * return, or a landing pad reached only from the loop are counted (see
+   * TripCountProfiler), so the histogram can add up to less than
+   * getTripCountInvocations.
+   */
+  std::vector<uint64_t> getTripCountHistogram(LoopStructure *loop) const;
+
+  /*
+   * Return the number of invocations of @loop observed by the trip-count
+   * profiler.
+   */
+  uint64_t getTripCountInvocations(LoopStructure *loop) const;
+
+  /*
+   * Return the trip count that @percentile (between 0 and 1) of the
+   * invocations of @loop do not exceed.
+   *
+   * The result is the upper bound of the bucket that includes the percentile.
+   */
+  uint64_t getTripCountPercentile(LoopStructure *loop,
+                                  double percentile) const;
+
+  /*
+   * Return the fraction of the invocations of @loop that executed more than
+   * @tripCount iterations.
+   *
+   * Buckets that include @tripCount are not counted, so this is a lower bound.
+   *
+   * @return Between 0 and 1
+   */
+  double getFractionOfInvocationsAbove(LoopStructure *loop,
+                                       uint64_t tripCount) const;
+
+  /*
+   * Name of the metadata that holds the trip-count histogram of a loop.
+   * It is attached to the terminator of the header and it includes the
+   * invocations followed by the buckets of the histogram.
+   */
+  static const std::string tripCountsMetadataKey;
+
+  static constexpr uint32_t numberOfTripCountBuckets = 65;
+
   /*
    * =========================== Functions ==================================
    */
@@ -166,15 +222,49 @@ public:
    */
   double getBranchFrequency(BasicBlock *sourceBB, BasicBlock *targetBB) const;
 
+  /*
+   * =========================== Updates =====================================
+   */
+
+  /*
+   * Re-read the profiles of @F (e.g., after they have been re-embedded) and
+   * update the aggregates of the functions, basic blocks, and loops that
+   * depend on them.
+   */
+  void updateProfiles(Function &F);
+
+  /*
+   * Drop the aggregates cached for the basic blocks and loops of @F.
+   * This must be invoked after modifying the IR of @F; the aggregates are
+   * recomputed on demand.
+   */
+  void invalidateCachedProfiles(Function &F);
+
 private:
+  struct BasicBlockProfile {
+    uint64_t totalInstructions;
+  };
+
+  struct LoopProfile {
+    uint64_t selfInstructions;
+    uint64_t totalInstructions;
+  };
+
   std::unordered_map<BasicBlock *, std::unordered_map<BasicBlock *, double>>
       branchProbability;
   std::unordered_map<BasicBlock *, uint64_t> bbInvocations;
+  std::unordered_map<Function *, std::unordered_map<BasicBlock *, uint64_t>>
+      bbRecordedInstructions;
   std::unordered_map<Function *, uint64_t> functionInvocations;
   std::unordered_map<Function *, uint64_t> functionSelfInstructions;
   std::unordered_map<Function *, uint64_t> functionTotalInstructions;
   std::unordered_map<Instruction *, uint64_t> instructionTotalInstructions;
   uint64_t moduleNumberOfInstructionsExecuted;
+  mutable std::unordered_map<Function *,
+                             DenseMap<BasicBlock *, BasicBlockProfile>>
+      basicBlockProfiles;
+  mutable std::unordered_map<Function *, DenseMap<BasicBlock *, LoopProfile>>
+      loopProfiles;
   std::function<llvm::BlockFrequencyInfo &(Function &F)> getBFI;
   std::function<llvm::BranchProbabilityInfo &(Function &F)> getBPI;
 
@@ -197,6 +287,16 @@ private:
   void computeProgramInvocations(Module &M);
 
   void analyzeProfiles(Module &M);
+
+  void analyzeProfiles(Function &F);
+
+  void indexBasicBlocks(Function &F);
+
+  BasicBlockProfile computeBasicBlockProfile(BasicBlock *bb) const;
+
+  const BasicBlockProfile &fetchBasicBlockProfile(BasicBlock *bb) const;
+
+  const LoopProfile &fetchLoopProfile(LoopStructure *l) const;
 };
 
 } // namespace arcana::noelle
@@ -48,60 +48,180 @@ void Hot::analyzeProfiles(Module &M) {
     if (F.empty()) {
       continue;
     }
-    auto &bfi = this->getBFI(F);
-    auto &bpi = this->getBPI(F);
+    this->analyzeProfiles(F);
+  }
+
+  /*
+   * Compute the global counters.
+   */
+  this->computeProgramInvocations(M);
+
+  /*
+   * Index the aggregates of the basic blocks so loop queries do not need to
+   * walk the instructions of their basic blocks every time.
+   */
+  for (auto &F : M) {
+    if (F.empty()) {
+      continue;
+    }
+    this->indexBasicBlocks(F);
+  }
+
+  return;
+}
+
+void Hot::analyzeProfiles(Function &F) {
+  auto &bfi = this->getBFI(F);
+  auto &bpi = this->getBPI(F);
+
+  /*
+   * Set the invocations of basic blocks.
+   */
+  for (auto &bb : F) {
 
     /*
-     * Set the invocations of basic blocks.
+     * Forget the branch frequencies of a previous profile.
      */
-    for (auto &bb : F) {
+    this->branchProbability.erase(&bb);
+
+    /*
+     * Check if the basic block has been executed at least once.
+     */
+    if (!bfi.getBlockProfileCount(&bb).hasValue()) {
 
       /*
-       * Check if the basic block has been executed at least once.
+       * The basic block hasn't been executed.
        */
-      if (!bfi.getBlockProfileCount(&bb).hasValue()) {
+      this->setBasicBlockInvocations(&bb, 0);
+      continue;
+    }
 
-        /*
-         * The basic block hasn't been executed.
-         */
-        this->setBasicBlockInvocations(&bb, 0);
+    /*
+     * Fetch the basic block counter.
+     */
+    auto v = bfi.getBlockProfileCount(&bb).getValue();
+
+    /*
+     * Set the invocations.
+     */
+    this->setBasicBlockInvocations(&bb, v);
+
+    /*
+     * Compute the frequency of jumping to the successors of bb.
+     */
+    for (auto succBB : successors(&bb)) {
+      auto prob = bpi.getEdgeProbability(&bb, succBB);
+      if (prob.isUnknown()) {
         continue;
       }
+      auto probNum = double(prob.getNumerator());
+      auto probDen = double(prob.getDenominator());
+      auto probValue = probNum / probDen;
 
       /*
-       * Fetch the basic block counter.
+       * Set the frequency.
        */
-      auto v = bfi.getBlockProfileCount(&bb).getValue();
+      this->setBranchFrequency(&bb, succBB, probValue);
+    }
+  }
 
-      /*
-       * Set the invocations.
-       */
-      this->setBasicBlockInvocations(&bb, v);
+  return;
+}
 
-      /*
-       * Compute the frequency of jumping to the successors of bb.
-       */
-      for (auto succBB : successors(&bb)) {
-        auto prob = bpi.getEdgeProbability(&bb, succBB);
-        if (prob.isUnknown()) {
-          continue;
-        }
-        auto probNum = double(prob.getNumerator());
-        auto probDen = double(prob.getDenominator());
-        auto probValue = probNum / probDen;
+void Hot::updateProfiles(Function &F) {
+  if (F.empty()) {
+    return;
+  }
 
-        /*
-         * Set the frequency.
-         */
-        this->setBranchFrequency(&bb, succBB, probValue);
-      }
+  /*
+   * Remove the contribution of the old profile of F from the module counter.
+   *
+   * The basic blocks of F might have been modified or deleted since their
+   * profile has been recorded, so the lengths they had back then are used.
+   */
+  auto recordedIt = this->bbRecordedInstructions.find(&F);
+  if (recordedIt != this->bbRecordedInstructions.end()) {
+    for (auto &[bb, instructions] : recordedIt->second) {
+      this->moduleNumberOfInstructionsExecuted -=
+          (this->bbInvocations.at(bb) * instructions);
+      this->bbInvocations.erase(bb);
+      this->branchProbability.erase(bb);
     }
+    this->bbRecordedInstructions.erase(recordedIt);
   }
 
   /*
-   * Compute the global counters.
+   * Read the new profile of F.
    */
-  this->computeProgramInvocations(M);
+  this->analyzeProfiles(F);
+
+  /*
+   * Add the contribution of the new profile of F.
+   */
+  uint64_t c = 0;
+  for (auto &bb : F) {
+    c += (this->getInvocations(&bb) * this->getStaticInstructions(&bb));
+  }
+  this->moduleNumberOfInstructionsExecuted += c;
+  this->functionSelfInstructions[&F] = c;
+
+  /*
+   * The total instructions of F propagate to its callers transitively.
+   * Recompute them and keep the old ones of the call instructions to find out
+   * which functions have been affected.
+   */
+  auto oldCallTotals = std::move(this->instructionTotalInstructions);
+  this->instructionTotalInstructions.clear();
+  this->functionTotalInstructions.clear();
+  this->computeTotalInstructions(*F.getParent());
+
+  /*
+   * Collect the functions whose basic block aggregates might have changed.
+   *
+   * The invocations of the calls to F depend on the invocations of F.
+   */
+  std::unordered_set<Function *> changedFunctions{ &F };
+  for (auto user : F.users()) {
+    if (auto call = dyn_cast<CallBase>(user)) {
+      changedFunctions.insert(call->getFunction());
+    }
+  }
+  for (auto &pair : oldCallTotals) {
+    auto newTotal = this->instructionTotalInstructions.find(pair.first);
+    if ((newTotal == this->instructionTotalInstructions.end())
+        || (newTotal->second != pair.second)) {
+      changedFunctions.insert(pair.first->getFunction());
+    }
+  }
+  for (auto &pair : this->instructionTotalInstructions) {
+    if (oldCallTotals.find(pair.first) == oldCallTotals.end()) {
+      changedFunctions.insert(pair.first->getFunction());
+    }
+  }
+
+  /*
+   * Drop the aggregates of the basic blocks and loops of the functions
+   * affected.
+   * They will be recomputed on demand.
+   */
+  for (auto changedF : changedFunctions) {
+    this->invalidateCachedProfiles(*changedF);
+  }
+
+  return;
+}
+
+void Hot::invalidateCachedProfiles(Function &F) {
+
+  /*
+   * Drop the aggregates of the basic blocks and loops of @F.
+   *
+   * They are indexed by the function they have been computed for rather than
+   * by the parent of their key because the basic block might have been
+   * deleted already.
+   */
+  this->basicBlockProfiles.erase(&F);
+  this->loopProfiles.erase(&F);
 
   return;
 }
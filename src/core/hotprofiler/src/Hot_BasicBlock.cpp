@@ -41,8 +41,11 @@ void Hot::setBasicBlockInvocations(BasicBlock *bb, uint64_t invocations) {
 
   /*
    * Insert the number of invocations of the basic block bb.
+   * Its length is recorded as well because the basic block might change
+   * before its contribution is removed from the module counter.
    */
   this->bbInvocations[bb] = invocations;
+  this->bbRecordedInstructions[f][bb] = bb->size();
 
   return;
 }
@@ -64,26 +67,65 @@ uint64_t Hot::getInvocations(BasicBlock *bb) const {
 }
 
 uint64_t Hot::getSelfInstructions(BasicBlock *bb) const {
-  auto invs = this->getInvocations(bb);
-
-  return invs * this->getStaticInstructions(bb);
+  return this->getInvocations(bb) * this->getStaticInstructions(bb);
 }
 
 uint64_t Hot::getTotalInstructions(BasicBlock *bb) const {
-  uint64_t t = 0;
+  return this->fetchBasicBlockProfile(bb).totalInstructions;
+}
+
+uint64_t Hot::getStaticInstructions(BasicBlock *bb) const {
+  auto bbLength = bb->size();
+  assert(bbLength > 0);
+
+  return bbLength;
+}
+
+void Hot::indexBasicBlocks(Function &F) {
+  auto &profiles = this->basicBlockProfiles[&F];
+  for (auto &bb : F) {
+    profiles[&bb] = this->computeBasicBlockProfile(&bb);
+  }
+
+  return;
+}
+
+Hot::BasicBlockProfile Hot::computeBasicBlockProfile(BasicBlock *bb) const {
+  BasicBlockProfile profile;
 
+  /*
+   * Compute the total instructions, which include the ones executed by the
+   * callees.
+   */
+  profile.totalInstructions = 0;
   for (auto &inst : *bb) {
-    t += this->getTotalInstructions(&inst);
+    profile.totalInstructions += this->getTotalInstructions(&inst);
   }
 
-  return t;
+  return profile;
 }
 
-uint64_t Hot::getStaticInstructions(BasicBlock *bb) const {
-  auto bbLength = std::distance(bb->begin(), bb->end());
-  assert(bbLength > 0);
+const Hot::BasicBlockProfile &Hot::fetchBasicBlockProfile(
+    BasicBlock *bb) const {
+  assert(bb != nullptr);
 
-  return bbLength;
+  /*
+   * Check if the basic block has been indexed.
+   */
+  auto &profiles = this->basicBlockProfiles[bb->getParent()];
+  auto it = profiles.find(bb);
+  if (it != profiles.end()) {
+    return it->second;
+  }
+
+  /*
+   * The basic block has not been indexed (e.g., it has been added after the
+   * profiles have been analyzed).
+   */
+  auto &bbProfile = profiles[bb];
+  bbProfile = this->computeBasicBlockProfile(bb);
+
+  return bbProfile;
 }
 
 uint64_t Hot::getStaticInstructions(
@@ -24,6 +24,8 @@
 
 namespace arcana::noelle {
 
+const std::string Hot::tripCountsMetadataKey = "noelle.prof.trip_counts";
+
 uint64_t Hot::getStaticInstructions(LoopStructure *l) const {
   uint64_t t = 0;
   for (auto bb : l->getBasicBlocks()) {
@@ -68,23 +70,42 @@ uint64_t Hot::getInvocations(LoopStructure *l) const {
 }
 
 uint64_t Hot::getSelfInstructions(LoopStructure *loop) const {
-  uint64_t insts = 0;
-
-  for (auto bb : loop->getBasicBlocks()) {
-    insts += this->getStaticInstructions(bb);
-  }
-
-  return insts;
+  return this->fetchLoopProfile(loop).selfInstructions;
 }
 
 uint64_t Hot::getTotalInstructions(LoopStructure *loop) const {
-  uint64_t insts = 0;
+  return this->fetchLoopProfile(loop).totalInstructions;
+}
+
+const Hot::LoopProfile &Hot::fetchLoopProfile(LoopStructure *l) const {
+  assert(l != nullptr);
+
+  /*
+   * Check if we have already aggregated the profiles of the loop.
+   *
+   * Loops are identified by their header because LoopStructure objects are
+   * re-allocated every time the loops of a program are requested.
+   */
+  auto header = l->getHeader();
+  auto &profiles = this->loopProfiles[l->getFunction()];
+  auto it = profiles.find(header);
+  if (it != profiles.end()) {
+    return it->second;
+  }
 
-  for (auto bb : loop->getBasicBlocks()) {
-    insts += this->getTotalInstructions(bb);
+  /*
+   * Aggregate the profiles of the basic blocks of the loop.
+   */
+  LoopProfile profile{ 0, 0 };
+  for (auto bb : l->getBasicBlocks()) {
+    profile.selfInstructions += this->getSelfInstructions(bb);
+    profile.totalInstructions += this->getTotalInstructions(bb);
   }
 
-  return insts;
+  auto &loopProfile = profiles[header];
+  loopProfile = profile;
+
+  return loopProfile;
 }
 
 double Hot::getDynamicTotalInstructionCoverage(LoopStructure *loop) const {
@@ -199,4 +220,127 @@ uint64_t Hot::getIterations(LoopStructure *l) const {
   return loopIterations;
 }
 
+bool Hot::hasTripCountHistogram(LoopStructure *loop) const {
+  auto headerTerminator = loop->getHeader()->getTerminator();
+  if (headerTerminator->getMetadata(Hot::tripCountsMetadataKey) == nullptr) {
+    return false;
+  }
+
+  return true;
+}
+
+std::vector<uint64_t> Hot::getTripCountHistogram(LoopStructure *loop) const {
+  std::vector<uint64_t> histogram(Hot::numberOfTripCountBuckets, 0);
+
+  /*
+   * Fetch the metadata.
+   */
+  auto headerTerminator = loop->getHeader()->getTerminator();
+  auto md = headerTerminator->getMetadata(Hot::tripCountsMetadataKey);
+  if (md == nullptr) {
+    return histogram;
+  }
+
+  /*
+   * Decode the buckets.
+   * The first operand is the number of invocations. Trailing empty buckets
+   * are not embedded.
+   */
+  for (auto i = 1u; i < md->getNumOperands(); i++) {
+    auto bucket = i - 1;
+    if (bucket >= Hot::numberOfTripCountBuckets) {
+      break;
+    }
+    auto value = mdconst::extract<ConstantInt>(md->getOperand(i));
+    histogram[bucket] = value->getZExtValue();
+  }
+
+  return histogram;
+}
+
+uint64_t Hot::getTripCountInvocations(LoopStructure *loop) const {
+  auto headerTerminator = loop->getHeader()->getTerminator();
+  auto md = headerTerminator->getMetadata(Hot::tripCountsMetadataKey);
+  if ((md == nullptr) || (md->getNumOperands() == 0)) {
+    return 0;
+  }
+  auto invocations = mdconst::extract<ConstantInt>(md->getOperand(0));
+
+  return invocations->getZExtValue();
+}
+
+uint64_t Hot::getTripCountPercentile(LoopStructure *loop,
+                                     double percentile) const {
+  assert(percentile >= 0);
+  assert(percentile <= 1);
+
+  /*
+   * Fetch the histogram.
+   */
+  auto histogram = this->getTripCountHistogram(loop);
+  uint64_t total = 0;
+  for (auto count : histogram) {
+    total += count;
+  }
+  if (total == 0) {
+    return 0;
+  }
+
+  /*
+   * Find the first bucket that reaches the percentile.
+   */
+  auto target = percentile * ((double)total);
+  uint64_t seen = 0;
+  for (auto bucket = 0u; bucket < histogram.size(); bucket++) {
+    seen += histogram[bucket];
+    if (((double)seen) < target) {
+      continue;
+    }
+
+    /*
+     * Return the upper bound of the bucket.
+     */
+    if (bucket == 0) {
+      return 0;
+    }
+    if (bucket >= 64) {
+      return std::numeric_limits<uint64_t>::max();
+    }
+    return (((uint64_t)1) << bucket) - 1;
+  }
+
+  return std::numeric_limits<uint64_t>::max();
+}
+
+double Hot::getFractionOfInvocationsAbove(LoopStructure *loop,
+                                          uint64_t tripCount) const {
+
+  /*
+   * Fetch the histogram.
+   */
+  auto histogram = this->getTripCountHistogram(loop);
+
+  /*
+   * Count the invocations of the buckets whose trip counts are all above
+   * @tripCount.
+   */
+  uint64_t total = 0;
+  uint64_t above = 0;
+  for (auto bucket = 0u; bucket < histogram.size(); bucket++) {
+    total += histogram[bucket];
+    if (bucket == 0) {
+      continue;
+    }
+    auto lowerBound = ((uint64_t)1) << (bucket - 1);
+    if (lowerBound > tripCount) {
+      above += histogram[bucket];
+    }
+  }
+  if (total == 0) {
+    return 0;
+  }
+
+  return ((double)above) / ((double)total);
+}
+
 } // namespace arcana::noelle
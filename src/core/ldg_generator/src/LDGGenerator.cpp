@@ -28,7 +28,7 @@
 namespace arcana::noelle {
 
 // TODO: Refactor along with HELIX's exact same implementation of this method
-DataFlowResult *computeReachabilityFromInstructions(
+DenseBlockDataFlowResult *computeReachabilityFromInstructions(
     LoopStructure *loopStructure) {
   assert(loopStructure != nullptr);
 
@@ -38,53 +38,31 @@ DataFlowResult *computeReachabilityFromInstructions(
   /*
    * Run the data flow analysis needed to identify the locations where signal
    * instructions will be placed.
+   *
+   * Only a few membership queries are done on the result, so the fixed point
+   * is kept at the basic block granularity.
    */
   auto dfa = DataFlowEngine{};
-  auto computeGEN = [](Instruction *i, DataFlowResult *df) {
+  auto computeGENAndKILL = [](Instruction *i, DenseBlockDataFlowResult *df) {
     assert(i != nullptr);
     assert(df != nullptr);
-    auto &gen = df->GEN(i);
-    gen.insert(i);
+    df->addToGEN(i, i);
     return;
   };
-  auto computeOUT = [loopHeader](Instruction *inst,
-                                 Instruction *succ,
-                                 std::set<Value *> &OUT,
-                                 DataFlowResult *df) {
-    assert(succ != nullptr);
-    assert(df != nullptr);
-
-    /*
-     * Check if the successor is the header.
-     * In this case, we do not propagate the reachable instructions.
-     * We do this because we are interested in understanding the reachability of
-     * instructions within a single iteration.
-     */
-    auto succBB = succ->getParent();
-    if (succBB == loopHeader) {
-      return;
-    }
 
-    /*
-     * Propagate the data flow values.
-     */
-    auto &inS = df->IN(succ);
-    OUT.insert(inS.begin(), inS.end());
-    return;
+  /*
+   * We do not propagate the reachable instructions from the header.
+   * We do this because we are interested in understanding the reachability of
+   * instructions within a single iteration.
+   */
+  auto isEdgeIgnored = [loopHeader](BasicBlock *src, BasicBlock *dst) {
+    return dst == loopHeader;
   };
-  auto computeIN =
-      [](Instruction *inst, std::set<Value *> &IN, DataFlowResult *df) {
-        assert(inst != nullptr);
-        assert(df != nullptr);
-
-        auto &genI = df->GEN(inst);
-        auto &outI = df->OUT(inst);
-        IN.insert(outI.begin(), outI.end());
-        IN.insert(genI.begin(), genI.end());
-        return;
-      };
-
-  return dfa.applyBackward(loopFunction, computeGEN, computeIN, computeOUT);
+
+  return dfa.applyBackwardOnBlocks<BitVector>(loopFunction,
+                                              DataFlowMeet::Union,
+                                              computeGENAndKILL,
+                                              isEdgeIgnored);
 }
 
 void LDGGenerator::improveDependenceGraph(PDG *loopDG, LoopStructure *loop) {
@@ -268,21 +246,23 @@ PDG *LDGGenerator::generateLoopDependenceGraph(PDG *functionDG,
     }
   }
 
-  /*
-   * Fetch the set of instructions that compose the loop.
-   */
-  std::vector<Value *> loopInternals;
-  for (auto internalNode : loopDG->internalNodePairs()) {
-    loopInternals.push_back(internalNode.first);
-  }
-
   /*
    * Compute the SCCDAG using only variable-related dependences.
-   * This will be used to detect induction variables.
+   * This will be used to detect induction variables, which are only needed
+   * by the loop-centric dependence analyses.
    */
-  auto loopInternalDG = loopDG->createSubgraphFromValues(loopInternals, false);
-  auto loopSCCDAGWithoutMemoryDeps =
-      this->computeSCCDAGWithOnlyVariableAndControlDependences(loopInternalDG);
+  SCCDAG *loopSCCDAGWithoutMemoryDeps = nullptr;
+  if (this->areLoopDependenceAnalysesEnabled()) {
+    std::vector<Value *> loopInternals;
+    for (auto internalNode : loopDG->internalNodePairs()) {
+      loopInternals.push_back(internalNode.first);
+    }
+    auto loopInternalDG =
+        loopDG->createSubgraphFromValues(loopInternals, false);
+    loopSCCDAGWithoutMemoryDeps =
+        this->computeSCCDAGWithOnlyVariableAndControlDependences(
+            loopInternalDG);
+  }
 
   /*
    * Detect the loop-carried data dependences.
@@ -298,25 +278,26 @@ PDG *LDGGenerator::generateLoopDependenceGraph(PDG *functionDG,
    */
   LoopCarriedDependencies::setLoopCarriedDependencies(&loopNode, DS, *loopDG);
 
-  /*
-   * Detect loop invariants and induction variables.
-   */
-  auto loopStructure = loopNode.getLoop();
-  auto loopExitBlocks = loopStructure->getLoopExitBasicBlocks();
-  auto env = LoopEnvironment(loopDG, loopExitBlocks, {});
-  auto invManager = InvariantManager(loopStructure, loopDG);
-  auto ivManager = InductionVariableManager(&loopNode,
-                                            invManager,
-                                            scalarEvolution,
-                                            *loopSCCDAGWithoutMemoryDeps,
-                                            env,
-                                            *l);
-
   /*
    * Check if loop-centric dependence analyses are enabled.
    */
+  auto loopStructure = loopNode.getLoop();
   if (this->areLoopDependenceAnalysesEnabled()) {
 
+    /*
+     * Detect loop invariants and induction variables.
+     * They are only needed by the loop-centric dependence analyses.
+     */
+    auto loopExitBlocks = loopStructure->getLoopExitBasicBlocks();
+    auto env = LoopEnvironment(loopDG, loopExitBlocks, {});
+    auto invManager = InvariantManager(loopStructure, loopDG);
+    auto ivManager = InductionVariableManager(&loopNode,
+                                              invManager,
+                                              scalarEvolution,
+                                              *loopSCCDAGWithoutMemoryDeps,
+                                              env,
+                                              *l);
+
     /*
      * Run SCAF.
      */
@@ -381,8 +362,7 @@ void LDGGenerator::runAffineAnalysis(PDG &loopDG,
      * remove dependencies between a producer and consumer where we know the
      * producer can NEVER reach the consumer during the same iteration
      */
-    auto &afterInstructions = dfr->OUT(fromInst);
-    if (afterInstructions.find(toInst) != afterInstructions.end()) {
+    if (dfr->isInOUT(fromInst, toInst)) {
       continue;
     }
 
@@ -25,6 +25,7 @@
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/TypesManager.hpp"
 #include "arcana/noelle/core/LoopStructure.hpp"
+#include "arcana/noelle/core/LoopEnvironmentLayout.hpp"
 
 namespace arcana::noelle {
 
@@ -32,6 +33,16 @@ class Linker {
 public:
   Linker(Module &m, TypesManager *tm);
 
+  /*
+   * Set the function to invoke every time the linker modifies a function.
+   */
+  void setFunctionModifiedCallback(std::function<void(Function *)> callback);
+
+  /*
+   * The layout of the environment is the one of the LoopEnvironmentBuilder
+   * that created "envArray".
+   * Without a layout, every variable is assumed to have its own cache line.
+   */
   void linkTransformedLoopToOriginalFunction(
       BasicBlock *originalPreHeader,
       BasicBlock *startOfParLoopInOriginalFunc,
@@ -39,7 +50,8 @@ public:
       Value *envArray,
       Value *envIndexForExitVariable,
       std::vector<BasicBlock *> &loopExitBlocks,
-      uint32_t minIdleCores);
+      uint32_t minIdleCores,
+      const LoopEnvironmentLayout *envLayout = nullptr);
 
   void substituteOriginalLoopWithTransformedLoop(
       LoopStructure *originalLoop,
@@ -48,11 +60,26 @@ public:
       Value *envArray,
       Value *envIndexForExitVariable,
       std::vector<BasicBlock *> &loopExitBlocks,
-      uint32_t minIdleCores);
+      uint32_t minIdleCores,
+      const LoopEnvironmentLayout *envLayout = nullptr);
 
 private:
   Module &program;
   TypesManager *tm;
+  std::function<void(Function *)> functionModified;
+
+  /*
+   * Tables with the offsets of the variables of the environment layouts seen
+   * so far, indexed by those offsets.
+   * A table that has been deleted is created again when needed.
+   */
+  std::map<std::vector<uint64_t>, WeakVH> environmentOffsetTables;
+
+  void notifyFunctionModified(Function *f);
+
+  Value *computeOffsetOfExitVariable(IRBuilder<> &builder,
+                                     Value *envIndexForExitVariable,
+                                     const LoopEnvironmentLayout *envLayout);
 };
 
 } // namespace arcana::noelle
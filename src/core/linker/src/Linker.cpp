@@ -24,11 +24,91 @@
 
 namespace arcana::noelle {
 
-Linker::Linker(Module &M, TypesManager *tm) : program{ M }, tm{ tm } {
+Linker::Linker(Module &M, TypesManager *tm)
+  : program{ M },
+    tm{ tm },
+    functionModified{} {
 
   return;
 }
 
+void Linker::setFunctionModifiedCallback(
+    std::function<void(Function *)> callback) {
+  this->functionModified = callback;
+
+  return;
+}
+
+void Linker::notifyFunctionModified(Function *f) {
+  if (this->functionModified) {
+    this->functionModified(f);
+  }
+
+  return;
+}
+
+Value *Linker::computeOffsetOfExitVariable(
+    IRBuilder<> &builder,
+    Value *envIndexForExitVariable,
+    const LoopEnvironmentLayout *envLayout) {
+
+  /*
+   * Without a layout, the variable with index "i" starts the cache line "i".
+   */
+  if (envLayout == nullptr) {
+    auto valuesInCacheLine =
+        Architecture::getCacheLineBytes() / sizeof(int64_t);
+    auto int64 = this->tm->getIntegerType(64);
+    return builder.CreateMul(envIndexForExitVariable,
+                             ConstantInt::get(int64, valuesInCacheLine));
+  }
+
+  /*
+   * A packed layout is not linear in the index.
+   * Check if the index is known at compile time.
+   */
+  auto indexType = envIndexForExitVariable->getType();
+  if (auto envIndex = dyn_cast<ConstantInt>(envIndexForExitVariable)) {
+    auto offset = envLayout->getOffsetOfVariable(envIndex->getZExtValue());
+    return ConstantInt::get(indexType, offset);
+  }
+
+  /*
+   * The index is only known at run time.
+   * Look its offset up in a table with the offsets of all variables.
+   * Layouts with the same offsets share the same table.
+   */
+  auto int64 = this->tm->getIntegerType(64);
+  std::vector<uint64_t> offsets;
+  for (auto i = 0u; i < envLayout->getNumberOfVariables(); i++) {
+    offsets.push_back(envLayout->getOffsetOfVariable(i));
+  }
+  auto tableType = ArrayType::get(int64, offsets.size());
+  auto &cachedTable = this->environmentOffsetTables[offsets];
+  if (cachedTable == nullptr) {
+    std::vector<Constant *> offsetConstants;
+    for (auto offset : offsets) {
+      offsetConstants.push_back(ConstantInt::get(int64, offset));
+    }
+    cachedTable =
+        new GlobalVariable(this->program,
+                           tableType,
+                           true,
+                           GlobalValue::PrivateLinkage,
+                           ConstantArray::get(tableType, offsetConstants),
+                           "noelle.environment_offsets");
+  }
+  auto table = cast<GlobalVariable>(cachedTable);
+  auto envIndex = builder.CreateZExtOrTrunc(envIndexForExitVariable, int64);
+  auto offsetPtr = builder.CreateInBoundsGEP(
+      tableType,
+      table,
+      ArrayRef<Value *>({ ConstantInt::get(int64, 0), envIndex }));
+  auto offset = builder.CreateLoad(int64, offsetPtr);
+
+  return builder.CreateZExtOrTrunc(offset, indexType);
+}
+
 void Linker::linkTransformedLoopToOriginalFunction(
     BasicBlock *originalPreHeader,
     BasicBlock *startOfParLoopInOriginalFunc,
@@ -36,7 +116,8 @@ void Linker::linkTransformedLoopToOriginalFunction(
     Value *envArray,
     Value *envIndexForExitVariable,
     std::vector<BasicBlock *> &loopExitBlocks,
-    uint32_t minIdleCores) {
+    uint32_t minIdleCores,
+    const LoopEnvironmentLayout *envLayout) {
 
   /*
    * Fetch the runtime API to invoke.
@@ -83,20 +164,16 @@ void Linker::linkTransformedLoopToOriginalFunction(
 
   } else {
 
-    /*
-     * Compute how many values can fit in a cache line.
-     */
-    auto valuesInCacheLine =
-        Architecture::getCacheLineBytes() / sizeof(int64_t);
-
     auto int64 = this->tm->getIntegerType(64);
+    auto exitEnvOffset =
+        this->computeOffsetOfExitVariable(endBuilder,
+                                          envIndexForExitVariable,
+                                          envLayout);
     auto exitEnvPtr = endBuilder.CreateGEP(
         envArray->getType()->getPointerElementType(),
         envArray,
-        ArrayRef<Value *>({ cast<Value>(ConstantInt::get(int64, 0)),
-                            endBuilder.CreateMul(
-                                envIndexForExitVariable,
-                                ConstantInt::get(int64, valuesInCacheLine)) }));
+        ArrayRef<Value *>(
+            { cast<Value>(ConstantInt::get(int64, 0)), exitEnvOffset }));
     auto newLoad =
         endBuilder.CreateLoad(exitEnvPtr->getType()->getPointerElementType(),
                               exitEnvPtr);
@@ -131,6 +208,11 @@ void Linker::linkTransformedLoopToOriginalFunction(
     }
   }
 
+  /*
+   * Notify that the original function has been modified.
+   */
+  this->notifyFunctionModified(originalPreHeader->getParent());
+
   return;
 }
 
@@ -141,12 +223,14 @@ void Linker::substituteOriginalLoopWithTransformedLoop(
     Value *envArray,
     Value *envIndexForExitVariable,
     std::vector<BasicBlock *> &loopExitBlocks,
-    uint32_t minIdleCores) {
+    uint32_t minIdleCores,
+    const LoopEnvironmentLayout *envLayout) {
 
   /*
    * Fetch the terminator of the preheader.
    */
   auto originalPreHeader = originalLoop->getPreHeader();
+  auto originalFunction = originalPreHeader->getParent();
   auto originalTerminator = originalPreHeader->getTerminator();
 
   /*
@@ -171,20 +255,16 @@ void Linker::substituteOriginalLoopWithTransformedLoop(
 
   } else {
 
-    /*
-     * Compute how many values can fit in a cache line.
-     */
-    auto valuesInCacheLine =
-        Architecture::getCacheLineBytes() / sizeof(int64_t);
-
     auto int64 = this->tm->getIntegerType(64);
+    auto exitEnvOffset =
+        this->computeOffsetOfExitVariable(endBuilder,
+                                          envIndexForExitVariable,
+                                          envLayout);
     auto exitEnvPtr = endBuilder.CreateGEP(
         envArray->getType()->getPointerElementType(),
         envArray,
-        ArrayRef<Value *>({ cast<Value>(ConstantInt::get(int64, 0)),
-                            endBuilder.CreateMul(
-                                envIndexForExitVariable,
-                                ConstantInt::get(int64, valuesInCacheLine)) }));
+        ArrayRef<Value *>(
+            { cast<Value>(ConstantInt::get(int64, 0)), exitEnvOffset }));
     auto integerType = this->tm->getIntegerType(32);
     auto newLoad =
         endBuilder.CreateLoad(exitEnvPtr->getType()->getPointerElementType(),
@@ -223,6 +303,11 @@ void Linker::substituteOriginalLoopWithTransformedLoop(
     bb->eraseFromParent();
   }
 
+  /*
+   * Notify that the original function has been modified.
+   */
+  this->notifyFunctionModified(originalFunction);
+
   return;
 }
 
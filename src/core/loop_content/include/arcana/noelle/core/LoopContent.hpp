@@ -139,8 +139,33 @@ public:
   bool iterateOverSubLoopsRecursively(
       std::function<bool(const LoopStructure &child)> funcToInvoke);
 
+  /*
+   * Set how the ScalarEvolution and LoopInfo of the function that includes
+   * the loop are fetched when the induction variables and the iteration space
+   * of the loop are computed.
+   * By default, the ScalarEvolution and the loop given to the constructor are
+   * used; they must then be alive when these are first requested.
+   */
+  void setLLVMAnalysesFetchers(
+      std::function<ScalarEvolution &(Function &F)> getSCEV,
+      std::function<LoopInfo &(Function &F)> getLoopInfo);
+
+  /*
+   * Return the induction variables of the loop.
+   * The environment, the invariants, the induction variables, and the
+   * iteration space of the loop are computed the first time they are
+   * requested, from the loop dependence graph and the dominators captured when
+   * "this" was built. Hence, request them before modifying the IR of the
+   * loop, or build a new LoopContent after.
+   */
   InductionVariableManager *getInductionVariableManager(void) const;
 
+  /*
+   * Return the attributes of the SCCs of the loop.
+   * They are computed the first time they are requested, and they are
+   * computed again if the loop dependence graph has changed since (see
+   * DG::getVersion). In this case, the attributes returned before are freed.
+   */
   SCCDAGAttrs *getSCCManager(void) const;
 
   InvariantManager *getInvariantManager(void) const;
@@ -168,18 +193,20 @@ private:
    */
   LoopTree *loop;
 
-  LoopEnvironment *environment;
+  LDGGenerator &ldgGenerator;
+
+  mutable LoopEnvironment *environment;
 
   PDG *loopDG; /* Dependence graph of the loop.
                 * This graph does not include instructions outside the loop
                 * (i.e., no external dependences are included).
                 */
 
-  InductionVariableManager *inductionVariables;
+  mutable InductionVariableManager *inductionVariables;
 
-  InvariantManager *invariantManager;
+  mutable InvariantManager *invariantManager;
 
-  LoopIterationSpaceAnalysis *domainSpaceAnalysis;
+  mutable LoopIterationSpaceAnalysis *domainSpaceAnalysis;
 
   MemoryCloningAnalysis *memoryCloningAnalysis;
 
@@ -187,7 +214,25 @@ private:
 
   uint64_t tripCount;
 
-  SCCDAGAttrs *sccdagAttrs;
+  mutable PDG *loopInternalDG;
+
+  mutable SCCDAG *loopSCCDAG;
+
+  mutable SCCDAGAttrs *sccdagAttrs;
+
+  mutable uint64_t sccdagAttrsLDGVersion; /* Version of the loop dependence
+                                           * graph the SCCDAG attributes
+                                           * have been computed from.
+                                           */
+
+  std::shared_ptr<DominatorSummary> dominators; /* Dominators of the
+                                                 * function, shared by the
+                                                 * loops of the function.
+                                                 */
+
+  std::function<ScalarEvolution &(void)> fetchSCEV;
+
+  std::function<Loop *(void)> fetchLLVMLoop;
 
   LoopTransformationsManager *loopTransformationsManager;
 
@@ -198,13 +243,17 @@ private:
    */
   void fetchLoopAndBBInfo(Loop *l, ScalarEvolution &SE);
 
-  std::pair<PDG *, SCCDAG *> createDGsForLoop(LDGGenerator &ldgGenerator,
-                                              CompilationOptionsManager *com,
-                                              Loop *l,
-                                              LoopTree *loopNode,
-                                              PDG *functionDG,
-                                              DominatorSummary &DS,
-                                              ScalarEvolution &SE);
+  PDG *createDGForLoop(LDGGenerator &ldgGenerator,
+                       CompilationOptionsManager *com,
+                       Loop *l,
+                       LoopTree *loopNode,
+                       PDG *functionDG,
+                       DominatorSummary &DS,
+                       ScalarEvolution &SE);
+
+  void computeSCCDAGAttrs(void) const;
+
+  void freeSCCDAGAttrs(void) const;
 
   uint64_t computeTripCounts(Loop *l, ScalarEvolution &SE);
 
@@ -64,9 +64,28 @@ public:
   std::unordered_set<LoopContentOptimization> getOptimizationsEnabled(
       void) const;
 
+  /*
+   * How the private copies of reduced variables are combined.
+   * A LoopEnvironmentBuilder built from "this" uses it.
+   */
+  ReductionStrategy getReductionStrategy(void) const;
+
+  void setReductionStrategy(ReductionStrategy strategy);
+
+  /*
+   * Whether the read-only variables of the loop environment are packed next
+   * to each other (see LoopEnvironmentLayout).
+   * A LoopEnvironmentBuilder built from "this" uses it.
+   */
+  bool areReadOnlyVariablesPacked(void) const;
+
+  void setReadOnlyVariablesPacked(bool packed);
+
 private:
   uint32_t chunkSize;
   uint32_t maxCores;
+  ReductionStrategy reductionStrategy;
+  bool packReadOnlyVariables;
   std::set<Transformation>
       enabledTransformations; /* Transformations enabled. */
   std::unordered_set<LoopContentOptimization>
@@ -155,7 +155,16 @@ LoopContent::LoopContent(
     bool enableLoopAwareDependenceAnalyses,
     uint32_t chunkSize)
   : loop{ loopNode },
+    ldgGenerator{ ldgGenerator },
+    environment{ nullptr },
+    inductionVariables{ nullptr },
+    invariantManager{ nullptr },
+    domainSpaceAnalysis{ nullptr },
     memoryCloningAnalysis{ nullptr },
+    loopInternalDG{ nullptr },
+    loopSCCDAG{ nullptr },
+    sccdagAttrs{ nullptr },
+    sccdagAttrsLDGVersion{ 0 },
     com{ compilationOptionsManager } {
   assert(this->loop != nullptr);
 
@@ -181,98 +190,51 @@ LoopContent::LoopContent(
   this->loopTransformationsManager->enableAllTransformations();
 
   /*
-   * Fetch the loop dependence graph (i.e., the subset of the PDG that relates
-   * to the loop @l) and its SCCDAG.
+   * Set the layout of the loop environment.
    */
-  this->fetchLoopAndBBInfo(l, SE);
-  auto ls = this->getLoopStructure();
-  auto loopExitBlocks = ls->getLoopExitBasicBlocks();
-  auto DGs = this->createDGsForLoop(ldgGenerator,
-                                    compilationOptionsManager,
-                                    l,
-                                    loopNode,
-                                    fG,
-                                    DS,
-                                    SE);
-  this->loopDG = DGs.first;
-  auto loopSCCDAG = DGs.second;
+  this->loopTransformationsManager->setReadOnlyVariablesPacked(
+      this->com->shouldReadOnlyEnvironmentVariablesBePacked());
 
   /*
-   * Create the environment for the loop.
-   *
-   * Exclude stack objects that will be cloned. To do so, we need to collect
-   * this set of objects.
+   * Fetch the loop dependence graph (i.e., the subset of the PDG that relates
+   * to the loop @l).
    */
-  std::set<Value *> stackObjectsThatWillBeCloned;
-  if (this->memoryCloningAnalysis != nullptr) {
-    for (auto memObject :
-         this->memoryCloningAnalysis->getClonableMemoryObjects()) {
-
-      /*
-       * Check if the stack object needs to be initialized.
-       * If it does, then we need to have the original stack object as live-in.
-       */
-      if (memObject->doPrivateCopiesNeedToBeInitialized()) {
-        continue;
-      }
-
-      /*
-       * The stack object does not need to be initialized.
-       * So, we can avoid having the pointer to the original stack object as
-       * live-in.
-       */
-      auto stackObject = memObject->getAllocation();
-      stackObjectsThatWillBeCloned.insert(stackObject);
-    }
-  }
-  this->environment =
-      new LoopEnvironment(loopDG, loopExitBlocks, stackObjectsThatWillBeCloned);
+  this->fetchLoopAndBBInfo(l, SE);
+  this->loopDG = this->createDGForLoop(ldgGenerator,
+                                       compilationOptionsManager,
+                                       l,
+                                       loopNode,
+                                       fG,
+                                       DS,
+                                       SE);
 
   /*
-   * Create the invariant manager.
-   *
-   * This step identifies instructions that are loop invariants.
+   * The other abstractions of the loop are computed the first time they are
+   * requested.
+   * Keep the dominators as @DS is owned by the caller. The loops of a function
+   * share the same copy.
    */
-  auto topLoop = this->loop->getLoop();
-  this->invariantManager = new InvariantManager(topLoop, this->loopDG);
+  this->dominators = DS.getSharedCopy();
+  this->fetchSCEV = [&SE](void) -> ScalarEvolution & { return SE; };
+  this->fetchLLVMLoop = [l](void) -> Loop * { return l; };
 
-  /*
-   * Create the induction variable manager.
-   *
-   * This step identifies IVs.
-   *
-   * First, we need to compute the LDG that doesn't include memory dependences.
-   * Memory dependences don't matter for the IV detection.
-   * Then, we compute the SCCDAG of this sub-LDG.
-   * And then, we can identify IVs from this new SCCDAG.
-   */
-  auto loopSCCDAGWithoutMemoryDeps =
-      ldgGenerator.computeSCCDAGWithOnlyVariableAndControlDependences(loopDG);
-  this->inductionVariables =
-      new InductionVariableManager(this->loop,
-                                   *invariantManager,
-                                   SE,
-                                   *loopSCCDAGWithoutMemoryDeps,
-                                   *environment,
-                                   *l);
+  return;
+}
 
-  /*
-   * Calculate various attributes on SCCs
-   */
-  this->sccdagAttrs = new SCCDAGAttrs(
-      compilationOptionsManager->canFloatsBeConsideredRealNumbers(),
-      loopDG,
-      loopSCCDAG,
-      this->loop,
-      *inductionVariables,
-      DS);
-  this->domainSpaceAnalysis =
-      new LoopIterationSpaceAnalysis(this->loop, *this->inductionVariables, SE);
+void LoopContent::setLLVMAnalysesFetchers(
+    std::function<ScalarEvolution &(Function &F)> getSCEV,
+    std::function<LoopInfo &(Function &F)> getLoopInfo) {
+  auto ls = this->getLoopStructure();
+  auto f = ls->getFunction();
+  auto header = ls->getHeader();
 
-  /*
-   * Collect induction variable information
-   */
-  this->inductionVariables->getLoopGoverningInductionVariable(*topLoop);
+  this->fetchSCEV = [getSCEV, f](void) -> ScalarEvolution & {
+    return getSCEV(*f);
+  };
+  this->fetchLLVMLoop = [getLoopInfo, f, header](void) -> Loop * {
+    auto &LI = getLoopInfo(*f);
+    return LI.getLoopFor(header);
+  };
 
   return;
 }
@@ -322,14 +284,13 @@ uint64_t LoopContent::computeTripCounts(Loop *l, ScalarEvolution &SE) {
   return tripCount;
 }
 
-std::pair<PDG *, SCCDAG *> LoopContent::createDGsForLoop(
-    LDGGenerator &ldgGenerator,
-    CompilationOptionsManager *com,
-    Loop *l,
-    LoopTree *loopNode,
-    PDG *functionDG,
-    DominatorSummary &DS,
-    ScalarEvolution &SE) {
+PDG *LoopContent::createDGForLoop(LDGGenerator &ldgGenerator,
+                                  CompilationOptionsManager *com,
+                                  Loop *l,
+                                  LoopTree *loopNode,
+                                  PDG *functionDG,
+                                  DominatorSummary &DS,
+                                  ScalarEvolution &SE) {
 
   /*
    * Perform loop-aware memory dependence analysis to refine the loop dependence
@@ -362,15 +323,28 @@ std::pair<PDG *, SCCDAG *> LoopContent::createDGsForLoop(
                                                                       DS);
   }
 
+  return loopDG;
+}
+
+void LoopContent::computeSCCDAGAttrs(void) const {
+  assert(this->dominators != nullptr);
+
+  /*
+   * Free the attributes computed from a previous version of the loop
+   * dependence graph.
+   */
+  this->freeSCCDAGAttrs();
+
   /*
    * Build a SCCDAG of loop-internal instructions
    */
-  auto loopInternalDG = loopDG->clone(false);
-  auto loopSCCDAG = new SCCDAG(loopInternalDG);
+  this->loopInternalDG = this->loopDG->clone(false);
+  this->loopSCCDAG = new SCCDAG(this->loopInternalDG);
 
   /*
-   * Safety check: check that the SCCDAG includes all instructions of the loop
-   * given as input.
+   * Safety check: check that the SCCDAG includes all instructions of the loop.
+   * Since this runs on demand, this also catches loops whose IR has been
+   * modified after this LoopContent was built.
    */
 #ifdef DEBUG
 
@@ -378,13 +352,13 @@ std::pair<PDG *, SCCDAG *> LoopContent::createDGsForLoop(
    * Check that all loop instructions belong to LC-specific containers.
    */
   {
+    auto loopInternals = this->getLoopStructure()->getInstructions();
     int64_t numberOfInstructionsInLoop = 0;
-    for (auto bbIter : l->blocks()) {
-      for (auto &I : *bbIter) {
-        assert(std::find(loopInternals.begin(), loopInternals.end(), &I)
-               != loopInternals.end());
-        assert(loopInternalDG->isInternal(&I));
-        assert(loopSCCDAG->doesItContain(&I));
+    for (auto bb : this->getLoopStructure()->getBasicBlocks()) {
+      for (auto &I : *bb) {
+        assert(loopInternals.find(&I) != loopInternals.end());
+        assert(this->loopInternalDG->isInternal(&I));
+        assert(this->loopSCCDAG->doesItContain(&I));
         numberOfInstructionsInLoop++;
       }
     }
@@ -393,11 +367,36 @@ std::pair<PDG *, SCCDAG *> LoopContent::createDGsForLoop(
      * Check that all LC-specific containers include only loop instructions.
      */
     assert(loopInternals.size() == numberOfInstructionsInLoop);
-    assert(loopInternalDG->numNodes() == loopInternals.size());
+    assert(this->loopInternalDG->numNodes() == loopInternals.size());
   }
 #endif
 
-  return std::make_pair(loopDG, loopSCCDAG);
+  /*
+   * Calculate various attributes on SCCs
+   */
+  this->sccdagAttrs =
+      new SCCDAGAttrs(this->com->canFloatsBeConsideredRealNumbers(),
+                      this->com->getMaximumSizeOfArrayReductions(),
+                      this->loopDG,
+                      this->loopSCCDAG,
+                      this->loop,
+                      *this->getInductionVariableManager(),
+                      *this->dominators);
+
+  this->sccdagAttrsLDGVersion = this->loopDG->getVersion();
+
+  return;
+}
+
+void LoopContent::freeSCCDAGAttrs(void) const {
+  delete this->sccdagAttrs;
+  delete this->loopSCCDAG;
+  delete this->loopInternalDG;
+  this->sccdagAttrs = nullptr;
+  this->loopSCCDAG = nullptr;
+  this->loopInternalDG = nullptr;
+
+  return;
 }
 
 void LoopContent::removeUnnecessaryDependenciesWithThreadSafeLibraryFunctions(
@@ -597,7 +596,38 @@ LoopStructure *LoopContent::getNestedMostLoopStructure(Instruction *I) const {
 }
 
 InductionVariableManager *LoopContent::getInductionVariableManager(void) const {
-  return inductionVariables;
+  if (this->inductionVariables != nullptr) {
+    return this->inductionVariables;
+  }
+
+  /*
+   * Identify the induction variables.
+   *
+   * First, we need to compute the LDG that doesn't include memory dependences.
+   * Memory dependences don't matter for the IV detection.
+   * Then, we compute the SCCDAG of this sub-LDG.
+   * And then, we can identify IVs from this new SCCDAG.
+   */
+  auto loopSCCDAGWithoutMemoryDeps =
+      this->ldgGenerator.computeSCCDAGWithOnlyVariableAndControlDependences(
+          this->loopDG);
+  auto llvmLoop = this->fetchLLVMLoop();
+  assert(llvmLoop != nullptr);
+  this->inductionVariables =
+      new InductionVariableManager(this->loop,
+                                   *this->getInvariantManager(),
+                                   this->fetchSCEV(),
+                                   *loopSCCDAGWithoutMemoryDeps,
+                                   *this->getEnvironment(),
+                                   *llvmLoop);
+
+  /*
+   * Collect induction variable information
+   */
+  auto topLoop = this->getLoopStructure();
+  this->inductionVariables->getLoopGoverningInductionVariable(*topLoop);
+
+  return this->inductionVariables;
 }
 
 MemoryCloningAnalysis *LoopContent::getMemoryCloningAnalysis(void) const {
@@ -616,11 +646,30 @@ uint64_t LoopContent::getCompileTimeTripCount(void) const {
 }
 
 InvariantManager *LoopContent::getInvariantManager(void) const {
+  if (this->invariantManager == nullptr) {
+
+    /*
+     * Identify the instructions that are loop invariants.
+     */
+    auto topLoop = this->getLoopStructure();
+    this->invariantManager = new InvariantManager(topLoop, this->loopDG);
+  }
+
   return this->invariantManager;
 }
 
 LoopIterationSpaceAnalysis *LoopContent::getLoopIterationSpaceAnalysis(
     void) const {
+  if (this->domainSpaceAnalysis == nullptr) {
+
+    /*
+     * Compute the iteration space of the loop.
+     */
+    auto IVM = this->getInductionVariableManager();
+    this->domainSpaceAnalysis =
+        new LoopIterationSpaceAnalysis(this->loop, *IVM, this->fetchSCEV());
+  }
+
   return this->domainSpaceAnalysis;
 }
 
@@ -629,10 +678,57 @@ LoopTree *LoopContent::getLoopHierarchyStructures(void) const {
 }
 
 SCCDAGAttrs *LoopContent::getSCCManager(void) const {
+
+  /*
+   * Compute the attributes if they have not been computed yet, or if the
+   * loop dependence graph has changed since they have been computed.
+   */
+  if ((this->sccdagAttrs == nullptr)
+      || (this->sccdagAttrsLDGVersion != this->loopDG->getVersion())) {
+    this->computeSCCDAGAttrs();
+  }
+
   return this->sccdagAttrs;
 }
 
 LoopEnvironment *LoopContent::getEnvironment(void) const {
+  if (this->environment != nullptr) {
+    return this->environment;
+  }
+
+  /*
+   * Create the environment for the loop.
+   *
+   * Exclude stack objects that will be cloned. To do so, we need to collect
+   * this set of objects.
+   */
+  std::set<Value *> stackObjectsThatWillBeCloned;
+  if (this->memoryCloningAnalysis != nullptr) {
+    for (auto memObject :
+         this->memoryCloningAnalysis->getClonableMemoryObjects()) {
+
+      /*
+       * Check if the stack object needs to be initialized.
+       * If it does, then we need to have the original stack object as live-in.
+       */
+      if (memObject->doPrivateCopiesNeedToBeInitialized()) {
+        continue;
+      }
+
+      /*
+       * The stack object does not need to be initialized.
+       * So, we can avoid having the pointer to the original stack object as
+       * live-in.
+       */
+      auto stackObject = memObject->getAllocation();
+      stackObjectsThatWillBeCloned.insert(stackObject);
+    }
+  }
+  auto loopExitBlocks = this->getLoopStructure()->getLoopExitBasicBlocks();
+  this->environment = new LoopEnvironment(this->loopDG,
+                                          loopExitBlocks,
+                                          stackObjectsThatWillBeCloned);
+
   return this->environment;
 }
 
@@ -642,17 +738,14 @@ LoopTransformationsManager *LoopContent::getLoopTransformationsManager(
 }
 
 LoopContent::~LoopContent() {
-  delete this->loopDG;
-  delete this->environment;
-
-  if (this->inductionVariables) {
-    delete this->inductionVariables;
-  }
+  this->freeSCCDAGAttrs();
 
-  assert(this->invariantManager);
+  delete this->domainSpaceAnalysis;
+  delete this->inductionVariables;
   delete this->invariantManager;
+  delete this->environment;
 
-  delete this->domainSpaceAnalysis;
+  delete this->loopDG;
 
   return;
 }
@@ -30,6 +30,8 @@ LoopTransformationsManager::LoopTransformationsManager(
     bool enableLoopAwareDependenceAnalyses)
   : chunkSize{ chunkSize },
     maxCores{ maxNumberOfCores },
+    reductionStrategy{ LINEAR_REDUCTION },
+    packReadOnlyVariables{ false },
     enabledTransformations{},
     enabledOptimizations{ optimizations } {
 
@@ -40,6 +42,8 @@ LoopTransformationsManager::LoopTransformationsManager(
     const LoopTransformationsManager &other) {
   this->chunkSize = other.chunkSize;
   this->maxCores = other.maxCores;
+  this->reductionStrategy = other.reductionStrategy;
+  this->packReadOnlyVariables = other.packReadOnlyVariables;
   this->enabledTransformations = other.enabledTransformations;
 
   return;
@@ -89,4 +93,26 @@ std::unordered_set<LoopContentOptimization> LoopTransformationsManager::
   return this->enabledOptimizations;
 }
 
+ReductionStrategy LoopTransformationsManager::getReductionStrategy(
+    void) const {
+  return this->reductionStrategy;
+}
+
+void LoopTransformationsManager::setReductionStrategy(
+    ReductionStrategy strategy) {
+  this->reductionStrategy = strategy;
+
+  return;
+}
+
+bool LoopTransformationsManager::areReadOnlyVariablesPacked(void) const {
+  return this->packReadOnlyVariables;
+}
+
+void LoopTransformationsManager::setReadOnlyVariablesPacked(bool packed) {
+  this->packReadOnlyVariables = packed;
+
+  return;
+}
+
 } // namespace arcana::noelle
@@ -24,8 +24,14 @@
 
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/BinaryReductionSCC.hpp"
+#include "arcana/noelle/core/MinMaxReductionSCC.hpp"
+#include "arcana/noelle/core/ArgMinMaxReductionSCC.hpp"
+#include "arcana/noelle/core/ArrayReductionSCC.hpp"
 #include "arcana/noelle/core/LoopEnvironment.hpp"
+#include "arcana/noelle/core/LoopEnvironmentLayout.hpp"
 #include "arcana/noelle/core/LoopEnvironmentUser.hpp"
+#include "arcana/noelle/core/Transformations.hpp"
+#include "arcana/noelle/core/LoopTransformationsOptions.hpp"
 
 namespace arcana::noelle {
 
@@ -53,6 +59,21 @@ public:
       uint64_t reducerCount,
       uint64_t numberOfUsers);
 
+  /*
+   * Build the environment of a loop as selected by its transformation
+   * options @ltm: one private copy of each reduced variable per core, combined
+   * by the reduction strategy of the loop.
+   */
+  LoopEnvironmentBuilder(
+      LLVMContext &cxt,
+      LoopEnvironment *env,
+      std::function<bool(uint32_t variableID, bool isLiveOut)>
+          shouldThisVariableBeReduced,
+      std::function<bool(uint32_t variableID, bool isLiveOut)>
+          shouldThisVariableBeSkipped,
+      const LoopTransformationsManager &ltm,
+      uint64_t numberOfUsers);
+
   LoopEnvironmentBuilder(LLVMContext &CXT,
                          const std::vector<Type *> &varTypes,
                          const std::set<uint32_t> &singleVarIDs,
@@ -64,6 +85,14 @@ public:
 
   virtual void addVariableToEnvironment(uint64_t varID, Type *varType);
 
+  /*
+   * Pack the live-ins that are only read by the users of the environment at
+   * the beginning of the environment array.
+   * This must be selected before the array is allocated.
+   */
+  virtual void setReadOnlyVariablesPacked(bool packed);
+  virtual const LoopEnvironmentLayout &getLayout(void) const;
+
   /*
    * Generate code to create environment array/variable allocations
    */
@@ -72,8 +101,21 @@ public:
 
   /*
    * Reduce live out variables given binary operators to reduce
-   * with and initial values to start at
+   * with and initial values to start at.
+   *
+   * The private copies are combined as selected by setReductionStrategy:
+   * - LINEAR_REDUCTION emits a loop that accumulates one copy per iteration.
+   * - TREE_REDUCTION emits straight-line code that combines the copies
+   *   pairwise, level by level, so the combining tree has log depth.
+   *
+   * Binary and min/max reductions are combined by their operation.
+   * The index of a min/max (e.g., argmin) is combined by selecting the copy
+   * with the best min/max and, on ties, the earliest iteration; its min/max
+   * must be part of @reductions.
    */
+  virtual void setReductionStrategy(ReductionStrategy strategy);
+  virtual ReductionStrategy getReductionStrategy(void) const;
+
   virtual BasicBlock *reduceLiveOutVariables(
       BasicBlock *bb,
       IRBuilder<> &builder,
@@ -81,6 +123,51 @@ public:
       Value *numberOfThreadsExecuted,
       std::function<Value *(ReductionSCC *scc)> castingInitialValue);
 
+  virtual BasicBlock *reduceLiveOutVariables(
+      BasicBlock *bb,
+      IRBuilder<> &builder,
+      const std::unordered_map<uint32_t, ReductionSCC *> &reductions,
+      Value *numberOfThreadsExecuted,
+      std::function<Value *(ReductionSCC *scc)> castingInitialValue);
+
+  /*
+   * Privatize the array reduced by @red: allocate one copy of it per reducer.
+   * Every copy starts at a cache line boundary, so reducers do not share
+   * cache lines.
+   * The copies are allocated on the heap, as they can be large; reduceArrays
+   * releases them.
+   */
+  virtual Value *allocatePrivateCopiesOfArray(IRBuilder<> &builder,
+                                              ArrayReductionSCC *red);
+  virtual Value *getPrivateCopiesOfArray(ArrayReductionSCC *red) const;
+
+  /*
+   * Return the private copy of the reducer @reducerIndex out of
+   * @privateCopies.
+   * It has the type of the original array, so it can replace it.
+   */
+  virtual Value *fetchPrivateCopyOfArray(IRBuilder<> &builder,
+                                         Value *privateCopies,
+                                         Value *reducerIndex) const;
+
+  /*
+   * Set all elements of @privateCopy to the identity of @red.
+   * The code is appended to @bb; the basic block after it is returned.
+   */
+  virtual BasicBlock *initializePrivateCopyOfArray(BasicBlock *bb,
+                                                   ArrayReductionSCC *red,
+                                                   Value *privateCopy);
+
+  /*
+   * Combine the private copies of the reducers that ran into the original
+   * arrays, element by element, and release the private copies.
+   * The code is appended to @bb; the basic block after it is returned.
+   */
+  virtual BasicBlock *reduceArrays(
+      BasicBlock *bb,
+      const std::vector<ArrayReductionSCC *> &reductions,
+      Value *numberOfThreadsExecuted);
+
   /*
    * As all users of the environment know its structure, pass around the
    * equivalent of a void pointer
@@ -127,6 +214,19 @@ protected:
   std::unordered_map<uint32_t, std::vector<Value *>> envIndexToReducableVar;
   std::unordered_map<uint32_t, AllocaInst *> envIndexToVectorOfReducableVar;
   uint64_t numReducers;
+  ReductionStrategy reductionStrategy;
+
+  /*
+   * The private copies of the arrays that are reduced
+   */
+  std::unordered_map<ArrayReductionSCC *, Value *> arrayToPrivateCopies;
+
+  /*
+   * The placement of the variables within the environment array, and the
+   * environment IDs of the variables that users only read.
+   */
+  LoopEnvironmentLayout layout;
+  std::set<uint32_t> readOnlyVarIDs;
 
   /*
    * Information on a specific user (a function, stage, chunk, etc...)
@@ -140,6 +240,64 @@ protected:
                                  uint64_t numberOfUsers);
 
   virtual void createUsers(uint32_t numUsers);
+
+  virtual BasicBlock *reduceLiveOutVariablesWithATree(
+      BasicBlock *bb,
+      const std::unordered_map<uint32_t, ReductionSCC *> &reductions,
+      Value *numberOfThreadsExecuted,
+      std::function<Value *(ReductionSCC *scc)> castingInitialValue);
+
+  /*
+   * Combine the private copy of a binary or min/max reduction with the value
+   * accumulated so far.
+   */
+  virtual Value *generateReductionOperation(IRBuilder<> &builder,
+                                            ReductionSCC *red,
+                                            Value *accumulatedValue,
+                                            Value *privateCopy);
+
+  /*
+   * Select the index of the private copy of an argmin/argmax reduction if its
+   * min/max is better than the accumulated one, or equal to it and reached
+   * at an earlier iteration.
+   * When @initialMinMax is given, ties are ignored while the accumulated
+   * min/max is still the initial one: its index refers to the iteration
+   * before the loop.
+   */
+  virtual Value *generateArgMinMaxSelection(IRBuilder<> &builder,
+                                            ArgMinMaxReductionSCC *red,
+                                            Value *accumulatedMinMax,
+                                            Value *accumulatedIndex,
+                                            Value *privateMinMax,
+                                            Value *privateIndex,
+                                            Value *initialMinMax);
+
+  /*
+   * Append to @bb a loop that executes @tripCount times, which must be at least
+   * one.
+   * @generateBody receives the first basic block of the body and the current
+   * iteration, and it returns the last basic block of the body.
+   */
+  BasicBlock *generateCountedLoop(
+      BasicBlock *bb,
+      Value *tripCount,
+      std::function<BasicBlock *(BasicBlock *bodyBB, Value *iteration)>
+          generateBody);
+
+  /*
+   * Return the pointer to the element @elementIndex of @array once flattened.
+   */
+  Value *fetchElementOfArray(IRBuilder<> &builder,
+                             ArrayReductionSCC *red,
+                             Value *array,
+                             Value *elementIndex) const;
+
+  /*
+   * Map the environment ID of every argmin/argmax reduction to the one of its
+   * min/max.
+   */
+  std::unordered_map<uint32_t, uint32_t> pairArgMinMaxReductions(
+      const std::unordered_map<uint32_t, ReductionSCC *> &reductions) const;
 };
 
 } // namespace arcana::noelle
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_LOOP_ENVIRONMENT_LOOPENVIRONMENTLAYOUT_H_
+#define NOELLE_SRC_CORE_LOOP_ENVIRONMENT_LOOPENVIRONMENTLAYOUT_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Placement of the variables of a loop environment within the environment
+ * array, which is an array of 64-bit words.
+ *
+ * By default every variable has its own cache line, which avoids false
+ * sharing between the users of the environment.
+ * When read-only variables are packed, they are stored next to each other at
+ * the beginning of the array, and only the other variables (e.g., live-outs
+ * and reductions) keep a cache line each.
+ */
+class LoopEnvironmentLayout {
+public:
+  LoopEnvironmentLayout();
+
+  /*
+   * Append the variable with the next index.
+   * A variable is read-only if the users of the environment never store to
+   * it, and if it fits in a word.
+   */
+  void addVariable(bool isReadOnly);
+
+  void setReadOnlyVariablesPacked(bool packed);
+
+  bool areReadOnlyVariablesPacked(void) const;
+
+  bool isPacked(uint32_t envIndex) const;
+
+  /*
+   * Offset of a variable from the beginning of the array, in words.
+   */
+  uint64_t getOffsetOfVariable(uint32_t envIndex) const;
+
+  /*
+   * Number of words of the array.
+   */
+  uint64_t getSize(void) const;
+
+  uint32_t getNumberOfVariables(void) const;
+
+  static uint64_t getWordsInCacheLine(void);
+
+  static bool fitsInAWord(Type *type);
+
+private:
+  bool packReadOnlyVariables;
+  std::vector<bool> readOnly;
+  std::vector<uint64_t> offsets;
+  uint64_t size;
+
+  void computeOffsets(void);
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_LOOP_ENVIRONMENT_LOOPENVIRONMENTLAYOUT_H_
@@ -23,13 +23,20 @@
 #define NOELLE_SRC_CORE_LOOP_ENVIRONMENT_LOOPENVIRONMENTUSER_H_
 
 #include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/LoopEnvironmentLayout.hpp"
 
 namespace arcana::noelle {
 
 class LoopEnvironmentUser {
 public:
+  /*
+   * Without a layout, the variable with index "i" starts the cache line "i".
+   */
   LoopEnvironmentUser(std::unordered_map<uint32_t, uint32_t> &envIDToIndex);
 
+  LoopEnvironmentUser(std::unordered_map<uint32_t, uint32_t> &envIDToIndex,
+                      const LoopEnvironmentLayout &layout);
+
   LoopEnvironmentUser() = delete;
 
   virtual void setEnvironmentArray(Value *envArr);
@@ -68,6 +75,9 @@ protected:
   std::set<uint32_t> liveInIDs;
   std::set<uint32_t> liveOutIDs;
   std::unordered_map<uint32_t, uint32_t> &envIDToIndex;
+  const LoopEnvironmentLayout *layout;
+
+  uint64_t getOffsetOfVariable(uint32_t envIndex) const;
 };
 
 } // namespace arcana::noelle
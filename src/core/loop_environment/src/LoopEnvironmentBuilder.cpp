@@ -81,6 +81,7 @@ LoopEnvironmentBuilder::LoopEnvironmentBuilder(
       reducableVars.insert(liveInVariableID);
     } else {
       nonReducableVars.insert(liveInVariableID);
+      this->readOnlyVarIDs.insert(liveInVariableID);
     }
   }
   for (auto liveOutVariableID : environment->getEnvIDsOfLiveOutVars()) {
@@ -113,6 +114,27 @@ LoopEnvironmentBuilder::LoopEnvironmentBuilder(
   return;
 }
 
+LoopEnvironmentBuilder::LoopEnvironmentBuilder(
+    LLVMContext &cxt,
+    LoopEnvironment *environment,
+    std::function<bool(uint32_t variableID, bool isLiveOut)>
+        shouldThisVariableBeReduced,
+    std::function<bool(uint32_t variableID, bool isLiveOut)>
+        shouldThisVariableBeSkipped,
+    const LoopTransformationsManager &ltm,
+    uint64_t numberOfUsers)
+  : LoopEnvironmentBuilder(cxt,
+                           environment,
+                           shouldThisVariableBeReduced,
+                           shouldThisVariableBeSkipped,
+                           ltm.getMaximumNumberOfCores(),
+                           numberOfUsers) {
+  this->reductionStrategy = ltm.getReductionStrategy();
+  this->setReadOnlyVariablesPacked(ltm.areReadOnlyVariablesPacked());
+
+  return;
+}
+
 LoopEnvironmentBuilder::LoopEnvironmentBuilder(
     LLVMContext &cxt,
     const std::vector<Type *> &varTypes,
@@ -164,6 +186,7 @@ void LoopEnvironmentBuilder::initializeBuilder(
   this->envSize = singleVarIDs.size() + reducableVarIDs.size();
   this->envArrayType = nullptr;
   this->numReducers = reducerCount;
+  this->reductionStrategy = LINEAR_REDUCTION;
 
   /*
    * Build up partial/all environment types array based on envSize
@@ -176,15 +199,22 @@ void LoopEnvironmentBuilder::initializeBuilder(
          && "Environment variables must either be singular or reducible\n");
 
   /*
-   * Compute how many values can fit in a cache line.
+   * Place the variables within the environment array.
+   * Only variables that fit in a word can be packed.
    */
-  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
+  for (uint32_t i = 0; i < this->envSize; i++) {
+    auto varID = this->indexToEnvID[i];
+    auto isReadOnly =
+        (this->readOnlyVarIDs.find(varID) != this->readOnlyVarIDs.end())
+        && LoopEnvironmentLayout::fitsInAWord(this->envTypes[i]);
+    this->layout.addVariable(isReadOnly);
+  }
 
   /*
    * Define the LLVM type for the array of environment values.
    */
   auto int64 = IntegerType::get(this->CXT, 64);
-  this->envArrayType = ArrayType::get(int64, this->envSize * valuesInCacheLine);
+  this->envArrayType = ArrayType::get(int64, this->layout.getSize());
 
   /*
    * Initialize the index-to-variable map.
@@ -208,7 +238,8 @@ void LoopEnvironmentBuilder::initializeBuilder(
 
 void LoopEnvironmentBuilder::createUsers(uint32_t numUsers) {
   for (auto i = 0u; i < numUsers; ++i) {
-    this->envUsers.push_back(new LoopEnvironmentUser(this->envIDToIndex));
+    this->envUsers.push_back(
+        new LoopEnvironmentUser(this->envIDToIndex, this->layout));
   }
 
   return;
@@ -235,15 +266,15 @@ void LoopEnvironmentBuilder::addVariableToEnvironment(uint64_t varID,
   this->envTypes.push_back(varType);
 
   /*
-   * Compute how many values can fit in a cache line.
+   * Users might store to the new variable, so it keeps its own cache line.
    */
-  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
+  this->layout.addVariable(false);
 
   /*
    * Define the LLVM type for the array of environment values.
    */
   auto int64 = IntegerType::get(this->CXT, 64);
-  this->envArrayType = ArrayType::get(int64, this->envSize * valuesInCacheLine);
+  this->envArrayType = ArrayType::get(int64, this->layout.getSize());
 
   /*
    * Set the index-to-var map for the new variable.
@@ -254,6 +285,21 @@ void LoopEnvironmentBuilder::addVariableToEnvironment(uint64_t varID,
   return;
 }
 
+void LoopEnvironmentBuilder::setReadOnlyVariablesPacked(bool packed) {
+  assert(this->envArray == nullptr
+         && "The layout cannot change after the environment is allocated\n");
+
+  this->layout.setReadOnlyVariablesPacked(packed);
+  auto int64 = IntegerType::get(this->CXT, 64);
+  this->envArrayType = ArrayType::get(int64, this->layout.getSize());
+
+  return;
+}
+
+const LoopEnvironmentLayout &LoopEnvironmentBuilder::getLayout(void) const {
+  return this->layout;
+}
+
 void LoopEnvironmentBuilder::allocateEnvironmentArray(IRBuilder<> &builder) {
 
   /*
@@ -289,21 +335,11 @@ void LoopEnvironmentBuilder::generateEnvVariables(IRBuilder<> &builder) {
   auto int64 = IntegerType::get(builder.getContext(), 64);
   auto zeroV = cast<Value>(ConstantInt::get(int64, 0));
   auto fetchCastedEnvPtr =
-      [&](Value *arr, uint32_t envIndex, Type *ptrType) -> Value * {
+      [&](Value *arr, uint64_t offset, Type *ptrType) -> Value * {
     /*
-     * Compute the offset of the variable with index "envIndex" that is stored
-     * inside the environment.
-     *
-     * Compute how many values can fit in a cache line.
-     */
-    auto valuesInCacheLine =
-        Architecture::getCacheLineBytes() / sizeof(int64_t);
-    auto indValue =
-        cast<Value>(ConstantInt::get(int64, envIndex * valuesInCacheLine));
-
-    /*
-     * Compute the address of the variable with index "envIndex".
+     * Compute the address of the word at "offset".
      */
+    auto indValue = cast<Value>(ConstantInt::get(int64, offset));
     auto envPtr = builder.CreateGEP(arr->getType()->getPointerElementType(),
                                     arr,
                                     ArrayRef<Value *>({ zeroV, indValue }));
@@ -328,8 +364,9 @@ void LoopEnvironmentBuilder::generateEnvVariables(IRBuilder<> &builder) {
   }
   for (auto envIndex : singleIndices) {
     auto ptrType = PointerType::getUnqual(this->envTypes[envIndex]);
+    auto offset = this->layout.getOffsetOfVariable(envIndex);
     this->envIndexToVar[envIndex] =
-        fetchCastedEnvPtr(this->envArray, envIndex, ptrType);
+        fetchCastedEnvPtr(this->envArray, offset, ptrType);
   }
 
   /*
@@ -374,14 +411,17 @@ void LoopEnvironmentBuilder::generateEnvVariables(IRBuilder<> &builder) {
      * environment.
      */
     auto reduceArrPtrType = PointerType::getUnqual(reduceArrAlloca->getType());
-    auto envPtr = fetchCastedEnvPtr(this->envArray, envIndex, reduceArrPtrType);
+    auto envPtr = fetchCastedEnvPtr(this->envArray,
+                                    this->layout.getOffsetOfVariable(envIndex),
+                                    reduceArrPtrType);
     builder.CreateStore(reduceArrAlloca, envPtr);
 
     /*
      * Compute and cache the pointer of each element of the vectorized variable.
      */
     for (auto i = 0u; i < this->numReducers; ++i) {
-      auto reducePtr = fetchCastedEnvPtr(reduceArrAlloca, i, ptrType);
+      auto reducePtr =
+          fetchCastedEnvPtr(reduceArrAlloca, i * valuesInCacheLine, ptrType);
       this->envIndexToReducableVar[envIndex].push_back(reducePtr);
     }
   }
@@ -395,6 +435,23 @@ BasicBlock *LoopEnvironmentBuilder::reduceLiveOutVariables(
     const std::unordered_map<uint32_t, BinaryReductionSCC *> &reductions,
     Value *numberOfThreadsExecuted,
     std::function<Value *(ReductionSCC *scc)> castingInitialValue) {
+  std::unordered_map<uint32_t, ReductionSCC *> genericReductions(
+      reductions.begin(),
+      reductions.end());
+
+  return this->reduceLiveOutVariables(bb,
+                                      builder,
+                                      genericReductions,
+                                      numberOfThreadsExecuted,
+                                      castingInitialValue);
+}
+
+BasicBlock *LoopEnvironmentBuilder::reduceLiveOutVariables(
+    BasicBlock *bb,
+    IRBuilder<> &builder,
+    const std::unordered_map<uint32_t, ReductionSCC *> &reductions,
+    Value *numberOfThreadsExecuted,
+    std::function<Value *(ReductionSCC *scc)> castingInitialValue) {
   assert(bb != nullptr);
 
   /*
@@ -404,6 +461,16 @@ BasicBlock *LoopEnvironmentBuilder::reduceLiveOutVariables(
     return bb;
   }
 
+  /*
+   * Check if the private copies should be combined by a tree.
+   */
+  if (this->reductionStrategy == TREE_REDUCTION) {
+    return this->reduceLiveOutVariablesWithATree(bb,
+                                                 reductions,
+                                                 numberOfThreadsExecuted,
+                                                 castingInitialValue);
+  }
+
   /*
    * Fetch the function that "bb" belongs to.
    */
@@ -528,7 +595,17 @@ BasicBlock *LoopEnvironmentBuilder::reduceLiveOutVariables(
 
   /*
    * Accumulate values to the appropriate accumulators.
+   *
+   * The index of a min/max needs the accumulator and the private copy of the
+   * min/max, so keep track of where they are.
    */
+  auto argMinMaxPairs = this->pairArgMinMaxReductions(reductions);
+  std::unordered_map<uint32_t, uint32_t> positionOfReduction;
+  count = 0;
+  for (auto envIDInitValue : reductions) {
+    positionOfReduction[envIDInitValue.first] = count;
+    count++;
+  }
   count = 0;
   for (auto envIDInitValue : reductions) {
     auto envID = envIDInitValue.first;
@@ -539,7 +616,6 @@ BasicBlock *LoopEnvironmentBuilder::reduceLiveOutVariables(
      * values.
      */
     auto red = reductions.at(envID);
-    auto binOp = red->getReductionOperation();
 
     /*
      * Fetch the accumulator, which is the PHI node related to the current
@@ -551,8 +627,25 @@ BasicBlock *LoopEnvironmentBuilder::reduceLiveOutVariables(
      * Accumulate values to the accumulator of the current reduced variable.
      */
     auto privateCurrentCopy = loadedValues[count];
-    auto newAccumulatorValue =
-        loopBodyBuilder.CreateBinOp(binOp, accumVal, privateCurrentCopy);
+    Value *newAccumulatorValue = nullptr;
+    if (auto argMinMax = dyn_cast<ArgMinMaxReductionSCC>(red)) {
+      auto minMaxPosition = positionOfReduction.at(argMinMaxPairs.at(envID));
+      auto minMaxAccumVal = phiNodes[minMaxPosition];
+      newAccumulatorValue = this->generateArgMinMaxSelection(
+          loopBodyBuilder,
+          argMinMax,
+          minMaxAccumVal,
+          accumVal,
+          loadedValues[minMaxPosition],
+          privateCurrentCopy,
+          minMaxAccumVal->getIncomingValueForBlock(bb));
+    } else {
+      newAccumulatorValue =
+          this->generateReductionOperation(loopBodyBuilder,
+                                           red,
+                                           accumVal,
+                                           privateCurrentCopy);
+    }
 
     /*
      * Keep track of the new accumulator value.
@@ -615,6 +708,512 @@ BasicBlock *LoopEnvironmentBuilder::reduceLiveOutVariables(
   return afterReductionBB;
 }
 
+BasicBlock *LoopEnvironmentBuilder::reduceLiveOutVariablesWithATree(
+    BasicBlock *bb,
+    const std::unordered_map<uint32_t, ReductionSCC *> &reductions,
+    Value *numberOfThreadsExecuted,
+    std::function<Value *(ReductionSCC *scc)> castingInitialValue) {
+
+  /*
+   * Fetch the function that "bb" belongs to.
+   */
+  auto f = bb->getParent();
+  assert(f != nullptr);
+
+  /*
+   * Create the basic block that will combine the private copies and the one
+   * that will include the code after the reduction.
+   */
+  auto treeBB = BasicBlock::Create(this->CXT, "ReductionTree", f);
+  auto afterReductionBB = BasicBlock::Create(this->CXT, "AfterReduction", f);
+
+  /*
+   * Change the successor of "bb" to be "treeBB".
+   */
+  auto bbTerminator = bb->getTerminator();
+  if (bbTerminator != nullptr) {
+    bbTerminator->eraseFromParent();
+  }
+  IRBuilder<> bbBuilder{ bb };
+  bbBuilder.CreateBr(treeBB);
+
+  /*
+   * Compute how many values can fit in a cache line.
+   */
+  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
+
+  /*
+   * Load the private copies of all reducers.
+   * A reducer that did not run never initialized its copy, so the copy of the
+   * first reducer, which always runs, is loaded in its place. The value
+   * loaded for such a reducer is then dropped while combining the copies.
+   */
+  IRBuilder<> treeBuilder{ treeBB };
+  auto int64 = IntegerType::get(this->CXT, 64);
+  auto zeroV = cast<Value>(ConstantInt::get(int64, 0));
+  auto threadsType = numberOfThreadsExecuted->getType();
+  std::unordered_map<uint32_t, std::vector<Value *>> partialValuesOf;
+  for (auto envIDReduction : reductions) {
+    auto envID = envIDReduction.first;
+    auto envIndex = this->envIDToIndex[envID];
+    auto varType = envTypes[envIndex];
+    auto ptrType = PointerType::getUnqual(varType);
+
+    auto baseAddressOfReducedVar =
+        this->envIndexToVectorOfReducableVar.at(envIndex);
+    auto &partialValues = partialValuesOf[envID];
+    Value *addressOfFirstCopy = nullptr;
+    for (auto i = 0u; i < this->numReducers; i++) {
+      auto offsetValue = ConstantInt::get(int64, i * valuesInCacheLine);
+      auto effectiveAddressOfReducedVar = treeBuilder.CreateGEP(
+          baseAddressOfReducedVar->getType()->getPointerElementType(),
+          baseAddressOfReducedVar,
+          ArrayRef<Value *>({ zeroV, offsetValue }));
+      Value *effectiveAddressOfReducedVarProperlyCasted =
+          treeBuilder.CreateBitCast(effectiveAddressOfReducedVar, ptrType);
+      if (i == 0) {
+        addressOfFirstCopy = effectiveAddressOfReducedVarProperlyCasted;
+      } else {
+        auto reducerID = ConstantInt::get(threadsType, i);
+        auto hasRun =
+            treeBuilder.CreateICmpSLT(reducerID, numberOfThreadsExecuted);
+        effectiveAddressOfReducedVarProperlyCasted =
+            treeBuilder.CreateSelect(hasRun,
+                                     effectiveAddressOfReducedVarProperlyCasted,
+                                     addressOfFirstCopy);
+      }
+      auto privateCopy =
+          treeBuilder.CreateLoad(varType,
+                                 effectiveAddressOfReducedVarProperlyCasted);
+      partialValues.push_back(privateCopy);
+    }
+  }
+
+  /*
+   * Combine the copies pairwise.
+   * At each level, the partial value at "i" absorbs the one at
+   * "i + stride" only if the reducer "i + stride" ran.
+   * The copy of the first reducer is always used, as in the linear loop.
+   *
+   * The index of a min/max reads the partial values of the min/max, so all
+   * variables are combined before any partial value is replaced.
+   */
+  auto argMinMaxPairs = this->pairArgMinMaxReductions(reductions);
+  for (uint64_t stride = 1; stride < this->numReducers; stride *= 2) {
+    for (uint64_t i = 0; (i + stride) < this->numReducers; i += 2 * stride) {
+      std::unordered_map<uint32_t, Value *> combinedValues;
+      for (auto envIDReduction : reductions) {
+        auto envID = envIDReduction.first;
+        auto red = envIDReduction.second;
+        auto &partialValues = partialValuesOf.at(envID);
+        if (auto argMinMax = dyn_cast<ArgMinMaxReductionSCC>(red)) {
+          auto &minMaxPartialValues =
+              partialValuesOf.at(argMinMaxPairs.at(envID));
+          combinedValues[envID] =
+              this->generateArgMinMaxSelection(treeBuilder,
+                                               argMinMax,
+                                               minMaxPartialValues[i],
+                                               partialValues[i],
+                                               minMaxPartialValues[i + stride],
+                                               partialValues[i + stride],
+                                               nullptr);
+          continue;
+        }
+        combinedValues[envID] =
+            this->generateReductionOperation(treeBuilder,
+                                             red,
+                                             partialValues[i],
+                                             partialValues[i + stride]);
+      }
+
+      auto reducerID = ConstantInt::get(threadsType, i + stride);
+      auto hasRun =
+          treeBuilder.CreateICmpSLT(reducerID, numberOfThreadsExecuted);
+      for (auto envIDReduction : reductions) {
+        auto envID = envIDReduction.first;
+        auto &partialValues = partialValuesOf.at(envID);
+        partialValues[i] = treeBuilder.CreateSelect(hasRun,
+                                                    combinedValues.at(envID),
+                                                    partialValues[i]);
+      }
+    }
+  }
+
+  /*
+   * Accumulate the result of the tree to the initial value.
+   */
+  std::unordered_map<uint32_t, Value *> initialValues;
+  for (auto envIDReduction : reductions) {
+    initialValues[envIDReduction.first] =
+        castingInitialValue(envIDReduction.second);
+  }
+  for (auto envIDReduction : reductions) {
+    auto envID = envIDReduction.first;
+    auto envIndex = this->envIDToIndex[envID];
+    auto red = envIDReduction.second;
+    auto initialValue = initialValues.at(envID);
+    auto treeValue = partialValuesOf.at(envID)[0];
+    Value *reducedValue = nullptr;
+    if (auto argMinMax = dyn_cast<ArgMinMaxReductionSCC>(red)) {
+      auto minMaxEnvID = argMinMaxPairs.at(envID);
+      auto initialMinMax = initialValues.at(minMaxEnvID);
+      reducedValue = this->generateArgMinMaxSelection(
+          treeBuilder,
+          argMinMax,
+          initialMinMax,
+          initialValue,
+          partialValuesOf.at(minMaxEnvID)[0],
+          treeValue,
+          initialMinMax);
+    } else {
+      reducedValue = this->generateReductionOperation(treeBuilder,
+                                                      red,
+                                                      initialValue,
+                                                      treeValue);
+    }
+    this->envIndexToAccumulatedReducableVar[envIndex] = reducedValue;
+  }
+  treeBuilder.CreateBr(afterReductionBB);
+
+  return afterReductionBB;
+}
+
+Value *LoopEnvironmentBuilder::generateReductionOperation(
+    IRBuilder<> &builder,
+    ReductionSCC *red,
+    Value *accumulatedValue,
+    Value *privateCopy) {
+
+  /*
+   * Check if the reduction is a binary one.
+   */
+  if (auto binaryRed = dyn_cast<BinaryReductionSCC>(red)) {
+    auto binOp = binaryRed->getReductionOperation();
+    return builder.CreateBinOp(binOp, accumulatedValue, privateCopy);
+  }
+
+  /*
+   * Check if the reduction is a min/max.
+   */
+  auto minMaxRed = dyn_cast<MinMaxReductionSCC>(red);
+  if (minMaxRed == nullptr) {
+    errs() << "LoopEnvironmentBuilder: ERROR = the reduction cannot be "
+              "combined by an operation\n";
+    abort();
+  }
+  auto predicate = getMinMaxReductionPredicate(minMaxRed->getMinMaxKind());
+  auto isBetter = builder.CreateCmp(predicate, privateCopy, accumulatedValue);
+
+  return builder.CreateSelect(isBetter, privateCopy, accumulatedValue);
+}
+
+Value *LoopEnvironmentBuilder::generateArgMinMaxSelection(
+    IRBuilder<> &builder,
+    ArgMinMaxReductionSCC *red,
+    Value *accumulatedMinMax,
+    Value *accumulatedIndex,
+    Value *privateMinMax,
+    Value *privateIndex,
+    Value *initialMinMax) {
+  auto kind = red->getMinMaxKind();
+  auto isFP = RecurrenceDescriptor::isFPMinMaxRecurrenceKind(kind);
+
+  /*
+   * Check if the private min/max is better than the accumulated one.
+   */
+  auto predicate = getMinMaxReductionPredicate(kind);
+  auto isBetter =
+      builder.CreateCmp(predicate, privateMinMax, accumulatedMinMax);
+
+  /*
+   * Check if the private min/max is the same as the accumulated one but it
+   * has been reached at an earlier iteration.
+   */
+  auto isTie = isFP ? builder.CreateFCmpOEQ(privateMinMax, accumulatedMinMax)
+                    : builder.CreateICmpEQ(privateMinMax, accumulatedMinMax);
+  auto isEarlier = red->isIndexIncreasing()
+                       ? builder.CreateICmpSLT(privateIndex, accumulatedIndex)
+                       : builder.CreateICmpSGT(privateIndex, accumulatedIndex);
+  auto isEarlierTie = builder.CreateAnd(isTie, isEarlier);
+  if (initialMinMax != nullptr) {
+    auto isNotInitial =
+        isFP ? builder.CreateFCmpONE(accumulatedMinMax, initialMinMax)
+             : builder.CreateICmpNE(accumulatedMinMax, initialMinMax);
+    isEarlierTie = builder.CreateAnd(isEarlierTie, isNotInitial);
+  }
+
+  /*
+   * Select the index.
+   */
+  auto isSelected = builder.CreateOr(isBetter, isEarlierTie);
+
+  return builder.CreateSelect(isSelected, privateIndex, accumulatedIndex);
+}
+
+std::unordered_map<uint32_t, uint32_t> LoopEnvironmentBuilder::
+    pairArgMinMaxReductions(
+        const std::unordered_map<uint32_t, ReductionSCC *> &reductions) const {
+  std::unordered_map<uint32_t, uint32_t> pairs;
+
+  for (auto envIDReduction : reductions) {
+    auto argMinMax = dyn_cast<ArgMinMaxReductionSCC>(envIDReduction.second);
+    if (argMinMax == nullptr) {
+      continue;
+    }
+
+    /*
+     * Look for the min/max the index is paired with.
+     */
+    for (auto otherEnvIDReduction : reductions) {
+      auto minMax = dyn_cast<MinMaxReductionSCC>(otherEnvIDReduction.second);
+      if ((minMax != nullptr)
+          && (minMax->getPhiThatAccumulatesValuesBetweenLoopIterations()
+              == argMinMax->getMinMaxAccumulator())) {
+        pairs[envIDReduction.first] = otherEnvIDReduction.first;
+        break;
+      }
+    }
+    if (pairs.find(envIDReduction.first) == pairs.end()) {
+      errs() << "LoopEnvironmentBuilder: ERROR = the min/max of an "
+                "argmin/argmax reduction is not reduced\n";
+      abort();
+    }
+  }
+
+  return pairs;
+}
+
+Value *LoopEnvironmentBuilder::allocatePrivateCopiesOfArray(
+    IRBuilder<> &builder,
+    ArrayReductionSCC *red) {
+
+  /*
+   * Pad the array to a multiple of the cache line.
+   */
+  auto cacheLineBytes = Architecture::getCacheLineBytes();
+  auto sizeInBytes = red->getSizeInBytes();
+  auto paddedSizeInBytes =
+      ((sizeInBytes + cacheLineBytes - 1) / cacheLineBytes) * cacheLineBytes;
+  auto int8 = IntegerType::get(this->CXT, 8);
+  auto paddingType = ArrayType::get(int8, paddedSizeInBytes - sizeInBytes);
+  auto privateCopyType =
+      StructType::get(this->CXT, { red->getArrayType(), paddingType });
+
+  /*
+   * Allocate the private copies on the heap.
+   * Their size is a multiple of the cache line, as aligned_alloc requires.
+   */
+  auto privateCopiesType = ArrayType::get(privateCopyType, this->numReducers);
+  auto int64 = IntegerType::get(this->CXT, 64);
+  auto int8Ptr = PointerType::getUnqual(int8);
+  auto module = builder.GetInsertBlock()->getModule();
+  auto alignedAllocF = module->getOrInsertFunction(
+      "aligned_alloc",
+      FunctionType::get(int8Ptr, { int64, int64 }, false));
+  auto memory = builder.CreateCall(
+      alignedAllocF,
+      { ConstantInt::get(int64, cacheLineBytes),
+        ConstantInt::get(int64, paddedSizeInBytes * this->numReducers) });
+  auto privateCopies =
+      builder.CreateBitCast(memory,
+                            PointerType::getUnqual(privateCopiesType),
+                            "noelle.private_array_for_all_tasks");
+  this->arrayToPrivateCopies[red] = privateCopies;
+
+  return privateCopies;
+}
+
+Value *LoopEnvironmentBuilder::getPrivateCopiesOfArray(
+    ArrayReductionSCC *red) const {
+  assert(this->arrayToPrivateCopies.find(red)
+             != this->arrayToPrivateCopies.end()
+         && "The array has not been privatized\n");
+
+  return this->arrayToPrivateCopies.at(red);
+}
+
+Value *LoopEnvironmentBuilder::fetchPrivateCopyOfArray(
+    IRBuilder<> &builder,
+    Value *privateCopies,
+    Value *reducerIndex) const {
+  auto int32 = IntegerType::get(this->CXT, 32);
+  auto zeroV = ConstantInt::get(int32, 0);
+
+  return builder.CreateInBoundsGEP(
+      privateCopies->getType()->getPointerElementType(),
+      privateCopies,
+      ArrayRef<Value *>({ zeroV, reducerIndex, zeroV }));
+}
+
+BasicBlock *LoopEnvironmentBuilder::initializePrivateCopyOfArray(
+    BasicBlock *bb,
+    ArrayReductionSCC *red,
+    Value *privateCopy) {
+  auto int64 = IntegerType::get(this->CXT, 64);
+  auto numberOfElements = ConstantInt::get(int64, red->getNumberOfElements());
+
+  return this->generateCountedLoop(
+      bb,
+      numberOfElements,
+      [this, red, privateCopy](BasicBlock *bodyBB,
+                               Value *iteration) -> BasicBlock * {
+        IRBuilder<> bodyBuilder{ bodyBB };
+        auto elementPtr =
+            this->fetchElementOfArray(bodyBuilder, red, privateCopy, iteration);
+        bodyBuilder.CreateStore(red->getIdentityValue(), elementPtr);
+
+        return bodyBB;
+      });
+}
+
+BasicBlock *LoopEnvironmentBuilder::reduceArrays(
+    BasicBlock *bb,
+    const std::vector<ArrayReductionSCC *> &reductions,
+    Value *numberOfThreadsExecuted) {
+  assert(bb != nullptr);
+  auto int64 = IntegerType::get(this->CXT, 64);
+
+  for (auto red : reductions) {
+    auto privateCopies = this->getPrivateCopiesOfArray(red);
+    auto numberOfElements =
+        ConstantInt::get(int64, red->getNumberOfElements());
+
+    /*
+     * Accumulate the private copies one after the other.
+     * The elements of a copy are combined by an inner loop with no
+     * loop-carried dependence, so it can be vectorized.
+     */
+    bb = this->generateCountedLoop(
+        bb,
+        numberOfThreadsExecuted,
+        [this, red, privateCopies, numberOfElements](
+            BasicBlock *reducerBB,
+            Value *reducerIndex) -> BasicBlock * {
+          IRBuilder<> reducerBuilder{ reducerBB };
+          auto privateCopy = this->fetchPrivateCopyOfArray(reducerBuilder,
+                                                           privateCopies,
+                                                           reducerIndex);
+
+          return this->generateCountedLoop(
+              reducerBB,
+              numberOfElements,
+              [this, red, privateCopy](BasicBlock *elementBB,
+                                       Value *elementIndex) -> BasicBlock * {
+                IRBuilder<> elementBuilder{ elementBB };
+                auto elementType = red->getElementType();
+                auto originalPtr = this->fetchElementOfArray(elementBuilder,
+                                                             red,
+                                                             red->getArray(),
+                                                             elementIndex);
+                auto privatePtr = this->fetchElementOfArray(elementBuilder,
+                                                            red,
+                                                            privateCopy,
+                                                            elementIndex);
+                auto originalValue =
+                    elementBuilder.CreateLoad(elementType, originalPtr);
+                auto privateValue =
+                    elementBuilder.CreateLoad(elementType, privatePtr);
+                auto reducedValue =
+                    elementBuilder.CreateBinOp(red->getReductionOperation(),
+                                               originalValue,
+                                               privateValue);
+                elementBuilder.CreateStore(reducedValue, originalPtr);
+
+                return elementBB;
+              });
+        });
+  }
+
+  /*
+   * Release the private copies.
+   */
+  IRBuilder<> afterReductionBuilder{ bb };
+  auto int8Ptr = PointerType::getUnqual(IntegerType::get(this->CXT, 8));
+  auto freeF = bb->getModule()->getOrInsertFunction(
+      "free",
+      FunctionType::get(Type::getVoidTy(this->CXT), { int8Ptr }, false));
+  for (auto red : reductions) {
+    auto privateCopies = this->getPrivateCopiesOfArray(red);
+    afterReductionBuilder.CreateCall(
+        freeF,
+        { afterReductionBuilder.CreateBitCast(privateCopies, int8Ptr) });
+  }
+
+  return bb;
+}
+
+BasicBlock *LoopEnvironmentBuilder::generateCountedLoop(
+    BasicBlock *bb,
+    Value *tripCount,
+    std::function<BasicBlock *(BasicBlock *bodyBB, Value *iteration)>
+        generateBody) {
+
+  /*
+   * Fetch the function that "bb" belongs to.
+   */
+  auto f = bb->getParent();
+  assert(f != nullptr);
+
+  /*
+   * Create the first basic block of the body and the one after the loop.
+   */
+  auto bodyBB = BasicBlock::Create(this->CXT, "ArrayReductionLoopBody", f);
+  auto afterLoopBB =
+      BasicBlock::Create(this->CXT, "AfterArrayReductionLoop", f);
+
+  /*
+   * Change the successor of "bb" to be "bodyBB".
+   */
+  auto bbTerminator = bb->getTerminator();
+  if (bbTerminator != nullptr) {
+    bbTerminator->eraseFromParent();
+  }
+  IRBuilder<> bbBuilder{ bb };
+  bbBuilder.CreateBr(bodyBB);
+
+  /*
+   * Generate the body.
+   */
+  IRBuilder<> bodyBuilder{ bodyBB };
+  auto ivType = tripCount->getType();
+  auto iteration = bodyBuilder.CreatePHI(ivType, 2);
+  iteration->addIncoming(ConstantInt::get(ivType, 0), bb);
+  auto lastBodyBB = generateBody(bodyBB, iteration);
+
+  /*
+   * Jump back to the body until all iterations have been executed.
+   */
+  IRBuilder<> latchBuilder{ lastBodyBB };
+  auto nextIteration =
+      latchBuilder.CreateAdd(iteration, ConstantInt::get(ivType, 1));
+  iteration->addIncoming(nextIteration, lastBodyBB);
+  auto isNotDone = latchBuilder.CreateICmpSLT(nextIteration, tripCount);
+  latchBuilder.CreateCondBr(isNotDone, bodyBB, afterLoopBB);
+
+  return afterLoopBB;
+}
+
+Value *LoopEnvironmentBuilder::fetchElementOfArray(IRBuilder<> &builder,
+                                                   ArrayReductionSCC *red,
+                                                   Value *array,
+                                                   Value *elementIndex) const {
+  auto elementType = red->getElementType();
+  auto elements =
+      builder.CreateBitCast(array, PointerType::getUnqual(elementType));
+
+  return builder.CreateInBoundsGEP(elementType, elements, elementIndex);
+}
+
+void LoopEnvironmentBuilder::setReductionStrategy(ReductionStrategy strategy) {
+  this->reductionStrategy = strategy;
+
+  return;
+}
+
+ReductionStrategy LoopEnvironmentBuilder::getReductionStrategy(void) const {
+  return this->reductionStrategy;
+}
+
 Value *LoopEnvironmentBuilder::getEnvironmentArrayVoidPtr(void) const {
   assert(this->envArrayInt8Ptr != nullptr);
 
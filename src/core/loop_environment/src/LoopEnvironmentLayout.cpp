@@ -0,0 +1,125 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/Architecture.hpp"
+#include "arcana/noelle/core/LoopEnvironmentLayout.hpp"
+
+namespace arcana::noelle {
+
+LoopEnvironmentLayout::LoopEnvironmentLayout()
+  : packReadOnlyVariables{ false },
+    size{ 0 } {
+
+  return;
+}
+
+void LoopEnvironmentLayout::addVariable(bool isReadOnly) {
+  this->readOnly.push_back(isReadOnly);
+  this->computeOffsets();
+
+  return;
+}
+
+void LoopEnvironmentLayout::setReadOnlyVariablesPacked(bool packed) {
+  this->packReadOnlyVariables = packed;
+  this->computeOffsets();
+
+  return;
+}
+
+bool LoopEnvironmentLayout::areReadOnlyVariablesPacked(void) const {
+  return this->packReadOnlyVariables;
+}
+
+bool LoopEnvironmentLayout::isPacked(uint32_t envIndex) const {
+  return this->packReadOnlyVariables && this->readOnly.at(envIndex);
+}
+
+uint64_t LoopEnvironmentLayout::getOffsetOfVariable(uint32_t envIndex) const {
+  return this->offsets.at(envIndex);
+}
+
+uint64_t LoopEnvironmentLayout::getSize(void) const {
+  return this->size;
+}
+
+uint32_t LoopEnvironmentLayout::getNumberOfVariables(void) const {
+  return this->readOnly.size();
+}
+
+uint64_t LoopEnvironmentLayout::getWordsInCacheLine(void) {
+  return Architecture::getCacheLineBytes() / sizeof(int64_t);
+}
+
+bool LoopEnvironmentLayout::fitsInAWord(Type *type) {
+  if (type->isPointerTy()) {
+    return true;
+  }
+  if (isa<ScalableVectorType>(type)) {
+    return false;
+  }
+  auto bits = type->getPrimitiveSizeInBits().getFixedSize();
+
+  return (bits > 0) && (bits <= 64);
+}
+
+void LoopEnvironmentLayout::computeOffsets(void) {
+  auto wordsInCacheLine = LoopEnvironmentLayout::getWordsInCacheLine();
+  this->offsets.resize(this->readOnly.size());
+
+  /*
+   * Without packing, the variable with index "i" starts the cache line "i".
+   */
+  if (!this->packReadOnlyVariables) {
+    for (auto i = 0u; i < this->readOnly.size(); i++) {
+      this->offsets[i] = i * wordsInCacheLine;
+    }
+    this->size = this->readOnly.size() * wordsInCacheLine;
+
+    return;
+  }
+
+  /*
+   * Place the read-only variables one word after the other.
+   */
+  uint64_t nextWord = 0;
+  for (auto i = 0u; i < this->readOnly.size(); i++) {
+    if (this->readOnly[i]) {
+      this->offsets[i] = nextWord++;
+    }
+  }
+
+  /*
+   * Give every other variable its own cache line after the packed ones.
+   */
+  nextWord = alignTo(nextWord, wordsInCacheLine);
+  for (auto i = 0u; i < this->readOnly.size(); i++) {
+    if (!this->readOnly[i]) {
+      this->offsets[i] = nextWord;
+      nextWord += wordsInCacheLine;
+    }
+  }
+  this->size = nextWord;
+
+  return;
+}
+
+} // namespace arcana::noelle
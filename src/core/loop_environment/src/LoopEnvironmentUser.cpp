@@ -19,7 +19,6 @@
  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
-#include "arcana/noelle/core/Architecture.hpp"
 #include "arcana/noelle/core/LoopEnvironmentUser.hpp"
 
 namespace arcana::noelle {
@@ -29,7 +28,20 @@ LoopEnvironmentUser::LoopEnvironmentUser(
   : envIndexToPtr{},
     liveInIDs{},
     liveOutIDs{},
-    envIDToIndex{ envIDToIndex } {
+    envIDToIndex{ envIDToIndex },
+    layout{ nullptr } {
+
+  return;
+}
+
+LoopEnvironmentUser::LoopEnvironmentUser(
+    std::unordered_map<uint32_t, uint32_t> &envIDToIndex,
+    const LoopEnvironmentLayout &layout)
+  : envIndexToPtr{},
+    liveInIDs{},
+    liveOutIDs{},
+    envIDToIndex{ envIDToIndex },
+    layout{ &layout } {
   envIndexToPtr.clear();
   liveInIDs.clear();
   liveOutIDs.clear();
@@ -37,6 +49,14 @@ LoopEnvironmentUser::LoopEnvironmentUser(
   return;
 }
 
+uint64_t LoopEnvironmentUser::getOffsetOfVariable(uint32_t envIndex) const {
+  if (this->layout == nullptr) {
+    return envIndex * LoopEnvironmentLayout::getWordsInCacheLine();
+  }
+
+  return this->layout->getOffsetOfVariable(envIndex);
+}
+
 void LoopEnvironmentUser::setEnvironmentArray(Value *envArr) {
   this->envArray = envArr;
 
@@ -70,16 +90,11 @@ Instruction *LoopEnvironmentUser::createEnvironmentVariablePointer(
   auto int64 = IntegerType::get(builder.getContext(), 64);
   auto zeroV = cast<Value>(ConstantInt::get(int64, 0));
 
-  /*
-   * Compute how many values can fit in a cache line.
-   */
-  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
-
   /*
    * Compute the offset of the environment variable.
    */
-  auto envIndV =
-      cast<Value>(ConstantInt::get(int64, envIndex * valuesInCacheLine));
+  auto envIndV = cast<Value>(
+      ConstantInt::get(int64, this->getOffsetOfVariable(envIndex)));
 
   /*
    * Compute the address of the environment variable
@@ -119,13 +134,14 @@ void LoopEnvironmentUser::createReducableEnvPtr(IRBuilder<> &builder,
 
   /*
    * Compute how many values can fit in a cache line.
+   * The private copies of the reducers are one cache line apart.
    */
-  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
+  auto valuesInCacheLine = LoopEnvironmentLayout::getWordsInCacheLine();
 
   auto int64 = IntegerType::get(builder.getContext(), 64);
   auto zeroV = cast<Value>(ConstantInt::get(int64, 0));
-  auto envIndV =
-      cast<Value>(ConstantInt::get(int64, envIndex * valuesInCacheLine));
+  auto envIndV = cast<Value>(
+      ConstantInt::get(int64, this->getOffsetOfVariable(envIndex)));
 
   auto envReduceGEP =
       builder.CreateGEP(this->envArray->getType()->getPointerElementType(),
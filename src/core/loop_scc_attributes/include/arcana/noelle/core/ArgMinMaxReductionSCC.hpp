@@ -0,0 +1,75 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_LOOP_SCC_ATTRIBUTES_ARGMINMAXREDUCTIONSCC_H_
+#define NOELLE_SRC_CORE_LOOP_SCC_ATTRIBUTES_ARGMINMAXREDUCTIONSCC_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/ReductionSCC.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * A variable that tracks the value of an induction variable at the iteration
+ * where a min/max reduction has been strictly improved (e.g., argmin).
+ *
+ * The variable can only be reduced together with its min/max reduction: the
+ * private copies of both are needed to combine the private copies of this one.
+ */
+class ArgMinMaxReductionSCC : public ReductionSCC {
+public:
+  ArgMinMaxReductionSCC(
+      SCC *s,
+      LoopStructure *loop,
+      const std::set<DGEdge<Value, Value> *> &loopCarriedDependences,
+      Value *initialValue,
+      PHINode *accumulator,
+      PHINode *minMaxAccumulator,
+      RecurKind minMaxKind,
+      bool isIndexIncreasing);
+
+  ArgMinMaxReductionSCC() = delete;
+
+  /*
+   * Return the PHI of the min/max reduction this variable is paired with.
+   */
+  PHINode *getMinMaxAccumulator(void) const;
+
+  RecurKind getMinMaxKind(void) const;
+
+  /*
+   * Return true if the tracked induction variable increases across
+   * iterations. In this case, the earliest iteration is the one with the
+   * smallest index.
+   */
+  bool isIndexIncreasing(void) const;
+
+  static bool classof(const GenericSCC *s);
+
+protected:
+  PHINode *minMaxAccumulator;
+  RecurKind minMaxKind;
+  bool indexIncreasing;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_LOOP_SCC_ATTRIBUTES_ARGMINMAXREDUCTIONSCC_H_
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_LOOP_SCC_ATTRIBUTES_ARRAYREDUCTIONSCC_H_
+#define NOELLE_SRC_CORE_LOOP_SCC_ATTRIBUTES_ARRAYREDUCTIONSCC_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/LoopCarriedSCC.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * An array of fixed size whose elements are only updated by
+ * read-modify-writes with the same associative and commutative operator
+ * (e.g., hist[key[i]] += 1).
+ * The loop-carried dependences of the SCC go away when every worker updates
+ * a private copy of the array; the private copies are then combined
+ * element-wise into the original array (see LoopEnvironmentBuilder).
+ *
+ * This is not a MemoryClonableSCC: the memory accesses of the SCC must be
+ * redirected to the private copy, and the copies must be combined, before
+ * the SCC stops constraining the parallelization of the loop.
+ */
+class ArrayReductionSCC : public LoopCarriedSCC {
+public:
+  ArrayReductionSCC(
+      SCC *s,
+      LoopStructure *loop,
+      const std::set<DGEdge<Value, Value> *> &loopCarriedDependences,
+      Value *array,
+      Instruction::BinaryOps reductionOperation,
+      const std::unordered_set<Instruction *> &memoryAccesses);
+
+  ArrayReductionSCC() = delete;
+
+  /*
+   * Return the stack or global object that is reduced.
+   */
+  Value *getArray(void) const;
+
+  /*
+   * Return the type of the object (e.g., [256 x i32]).
+   */
+  Type *getArrayType(void) const;
+
+  /*
+   * Return the type of the elements once the array is flattened.
+   */
+  Type *getElementType(void) const;
+
+  uint64_t getNumberOfElements(void) const;
+
+  uint64_t getSizeInBytes(void) const;
+
+  /*
+   * Return the operation used to combine two copies of the same element.
+   */
+  Instruction::BinaryOps getReductionOperation(void) const;
+
+  /*
+   * Return the value the elements of a private copy start from.
+   */
+  Value *getIdentityValue(void) const;
+
+  /*
+   * Return the loads and stores of the loop that access the array.
+   */
+  std::unordered_set<Instruction *> getMemoryAccesses(void) const;
+
+  /*
+   * Return the type of the elements of @arrayType once flattened, or nullptr
+   * if @arrayType is not built only out of arrays.
+   */
+  static Type *getElementTypeOfArrayType(Type *arrayType);
+
+  static bool classof(const GenericSCC *s);
+
+protected:
+  Value *array;
+  Type *arrayType;
+  Type *elementType;
+  uint64_t numberOfElements;
+  uint64_t sizeInBytes;
+  Instruction::BinaryOps reductionOperation;
+  Value *identity;
+  std::unordered_set<Instruction *> memoryAccesses;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_LOOP_SCC_ATTRIBUTES_ARRAYREDUCTIONSCC_H_
@@ -43,6 +43,8 @@ public:
 
     REDUCTION,
     BINARY_REDUCTION,
+    MIN_MAX_REDUCTION,
+    ARG_MIN_MAX_REDUCTION,
     LAST_REDUCTION,
 
     RECOMPUTABLE,
@@ -64,6 +66,8 @@ public:
     STACK_OBJECT_CLONABLE,
     LAST_MEMORY_CLONABLE,
 
+    ARRAY_REDUCTION,
+
     LOOP_CARRIED_UNKNOWN,
 
     LAST_LOOP_CARRIED,
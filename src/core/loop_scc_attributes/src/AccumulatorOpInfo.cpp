@@ -104,4 +104,35 @@ Value *AccumulatorOpInfo::generateIdentityFor(Instruction *accumulator,
   return initVal;
 }
 
+Value *AccumulatorOpInfo::generateIdentityFor(RecurKind minMaxKind,
+                                              Type *type) {
+
+  /*
+   * The identity of a min (max) is the largest (smallest) value of the type.
+   */
+  switch (minMaxKind) {
+    case RecurKind::SMin:
+      return ConstantInt::get(
+          type,
+          APInt::getSignedMaxValue(type->getIntegerBitWidth()));
+    case RecurKind::SMax:
+      return ConstantInt::get(
+          type,
+          APInt::getSignedMinValue(type->getIntegerBitWidth()));
+    case RecurKind::UMin:
+      return ConstantInt::get(type,
+                              APInt::getMaxValue(type->getIntegerBitWidth()));
+    case RecurKind::UMax:
+      return ConstantInt::get(type, 0);
+    case RecurKind::FMin:
+      return ConstantFP::getInfinity(type, false);
+    case RecurKind::FMax:
+      return ConstantFP::getInfinity(type, true);
+    default:
+      assert(false && "Attempting to reduce unknown min/max kind!");
+  }
+
+  return nullptr;
+}
+
 } // namespace arcana::noelle
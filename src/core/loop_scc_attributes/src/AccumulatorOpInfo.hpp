@@ -42,6 +42,7 @@ public:
   bool isSubOp(unsigned op);
   Instruction::BinaryOps accumOpForType(unsigned op, Type *type);
   Value *generateIdentityFor(Instruction *accumulator, Type *castType);
+  Value *generateIdentityFor(RecurKind minMaxKind, Type *type);
 };
 
 } // namespace arcana::noelle
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/ArgMinMaxReductionSCC.hpp"
+
+namespace arcana::noelle {
+
+ArgMinMaxReductionSCC::ArgMinMaxReductionSCC(
+    SCC *s,
+    LoopStructure *loop,
+    const std::set<DGEdge<Value, Value> *> &loopCarriedDependences,
+    Value *initialValue,
+    PHINode *accumulator,
+    PHINode *minMaxAccumulator,
+    RecurKind minMaxKind,
+    bool isIndexIncreasing)
+  : ReductionSCC(SCCKind::ARG_MIN_MAX_REDUCTION,
+                 s,
+                 loop,
+                 loopCarriedDependences,
+                 initialValue,
+                 accumulator,
+                 Constant::getNullValue(accumulator->getType())),
+    minMaxAccumulator{ minMaxAccumulator },
+    minMaxKind{ minMaxKind },
+    indexIncreasing{ isIndexIncreasing } {
+  assert(RecurrenceDescriptor::isMinMaxRecurrenceKind(minMaxKind));
+
+  return;
+}
+
+PHINode *ArgMinMaxReductionSCC::getMinMaxAccumulator(void) const {
+  return this->minMaxAccumulator;
+}
+
+RecurKind ArgMinMaxReductionSCC::getMinMaxKind(void) const {
+  return this->minMaxKind;
+}
+
+bool ArgMinMaxReductionSCC::isIndexIncreasing(void) const {
+  return this->indexIncreasing;
+}
+
+bool ArgMinMaxReductionSCC::classof(const GenericSCC *s) {
+  return (s->getKind() == GenericSCC::SCCKind::ARG_MIN_MAX_REDUCTION);
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/ArrayReductionSCC.hpp"
+
+namespace arcana::noelle {
+
+ArrayReductionSCC::ArrayReductionSCC(
+    SCC *s,
+    LoopStructure *loop,
+    const std::set<DGEdge<Value, Value> *> &loopCarriedDependences,
+    Value *array,
+    Instruction::BinaryOps reductionOperation,
+    const std::unordered_set<Instruction *> &memoryAccesses)
+  : LoopCarriedSCC{ ARRAY_REDUCTION, s, loop, loopCarriedDependences, true },
+    array{ array },
+    arrayType{ nullptr },
+    elementType{ nullptr },
+    numberOfElements{ 0 },
+    sizeInBytes{ 0 },
+    reductionOperation{ reductionOperation },
+    identity{ nullptr },
+    memoryAccesses{ memoryAccesses } {
+
+  /*
+   * Fetch the type of the object.
+   */
+  if (auto allocation = dyn_cast<AllocaInst>(array)) {
+    this->arrayType = allocation->getAllocatedType();
+  } else {
+    this->arrayType = cast<GlobalVariable>(array)->getValueType();
+  }
+  this->elementType =
+      ArrayReductionSCC::getElementTypeOfArrayType(this->arrayType);
+  assert(this->elementType != nullptr);
+
+  /*
+   * Compute the size of the array.
+   */
+  auto &DL = loop->getFunction()->getParent()->getDataLayout();
+  this->sizeInBytes = DL.getTypeAllocSize(this->arrayType);
+  this->numberOfElements =
+      this->sizeInBytes / DL.getTypeAllocSize(this->elementType);
+
+  /*
+   * Set the identity value.
+   */
+  this->identity =
+      ConstantExpr::getBinOpIdentity(reductionOperation, this->elementType);
+  assert(this->identity != nullptr);
+
+  return;
+}
+
+Value *ArrayReductionSCC::getArray(void) const {
+  return this->array;
+}
+
+Type *ArrayReductionSCC::getArrayType(void) const {
+  return this->arrayType;
+}
+
+Type *ArrayReductionSCC::getElementType(void) const {
+  return this->elementType;
+}
+
+uint64_t ArrayReductionSCC::getNumberOfElements(void) const {
+  return this->numberOfElements;
+}
+
+uint64_t ArrayReductionSCC::getSizeInBytes(void) const {
+  return this->sizeInBytes;
+}
+
+Instruction::BinaryOps ArrayReductionSCC::getReductionOperation(void) const {
+  return this->reductionOperation;
+}
+
+Value *ArrayReductionSCC::getIdentityValue(void) const {
+  return this->identity;
+}
+
+std::unordered_set<Instruction *> ArrayReductionSCC::getMemoryAccesses(
+    void) const {
+  return this->memoryAccesses;
+}
+
+Type *ArrayReductionSCC::getElementTypeOfArrayType(Type *arrayType) {
+  if (!arrayType->isArrayTy()) {
+    return nullptr;
+  }
+  auto t = arrayType;
+  while (auto a = dyn_cast<ArrayType>(t)) {
+    t = a->getElementType();
+  }
+  if (!t->isIntegerTy() && !t->isFloatingPointTy()) {
+    return nullptr;
+  }
+
+  return t;
+}
+
+bool ArrayReductionSCC::classof(const GenericSCC *s) {
+  return (s->getKind() == GenericSCC::SCCKind::ARRAY_REDUCTION);
+}
+
+} // namespace arcana::noelle
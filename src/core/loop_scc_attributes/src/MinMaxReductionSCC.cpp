@@ -0,0 +1,63 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/MinMaxReductionSCC.hpp"
+#include "AccumulatorOpInfo.hpp"
+
+namespace arcana::noelle {
+
+static AccumulatorOpInfo accumOpInfo;
+
+MinMaxReductionSCC::MinMaxReductionSCC(
+    SCC *s,
+    LoopStructure *loop,
+    const std::set<DGEdge<Value, Value> *> &loopCarriedDependences,
+    Value *initialValue,
+    RecurKind minMaxKind,
+    PHINode *accumulator)
+  : ReductionSCC(SCCKind::MIN_MAX_REDUCTION,
+                 s,
+                 loop,
+                 loopCarriedDependences,
+                 initialValue,
+                 accumulator,
+                 nullptr),
+    minMaxKind{ minMaxKind } {
+  assert(RecurrenceDescriptor::isMinMaxRecurrenceKind(minMaxKind));
+
+  /*
+   * Set the identity value.
+   */
+  this->identity =
+      accumOpInfo.generateIdentityFor(minMaxKind, accumulator->getType());
+
+  return;
+}
+
+RecurKind MinMaxReductionSCC::getMinMaxKind(void) const {
+  return this->minMaxKind;
+}
+
+bool MinMaxReductionSCC::classof(const GenericSCC *s) {
+  return (s->getKind() == GenericSCC::SCCKind::MIN_MAX_REDUCTION);
+}
+
+} // namespace arcana::noelle
@@ -39,6 +39,7 @@ namespace arcana::noelle {
 class SCCDAGAttrs {
 public:
   SCCDAGAttrs(bool enableFloatAsReal,
+              uint64_t maximumSizeOfArrayReductions,
               PDG *loopDG,
               SCCDAG *loopSCCDAG,
               LoopTree *loopNode,
@@ -85,6 +86,7 @@ private:
   std::map<SCC *, std::set<DGEdge<Value, Value> *>>
       sccToLoopCarriedDependencies;
   bool enableFloatAsReal;
+  uint64_t maximumSizeOfArrayReductions;
   std::unordered_map<SCC *, GenericSCC *> sccToInfo;
   PDG *loopDG;
   SCCDAG *sccdag; /* SCCDAG of the related loop.  */
@@ -104,6 +106,36 @@ private:
       SCC *scc,
       LoopTree *loopNode);
 
+  /*
+   * Return the PHI of the min/max variable computed by @scc, its initial value,
+   * and the kind of min/max.
+   */
+  std::tuple<PHINode *, Value *, RecurKind> checkIfMinMaxReduction(
+      SCC *scc,
+      LoopTree *loopNode,
+      std::set<InductionVariable *> &IVs) const;
+
+  /*
+   * Return the PHI of the index variable computed by @scc, its initial value,
+   * the PHI of the min/max variable it is paired with, the kind of min/max,
+   * and whether the index increases across iterations.
+   */
+  std::tuple<PHINode *, Value *, PHINode *, RecurKind, bool>
+  checkIfArgMinMaxReduction(SCC *scc,
+                            LoopTree *loopNode,
+                            std::set<InductionVariable *> &IVs) const;
+
+  std::pair<PHINode *, RecurKind> matchMinMaxUpdate(Value *update,
+                                                    LoopTree *loopNode) const;
+
+  std::tuple<PHINode *, PHINode *, RecurKind, bool> matchArgMinMaxUpdate(
+      SelectInst *update,
+      LoopTree *loopNode,
+      std::set<InductionVariable *> &IVs) const;
+
+  std::pair<PHINode *, Value *> fetchHeaderPHIOfSCC(SCC *scc,
+                                                   LoopTree *loopNode) const;
+
   bool checkIfIndependent(SCC *scc);
 
   std::set<InductionVariable *> checkIfSCCOnlyContainsInductionVariables(
@@ -116,6 +148,15 @@ private:
       SCC *scc,
       LoopTree *loop) const;
 
+  /*
+   * Return the array reduced by @scc, the operation that combines two copies
+   * of an element, and the loads and stores of the loop that access the
+   * array.
+   * The array is nullptr if @scc is not an array reduction.
+   */
+  std::tuple<Value *, Instruction::BinaryOps, std::unordered_set<Instruction *>>
+  checkIfArrayReduction(SCC *scc, LoopTree *loopNode) const;
+
   std::set<Instruction *> checkIfRecomputable(SCC *scc,
                                               LoopTree *loopNode) const;
 
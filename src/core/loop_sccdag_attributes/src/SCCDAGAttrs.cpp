@@ -22,25 +22,31 @@
 #include "arcana/noelle/core/SCCDAGAttrs.hpp"
 #include "arcana/noelle/core/PDGPrinter.hpp"
 #include "arcana/noelle/core/BinaryReductionSCC.hpp"
+#include "arcana/noelle/core/MinMaxReductionSCC.hpp"
+#include "arcana/noelle/core/ArgMinMaxReductionSCC.hpp"
 #include "arcana/noelle/core/LoopIterationSCC.hpp"
 #include "arcana/noelle/core/LinearInductionVariableSCC.hpp"
 #include "arcana/noelle/core/PeriodicVariableSCC.hpp"
 #include "arcana/noelle/core/StackObjectClonableSCC.hpp"
+#include "arcana/noelle/core/ArrayReductionSCC.hpp"
 #include "arcana/noelle/core/LoopCarriedUnknownSCC.hpp"
 #include "arcana/noelle/core/LoopCarriedDependencies.hpp"
 #include "arcana/noelle/core/UnknownClosedFormSCC.hpp"
 #include "arcana/noelle/core/Utils.hpp"
 #include "llvm/IR/Constants.h"
+#include "llvm/IR/PatternMatch.h"
 
 namespace arcana::noelle {
 
 SCCDAGAttrs::SCCDAGAttrs(bool enableFloatAsReal,
+                         uint64_t maximumSizeOfArrayReductions,
                          PDG *loopDG,
                          SCCDAG *loopSCCDAG,
                          LoopTree *loopNode,
                          InductionVariableManager &IV,
                          DominatorSummary &DS)
   : enableFloatAsReal{ enableFloatAsReal },
+    maximumSizeOfArrayReductions{ maximumSizeOfArrayReductions },
     loopDG{ loopDG },
     sccdag{ loopSCCDAG },
     memoryCloningAnalysis{ nullptr } {
@@ -100,8 +106,11 @@ SCCDAGAttrs::SCCDAGAttrs(bool enableFloatAsReal,
                                                        loopGoverningIVs);
     auto lcVar = this->checkIfReducible(scc, loopNode);
     auto isReducable = lcVar != nullptr;
+    auto minMax = this->checkIfMinMaxReduction(scc, loopNode, ivs);
+    auto argMinMax = this->checkIfArgMinMaxReduction(scc, loopNode, ivs);
     auto stackObjectsThatAreClonable =
         this->checkIfClonableByUsingLocalMemory(scc, loopNode);
+    auto arrayReduction = this->checkIfArrayReduction(scc, loopNode);
     auto valuesToPropagateAcrossIterations =
         this->checkIfRecomputable(scc, loopNode);
 
@@ -159,6 +168,36 @@ SCCDAGAttrs::SCCDAGAttrs(bool enableFloatAsReal,
                                        lcVar,
                                        DS);
 
+    } else if (std::get<0>(minMax) != nullptr) {
+
+      /*
+       * The SCC is a min/max reduction.
+       */
+      auto loopCarriedDependences = this->sccToLoopCarriedDependencies.at(scc);
+      auto [phi, initialValue, kind] = minMax;
+      sccInfo = new MinMaxReductionSCC(scc,
+                                       rootLoop,
+                                       loopCarriedDependences,
+                                       initialValue,
+                                       kind,
+                                       phi);
+
+    } else if (std::get<0>(argMinMax) != nullptr) {
+
+      /*
+       * The SCC tracks the index of a min/max reduction.
+       */
+      auto loopCarriedDependences = this->sccToLoopCarriedDependencies.at(scc);
+      auto [phi, initialValue, minMaxPHI, kind, isIndexIncreasing] = argMinMax;
+      sccInfo = new ArgMinMaxReductionSCC(scc,
+                                          rootLoop,
+                                          loopCarriedDependences,
+                                          initialValue,
+                                          phi,
+                                          minMaxPHI,
+                                          kind,
+                                          isIndexIncreasing);
+
     } else if (valuesToPropagateAcrossIterations.size() > 0) {
 
       /*
@@ -181,6 +220,21 @@ SCCDAGAttrs::SCCDAGAttrs(bool enableFloatAsReal,
                                            loopCarriedDependences,
                                            stackObjectsThatAreClonable);
 
+    } else if (std::get<0>(arrayReduction) != nullptr) {
+
+      /*
+       * The SCC can be removed by privatizing an array and by combining its
+       * private copies after the loop.
+       */
+      auto loopCarriedDependences = this->sccToLoopCarriedDependencies.at(scc);
+      auto [array, reductionOperation, memoryAccesses] = arrayReduction;
+      sccInfo = new ArrayReductionSCC(scc,
+                                      rootLoop,
+                                      loopCarriedDependences,
+                                      array,
+                                      reductionOperation,
+                                      memoryAccesses);
+
     } else {
 
       /*
@@ -342,6 +396,28 @@ std::set<uint32_t> SCCDAGAttrs::getLiveOutVariablesThatAreNotReducable(
      * Check the SCC type.
      */
     auto sccInfo = this->getSCCAttrs(scc);
+    if (auto argMinMax = dyn_cast<ArgMinMaxReductionSCC>(sccInfo)) {
+
+      /*
+       * The index of a min/max can be reduced only if the min/max is reduced
+       * as well.
+       */
+      auto minMaxSCC =
+          this->sccdag->sccOfValue(argMinMax->getMinMaxAccumulator());
+      auto isMinMaxLiveOut = false;
+      for (auto otherEnvID : env->getEnvIDsOfLiveOutVars()) {
+        auto otherProducer = env->getProducer(otherEnvID);
+        if (this->sccdag->sccOfValue(otherProducer) == minMaxSCC) {
+          isMinMaxLiveOut = true;
+          break;
+        }
+      }
+      if (isMinMaxLiveOut) {
+        continue;
+      }
+      s.insert(envID);
+      continue;
+    }
     if (isa<ReductionSCC>(sccInfo)) {
       continue;
     }
@@ -853,6 +929,392 @@ LoopCarriedVariable *SCCDAGAttrs::checkIfReducible(SCC *scc,
   return variable;
 }
 
+std::pair<PHINode *, Value *> SCCDAGAttrs::fetchHeaderPHIOfSCC(
+    SCC *scc,
+    LoopTree *loopNode) const {
+  auto notFound = std::make_pair<PHINode *, Value *>(nullptr, nullptr);
+
+  /*
+   * The SCC must carry a value across iterations only through registers.
+   */
+  if (this->sccToLoopCarriedDependencies.find(scc)
+      == this->sccToLoopCarriedDependencies.end()) {
+    return notFound;
+  }
+  for (auto edge : scc->getEdges()) {
+    if (isa<MemoryDependence<Value, Value>>(edge)) {
+      return notFound;
+    }
+  }
+  for (auto dependence : this->sccToLoopCarriedDependencies.at(scc)) {
+    if (isa<ControlDependence<Value, Value>>(dependence)
+        && scc->isInternal(dependence->getSrc())) {
+      return notFound;
+    }
+  }
+
+  /*
+   * Fetch the only PHI of the SCC, which must be in the header of the loop.
+   */
+  auto rootLoop = loopNode->getLoop();
+  PHINode *phi = nullptr;
+  for (auto nodePair : scc->internalNodePairs()) {
+    auto currentPHI = dyn_cast<PHINode>(nodePair.first);
+    if (currentPHI == nullptr) {
+      continue;
+    }
+    if ((phi != nullptr) || (currentPHI->getParent() != rootLoop->getHeader())
+        || (currentPHI->getNumIncomingValues() != 2)) {
+      return notFound;
+    }
+    phi = currentPHI;
+  }
+  if (phi == nullptr) {
+    return notFound;
+  }
+
+  /*
+   * Fetch the initial value, which comes from outside the loop.
+   */
+  Value *initialValue = nullptr;
+  for (auto i = 0u; i < phi->getNumIncomingValues(); i++) {
+    if (!rootLoop->isIncluded(phi->getIncomingBlock(i))) {
+      initialValue = phi->getIncomingValue(i);
+    }
+  }
+  if (initialValue == nullptr) {
+    return notFound;
+  }
+
+  return std::make_pair(phi, initialValue);
+}
+
+std::pair<PHINode *, RecurKind> SCCDAGAttrs::matchMinMaxUpdate(
+    Value *update,
+    LoopTree *loopNode) const {
+  using namespace PatternMatch;
+  auto notMinMax = std::make_pair<PHINode *, RecurKind>(nullptr,
+                                                        RecurKind::None);
+
+  /*
+   * Match the min/max computed either by a select of a compare or by an
+   * intrinsic.
+   */
+  Value *left = nullptr;
+  Value *right = nullptr;
+  auto kind = RecurKind::None;
+  if (match(update, m_SMin(m_Value(left), m_Value(right)))) {
+    kind = RecurKind::SMin;
+  } else if (match(update, m_SMax(m_Value(left), m_Value(right)))) {
+    kind = RecurKind::SMax;
+  } else if (match(update, m_UMin(m_Value(left), m_Value(right)))) {
+    kind = RecurKind::UMin;
+  } else if (match(update, m_UMax(m_Value(left), m_Value(right)))) {
+    kind = RecurKind::UMax;
+  } else if (match(update, m_OrdFMin(m_Value(left), m_Value(right)))
+             || match(update, m_UnordFMin(m_Value(left), m_Value(right)))
+             || match(update, m_FMin(m_Value(left), m_Value(right)))) {
+    kind = RecurKind::FMin;
+  } else if (match(update, m_OrdFMax(m_Value(left), m_Value(right)))
+             || match(update, m_UnordFMax(m_Value(left), m_Value(right)))
+             || match(update, m_FMax(m_Value(left), m_Value(right)))) {
+    kind = RecurKind::FMax;
+  } else {
+    return notMinMax;
+  }
+
+  /*
+   * One operand must be the accumulator, which is a PHI of the header of the
+   * loop that receives @update from the previous iteration.
+   */
+  auto header = loopNode->getLoop()->getHeader();
+  auto isAccumulator = [header, update](Value *v) -> bool {
+    auto phi = dyn_cast<PHINode>(v);
+    return (phi != nullptr) && (phi->getParent() == header)
+           && is_contained(phi->incoming_values(), update);
+  };
+  if (isAccumulator(left) == isAccumulator(right)) {
+    return notMinMax;
+  }
+  auto phi = cast<PHINode>(isAccumulator(left) ? left : right);
+
+  return std::make_pair(phi, kind);
+}
+
+std::tuple<PHINode *, PHINode *, RecurKind, bool> SCCDAGAttrs::
+    matchArgMinMaxUpdate(SelectInst *update,
+                         LoopTree *loopNode,
+                         std::set<InductionVariable *> &IVs) const {
+  auto notArgMinMax =
+      std::make_tuple<PHINode *, PHINode *, RecurKind, bool>(nullptr,
+                                                             nullptr,
+                                                             RecurKind::None,
+                                                             false);
+
+  /*
+   * The condition of @update must be the compare of a min/max select.
+   */
+  auto cmp = dyn_cast<CmpInst>(update->getCondition());
+  if (cmp == nullptr) {
+    return notArgMinMax;
+  }
+  SelectInst *minMaxUpdate = nullptr;
+  PHINode *minMaxPHI = nullptr;
+  auto kind = RecurKind::None;
+  for (auto user : cmp->users()) {
+    auto userSelect = dyn_cast<SelectInst>(user);
+    if ((userSelect == nullptr) || (userSelect == update)) {
+      continue;
+    }
+    auto minMax = this->matchMinMaxUpdate(userSelect, loopNode);
+    if (minMax.first == nullptr) {
+      continue;
+    }
+    minMaxUpdate = userSelect;
+    std::tie(minMaxPHI, kind) = minMax;
+    break;
+  }
+  if (minMaxUpdate == nullptr) {
+    return notArgMinMax;
+  }
+
+  /*
+   * One operand of @update must be the index accumulator, a PHI of the header
+   * that receives @update from the previous iteration.
+   * The index must be kept when the min/max is kept.
+   */
+  auto header = loopNode->getLoop()->getHeader();
+  auto isIndexAccumulator = [header, update](Value *v) -> bool {
+    auto phi = dyn_cast<PHINode>(v);
+    return (phi != nullptr) && (phi->getParent() == header)
+           && is_contained(phi->incoming_values(), update);
+  };
+  auto isIndexKeptOnTrue = isIndexAccumulator(update->getTrueValue());
+  if (isIndexKeptOnTrue == isIndexAccumulator(update->getFalseValue())) {
+    return notArgMinMax;
+  }
+  auto indexPHI = cast<PHINode>(isIndexKeptOnTrue ? update->getTrueValue()
+                                                  : update->getFalseValue());
+  auto newIndex = isIndexKeptOnTrue ? update->getFalseValue()
+                                    : update->getTrueValue();
+  auto isMinMaxKeptOnTrue = (minMaxUpdate->getTrueValue() == minMaxPHI);
+  if (isMinMaxKeptOnTrue != isIndexKeptOnTrue) {
+    return notArgMinMax;
+  }
+
+  /*
+   * The index must be updated only when the new value is strictly better
+   * than the current min/max. So the first iteration that reaches the final
+   * min/max is the one the index refers to.
+   */
+  auto predicate = cmp->getPredicate();
+  if (cmp->getOperand(0) == minMaxPHI) {
+    predicate = CmpInst::getSwappedPredicate(predicate);
+  }
+  if (isMinMaxKeptOnTrue) {
+    predicate = CmpInst::getInversePredicate(predicate);
+  }
+  if (!CmpInst::isStrictPredicate(predicate)) {
+    return notArgMinMax;
+  }
+
+  /*
+   * The new index must be an induction variable of the loop with a constant
+   * step. Its direction tells which private copy refers to the earliest
+   * iteration when they have the same min/max.
+   */
+  for (auto IV : IVs) {
+    if (IV->getLoopEntryPHI() != newIndex) {
+      continue;
+    }
+    if ((!newIndex->getType()->isIntegerTy())
+        || (newIndex->getType() != indexPHI->getType())) {
+      return notArgMinMax;
+    }
+    auto step = dyn_cast_or_null<ConstantInt>(IV->getSingleComputedStepValue());
+    if ((step == nullptr) || step->isZero()) {
+      return notArgMinMax;
+    }
+    return std::make_tuple(indexPHI,
+                           minMaxPHI,
+                           kind,
+                           step->getValue().isStrictlyPositive());
+  }
+
+  return notArgMinMax;
+}
+
+std::tuple<PHINode *, Value *, RecurKind> SCCDAGAttrs::checkIfMinMaxReduction(
+    SCC *scc,
+    LoopTree *loopNode,
+    std::set<InductionVariable *> &IVs) const {
+  auto notMinMax =
+      std::make_tuple<PHINode *, Value *, RecurKind>(nullptr,
+                                                     nullptr,
+                                                     RecurKind::None);
+
+  /*
+   * Fetch the accumulator and the value it gets from the previous iteration.
+   */
+  auto rootLoop = loopNode->getLoop();
+  auto [phi, initialValue] = this->fetchHeaderPHIOfSCC(scc, loopNode);
+  if (phi == nullptr) {
+    return notMinMax;
+  }
+  Value *update = nullptr;
+  for (auto i = 0u; i < phi->getNumIncomingValues(); i++) {
+    if (rootLoop->isIncluded(phi->getIncomingBlock(i))) {
+      update = phi->getIncomingValue(i);
+    }
+  }
+  auto updateInst = dyn_cast<Instruction>(update);
+  if ((updateInst == nullptr) || !scc->isInternal(updateInst)) {
+    return notMinMax;
+  }
+
+  /*
+   * Check the update computes the min/max of the accumulator.
+   */
+  auto minMax = this->matchMinMaxUpdate(updateInst, loopNode);
+  if (minMax.first != phi) {
+    return notMinMax;
+  }
+  auto kind = minMax.second;
+  if (RecurrenceDescriptor::isFPMinMaxRecurrenceKind(kind)
+      && (!this->enableFloatAsReal)) {
+    return notMinMax;
+  }
+
+  /*
+   * The SCC must only include the accumulator, the update, and the compare of
+   * the update (if any).
+   */
+  std::set<Instruction *> sccInsts{ phi, updateInst };
+  CmpInst *cmp = nullptr;
+  if (auto select = dyn_cast<SelectInst>(updateInst)) {
+    cmp = cast<CmpInst>(select->getCondition());
+    sccInsts.insert(cmp);
+  }
+  if (scc->numberOfInstructions() != (int64_t)sccInsts.size()) {
+    return notMinMax;
+  }
+  for (auto inst : sccInsts) {
+    if (!scc->isInternal(inst)) {
+      return notMinMax;
+    }
+  }
+
+  /*
+   * Intermediate values of the accumulator cannot be observed within the
+   * loop. The only exceptions are the selects of the indexes paired with the
+   * min/max (e.g., argmin), which are reduced together with it.
+   */
+  auto isObservedWithinLoop = [&](Instruction *inst) -> bool {
+    for (auto user : inst->users()) {
+      auto userInst = cast<Instruction>(user);
+      if (sccInsts.find(userInst) != sccInsts.end()) {
+        continue;
+      }
+      if (!rootLoop->isIncluded(userInst)) {
+        if (inst == cmp) {
+          return true;
+        }
+        continue;
+      }
+      auto userSelect = dyn_cast<SelectInst>(userInst);
+      if ((inst == cmp) && (userSelect != nullptr)
+          && (std::get<0>(this->matchArgMinMaxUpdate(userSelect,
+                                                     loopNode,
+                                                     IVs))
+              != nullptr)) {
+        continue;
+      }
+      return true;
+    }
+    return false;
+  };
+  for (auto inst : sccInsts) {
+    if (isObservedWithinLoop(inst)) {
+      return notMinMax;
+    }
+  }
+
+  return std::make_tuple(phi, initialValue, kind);
+}
+
+std::tuple<PHINode *, Value *, PHINode *, RecurKind, bool> SCCDAGAttrs::
+    checkIfArgMinMaxReduction(SCC *scc,
+                              LoopTree *loopNode,
+                              std::set<InductionVariable *> &IVs) const {
+  auto notArgMinMax =
+      std::make_tuple<PHINode *, Value *, PHINode *, RecurKind, bool>(
+          nullptr,
+          nullptr,
+          nullptr,
+          RecurKind::None,
+          false);
+
+  /*
+   * Fetch the index accumulator.
+   */
+  auto rootLoop = loopNode->getLoop();
+  auto [phi, initialValue] = this->fetchHeaderPHIOfSCC(scc, loopNode);
+  if (phi == nullptr) {
+    return notArgMinMax;
+  }
+
+  /*
+   * The SCC must only include the accumulator and the select that updates it.
+   */
+  if (scc->numberOfInstructions() != 2) {
+    return notArgMinMax;
+  }
+  SelectInst *update = nullptr;
+  for (auto i = 0u; i < phi->getNumIncomingValues(); i++) {
+    if (rootLoop->isIncluded(phi->getIncomingBlock(i))) {
+      update = dyn_cast<SelectInst>(phi->getIncomingValue(i));
+    }
+  }
+  if ((update == nullptr) || !scc->isInternal(update)) {
+    return notArgMinMax;
+  }
+  auto [indexPHI, minMaxPHI, kind, isIndexIncreasing] =
+      this->matchArgMinMaxUpdate(update, loopNode, IVs);
+  if (indexPHI != phi) {
+    return notArgMinMax;
+  }
+
+  /*
+   * The min/max must be a reduction as well.
+   */
+  auto minMaxSCC = this->sccdag->sccOfValue(minMaxPHI);
+  if (std::get<0>(this->checkIfMinMaxReduction(minMaxSCC, loopNode, IVs))
+      != minMaxPHI) {
+    return notArgMinMax;
+  }
+
+  /*
+   * Intermediate values of the index cannot be observed within the loop.
+   */
+  for (auto inst : std::vector<Instruction *>{ phi, update }) {
+    for (auto user : inst->users()) {
+      auto userInst = cast<Instruction>(user);
+      if ((userInst == phi) || (userInst == update)) {
+        continue;
+      }
+      if (rootLoop->isIncluded(userInst)) {
+        return notArgMinMax;
+      }
+    }
+  }
+
+  return std::make_tuple(phi,
+                         initialValue,
+                         minMaxPHI,
+                         kind,
+                         isIndexIncreasing);
+}
+
 /*
  * The SCC is independent if it doesn't have loop carried data dependencies
  */
@@ -978,6 +1440,201 @@ std::set<ClonableMemoryObject *> SCCDAGAttrs::checkIfClonableByUsingLocalMemory(
   return locations;
 }
 
+std::tuple<Value *, Instruction::BinaryOps, std::unordered_set<Instruction *>>
+SCCDAGAttrs::checkIfArrayReduction(SCC *scc, LoopTree *loopNode) const {
+  std::tuple<Value *, Instruction::BinaryOps, std::unordered_set<Instruction *>>
+      notAnArrayReduction{ nullptr, Instruction::Add, {} };
+
+  /*
+   * Check if array reductions are enabled.
+   */
+  if (this->maximumSizeOfArrayReductions == 0) {
+    return notAnArrayReduction;
+  }
+
+  /*
+   * Check if the SCC has loop-carried dependences and all of them go through
+   * memory.
+   * External control dependences are ignored.
+   */
+  if (this->sccToLoopCarriedDependencies.find(scc)
+      == this->sccToLoopCarriedDependencies.end()) {
+    return notAnArrayReduction;
+  }
+  for (auto dependency : this->sccToLoopCarriedDependencies.at(scc)) {
+    if (isa<ControlDependence<Value, Value>>(dependency)) {
+      if (scc->isInternal(dependency->getSrc())) {
+        return notAnArrayReduction;
+      }
+      continue;
+    }
+    if (!isa<MemoryDependence<Value, Value>>(dependency)) {
+      return notAnArrayReduction;
+    }
+  }
+
+  /*
+   * Every instruction of the SCC must belong to a read-modify-write of an
+   * element of the array: a load, a binary operator that combines the loaded
+   * value with a value computed outside the SCC, and a store of the result to
+   * the loaded address.
+   * Each store identifies one read-modify-write.
+   */
+  auto rootLoop = loopNode->getLoop();
+  Value *array = nullptr;
+  Type *arrayType = nullptr;
+  std::optional<Instruction::BinaryOps> reductionOperation;
+  std::unordered_set<Instruction *> memoryAccesses;
+  uint64_t numberOfUpdates = 0;
+  auto instructions = scc->getInstructions();
+  for (auto inst : instructions) {
+    auto store = dyn_cast<StoreInst>(inst);
+    if (store == nullptr) {
+      continue;
+    }
+    if (!store->isSimple()) {
+      return notAnArrayReduction;
+    }
+
+    /*
+     * Fetch the update of the element.
+     */
+    auto update = dyn_cast<BinaryOperator>(store->getValueOperand());
+    if ((update == nullptr) || (!scc->isInternal(update))
+        || (!update->hasOneUse())) {
+      return notAnArrayReduction;
+    }
+
+    /*
+     * Fetch the load of the element.
+     * Its value must be consumed only by the update, and the other operand of
+     * the update must not depend on the array.
+     */
+    auto load = dyn_cast<LoadInst>(update->getOperand(0));
+    auto otherOperand = update->getOperand(1);
+    if ((load == nullptr) && update->isCommutative()) {
+      load = dyn_cast<LoadInst>(update->getOperand(1));
+      otherOperand = update->getOperand(0);
+    }
+    if ((load == nullptr) || (!scc->isInternal(load)) || (!load->isSimple())
+        || (!load->hasOneUse())
+        || (load->getPointerOperand() != store->getPointerOperand())
+        || scc->isInternal(otherOperand)) {
+      return notAnArrayReduction;
+    }
+
+    /*
+     * Fetch the operation that combines two copies of the element.
+     * Subtractions accumulate the negated values, which are then added.
+     */
+    std::optional<Instruction::BinaryOps> op;
+    switch (update->getOpcode()) {
+      case Instruction::Add:
+      case Instruction::Sub:
+        op = Instruction::Add;
+        break;
+      case Instruction::Mul:
+      case Instruction::And:
+      case Instruction::Or:
+      case Instruction::Xor:
+        op = update->getOpcode();
+        break;
+      case Instruction::FAdd:
+      case Instruction::FSub:
+        if (this->enableFloatAsReal) {
+          op = Instruction::FAdd;
+        }
+        break;
+      case Instruction::FMul:
+        if (this->enableFloatAsReal) {
+          op = Instruction::FMul;
+        }
+        break;
+      default:
+        break;
+    }
+    if (!op || (reductionOperation && (*reductionOperation != *op))) {
+      return notAnArrayReduction;
+    }
+    reductionOperation = op;
+
+    /*
+     * The element must be accessed by indexing the array directly, so the
+     * private copies can be accessed the same way.
+     */
+    auto gep = dyn_cast<GEPOperator>(store->getPointerOperand());
+    if (gep == nullptr) {
+      return notAnArrayReduction;
+    }
+    auto object = gep->getPointerOperand();
+    if ((array != nullptr) && (array != object)) {
+      return notAnArrayReduction;
+    }
+    if (auto allocation = dyn_cast<AllocaInst>(object)) {
+      if (allocation->isArrayAllocation()
+          || rootLoop->isIncluded(allocation)) {
+        return notAnArrayReduction;
+      }
+      arrayType = allocation->getAllocatedType();
+    } else if (auto global = dyn_cast<GlobalVariable>(object)) {
+      arrayType = global->getValueType();
+    } else {
+      return notAnArrayReduction;
+    }
+    auto elementType = ArrayReductionSCC::getElementTypeOfArrayType(arrayType);
+    if ((gep->getSourceElementType() != arrayType)
+        || (gep->getResultElementType() != elementType)
+        || (elementType != load->getType())) {
+      return notAnArrayReduction;
+    }
+    array = object;
+
+    memoryAccesses.insert(load);
+    memoryAccesses.insert(store);
+    numberOfUpdates++;
+  }
+  if ((array == nullptr) || ((3 * numberOfUpdates) != instructions.size())) {
+    return notAnArrayReduction;
+  }
+
+  /*
+   * Check the size of the array.
+   */
+  auto &DL = rootLoop->getFunction()->getParent()->getDataLayout();
+  auto sizeInBytes = DL.getTypeAllocSize(arrayType);
+  if ((sizeInBytes == 0)
+      || (sizeInBytes > this->maximumSizeOfArrayReductions)) {
+    return notAnArrayReduction;
+  }
+
+  /*
+   * No other instruction of the loop can access the array: it would observe
+   * a partial value of an element.
+   */
+  auto isOutsideTheSCC = [scc, rootLoop](Value *v,
+                                         DGEdge<Value, Value> *d) -> bool {
+    auto inst = dyn_cast<Instruction>(v);
+    return (inst != nullptr) && rootLoop->isIncluded(inst)
+           && (!scc->isInternal(inst));
+  };
+  for (auto access : memoryAccesses) {
+    if (this->loopDG->iterateOverDependencesFrom(access,
+                                                 false,
+                                                 true,
+                                                 false,
+                                                 isOutsideTheSCC)
+        || this->loopDG->iterateOverDependencesTo(access,
+                                                  false,
+                                                  true,
+                                                  false,
+                                                  isOutsideTheSCC)) {
+      return notAnArrayReduction;
+    }
+  }
+
+  return std::make_tuple(array, *reductionOperation, memoryAccesses);
+}
+
 SCCDAG *SCCDAGAttrs::getSCCDAG(void) const {
   return this->sccdag;
 }
@@ -20,7 +20,6 @@
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "arcana/noelle/core/LoopStructure.hpp"
-#include "arcana/noelle/core/MetadataManager.hpp"
 
 namespace arcana::noelle {
 
@@ -241,36 +240,41 @@ void LoopStructure::print(raw_ostream &stream) {
 }
 
 std::optional<uint64_t> LoopStructure::getID(void) {
-  Module *M = this->header->getModule();
-  MetadataManager metadataManager{ *M };
-  if (metadataManager.doesHaveMetadata(this, LoopStructure::metadataKeyID)) {
-    std::string idAsString =
-        metadataManager.getMetadata(this, LoopStructure::metadataKeyID);
-    uint64_t ID = std::stoi(idAsString);
-    return ID;
+
+  /*
+   * The ID is attached to the terminator of the header.
+   * Read it directly from there rather than going through a MetadataManager,
+   * which would scan the whole module for its source code annotations.
+   */
+  auto headerTerm = this->header->getTerminator();
+  auto metaNode = headerTerm->getMetadata(LoopStructure::metadataKeyID);
+  if (metaNode == nullptr) {
+    return std::nullopt;
   }
+  auto idAsString = cast<MDString>(metaNode->getOperand(0))->getString();
+  uint64_t ID = std::stoi(idAsString.str());
 
-  return std::nullopt;
+  return ID;
 }
 
 bool LoopStructure::doesHaveID(void) {
-  Module *M = this->header->getModule();
-  MetadataManager metadataManager{ *M };
-  return metadataManager.doesHaveMetadata(this, LoopStructure::metadataKeyID);
+  auto headerTerm = this->header->getTerminator();
+  auto metaNode = headerTerm->getMetadata(LoopStructure::metadataKeyID);
+
+  return metaNode != nullptr;
 }
 
 void LoopStructure::setID(uint64_t ID) {
-  Module *M = this->header->getModule();
-  MetadataManager metadataManager{ *M };
-  if (this->doesHaveID()) {
-    metadataManager.setMetadata(this,
-                                LoopStructure::metadataKeyID,
-                                std::to_string(ID));
-  } else {
-    metadataManager.addMetadata(this,
-                                LoopStructure::metadataKeyID,
-                                std::to_string(ID));
-  }
+
+  /*
+   * Attach the ID to the terminator of the header, replacing the previous one
+   * if it exists.
+   */
+  auto headerTerm = this->header->getTerminator();
+  auto &cxt = headerTerm->getContext();
+  auto s = MDString::get(cxt, std::to_string(ID));
+  auto n = MDNode::get(cxt, s);
+  headerTerm->setMetadata(LoopStructure::metadataKeyID, n);
 
   return;
 }
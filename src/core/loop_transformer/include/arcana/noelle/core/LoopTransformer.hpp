@@ -41,6 +41,12 @@ public:
 
   void setPDG(PDG *programDependenceGraph);
 
+  /*
+   * Set the function to invoke every time a transformation modifies a
+   * function.
+   */
+  void setFunctionModifiedCallback(std::function<void(Function *)> callback);
+
   LoopUnrollResult unrollLoop(LoopContent *loop, uint32_t unrollFactor);
 
   bool fullyUnrollLoop(LoopContent *loop);
@@ -61,6 +67,9 @@ private:
   std::function<llvm::PostDominatorTree &(Function &F)> getPDT;
   std::function<llvm::DominatorTree &(Function &F)> getDT;
   std::function<llvm::AssumptionCache &(Function &F)> getAssumptionCache;
+  std::function<void(Function *)> functionModified;
+
+  void notifyFunctionModified(Function *f);
 };
 
 } // namespace arcana::noelle
@@ -37,7 +37,8 @@ LoopTransformer::LoopTransformer(
     getLoopInfo{ getLoopInfo },
     getPDT{ getPDT },
     getDT{ getDT },
-    getAssumptionCache{ getAssumptionCache } {
+    getAssumptionCache{ getAssumptionCache },
+    functionModified{} {
   return;
 }
 
@@ -48,6 +49,21 @@ void LoopTransformer::setPDG(PDG *programDependenceGraph) {
   return;
 }
 
+void LoopTransformer::setFunctionModifiedCallback(
+    std::function<void(Function *)> callback) {
+  this->functionModified = callback;
+
+  return;
+}
+
+void LoopTransformer::notifyFunctionModified(Function *f) {
+  if (this->functionModified) {
+    this->functionModified(f);
+  }
+
+  return;
+}
+
 LoopUnrollResult LoopTransformer::unrollLoop(LoopContent *loop,
                                              uint32_t unrollFactor) {
 
@@ -86,6 +102,9 @@ LoopUnrollResult LoopTransformer::unrollLoop(LoopContent *loop,
   TargetTransformInfo TTI(lsFunction->getParent()->getDataLayout());
   auto unrolled =
       UnrollLoop(llvmLoop, opts, &LLVMLoops, &SE, &DT, &AC, &TTI, &ORE, true);
+  if (unrolled != LoopUnrollResult::Unmodified) {
+    this->notifyFunctionModified(lsFunction);
+  }
 
   return unrolled;
 }
@@ -107,6 +126,9 @@ bool LoopTransformer::fullyUnrollLoop(LoopContent *loop) {
   auto &SE = this->getSCEV(loopFunction);
   auto &AC = this->getAssumptionCache(loopFunction);
   auto modified = loopUnroll.fullyUnrollLoop(*loop, LS, DT, SE, AC);
+  if (modified) {
+    this->notifyFunctionModified(&loopFunction);
+  }
 
   return modified;
 }
@@ -134,6 +156,9 @@ bool LoopTransformer::whilifyLoop(LoopContent *loop) {
    * Whilify the loop.
    */
   auto modified = loopWhilify.whilifyLoop(*loop, scheduler, DS, FDG);
+  if (modified) {
+    this->notifyFunctionModified(func);
+  }
 
   return modified;
 }
@@ -162,6 +187,9 @@ bool LoopTransformer::splitLoop(LoopContent *loop,
                                SCCsToPullOut,
                                instructionsRemoved,
                                instructionsAdded);
+  if (modified) {
+    this->notifyFunctionModified(loop->getLoopStructure()->getFunction());
+  }
 
   return modified;
 }
@@ -28,9 +28,44 @@ namespace arcana::noelle {
 
 typedef uint32_t NodeID;
 
+class CallGraph;
+
+/*
+ * Interprocedural summary of a function.
+ *
+ * The per-parameter entries are indexed by the position of the parameter, and
+ * they are false for parameters that are not pointers.
+ */
+class MpaFunctionSummary {
+public:
+  /*
+   * The memory reachable from the parameter may still be reachable after the
+   * function returns: from memory objects not allocated by the function, or
+   * from its return value.
+   */
+  std::vector<bool> capturedParameters;
+
+  /*
+   * The memory reachable from the parameter may be written (mod) or read (ref)
+   * by the function or by its callees.
+   */
+  std::vector<bool> modParameters;
+  std::vector<bool> refParameters;
+
+  /*
+   * The returned pointer can only point to memory objects that have been
+   * allocated by the invocation and that did not escape otherwise, like the
+   * one returned by malloc.
+   */
+  bool returnsFreshMemobj = false;
+};
+
+typedef std::unordered_map<Function *, MpaFunctionSummary> MpaFunctionSummaries;
+
 class MpaSummary {
 public:
-  MpaSummary(Function *currentF);
+  MpaSummary(Function *currentF,
+             const MpaFunctionSummaries *calleeSummaries = nullptr);
 
   Function *currentF;
 
@@ -44,11 +79,33 @@ public:
   bool mayBePointedByReturnValue(Value *memobj);
   std::unordered_set<Value *> getPointeeMemobjs(Value *ptr);
 
+  /*
+   * Bitset-based queries.
+   * A bit is the NodeID of a pointee memory object, where the "unknown" memory
+   * object is bit UnknownMemobjId.
+   */
+  const BitVector &getPointeeBits(Value *ptr);
+  bool mayPointToUnknown(Value *ptr);
+  bool mayPointToACommonMemobj(Value *ptr1, Value *ptr2);
+
   void doMayPointsToAnalysis(void);
   void doMayPointsToAnalysisFor(GlobalVariable *globalVar);
   void clearPointsToSummary(void);
 
+  /*
+   * Compute the interprocedural summary of the current function from its
+   * points-to graph.
+   */
+  MpaFunctionSummary summarize(void);
+
 private:
+  /*
+   * The summaries of the callees that have already been analyzed.
+   * Calls to the other functions are handled conservatively.
+   */
+  const MpaFunctionSummaries *calleeSummaries;
+  std::unordered_set<CallBase *> userDefinedCallInsts;
+
   /*
    * All pointers may be used as return value of the current function.
    */
@@ -88,6 +145,16 @@ private:
    *
    * The "unkonwn" memory object is a summary of several memory objects, hence
    * it will point to itself.
+   *
+   * 3. Each pointer argument of the current function also points to a memory
+   * object represented by the argument itself, which summarizes all memory
+   * reachable from the argument. The argument (and this memory object) also
+   * points to the "unknown" memory object to preserve conservativeness: these
+   * memory objects only tell which argument a pointer may come from, which is
+   * what the interprocedural summary of the current function needs.
+   *
+   * 4. A call to a function whose summary returns a fresh memory object
+   * allocates a memory object, represented by the callInst, like malloc.
    */
   std::unordered_map<Value *, NodeID> memobj2nodeId;
   std::unordered_map<NodeID, Value *> nodeId2memobj;
@@ -99,6 +166,14 @@ private:
    * pointee memory objects.
    */
   std::unordered_map<NodeID, BitVector> pointsTo;
+  const BitVector noPointees;
+
+  /*
+   * Results of mayPointToACommonMemobj, keyed by the ordered pair of stripped
+   * pointers.
+   * They are valid until the points-to summary is cleared.
+   */
+  DenseMap<std::pair<Value *, Value *>, bool> commonMemobjResults;
 
   /*
    * A copy edge (src => dest) means that dest may point to the same memory
@@ -130,6 +205,14 @@ private:
    */
   std::unordered_set<NodeID> usedAsFuncArg;
 
+  /*
+   * Pointers given to callees that may write the memory reachable from them
+   * without capturing it, and the memory objects reachable from them.
+   * These memory objects may point to the "unknown" memory object after the
+   * call.
+   */
+  std::unordered_set<NodeID> modifiedByFuncCall;
+
   /*
    * privatizeCandidate is a global variable that we want to privatize into the
    * current function. "Privatize" means we want to transform the global
@@ -177,11 +260,16 @@ private:
   NodeID getPtrId(Value *v);
   bool addCopyEdge(NodeID src, NodeID dst);
 
+  const MpaFunctionSummary *getCalleeSummary(CallBase *callInst);
+  bool returnsFreshMemobj(CallBase *callInst);
+  void handleUserDefinedCall(NodeID ptrId, Value *ptr, CallBase *callInst);
+
   void initPtInfo(void);
   void solveWorklist(void);
 
   void handleLoadStore(NodeID ptrId);
   void handleFuncUsers(NodeID ptrId);
+  void handleModifyingFuncUsers(NodeID ptrId);
   void handleCopyEdges(NodeID srcId);
 
   BitVector getPointeeBitVector(NodeID nodeId);
@@ -198,10 +286,45 @@ public:
   bool notPrivatizable(GlobalVariable *globalVar, Function *currentF);
   std::unordered_set<Value *> getPointees(Value *ptr, Function *currentF);
 
+  /*
+   * Compute the interprocedural summaries of the functions of @callGraph.
+   *
+   * The strongly connected components of @callGraph are analyzed bottom-up, so
+   * the analysis of a function uses the summaries of its callees. Components
+   * that do not depend on each other are analyzed in parallel by
+   * @numberOfJobs threads.
+   * Calls within a component are handled conservatively.
+   */
+  void computeFunctionSummaries(noelle::CallGraph *callGraph,
+                                uint32_t numberOfJobs = 1);
+
+  /*
+   * Drop the points-to graphs and the interprocedural summaries of
+   * @functions, which might have been deleted.
+   */
+  void invalidateFunctionSummaries(
+      const std::unordered_set<Function *> &functions);
+
+  /*
+   * Compute the interprocedural summaries of @functions again.
+   *
+   * The summaries of @functions, and of their callers, must have been
+   * invalidated. The callees of a function in @functions are summarized before
+   * it; calls to a function of @functions that is not summarized yet (i.e.,
+   * recursive calls) are handled conservatively.
+   */
+  void summarizeFunctions(const std::vector<Function *> &functions);
+
+  /*
+   * Return the interprocedural summary of @f, or nullptr if there is none.
+   */
+  const MpaFunctionSummary *getInterproceduralSummary(Function *f) const;
+
   ~MayPointsToAnalysis();
 
 private:
   std::unordered_map<Function *, MpaSummary *> functionSummaries;
+  MpaFunctionSummaries interproceduralSummaries;
 
   MpaSummary *getFunctionSummary(Function *currentF);
 };
@@ -19,7 +19,9 @@
  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include "llvm/Support/ThreadPool.h"
 #include "arcana/noelle/core/MayPointsToAnalysis.hpp"
+#include "arcana/noelle/core/SCCCAG.hpp"
 #include "MpaUtils.hpp"
 
 namespace arcana::noelle {
@@ -59,24 +61,15 @@ bool MayPointsToAnalysis::mayAlias(Value *ptr1, Value *ptr2) {
   } else if (func1 != nullptr && func2 == nullptr) {
     auto funcSum = getFunctionSummary(func1);
     funcSum->doMayPointsToAnalysis();
-    return funcSum->getPointeeMemobjs(stripped1).count(nullptr) > 0;
+    return funcSum->mayPointToUnknown(stripped1);
   } else if (func1 == nullptr && func2 != nullptr) {
     auto funcSum = getFunctionSummary(func2);
     funcSum->doMayPointsToAnalysis();
-    return funcSum->getPointeeMemobjs(stripped2).count(nullptr) > 0;
+    return funcSum->mayPointToUnknown(stripped2);
   } else if (func1 == func2) {
     auto funcSum = getFunctionSummary(func1);
     funcSum->doMayPointsToAnalysis();
-    auto ptes1 = funcSum->getPointeeMemobjs(stripped1);
-    auto ptes2 = funcSum->getPointeeMemobjs(stripped2);
-    for (auto pte1 : ptes1) {
-      for (auto pte2 : ptes2) {
-        if (pte1 == pte2) {
-          return true;
-        }
-      }
-    }
-    return false;
+    return funcSum->mayPointToACommonMemobj(stripped1, stripped2);
   } else {
     return true;
   }
@@ -111,6 +104,171 @@ std::unordered_set<Value *> MayPointsToAnalysis::getPointees(
   return funcSum->getPointeeMemobjs(ptr);
 }
 
+void MayPointsToAnalysis::computeFunctionSummaries(noelle::CallGraph *callGraph,
+                                                   uint32_t numberOfJobs) {
+
+  /*
+   * The points-to graphs computed so far did not use the summaries.
+   */
+  for (auto &[f, funcSum] : functionSummaries) {
+    delete funcSum;
+  }
+  functionSummaries.clear();
+  interproceduralSummaries.clear();
+
+  /*
+   * Count the callees of each SCC of the call graph.
+   * An SCC is analyzed once all its callees have been summarized.
+   */
+  SCCCAG sccCAG(callGraph);
+  std::unordered_map<SCCCAGNode *, uint64_t> calleesToSummarize;
+  std::vector<SCCCAGNode *> ready;
+  for (auto node : sccCAG.getNodes()) {
+    auto callees = sccCAG.getOutgoingEdges(node);
+    auto numCallees = callees.size() - callees.count(node);
+    calleesToSummarize[node] = numCallees;
+    if (numCallees == 0) {
+      ready.push_back(node);
+    }
+  }
+
+  auto getFunctionsOfSCC = [](SCCCAGNode *node) -> std::vector<Function *> {
+    std::vector<CallGraphFunctionNode *> cgNodes;
+    if (node->isAnSCC()) {
+      auto sccNode = static_cast<SCCCAGNode_SCC *>(node);
+      for (auto cgNode : sccNode->getInternalNodes()) {
+        cgNodes.push_back(cgNode);
+      }
+    } else {
+      auto funcNode = static_cast<SCCCAGNode_Function *>(node);
+      cgNodes.push_back(funcNode->getNode());
+    }
+    std::vector<Function *> functions;
+    for (auto cgNode : cgNodes) {
+      auto f = cgNode->getFunction();
+      if (!f->empty()) {
+        functions.push_back(f);
+      }
+    }
+    return functions;
+  };
+
+  /*
+   * Analyze the SCCs bottom-up.
+   *
+   * The SCCs that are ready do not depend on each other, so they are analyzed
+   * by the threads of the pool. The summaries are published only once all of
+   * them are done; hence, the threads only read the summaries of the SCCs
+   * analyzed before.
+   */
+  typedef std::vector<std::pair<MpaSummary *, MpaFunctionSummary>> Results;
+  ThreadPool pool(hardware_concurrency(numberOfJobs));
+  while (!ready.empty()) {
+    std::vector<std::shared_future<Results>> pendingResults;
+    for (auto node : ready) {
+      auto functions = getFunctionsOfSCC(node);
+      auto result = pool.async([this, functions]() -> Results {
+        Results results;
+        for (auto f : functions) {
+          auto funcSum = new MpaSummary(f, &this->interproceduralSummaries);
+          funcSum->doMayPointsToAnalysis();
+          results.push_back(std::make_pair(funcSum, funcSum->summarize()));
+        }
+        return results;
+      });
+      pendingResults.push_back(result);
+    }
+    pool.wait();
+
+    for (auto &pendingResult : pendingResults) {
+      for (auto &[funcSum, summary] : pendingResult.get()) {
+        functionSummaries[funcSum->currentF] = funcSum;
+        interproceduralSummaries[funcSum->currentF] = summary;
+      }
+    }
+
+    /*
+     * Fetch the SCCs whose callees have now been summarized.
+     */
+    std::vector<SCCCAGNode *> nextReady;
+    for (auto node : ready) {
+      for (auto &[caller, edge] : sccCAG.getIncomingEdges(node)) {
+        if (caller == node) {
+          continue;
+        }
+        calleesToSummarize[caller]--;
+        if (calleesToSummarize[caller] == 0) {
+          nextReady.push_back(caller);
+        }
+      }
+    }
+    ready = nextReady;
+  }
+
+  return;
+}
+
+void MayPointsToAnalysis::invalidateFunctionSummaries(
+    const std::unordered_set<Function *> &functions) {
+  for (auto f : functions) {
+    auto funcSumIt = functionSummaries.find(f);
+    if (funcSumIt != functionSummaries.end()) {
+      delete funcSumIt->second;
+      functionSummaries.erase(funcSumIt);
+    }
+    interproceduralSummaries.erase(f);
+  }
+
+  return;
+}
+
+void MayPointsToAnalysis::summarizeFunctions(
+    const std::vector<Function *> &functions) {
+  std::unordered_set<Function *> toSummarize(functions.begin(),
+                                             functions.end());
+
+  /*
+   * Summarize the functions in post-order of their calls, so the callees are
+   * summarized before their callers.
+   */
+  std::unordered_set<Function *> visited;
+  std::function<void(Function *)> summarizeFunction = [&](Function *f) {
+    if (!visited.insert(f).second) {
+      return;
+    }
+    for (auto &inst : instructions(*f)) {
+      auto callInst = dyn_cast<CallBase>(&inst);
+      if (callInst == nullptr) {
+        continue;
+      }
+      auto callee = callInst->getCalledFunction();
+      if ((callee != nullptr)
+          && (toSummarize.find(callee) != toSummarize.end())) {
+        summarizeFunction(callee);
+      }
+    }
+
+    auto funcSum = new MpaSummary(f, &interproceduralSummaries);
+    funcSum->doMayPointsToAnalysis();
+    interproceduralSummaries[f] = funcSum->summarize();
+    functionSummaries[f] = funcSum;
+  };
+  for (auto f : functions) {
+    summarizeFunction(f);
+  }
+
+  return;
+}
+
+const MpaFunctionSummary *MayPointsToAnalysis::getInterproceduralSummary(
+    Function *f) const {
+  auto summaryIt = interproceduralSummaries.find(f);
+  if (summaryIt == interproceduralSummaries.end()) {
+    return nullptr;
+  }
+  return &summaryIt->second;
+}
+
 MayPointsToAnalysis::~MayPointsToAnalysis() {
   for (auto &[f, funcSum] : functionSummaries) {
     delete funcSum;
@@ -120,7 +278,8 @@ MayPointsToAnalysis::~MayPointsToAnalysis() {
 
 MpaSummary *MayPointsToAnalysis::getFunctionSummary(Function *currentF) {
   if (functionSummaries.find(currentF) == functionSummaries.end()) {
-    functionSummaries[currentF] = new MpaSummary(currentF);
+    functionSummaries[currentF] =
+        new MpaSummary(currentF, &interproceduralSummaries);
   }
   return functionSummaries[currentF];
 }
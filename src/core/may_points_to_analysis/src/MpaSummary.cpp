@@ -26,7 +26,10 @@ using namespace std;
 
 namespace arcana::noelle {
 
-MpaSummary::MpaSummary(Function *currentF) : currentF(currentF) {
+MpaSummary::MpaSummary(Function *currentF,
+                       const MpaFunctionSummaries *calleeSummaries)
+  : currentF(currentF),
+    calleeSummaries(calleeSummaries) {
 
   auto insertPointer = [&](Value *v) {
     if (v->getType()->isPointerTy()) {
@@ -97,6 +100,9 @@ MpaSummary::MpaSummary(Function *currentF) : currentF(currentF) {
             insertPointer(callInst);
             break;
           default:
+            if (calleeType == USER_DEFINED) {
+              userDefinedCallInsts.insert(callInst);
+            }
             insertPointer(callInst);
             for (auto &arg : callInst->args()) {
               auto operand = callInst->getArgOperand(arg.getOperandNo());
@@ -127,18 +133,18 @@ MpaSummary::MpaSummary(Function *currentF) : currentF(currentF) {
 }
 
 unordered_set<Value *> MpaSummary::getPointeeMemobjs(Value *ptr) {
-  assert(mpaFinished);
-
-  auto stripped = strip(ptr);
-  assert(ptr2nodeId.find(stripped) != ptr2nodeId.end());
-
-  auto ptrId = ptr2nodeId[stripped];
   unordered_set<Value *> pointees;
 
-  auto pointeeBitVec = getPointeeBitVector(ptrId);
+  auto &pointeeBitVec = getPointeeBits(ptr);
   for (auto memobjId : pointeeBitVec.set_bits()) {
     if (memobjId == UnknownMemobjId) {
       pointees.insert(nullptr);
+    } else if (isa<Argument>(nodeId2memobj[memobjId])) {
+      /*
+       * The memory objects of the arguments always come with the "unknown"
+       * memory object.
+       */
+      continue;
     } else {
       pointees.insert(nodeId2memobj[memobjId]);
     }
@@ -146,9 +152,52 @@ unordered_set<Value *> MpaSummary::getPointeeMemobjs(Value *ptr) {
   return pointees;
 }
 
+const BitVector &MpaSummary::getPointeeBits(Value *ptr) {
+  assert(mpaFinished);
+
+  auto stripped = strip(ptr);
+  assert(ptr2nodeId.find(stripped) != ptr2nodeId.end());
+
+  auto ptrId = ptr2nodeId[stripped];
+  auto ptsIt = pointsTo.find(ptrId);
+  if (ptsIt == pointsTo.end()) {
+    return noPointees;
+  }
+  return ptsIt->second;
+}
+
+bool MpaSummary::mayPointToUnknown(Value *ptr) {
+  auto &pointeeBitVec = getPointeeBits(ptr);
+  return (UnknownMemobjId < pointeeBitVec.size())
+         && pointeeBitVec.test(UnknownMemobjId);
+}
+
+bool MpaSummary::mayPointToACommonMemobj(Value *ptr1, Value *ptr2) {
+  assert(mpaFinished);
+
+  /*
+   * The relation is symmetric, so both orders share the same entry.
+   */
+  auto stripped1 = strip(ptr1);
+  auto stripped2 = strip(ptr2);
+  if (stripped2 < stripped1) {
+    std::swap(stripped1, stripped2);
+  }
+  auto key = std::make_pair(stripped1, stripped2);
+  auto resultIt = commonMemobjResults.find(key);
+  if (resultIt != commonMemobjResults.end()) {
+    return resultIt->second;
+  }
+
+  auto result = getPointeeBits(stripped1).anyCommon(getPointeeBits(stripped2));
+  commonMemobjResults[key] = result;
+
+  return result;
+}
+
 bool MpaSummary::mayBePointedByUnknown(Value *memobj) {
   assert(mpaFinished);
-  assert(getAllocations().count(memobj) > 0);
+  assert(memobj2nodeId.count(memobj) > 0);
   auto memobjId = memobj2nodeId.at(memobj);
 
   auto unknownPts = getreachableMemobjIds(UnknownMemobjId);
@@ -160,7 +209,7 @@ bool MpaSummary::mayBePointedByUnknown(Value *memobj) {
 
 bool MpaSummary::mayBePointedByReturnValue(Value *memobj) {
   assert(mpaFinished);
-  assert(getAllocations().count(memobj) > 0);
+  assert(memobj2nodeId.count(memobj) > 0);
   auto memobjId = memobj2nodeId.at(memobj);
 
   for (auto retPtr : returnPointers) {
@@ -173,6 +222,163 @@ bool MpaSummary::mayBePointedByReturnValue(Value *memobj) {
   return false;
 }
 
+MpaFunctionSummary MpaSummary::summarize(void) {
+  assert(mpaFinished);
+
+  MpaFunctionSummary summary;
+  auto numArgs = currentF->arg_size();
+  summary.capturedParameters.assign(numArgs, false);
+  summary.modParameters.assign(numArgs, false);
+  summary.refParameters.assign(numArgs, false);
+
+  /*
+   * Fetch the memory objects that escape from the current function.
+   */
+  auto escaped = getreachableMemobjIds(UnknownMemobjId);
+  for (auto retPtr : returnPointers) {
+    auto retMemobjs = getreachableMemobjIds(getPtrId(retPtr));
+    escaped.insert(retMemobjs.begin(), retMemobjs.end());
+  }
+
+  /*
+   * A parameter is captured if the memory object of the argument escapes.
+   */
+  unordered_map<NodeID, unsigned> argOfMemobj;
+  for (auto &arg : currentF->args()) {
+    auto memobjIt = memobj2nodeId.find(&arg);
+    if (memobjIt == memobj2nodeId.end()) {
+      continue;
+    }
+    auto memobjId = memobjIt->second;
+    argOfMemobj[memobjId] = arg.getArgNo();
+    if (escaped.find(memobjId) != escaped.end()) {
+      summary.capturedParameters[arg.getArgNo()] = true;
+    }
+  }
+
+  /*
+   * Compute the mod/ref of the memory reachable from the parameters.
+   * A pointer without points-to information may access the memory of any
+   * parameter.
+   */
+  auto markAccess = [&](Value *ptr, vector<bool> &accesses) {
+    auto stripped = strip(ptr);
+    if (ptr2nodeId.find(stripped) == ptr2nodeId.end()) {
+      for (auto &[memobjId, argNo] : argOfMemobj) {
+        accesses[argNo] = true;
+      }
+      return;
+    }
+    for (auto memobjId : getPointeeBits(stripped).set_bits()) {
+      auto argIt = argOfMemobj.find(memobjId);
+      if (argIt != argOfMemobj.end()) {
+        accesses[argIt->second] = true;
+      }
+    }
+  };
+  auto markPointerArgs = [&](CallBase *callInst, vector<bool> &accesses) {
+    for (auto &arg : callInst->args()) {
+      if (arg->getType()->isPointerTy()) {
+        markAccess(arg, accesses);
+      }
+    }
+  };
+  for (auto &inst : instructions(currentF)) {
+    if (auto loadInst = dyn_cast<LoadInst>(&inst)) {
+      markAccess(loadInst->getPointerOperand(), summary.refParameters);
+
+    } else if (auto storeInst = dyn_cast<StoreInst>(&inst)) {
+      markAccess(storeInst->getPointerOperand(), summary.modParameters);
+
+    } else if (auto callInst = dyn_cast<CallBase>(&inst)) {
+      switch (getCalleeFunctionType(callInst)) {
+        case MALLOC:
+        case CALLOC:
+        case INTRINSIC:
+          break;
+        case READ_ONLY:
+          markPointerArgs(callInst, summary.refParameters);
+          break;
+        case MEM_COPY:
+          markAccess(callInst->getArgOperand(0), summary.modParameters);
+          markAccess(callInst->getArgOperand(1), summary.refParameters);
+          break;
+        case FREE:
+        case REALLOC:
+          markAccess(callInst->getArgOperand(0), summary.modParameters);
+          markAccess(callInst->getArgOperand(0), summary.refParameters);
+          break;
+        case USER_DEFINED: {
+          auto calleeSummary = getCalleeSummary(callInst);
+          if (calleeSummary == nullptr) {
+            markPointerArgs(callInst, summary.modParameters);
+            markPointerArgs(callInst, summary.refParameters);
+            break;
+          }
+          for (auto argID = 0u; argID < callInst->arg_size(); argID++) {
+            auto arg = callInst->getArgOperand(argID);
+            if (!arg->getType()->isPointerTy()) {
+              continue;
+            }
+            auto isKnown = argID < calleeSummary->modParameters.size();
+            if (!isKnown || calleeSummary->modParameters[argID]) {
+              markAccess(arg, summary.modParameters);
+            }
+            if (!isKnown || calleeSummary->refParameters[argID]) {
+              markAccess(arg, summary.refParameters);
+            }
+          }
+          break;
+        }
+        default:
+          markPointerArgs(callInst, summary.modParameters);
+          markPointerArgs(callInst, summary.refParameters);
+          break;
+      }
+
+    } else if (inst.mayReadOrWriteMemory()) {
+      for (auto &[memobjId, argNo] : argOfMemobj) {
+        summary.modParameters[argNo] = true;
+        summary.refParameters[argNo] = true;
+      }
+    }
+  }
+
+  /*
+   * The returned pointer is fresh if it can only point to heap memory
+   * objects allocated in the current function that do not escape otherwise.
+   * A returned pointer without points-to information (e.g., inttoptr) is not.
+   */
+  if (currentF->getReturnType()->isPointerTy()) {
+    auto unknownMemobjs = getreachableMemobjIds(UnknownMemobjId);
+    auto isFresh = true;
+    for (auto retPtr : returnPointers) {
+      if (isa<ConstantPointerNull>(retPtr)) {
+        continue;
+      }
+      auto &pointees = getPointeeBits(retPtr);
+      if (pointees.none()) {
+        isFresh = false;
+      }
+      for (auto memobjId : pointees.set_bits()) {
+        auto memobj = nodeId2memobj[memobjId];
+        auto isHeapAllocation =
+            (memobj != nullptr) && isa<CallBase>(memobj)
+            && (mallocInsts.count(cast<CallBase>(memobj))
+                || callocInsts.count(cast<CallBase>(memobj))
+                || userDefinedCallInsts.count(cast<CallBase>(memobj)));
+        if (!isHeapAllocation
+            || (unknownMemobjs.find(memobjId) != unknownMemobjs.end())) {
+          isFresh = false;
+        }
+      }
+    }
+    summary.returnsFreshMemobj = isFresh;
+  }
+
+  return summary;
+}
+
 BitVector MpaSummary::getPointeeBitVector(NodeID nodeId) {
   if (pointsTo.find(nodeId) != pointsTo.end()) {
     return pointsTo[nodeId];
@@ -202,7 +408,7 @@ unordered_set<NodeID> MpaSummary::getreachableMemobjIds(NodeID ptrId) {
 }
 
 BitVector MpaSummary::getEmptyBitVector(void) {
-  auto bitVecSize = 1 + getAllocations().size();
+  auto bitVecSize = nodeId2memobj.size();
   return BitVector(bitVecSize, false);
 }
 
@@ -227,6 +433,16 @@ unordered_set<Value *> MpaSummary::getAllocations(void) {
   if (privatizeCandidate) {
     allocations.insert(privatizeCandidate);
   }
+  for (auto &arg : currentF->args()) {
+    if (arg.getType()->isPointerTy()) {
+      allocations.insert(&arg);
+    }
+  }
+  for (auto callInst : userDefinedCallInsts) {
+    if (returnsFreshMemobj(callInst)) {
+      allocations.insert(callInst);
+    }
+  }
   return allocations;
 }
 
@@ -244,6 +460,26 @@ bool MpaSummary::addCopyEdge(NodeID src, NodeID dst) {
   return copyOutEdges[src].insert(dst).second;
 }
 
+const MpaFunctionSummary *MpaSummary::getCalleeSummary(CallBase *callInst) {
+  if (calleeSummaries == nullptr) {
+    return nullptr;
+  }
+  auto callee = callInst->getCalledFunction();
+  auto summaryIt = calleeSummaries->find(callee);
+  if (summaryIt == calleeSummaries->end()) {
+    return nullptr;
+  }
+  return &summaryIt->second;
+}
+
+bool MpaSummary::returnsFreshMemobj(CallBase *callInst) {
+  if (!callInst->getType()->isPointerTy()) {
+    return false;
+  }
+  auto summary = getCalleeSummary(callInst);
+  return (summary != nullptr) && summary->returnsFreshMemobj;
+}
+
 void MpaSummary::doMayPointsToAnalysis(void) {
   if (!mpaFinished) {
     initPtInfo();
@@ -266,10 +502,12 @@ void MpaSummary::clearPointsToSummary(void) {
   memobj2nodeId.clear();
   nodeId2memobj.clear();
   pointsTo.clear();
+  commonMemobjResults.clear();
   copyOutEdges.clear();
   incomingStores.clear();
   outgoingLoads.clear();
   usedAsFuncArg.clear();
+  modifiedByFuncCall.clear();
 }
 
 void MpaSummary::initPtInfo(void) {
@@ -311,6 +549,12 @@ void MpaSummary::initPtInfo(void) {
    *     "unknown" memory object.
    * (5) PrivatizeCandidate will points to its own memory object instead of the
    *     "unknown" memory object (see MayPointsToAnalysis.hpp).
+   * (6) Arguments of the current function, and their memory objects, also
+   *     point to the memory object of the argument (see
+   *     MayPointsToAnalysis.hpp).
+   * (7) The memory object allocated by a call to a function that returns a
+   *     fresh memory object points to the "unknown" memory object, because
+   *     the callee may have stored any pointer in it.
    *
    * 3. Add copy edges for pointers and memory objects.
    * (1) Copy edges between pointers can be added through PHINode, SelectInst,
@@ -319,6 +563,8 @@ void MpaSummary::initPtInfo(void) {
    * object because the "unknown" memory object may point to escaped memory
    * objects. (3) Add copy edges from the "unknown" memory object to the
    * callInst if the callInst returns a pointer.
+   * (4) Arguments of calls to functions with a summary only escape if the
+   * callee captures them (see handleUserDefinedCall).
    *
    * 4. Record uses of pointers.
    * If a pointer is used as the pointer operand of a store/load instruction,
@@ -330,9 +576,17 @@ void MpaSummary::initPtInfo(void) {
   for (auto &ptr : pointers) {
     auto ptrId = getPtrId(ptr);
 
-    if (allocations.find(ptr) != allocations.end()) {
+    if (isa<Argument>(ptr)) {
+      auto memobjId = memobj2nodeId[ptr];
+      pointsTo[ptrId] = onlyPointsTo(memobjId);
+      pointsTo[ptrId].set(UnknownMemobjId);
+      pointsTo[memobjId] = pointsTo[ptrId];
+    } else if (allocations.find(ptr) != allocations.end()) {
       auto memobjId = memobj2nodeId[ptr];
       pointsTo[ptrId] = onlyPointsTo(memobjId);
+      if (isa<CallBase>(ptr) && returnsFreshMemobj(cast<CallBase>(ptr))) {
+        addCopyEdge(UnknownMemobjId, memobjId);
+      }
     } else if (isa<PHINode>(ptr)) {
       auto phiNode = dyn_cast<PHINode>(ptr);
       for (auto &incoming : phiNode->incoming_values()) {
@@ -345,7 +599,7 @@ void MpaSummary::initPtInfo(void) {
       auto falseValuePtrId = getPtrId(selectInst->getFalseValue());
       addCopyEdge(trueValuePtrId, ptrId);
       addCopyEdge(falseValuePtrId, ptrId);
-    } else if (isa<Argument>(ptr) || isa<GlobalVariable>(ptr)) {
+    } else if (isa<GlobalVariable>(ptr)) {
       pointsTo[ptrId] = onlyPointsTo(UnknownMemobjId);
     } else if (isa<CallBase>(ptr)) {
       auto callInst = dyn_cast<CallBase>(ptr);
@@ -389,6 +643,8 @@ void MpaSummary::initPtInfo(void) {
                         getPtrId(callInst->getArgOperand(0)));
             break;
           case USER_DEFINED:
+            handleUserDefinedCall(ptrId, ptr, callInst);
+            break;
           case UNKNOWN:
             usedAsFuncArg.insert(ptrId);
             addCopyEdge(ptrId, UnknownMemobjId);
@@ -412,6 +668,7 @@ void MpaSummary::solveWorklist(void) {
     worklist.pop();
     handleLoadStore(nodeID);
     handleFuncUsers(nodeID);
+    handleModifyingFuncUsers(nodeID);
     handleCopyEdges(nodeID);
   }
 }
@@ -520,6 +777,65 @@ void MpaSummary::handleFuncUsers(NodeID ptrId) {
   }
 }
 
+void MpaSummary::handleUserDefinedCall(NodeID ptrId,
+                                       Value *ptr,
+                                       CallBase *callInst) {
+
+  /*
+   * Without the summary of the callee, the pointer escapes like it does with
+   * unknown callees.
+   * Otherwise, it escapes only if the callee captures it. If it doesn't, the
+   * callee may still write new pointers in the memory reachable from it.
+   */
+  auto summary = getCalleeSummary(callInst);
+  auto escapes = (summary == nullptr);
+  auto isUsedAsArgument = false;
+  auto isModified = false;
+  for (auto argID = 0u; !escapes && argID < callInst->arg_size(); argID++) {
+    if (callInst->getArgOperand(argID) != ptr) {
+      continue;
+    }
+    isUsedAsArgument = true;
+    if ((argID >= summary->capturedParameters.size())
+        || summary->capturedParameters[argID]) {
+      escapes = true;
+    } else if (summary->modParameters[argID]) {
+      isModified = true;
+    }
+  }
+  if (escapes || !isUsedAsArgument) {
+    usedAsFuncArg.insert(ptrId);
+    addCopyEdge(ptrId, UnknownMemobjId);
+  } else if (isModified) {
+    modifiedByFuncCall.insert(ptrId);
+  }
+}
+
+void MpaSummary::handleModifyingFuncUsers(NodeID nodeId) {
+  if (modifiedByFuncCall.find(nodeId) == modifiedByFuncCall.end()) {
+    return;
+  }
+  /*
+   * A callee that doesn't capture its argument may still store in the memory
+   * reachable from it any pointer it has access to. These pointers point to
+   * memory objects summarized by the "unknown" memory object: the ones that
+   * are not allocated in the current function, and the ones that escaped.
+   *
+   * Hence, add copy edges from the "unknown" memory object to all memory
+   * objects reachable from the argument. Memory objects become reachable
+   * while the analysis progresses, so they are recorded as well.
+   */
+  auto pointees = getPointeeBitVector(nodeId);
+  for (auto memobjId : pointees.set_bits()) {
+    if (!modifiedByFuncCall.insert(memobjId).second) {
+      continue;
+    }
+    addCopyEdge(UnknownMemobjId, memobjId);
+    worklist.push(UnknownMemobjId);
+    worklist.push(memobjId);
+  }
+}
+
 void MpaSummary::handleCopyEdges(NodeID srcId) {
   if (copyOutEdges.find(srcId) == copyOutEdges.end()) {
     return;
@@ -141,9 +141,15 @@ private:
 
   void addMetadata(LoopStructure *loop, const std::string &metadataName);
 
-  std::map<Function *, std::set<std::string>> functionMetadata;
-  std::map<AllocaInst *, std::set<std::string>> varMetadata;
-  std::map<GlobalVariable *, std::set<std::string>> globalMetadata;
+  /*
+   * Source code annotations, collected lazily.
+   */
+  mutable bool sourceCodeAnnotationsCollected;
+  mutable std::map<Function *, std::set<std::string>> functionMetadata;
+  mutable std::map<AllocaInst *, std::set<std::string>> varMetadata;
+  mutable std::map<GlobalVariable *, std::set<std::string>> globalMetadata;
+
+  void collectSourceCodeAnnotations(void) const;
 };
 
 } // namespace arcana::noelle
@@ -23,7 +23,25 @@
 
 namespace arcana::noelle {
 
-MetadataManager::MetadataManager(Module &M) : program{ M } {
+MetadataManager::MetadataManager(Module &M)
+  : program{ M },
+    sourceCodeAnnotationsCollected{ false } {
+  return;
+}
+
+void MetadataManager::collectSourceCodeAnnotations(void) const {
+
+  /*
+   * Check if the annotations have already been collected.
+   *
+   * Collecting them requires a scan of the whole module, so we only do it the
+   * first time they are requested.
+   */
+  if (this->sourceCodeAnnotationsCollected) {
+    return;
+  }
+  this->sourceCodeAnnotationsCollected = true;
+  auto &M = this->program;
 
   /*
    * Collect variable metadata.
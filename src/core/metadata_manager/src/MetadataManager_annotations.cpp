@@ -25,6 +25,7 @@ namespace arcana::noelle {
 
 std::set<std::string> MetadataManager::getSourceCodeAnnotations(
     Function *f) const {
+  this->collectSourceCodeAnnotations();
   if (this->functionMetadata.find(f) == this->functionMetadata.end()) {
     return {};
   }
@@ -33,6 +34,7 @@ std::set<std::string> MetadataManager::getSourceCodeAnnotations(
 
 std::set<std::string> MetadataManager::getSourceCodeAnnotations(
     AllocaInst *var) const {
+  this->collectSourceCodeAnnotations();
   if (this->varMetadata.find(var) == this->varMetadata.end()) {
     return {};
   }
@@ -41,6 +43,7 @@ std::set<std::string> MetadataManager::getSourceCodeAnnotations(
 
 std::set<std::string> MetadataManager::getSourceCodeAnnotations(
     GlobalVariable *g) const {
+  this->collectSourceCodeAnnotations();
   if (this->globalMetadata.find(g) == this->globalMetadata.end()) {
     return {};
   }
@@ -79,7 +79,9 @@ public:
          bool disableSVF,
          bool disableSVFCallGraph,
          bool disableAllocAA,
-         bool disableRA);
+         bool disableRA,
+         bool usePDGCache,
+         uint32_t pdgJobs = 1);
 
   FunctionsManager *getFunctionsManager(void);
 
@@ -188,6 +190,13 @@ public:
   LoopForest *organizeLoopsInTheirNestingForest(
       std::vector<LoopStructure *> const &loops);
 
+  /*
+   * Index the loops given as input by their ID.
+   * Loops without an ID are not included.
+   */
+  std::unordered_map<uint64_t, LoopStructure *> indexLoopsByID(
+      std::vector<LoopStructure *> const &loops);
+
   void filterOutLoops(std::vector<LoopStructure *> &loops,
                       std::function<bool(LoopStructure *)> filter);
 
@@ -210,6 +219,10 @@ public:
 
   CFGAnalysis getCFGAnalysis(void) const;
 
+  /*
+   * The CFG transformer and the schedulers created by the scheduler returned
+   * invalidate the dependence graphs of the functions they modify.
+   */
   CFGTransformer getCFGTransformer(void) const;
 
   DataFlowEngine getDataFlowEngine(void) const;
@@ -241,6 +254,22 @@ public:
 
   PDGGenerator &getPDGGenerator(void);
 
+  /*
+   * Drop everything NOELLE has cached about @f: its dependence graph and the
+   * profile aggregates of its basic blocks and loops.
+   * The transformers handed out by NOELLE (Linker, LoopTransformer,
+   * CFGTransformer, and the schedulers of Scheduler) invoke it when they modify
+   * @f. Code that modifies the IR directly must invoke it as well.
+   */
+  void functionHasBeenModified(Function *f) const;
+
+  /*
+   * Drop the cached dependence graph of @f.
+   */
+  void invalidateFunctionDependenceGraph(Function *f) const;
+
+  void invalidateFunctionDependenceGraphs(void);
+
   bool verifyCode(void) const;
 
   ~Noelle();
@@ -255,9 +284,10 @@ private:
   Module &program;
   Hot *profiles;
   PDG *programDependenceGraph;
+  mutable std::unordered_map<Function *, PDG *> functionDependenceGraphs;
   std::unordered_set<Transformation> enabledTransformations;
   Verbosity verbose;
-  PDGGenerator pdgGenerator;
+  mutable PDGGenerator pdgGenerator;
   LDGGenerator ldgGenerator;
   char *filterFileName;
   bool hasReadFilterFile;
@@ -282,6 +312,13 @@ private:
   std::set<AliasAnalysisEngine *> aaEngines;
   Logger log;
 
+  /*
+   * Return the dependence graph of @f.
+   *
+   * The graph is owned and cached by NOELLE, and it is shared by all the loop
+   * contents of @f: callers must not delete or modify it. It is freed when @f
+   * is invalidated (see functionHasBeenModified).
+   */
   PDG *getFunctionDependenceGraph(Function *f);
 
   uint32_t fetchTheNextValue(std::stringstream &stream);
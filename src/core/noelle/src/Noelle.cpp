@@ -46,11 +46,14 @@ Noelle::Noelle(
     bool disableSVF,
     bool disableSVFCallGraph,
     bool disableAllocAA,
-    bool disableRA)
+    bool disableRA,
+    bool usePDGCache,
+    uint32_t pdgJobs)
   : minHot{ minHot },
     program{ m },
     profiles{ nullptr },
     programDependenceGraph{ nullptr },
+    functionDependenceGraphs{},
     enabledTransformations{ enabledTransformations },
     verbose{ v },
     pdgGenerator{ m,
@@ -65,7 +68,9 @@ Noelle::Noelle(
                   disableSVFCallGraph,
                   disableAllocAA,
                   disableRA,
-                  pdgVerbose },
+                  usePDGCache,
+                  pdgVerbose,
+                  pdgJobs },
     ldgGenerator{ ldgGenerator },
     filterFileName{ nullptr },
     hasReadFilterFile{ false },
@@ -167,7 +172,11 @@ CFGAnalysis Noelle::getCFGAnalysis(void) const {
 }
 
 CFGTransformer Noelle::getCFGTransformer(void) const {
-  return CFGTransformer{};
+  CFGTransformer cfgTransformer{};
+  cfgTransformer.setFunctionModifiedCallback(
+      [this](Function *f) { this->functionHasBeenModified(f); });
+
+  return cfgTransformer;
 }
 
 DataFlowEngine Noelle::getDataFlowEngine(void) const {
@@ -175,7 +184,11 @@ DataFlowEngine Noelle::getDataFlowEngine(void) const {
 }
 
 Scheduler Noelle::getScheduler(void) const {
-  return Scheduler{};
+  Scheduler scheduler{};
+  scheduler.setFunctionModifiedCallback(
+      [this](Function *f) { this->functionHasBeenModified(f); });
+
+  return scheduler;
 }
 
 MayPointsToAnalysis Noelle::getMayPointsToAnalysis(void) const {
@@ -185,6 +198,8 @@ MayPointsToAnalysis Noelle::getMayPointsToAnalysis(void) const {
 LoopTransformer &Noelle::getLoopTransformer(void) {
   auto pdg = this->getProgramDependenceGraph();
   this->lt.setPDG(pdg);
+  this->lt.setFunctionModifiedCallback(
+      [this](Function *f) { this->functionHasBeenModified(f); });
 
   return lt;
 }
@@ -204,6 +219,7 @@ uint64_t Noelle::numberOfProgramInstructions(void) const {
 }
 
 Noelle::~Noelle() {
+  this->invalidateFunctionDependenceGraphs();
 
   return;
 }
@@ -229,6 +245,8 @@ Linker *Noelle::getLinker(void) {
   if (!this->linker) {
     auto tm = this->getTypesManager();
     this->linker = new Linker(this->program, tm);
+    this->linker->setFunctionModifiedCallback(
+        [this](Function *f) { this->functionHasBeenModified(f); });
   }
 
   return this->linker;
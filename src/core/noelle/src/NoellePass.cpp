@@ -48,6 +48,19 @@ static cl::opt<bool> DisableFloatAsReal(
     cl::ZeroOrMore,
     cl::Hidden,
     cl::desc("Do not consider floating point variables as real numbers"));
+static cl::opt<uint64_t> MaximumArrayReductionSize(
+    "noelle-max-array-reduction-size",
+    cl::ZeroOrMore,
+    cl::init(0),
+    cl::Hidden,
+    cl::desc("Maximum size in bytes of arrays that can be reduced (default: "
+             "0, which disables array reductions)"));
+static cl::opt<bool> PackReadOnlyEnvironmentVariables(
+    "noelle-pack-read-only-environment",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Pack the read-only variables of loop environments instead of "
+             "giving a cache line to each of them"));
 static cl::opt<bool> DisableDSWP("noelle-disable-dswp",
                                  cl::ZeroOrMore,
                                  cl::Hidden,
@@ -133,6 +146,21 @@ static cl::opt<bool> PDGRADisable(
     cl::Hidden,
     cl::desc("Disable the use of reaching analysis to compute the PDG"));
 
+static cl::opt<bool> PDGCacheUse(
+    "noelle-pdg-cache",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Reuse the PDG stored in the binary file next to the bitcode "
+             "(see noelle-pdg-embed-binary)"));
+
+static cl::opt<int> PDGJobs(
+    "noelle-pdg-jobs",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Number of threads used to compute the memory dependences and "
+             "the function summaries of the PDG (0: all cores); alias "
+             "queries are issued by one thread at a time"));
+
 NoellePass::NoellePass() : ModulePass{ ID }, n{ nullptr } {
 
   return;
@@ -182,6 +210,7 @@ bool NoellePass::runOnModule(Module &M) {
   if (optMaxCores == 0) {
     optMaxCores = Architecture::getNumberOfPhysicalCores();
   }
+  uint64_t maxArrayReductionBytes = MaximumArrayReductionSize.getValue();
   if (DisableDOALL.getNumOccurrences() > 0) {
     enabledTransformations.erase(DOALL_ID);
   }
@@ -221,6 +250,13 @@ bool NoellePass::runOnModule(Module &M) {
   auto disableAllocAA =
       (PDGAllocAADisable.getNumOccurrences() > 0) ? true : false;
   auto disableRA = (PDGRADisable.getNumOccurrences() > 0) ? true : false;
+  auto usePDGCache = (PDGCacheUse.getNumOccurrences() > 0) ? true : false;
+  uint32_t pdgJobs = 1;
+  if (PDGJobs.getNumOccurrences() > 0) {
+    pdgJobs = (PDGJobs.getValue() > 0)
+                  ? PDGJobs.getValue()
+                  : Architecture::getNumberOfLogicalCores();
+  }
 
   /*
    * Allocate the managers.
@@ -230,7 +266,9 @@ bool NoellePass::runOnModule(Module &M) {
       optMaxCores,
       (ND_PRVGs.getNumOccurrences() > 0),
       (DisableFloatAsReal.getNumOccurrences() == 0),
-      (InlinerDisableHoistToMain.getNumOccurrences() > 0));
+      (InlinerDisableHoistToMain.getNumOccurrences() > 0),
+      maxArrayReductionBytes,
+      (PackReadOnlyEnvironmentVariables.getNumOccurrences() > 0));
 
   /*
    * Fetch the other passes.
@@ -296,7 +334,9 @@ bool NoellePass::runOnModule(Module &M) {
                        disableSVF,
                        disableSVFCallGraph,
                        disableAllocAA,
-                       disableRA);
+                       disableRA,
+                       usePDGCache,
+                       pdgJobs);
 
   return false;
 }
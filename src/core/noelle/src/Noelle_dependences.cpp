@@ -24,9 +24,12 @@
 namespace arcana::noelle {
 
 PDG *Noelle::getProgramDependenceGraph(void) {
-  if (this->programDependenceGraph == nullptr) {
-    this->programDependenceGraph = this->pdgGenerator.getPDG();
-  }
+
+  /*
+   * Fetch the PDG from the generator every time so the dependences of the
+   * functions modified since the last request are recomputed.
+   */
+  this->programDependenceGraph = this->pdgGenerator.getPDG();
 
   return this->programDependenceGraph;
 }
@@ -34,19 +37,79 @@ PDG *Noelle::getProgramDependenceGraph(void) {
 PDG *Noelle::getFunctionDependenceGraph(Function *f) {
 
   /*
-   * Get the PDG
-   * The FDG is a subset of it.
+   * Check if we have already computed the FDG.
    */
-  auto pdg = this->getProgramDependenceGraph();
+  auto it = this->functionDependenceGraphs.find(f);
+  if (it != this->functionDependenceGraphs.end()) {
+    return it->second;
+  }
 
   /*
    * Create the function dependence graph (FDG).
+   * The FDG is a subset of the PDG, but only the dependences of @f need to
+   * be in the PDG.
    */
-  auto fdg = pdg->createFunctionSubgraph(*f);
+  auto fdg = this->pdgGenerator.createFunctionDependenceGraph(*f);
+  this->functionDependenceGraphs[f] = fdg;
 
   return fdg;
 }
 
+void Noelle::functionHasBeenModified(Function *f) const {
+
+  /*
+   * Drop the dependences of @f.
+   */
+  this->invalidateFunctionDependenceGraph(f);
+
+  /*
+   * Drop the profile aggregates of @f.
+   */
+  if (this->profiles != nullptr) {
+    this->profiles->invalidateCachedProfiles(*f);
+  }
+
+  return;
+}
+
+void Noelle::invalidateFunctionDependenceGraph(Function *f) const {
+
+  /*
+   * The dependences of @f will be recomputed the next time the PDG is
+   * requested.
+   */
+  this->pdgGenerator.invalidateFunction(*f);
+
+  /*
+   * Drop the FDG of @f.
+   * The dependences of its calls change as well, so drop the FDGs of the
+   * callers too.
+   */
+  std::unordered_set<Function *> functions{ f };
+  for (auto &pair : this->pdgGenerator.fetchCallsAffectedBy({ f })) {
+    functions.insert(pair.first);
+  }
+  for (auto function : functions) {
+    auto it = this->functionDependenceGraphs.find(function);
+    if (it == this->functionDependenceGraphs.end()) {
+      continue;
+    }
+    delete it->second;
+    this->functionDependenceGraphs.erase(it);
+  }
+
+  return;
+}
+
+void Noelle::invalidateFunctionDependenceGraphs(void) {
+  for (auto &pair : this->functionDependenceGraphs) {
+    delete pair.second;
+  }
+  this->functionDependenceGraphs.clear();
+
+  return;
+}
+
 std::vector<SCC *> Noelle::sortByHotness(const std::set<SCC *> &SCCs) {
   std::vector<SCC *> s;
 
@@ -69,18 +132,26 @@ std::vector<SCC *> Noelle::sortByHotness(const std::set<SCC *> &SCCs) {
    */
   auto hot = this->getProfiles();
 
+  /*
+   * Aggregate the profiles of each SCC once rather than at every comparison.
+   */
+  std::unordered_map<SCC *, uint64_t> totalInstructions;
+  for (auto scc : s) {
+    totalInstructions[scc] = hot->getTotalInstructions(scc);
+  }
+
   /*
    * Define the order between loops.
    */
-  auto compareSCCs = [hot](SCC *s0, SCC *s1) -> bool {
+  auto compareSCCs = [&totalInstructions](SCC *s0, SCC *s1) -> bool {
     assert(s0 != nullptr);
     assert(s1 != nullptr);
 
     /*
      * Fetch the information.
      */
-    auto s0Insts = hot->getTotalInstructions(s0);
-    auto s1Insts = hot->getTotalInstructions(s1);
+    auto s0Insts = totalInstructions.at(s0);
+    auto s1Insts = totalInstructions.at(s1);
 
     return s0Insts > s1Insts;
   };
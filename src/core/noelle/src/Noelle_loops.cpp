@@ -570,6 +570,7 @@ std::vector<LoopContent *> *Noelle::getLoopContents(Function *function,
                                 *DS,
                                 SE,
                                 this->om->getMaximumNumberOfCores());
+      LC->setLLVMAnalysesFetchers(this->getSCEV, this->getLoopInfo);
       allLoops->push_back(LC);
     }
   }
@@ -768,6 +769,7 @@ std::vector<LoopContent *> *Noelle::getLoopContents(double minimumHotness) {
                                *DS,
                                SE,
                                this->om->getMaximumNumberOfCores());
+          LC->setLLVMAnalysesFetchers(this->getSCEV, this->getLoopInfo);
 
         } else {
           auto maximumNumberOfCoresForTheParallelization =
@@ -1330,6 +1332,7 @@ LoopContent *Noelle::getLoopContentForLoop(
                             maxCores,
                             optimizations,
                             DOALLChunkSizeForLoop);
+  LC->setLLVMAnalysesFetchers(this->getSCEV, this->getLoopInfo);
 
   /*
    * Set the techniques that are enabled.
@@ -1497,6 +1500,21 @@ LoopForest *Noelle::organizeLoopsInTheirNestingForest(
   return n;
 }
 
+std::unordered_map<uint64_t, LoopStructure *> Noelle::indexLoopsByID(
+    std::vector<LoopStructure *> const &loops) {
+  std::unordered_map<uint64_t, LoopStructure *> index{};
+
+  for (auto loop : loops) {
+    auto loopIDOpt = loop->getID();
+    if (!loopIDOpt) {
+      continue;
+    }
+    index[loopIDOpt.value()] = loop;
+  }
+
+  return index;
+}
+
 std::function<std::vector<Function *>(std::set<Function *> fns)> Noelle::
     fetchFunctionsSorting(void) {
   std::function<std::vector<Function *>(std::set<Function *> fns)> s;
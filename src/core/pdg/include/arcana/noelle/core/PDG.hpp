@@ -129,6 +129,22 @@ public:
       std::unordered_set<DGEdge<Value, Value> *> edgesToIgnore);
 
   PDG *clone(bool includeExternalNodes);
+
+  /*
+   * Incremental maintenance (see PDGGenerator::invalidateFunction).
+   *
+   * Remove the nodes of @values, and their dependences, from the PDG.
+   * The values are not dereferenced, so they can be already deleted from the
+   * IR. Values without a node are ignored.
+   */
+  void removeNodes(const std::vector<Value *> &values);
+
+  /*
+   * Add a node per instruction and argument of @F.
+   * If the entry node of the PDG has been removed and @F is "main", then the
+   * entry node is set again.
+   */
+  void addFunction(Function &F);
   std::vector<Value *> getSortedValues(void);
 
   std::vector<DGEdge<Value, Value> *> getSortedDependences(void);
@@ -82,7 +82,7 @@ PDG::PDG(Loop *loop) {
    * (See include/llvm/Analysis/LoopInfo.h:653)
    */
   auto bbBegin = *(loop->block_begin());
-  this->entryNode = this->internalNodeMap[&*(bbBegin->begin())];
+  this->entryNode = this->fetchNode(&*(bbBegin->begin()));
   assert(this->entryNode != nullptr);
 
   return;
@@ -93,7 +93,7 @@ PDG::PDG(std::vector<Value *> &values) {
     this->addNode(V, /*inclusion=*/true);
   }
 
-  this->entryNode = this->internalNodeMap[*(values.begin())];
+  this->entryNode = this->fetchNode(*(values.begin()));
   assert(this->entryNode != nullptr);
 
   return;
@@ -113,10 +113,34 @@ void PDG::addNodesOf(Function &F) {
 
 void PDG::setEntryPointAt(Function &F) {
   auto entryInstr = &*(F.begin()->begin());
-  entryNode = internalNodeMap[entryInstr];
+  entryNode = this->fetchNode(entryInstr);
   assert(entryNode != nullptr);
 }
 
+void PDG::removeNodes(const std::vector<Value *> &values) {
+  for (auto value : values) {
+    auto node = this->fetchNode(value);
+    if (node == nullptr) {
+      continue;
+    }
+    if (node == this->entryNode) {
+      this->entryNode = nullptr;
+    }
+    this->removeNode(node);
+  }
+
+  return;
+}
+
+void PDG::addFunction(Function &F) {
+  this->addNodesOf(F);
+  if ((this->entryNode == nullptr) && (F.getName() == "main")) {
+    this->setEntryPointAt(F);
+  }
+
+  return;
+}
+
 PDG *PDG::createFunctionSubgraph(Function &F) {
 
   /*
@@ -183,24 +207,34 @@ void PDG::copyEdgesInto(
     PDG *newPDG,
     bool linkToExternal,
     std::unordered_set<DGEdge<Value, Value> *> const &edgesToIgnore) {
-  for (auto *oldEdge : allEdges) {
+
+  /*
+   * Collect the nodes of the new PDG.
+   *
+   * Only the dependences connected to these nodes need to be copied, so we
+   * walk their adjacency lists rather than every edge of this PDG.
+   */
+  std::vector<Value *> newInternalValues;
+  for (auto pair : newPDG->internalNodePairs()) {
+    newInternalValues.push_back(pair.first);
+  }
+
+  auto copyEdge = [this, newPDG, linkToExternal, &edgesToIgnore](
+                      DGEdge<Value, Value> *oldEdge) {
     if (edgesToIgnore.find(oldEdge) != edgesToIgnore.end()) {
-      continue;
+      return;
     }
 
     auto fromT = oldEdge->getSrc();
     auto toT = oldEdge->getDst();
 
     /*
-     * Check whether edge belongs to nodes within function F
+     * Check whether edge belongs to nodes within the new PDG
      */
     auto fromInclusion = newPDG->isInternal(fromT);
     auto toInclusion = newPDG->isInternal(toT);
-    if (!fromInclusion && !toInclusion) {
-      continue;
-    }
     if (!linkToExternal && (!fromInclusion || !toInclusion)) {
-      continue;
+      return;
     }
 
     /*
@@ -213,6 +247,32 @@ void PDG::copyEdgesInto(
      * Copy edge to match properties (mem/var, must/may, RAW/WAW/WAR/control)
      */
     newPDG->copyAddEdge(*oldEdge);
+  };
+
+  for (auto value : newInternalValues) {
+    if (!this->isInGraph(value)) {
+      continue;
+    }
+    auto oldNode = this->fetchNode(value);
+
+    /*
+     * Outgoing dependences are copied from their source.
+     */
+    for (auto oldEdge : oldNode->getOutgoingEdges()) {
+      copyEdge(oldEdge);
+    }
+
+    /*
+     * Incoming dependences are copied from their destination only when
+     * their source is not part of the new PDG; otherwise they have been
+     * copied already.
+     */
+    for (auto oldEdge : oldNode->getIncomingEdges()) {
+      if (newPDG->isInternal(oldEdge->getSrc())) {
+        continue;
+      }
+      copyEdge(oldEdge);
+    }
   }
 
   return;
@@ -437,12 +497,7 @@ PDG *PDG::clone(bool includeExternalNodes) {
 }
 
 PDG::~PDG() {
-  for (auto *edge : allEdges)
-    if (edge)
-      delete edge;
-  for (auto *node : allNodes)
-    if (node)
-      delete node;
+  return;
 }
 
 } // namespace arcana::noelle
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_PDG_GENERATOR_MEMORYDEPENDENCEEDGES_H_
+#define NOELLE_SRC_CORE_PDG_GENERATOR_MEMORYDEPENDENCEEDGES_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/PDG.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Memory dependences computed for a function before they are added to a PDG.
+ *
+ * This lets the dependences of different functions be computed by different
+ * threads, each one writing to its own buffer, and then added to the PDG by a
+ * single thread.
+ */
+class MemoryDependenceEdges {
+public:
+  void addMemoryDataDependenceEdge(Value *from,
+                                   Value *to,
+                                   DataDependenceType type,
+                                   bool isMust);
+
+  /*
+   * Add the dependences to @pdg following the order they have been computed.
+   */
+  void addTo(PDG *pdg) const;
+
+private:
+  struct Edge {
+    Value *from;
+    Value *to;
+    DataDependenceType type;
+    bool isMust;
+  };
+
+  std::vector<Edge> edges;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_PDG_GENERATOR_MEMORYDEPENDENCEEDGES_H_
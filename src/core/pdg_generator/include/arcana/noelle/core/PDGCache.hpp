@@ -0,0 +1,182 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_PDG_GENERATOR_PDGCACHE_H_
+#define NOELLE_SRC_CORE_PDG_GENERATOR_PDGCACHE_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/Utils.hpp"
+#include "arcana/noelle/core/PDG.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Binary sidecar file that stores the memory dependences of a PDG.
+ *
+ * The file is written next to the bitcode of the program and it is
+ * memory-mapped when loaded.
+ * Dependences are grouped in one section per function, so the section of a
+ * function is decoded only when that function is added to a PDG.
+ *
+ * Layout (all integers are ULEB128 unless stated otherwise):
+ *   header:    "NPDG", version (u32 little endian), options, number of
+ *              functions
+ *   functions: name, #arguments, #instructions, fingerprint, offset, size
+ *   section:   #sub-edge lists, sub-edge lists, #edges, edges
+ *   edge:      flags, source, destination, [sub-edge list index]
+ *   endpoint:  (localID << 1) | isForeign, [function index if foreign]
+ *
+ * Local IDs number the arguments of a function first and then its
+ * instructions in layout order.
+ *
+ * The options are a string that describes the analyses that computed the
+ * dependences (see PDGGenerator::getPDGCacheOptions). A cache written with
+ * different options is not used.
+ */
+class PDGCache {
+public:
+  /*
+   * Load the cache stored in @fileName.
+   * The cache is not available if the file does not exist, it is malformed,
+   * or it has been written with options other than @options.
+   */
+  PDGCache(Module &M, const std::string &fileName, const std::string &options);
+
+  /*
+   * Load the cache stored in @buffer.
+   */
+  PDGCache(Module &M,
+           std::unique_ptr<MemoryBuffer> buffer,
+           const std::string &options);
+
+  PDGCache() = delete;
+
+  bool isAvailable(void) const;
+
+  /*
+   * Return true if the section of @F matches the current body of @F.
+   */
+  bool isUpToDate(Function &F) const;
+
+  /*
+   * Add the dependences of the section of @F to @pdg.
+   * Return false (and leave @pdg untouched) if the section is stale.
+   */
+  bool addDependencesOf(PDG *pdg, Function &F);
+
+  /*
+   * Declare that @F has been modified or deleted since the cache has been
+   * loaded.
+   * The section of @F, and the dependences of other sections with an
+   * endpoint in @F, are not used anymore.
+   * @F is not dereferenced.
+   */
+  void invalidate(Function &F);
+
+  uint64_t getNumberOfFunctions(void) const;
+
+  /*
+   * Store the memory dependences of @pdg, computed with @options, to
+   * @fileName.
+   * Dependences with an endpoint that does not belong to a function are not
+   * stored.
+   */
+  static bool write(PDG *pdg,
+                    Module &M,
+                    const std::string &options,
+                    const std::string &fileName);
+
+  /*
+   * Store the memory dependences of @pdg, computed with @options, to @out.
+   */
+  static bool write(PDG *pdg,
+                    Module &M,
+                    const std::string &options,
+                    raw_ostream &out);
+
+  /*
+   * Return the name of the sidecar file of @M, or the empty string if @M has
+   * not been read from a file.
+   */
+  static std::string getFileName(Module &M);
+
+  static const uint32_t version = 3;
+
+private:
+  struct FunctionSection {
+    Function *function;
+    uint64_t numberOfArguments;
+    uint64_t numberOfInstructions;
+    uint64_t fingerprint;
+    uint64_t offset;
+    uint64_t size;
+  };
+
+  struct EdgeRecord {
+    uint64_t flags;
+    Value *src;
+    Value *dst;
+    uint64_t subEdges;
+  };
+
+  enum EdgeFlags : uint64_t {
+    MemoryFlag = 1 << 0,
+    MustFlag = 1 << 1,
+    ControlFlag = 1 << 2,
+    LoopCarriedFlag = 1 << 3,
+    DataTypeShift = 4,
+    DataTypeMask = 3 << DataTypeShift,
+    SubEdgesFlag = 1 << 6
+  };
+
+  std::unique_ptr<MemoryBuffer> buffer;
+  std::vector<FunctionSection> sections;
+  std::unordered_map<Function *, uint64_t> sectionOfFunction;
+  std::unordered_map<uint64_t, std::vector<Value *>> localValues;
+  mutable std::unordered_map<const Function *, bool> fingerprintMatches;
+
+  void load(Module &M,
+            std::unique_ptr<MemoryBuffer> buffer,
+            const std::string &options);
+
+  bool readFunctionTable(Module &M, const std::string &options);
+
+  bool readEdge(const uint8_t *&cur,
+                const uint8_t *end,
+                uint64_t functionIndex,
+                EdgeRecord &record);
+
+  Value *readEndpoint(const uint8_t *&cur,
+                      const uint8_t *end,
+                      uint64_t functionIndex);
+
+  DGEdge<Value, Value> *createEdge(PDG *pdg,
+                                   const EdgeRecord &record,
+                                   bool addToPDG);
+
+  std::vector<Value *> &getLocalValues(uint64_t functionIndex);
+
+  static uint64_t getFlags(DGEdge<Value, Value> *edge);
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_PDG_GENERATOR_PDGCACHE_H_
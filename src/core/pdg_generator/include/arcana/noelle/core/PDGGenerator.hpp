@@ -27,9 +27,12 @@
 #include "arcana/noelle/core/AllocAA.hpp"
 #include "arcana/noelle/core/PDG.hpp"
 #include "arcana/noelle/core/PDGPrinter.hpp"
+#include "arcana/noelle/core/PDGCache.hpp"
+#include "arcana/noelle/core/MemoryDependenceEdges.hpp"
 #include "arcana/noelle/core/DataFlow.hpp"
 #include "arcana/noelle/core/CallGraph.hpp"
 #include "arcana/noelle/core/AliasAnalysisEngine.hpp"
+#include "arcana/noelle/core/AliasQueryCache.hpp"
 #include "arcana/noelle/core/MayPointsToAnalysis.hpp"
 #include "arcana/noelle/core/DependenceAnalysis.hpp"
 #include "arcana/noelle/core/CallGraphAnalysis.hpp"
@@ -52,7 +55,9 @@ public:
                bool disableSVFCallGraph,
                bool disableAllocAA,
                bool disableRA,
-               PDGVerbosity verbose);
+               bool usePDGCache,
+               PDGVerbosity verbose,
+               uint32_t numberOfJobs = 1);
 
   void addAnalysis(DependenceAnalysis *a);
 
@@ -60,12 +65,85 @@ public:
 
   PDG *getPDG(void);
 
+  /*
+   * Return a new PDG with the dependences of @F (see
+   * PDG::createFunctionSubgraph).
+   * When the PDG has been loaded from a PDG cache, only the memory
+   * dependences of @F are decoded from it.
+   */
+  PDG *createFunctionDependenceGraph(Function &F);
+
+  /*
+   * Incremental maintenance of the PDG.
+   *
+   * Declare that @F has been modified or deleted by a transformation.
+   * The dependences of @F, and the memory dependences of the calls that can
+   * invoke it (see fetchCallsAffectedBy), are recomputed the next time the
+   * PDG is requested. The rest of the PDG is kept.
+   *
+   * All functions modified by a transformation must be invalidated, including
+   * the ones that received code from other functions.
+   */
+  void invalidateFunction(Function &F);
+
+  /*
+   * Recompute the dependences of @F now (see invalidateFunction).
+   */
+  void recomputeFunction(Function &F);
+
+  /*
+   * Recompute the dependences of the functions invalidated so far.
+   */
+  void recomputeInvalidatedFunctions(void);
+
+  /*
+   * Return the calls whose memory dependences depend on the code of
+   * @functions, grouped by the function that includes them: the direct calls
+   * to @functions and, for the ones whose address is taken, the indirect
+   * calls with the same signature.
+   * Calls that belong to @functions are not included.
+   */
+  std::unordered_map<Function *, std::unordered_set<CallBase *>>
+  fetchCallsAffectedBy(const std::unordered_set<Function *> &functions) const;
+
   noelle::CallGraph *getProgramCallGraph(void);
 
   void cleanAndEmbedPDGAsMetadata(PDG *pdg);
 
   void embedSCCAsMetadata(PDG *dg);
 
+  /*
+   * Store the memory dependences of @pdg in the binary sidecar file of the
+   * program (see PDGCache).
+   * The sidecar file is used by getPDG only if the generator has been
+   * created with @usePDGCache set.
+   */
+  bool writePDGCache(PDG *pdg);
+
+  /*
+   * Return the description of the analyses used to compute the memory
+   * dependences, as stored in the PDG caches.
+   */
+  std::string getPDGCacheOptions(void) const;
+
+  /*
+   * Keep a copy of the memory dependences of every PDG built for @M in
+   * memory, until released. The next PDG built for @M reuses the dependences
+   * of the functions that have not changed since then, as it is done with
+   * the sidecar file.
+   *
+   * This is meant for drivers that run several NOELLE passes on @M in the
+   * same process.
+   */
+  static void retainPDGCacheInMemory(Module &M);
+
+  static void releasePDGCacheInMemory(Module &M);
+
+  /*
+   * Return true if @pdg1 and @pdg2 have the same nodes and dependences.
+   */
+  bool comparePDGs(PDG *pdg1, PDG *pdg2);
+
   virtual ~PDGGenerator();
 
   static bool isTheLibraryFunctionPure(Function *libraryFunction);
@@ -102,14 +180,36 @@ private:
   bool disableSVFCallGraph;
   bool disableAllocAA;
   bool disableRA;
+  bool usePDGCache;
+
+  /*
+   * Number of threads used to compute the memory dependences and the
+   * summaries of the functions.
+   * Alias queries are issued by one thread at a time, and edges are added to
+   * the PDG by the calling thread.
+   */
+  uint32_t numberOfJobs;
   PDGPrinter printer;
   noelle::CallGraph *noelleCG;
+  AliasQueryCache aaQueries;
+  AliasQueryCache svfQueries;
   std::set<DependenceAnalysis *> ddAnalyses;
   std::set<CallGraphAnalysis *> cgAnalyses;
   std::unordered_set<const Function *> internalFuncs;
   std::unordered_set<const Function *> unhandledExternalFuncs;
   std::unordered_map<const Function *, std::unordered_set<const Function *>>
       reachableUnhandledExternalFuncs;
+  std::unordered_map<const Function *, std::vector<Value *>> valuesOfFunctions;
+  SetVector<Function *> invalidatedFunctions;
+  std::unordered_set<const Function *> functionsUnknownToSVF;
+
+  /*
+   * PDG cache the PDG has been loaded from, and the functions whose memory
+   * dependences are still only in it.
+   * The cache is released once all of them have been added to the PDG.
+   */
+  std::unique_ptr<PDGCache> pdgCache;
+  std::unordered_set<Function *> functionsInPDGCache;
 
   void identifyFunctionsThatInvokeUnhandledLibrary(Module &M);
   void printFunctionReachabilityResult();
@@ -118,8 +218,10 @@ private:
   bool isInternalFunctionThatReachUnhandledExternalFunction(const Function *F);
   bool cannotReachUnhandledExternalFunction(CallBase *call);
   bool hasNoMemoryOperations(CallBase *call);
+  bool canUseSVF(const Function &F) const;
+
+  std::vector<Value *> &indexValuesOfFunction(Function &F);
 
-  bool comparePDGs(PDG *pdg1, PDG *pdg2);
   bool compareNodes(PDG *pdg1, PDG *pdg2);
   bool compareEdges(PDG *pdg1, PDG *pdg2);
   bool compareEdges(
@@ -141,7 +243,21 @@ private:
   DGEdge<Value, Value> *constructEdgeFromMetadata(
       PDG *,
       MDNode *,
-      std::unordered_map<MDNode *, Value *> &);
+      std::unordered_map<MDNode *, Value *> &,
+      bool addToPDG);
+
+  /*
+   * Return the PDG, built or brought up to date if needed.
+   * The memory dependences of the functions in functionsInPDGCache are not
+   * part of it yet.
+   */
+  PDG *fetchPDG(void);
+
+  std::unique_ptr<PDGCache> openPDGCache(void);
+  void storePDGCacheInMemory(PDG *pdg);
+  PDG *constructPDGFromCache(Module &, std::unique_ptr<PDGCache> cache);
+  void addDependencesFromPDGCache(Function &F);
+  void addDependencesFromPDGCache(void);
 
   void embedPDGAsMetadata(PDG *);
   void embedNodesAsMetadata(PDG *,
@@ -158,49 +274,66 @@ private:
                               std::unordered_map<Value *, MDNode *> &);
 
   void trimDGUsingCustomAliasAnalysis(PDG *pdg);
+  void computeFunctionSummaries(void);
 
   PDG *constructPDGFromAnalysis(Module &M);
   void constructEdgesFromUseDefs(PDG *pdg);
+  void constructEdgesFromUseDefsOf(PDG *pdg, Value *definition);
   void constructEdgesFromAliases(PDG *pdg, Module &M);
   void constructEdgesFromControl(PDG *pdg, Module &M);
+  void constructEdgesFromAliasesInParallel(PDG *pdg, Module &M);
   void constructEdgesFromAliasesForFunction(PDG *pdg, Function &F);
+  void constructEdgesFromAliasesForFunction(MemoryDependenceEdges *edges,
+                                            Function &F,
+                                            DenseDataFlowResult *dfr);
+  DenseDataFlowResult *computeReachabilityOfMemoryInstructions(Function &F);
   void constructEdgesFromControlForFunction(PDG *pdg, Function &F);
-
-  void iterateInstForStore(PDG *,
-                           Function &,
-                           AAResults &,
-                           DataFlowResult *,
-                           StoreInst *);
-  void iterateInstForLoad(PDG *,
-                          Function &,
-                          AAResults &,
-                          DataFlowResult *,
-                          LoadInst *);
-  void iterateInstForCall(PDG *,
-                          Function &,
-                          AAResults &,
-                          DataFlowResult *,
-                          CallBase *);
-
-  void addEdgeFromMemoryAlias(PDG *,
+  std::vector<DGEdge<Value, Value> *> recomputeMemoryEdgesOfCalls(
+      PDG *pdg,
+      Function &F,
+      const std::unordered_set<CallBase *> &calls);
+
+  void iterateInstForStore(
+      MemoryDependenceEdges *,
+      Function &,
+      AAResults &,
+      DenseDataFlowResult *,
+      StoreInst *,
+      const std::unordered_set<Instruction *> *targets = nullptr);
+  void iterateInstForLoad(
+      MemoryDependenceEdges *,
+      Function &,
+      AAResults &,
+      DenseDataFlowResult *,
+      LoadInst *,
+      const std::unordered_set<Instruction *> *targets = nullptr);
+  void iterateInstForCall(
+      MemoryDependenceEdges *,
+      Function &,
+      AAResults &,
+      DenseDataFlowResult *,
+      CallBase *,
+      const std::unordered_set<Instruction *> *targets = nullptr);
+
+  void addEdgeFromMemoryAlias(MemoryDependenceEdges *,
                               Function &,
                               AAResults &,
                               Value *,
                               Value *,
                               DataDependenceType);
-  void addEdgeFromFunctionModRef(PDG *,
+  void addEdgeFromFunctionModRef(MemoryDependenceEdges *,
                                  Function &,
                                  AAResults &,
                                  CallBase *,
                                  StoreInst *,
                                  bool);
-  void addEdgeFromFunctionModRef(PDG *,
+  void addEdgeFromFunctionModRef(MemoryDependenceEdges *,
                                  Function &,
                                  AAResults &,
                                  CallBase *,
                                  LoadInst *,
                                  bool);
-  void addEdgeFromFunctionModRef(PDG *,
+  void addEdgeFromFunctionModRef(MemoryDependenceEdges *,
                                  Function &,
                                  AAResults &,
                                  CallBase *,
@@ -208,13 +341,34 @@ private:
                                  bool);
 
   void removeEdgesNotUsedByParSchemes(PDG *pdg);
+  bool isEdgeNotUsedByParSchemes(PDG *pdg, DGEdge<Value, Value> *edge);
 
-  AliasResult doTheyAlias(PDG *pdg,
+  AliasResult doTheyAlias(MemoryDependenceEdges *edges,
                           Function &F,
                           AAResults &AA,
                           Value *instI,
                           Value *instJ);
 
+  AliasResult queryAlias(Function &F,
+                         AAResults &AA,
+                         const MemoryLocation &loc1,
+                         const MemoryLocation &loc2);
+  AliasResult queryAlias(Function &F, AAResults &AA, Value *v1, Value *v2);
+  ModRefInfo queryModRefInfo(Function &F,
+                             AAResults &AA,
+                             CallBase *call,
+                             const MemoryLocation &loc);
+  ModRefInfo queryModRefInfo(Function &F,
+                             AAResults &AA,
+                             CallBase *call,
+                             CallBase *otherCall);
+  AliasResult querySVFAlias(Function &F,
+                            const MemoryLocation &loc1,
+                            const MemoryLocation &loc2);
+  AliasResult querySVFAlias(Function &F, Value *v1, Value *v2);
+  ModRefInfo querySVFModRefInfo(CallBase *call, const MemoryLocation &loc);
+  ModRefInfo querySVFModRefInfo(CallBase *call, CallBase *otherCall);
+
   bool edgeIsNotLoopCarriedMemoryDependency(DGEdge<Value, Value> *edge);
   bool isBackedgeIntoSameGlobal(DGEdge<Value, Value> *edge);
   bool isMemoryAccessIntoDifferentArrays(DGEdge<Value, Value> *edge);
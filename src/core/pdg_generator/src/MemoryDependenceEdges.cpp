@@ -0,0 +1,49 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/MemoryDependenceEdges.hpp"
+
+namespace arcana::noelle {
+
+void MemoryDependenceEdges::addMemoryDataDependenceEdge(
+    Value *from,
+    Value *to,
+    DataDependenceType type,
+    bool isMust) {
+  this->edges.push_back({ from, to, type, isMust });
+
+  return;
+}
+
+void MemoryDependenceEdges::addTo(PDG *pdg) const {
+  assert(pdg != nullptr);
+
+  for (auto &edge : this->edges) {
+    pdg->addMemoryDataDependenceEdge(edge.from,
+                                     edge.to,
+                                     edge.type,
+                                     edge.isMust);
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
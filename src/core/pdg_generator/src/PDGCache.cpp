@@ -0,0 +1,668 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "llvm/Support/LEB128.h"
+#include "llvm/Support/EndianStream.h"
+#include "arcana/noelle/core/PDGCache.hpp"
+
+namespace arcana::noelle {
+
+static const char PDGCacheMagic[] = { 'N', 'P', 'D', 'G' };
+
+static bool readULEB(const uint8_t *&cur, const uint8_t *end, uint64_t &value) {
+  if (cur >= end) {
+    return false;
+  }
+  unsigned length = 0;
+  const char *error = nullptr;
+  value = decodeULEB128(cur, &length, end, &error);
+  if (error != nullptr) {
+    return false;
+  }
+  cur += length;
+
+  return true;
+}
+
+static Function *getFunctionOf(Value *v) {
+  if (auto arg = dyn_cast<Argument>(v)) {
+    return arg->getParent();
+  }
+  if (auto inst = dyn_cast<Instruction>(v)) {
+    return inst->getFunction();
+  }
+
+  return nullptr;
+}
+
+PDGCache::PDGCache(Module &M,
+                   const std::string &fileName,
+                   const std::string &options) {
+
+  /*
+   * Map the file in memory.
+   */
+  auto fileOrError = MemoryBuffer::getFile(fileName,
+                                           /*IsText=*/false,
+                                           /*RequiresNullTerminator=*/false);
+  if (!fileOrError) {
+    return;
+  }
+  this->load(M, std::move(fileOrError.get()), options);
+
+  return;
+}
+
+PDGCache::PDGCache(Module &M,
+                   std::unique_ptr<MemoryBuffer> buffer,
+                   const std::string &options) {
+  this->load(M, std::move(buffer), options);
+
+  return;
+}
+
+void PDGCache::load(Module &M,
+                    std::unique_ptr<MemoryBuffer> buffer,
+                    const std::string &options) {
+  this->buffer = std::move(buffer);
+
+  /*
+   * Read the table of functions.
+   */
+  if (!this->readFunctionTable(M, options)) {
+    this->buffer.reset();
+    this->sections.clear();
+    this->sectionOfFunction.clear();
+  }
+
+  return;
+}
+
+bool PDGCache::isAvailable(void) const {
+  return this->buffer != nullptr;
+}
+
+uint64_t PDGCache::getNumberOfFunctions(void) const {
+  return this->sections.size();
+}
+
+bool PDGCache::readFunctionTable(Module &M, const std::string &options) {
+  auto cur = reinterpret_cast<const uint8_t *>(this->buffer->getBufferStart());
+  auto end = reinterpret_cast<const uint8_t *>(this->buffer->getBufferEnd());
+
+  /*
+   * Check the header.
+   */
+  auto headerSize = sizeof(PDGCacheMagic) + sizeof(uint32_t);
+  if (static_cast<uint64_t>(end - cur) < headerSize) {
+    return false;
+  }
+  if (std::memcmp(cur, PDGCacheMagic, sizeof(PDGCacheMagic)) != 0) {
+    return false;
+  }
+  cur += sizeof(PDGCacheMagic);
+  auto fileVersion =
+      support::endian::read<uint32_t, support::little, support::unaligned>(
+          cur);
+  cur += sizeof(uint32_t);
+  if (fileVersion != PDGCache::version) {
+    return false;
+  }
+
+  /*
+   * Check the dependences have been computed with the same analyses.
+   */
+  uint64_t optionsLength = 0;
+  if (!readULEB(cur, end, optionsLength)) {
+    return false;
+  }
+  if (optionsLength > static_cast<uint64_t>(end - cur)) {
+    return false;
+  }
+  StringRef fileOptions(reinterpret_cast<const char *>(cur), optionsLength);
+  cur += optionsLength;
+  if (fileOptions != options) {
+    return false;
+  }
+
+  /*
+   * Read the descriptor of every function.
+   */
+  uint64_t numberOfFunctions = 0;
+  if (!readULEB(cur, end, numberOfFunctions)) {
+    return false;
+  }
+  for (uint64_t i = 0; i < numberOfFunctions; i++) {
+    uint64_t nameLength = 0;
+    if (!readULEB(cur, end, nameLength)) {
+      return false;
+    }
+    if (nameLength > static_cast<uint64_t>(end - cur)) {
+      return false;
+    }
+    StringRef name(reinterpret_cast<const char *>(cur), nameLength);
+    cur += nameLength;
+
+    FunctionSection section;
+    if (!readULEB(cur, end, section.numberOfArguments)
+        || !readULEB(cur, end, section.numberOfInstructions)
+        || !readULEB(cur, end, section.fingerprint)
+        || !readULEB(cur, end, section.offset)
+        || !readULEB(cur, end, section.size)) {
+      return false;
+    }
+
+    /*
+     * Bind the section to the function of the current module.
+     * Functions that no longer exist keep their section, so that the
+     * function indices used by foreign endpoints stay valid.
+     */
+    section.function = M.getFunction(name);
+    if ((section.function != nullptr) && (section.function->isDeclaration())) {
+      section.function = nullptr;
+    }
+    if (section.function != nullptr) {
+      this->sectionOfFunction[section.function] = this->sections.size();
+    }
+    this->sections.push_back(section);
+  }
+
+  /*
+   * Offsets of the sections are relative to the end of the table.
+   */
+  auto start =
+      reinterpret_cast<const uint8_t *>(this->buffer->getBufferStart());
+  auto dataStart = static_cast<uint64_t>(cur - start);
+  auto dataSize = static_cast<uint64_t>(end - cur);
+  for (auto &section : this->sections) {
+    if ((section.offset > dataSize)
+        || (section.size > (dataSize - section.offset))) {
+      return false;
+    }
+    section.offset += dataStart;
+  }
+
+  return true;
+}
+
+bool PDGCache::isUpToDate(Function &F) const {
+  auto it = this->sectionOfFunction.find(&F);
+  if (it == this->sectionOfFunction.end()) {
+    return false;
+  }
+  auto &section = this->sections[it->second];
+
+  /*
+   * Check the shape of the function first as it is cheaper than the
+   * fingerprint.
+   */
+  if (section.numberOfArguments != F.arg_size()) {
+    return false;
+  }
+  if (section.numberOfInstructions != F.getInstructionCount()) {
+    return false;
+  }
+
+  /*
+   * The fingerprint is computed once per function as endpoints of many
+   * dependences check it.
+   */
+  auto checked = this->fingerprintMatches.find(&F);
+  if (checked != this->fingerprintMatches.end()) {
+    return checked->second;
+  }
+  auto matches = section.fingerprint == Utils::computeFingerprint(F);
+  this->fingerprintMatches[&F] = matches;
+
+  return matches;
+}
+
+void PDGCache::invalidate(Function &F) {
+  auto it = this->sectionOfFunction.find(&F);
+  if (it == this->sectionOfFunction.end()) {
+    return;
+  }
+
+  /*
+   * Unbind the section from @F, as done for the functions that no longer
+   * exist when the cache is loaded.
+   */
+  auto functionIndex = it->second;
+  this->sections[functionIndex].function = nullptr;
+  this->sectionOfFunction.erase(it);
+  this->localValues.erase(functionIndex);
+  this->fingerprintMatches.erase(&F);
+
+  return;
+}
+
+std::vector<Value *> &PDGCache::getLocalValues(uint64_t functionIndex) {
+  auto &values = this->localValues[functionIndex];
+  if (!values.empty()) {
+    return values;
+  }
+
+  auto F = this->sections[functionIndex].function;
+  for (auto &arg : F->args()) {
+    values.push_back(&arg);
+  }
+  for (auto &inst : instructions(*F)) {
+    values.push_back(&inst);
+  }
+
+  return values;
+}
+
+Value *PDGCache::readEndpoint(const uint8_t *&cur,
+                              const uint8_t *end,
+                              uint64_t functionIndex) {
+
+  /*
+   * Decode the endpoint.
+   */
+  uint64_t encoded = 0;
+  if (!readULEB(cur, end, encoded)) {
+    return nullptr;
+  }
+  auto localID = encoded >> 1;
+  if (encoded & 1) {
+    if (!readULEB(cur, end, functionIndex)) {
+      return nullptr;
+    }
+  }
+
+  /*
+   * Endpoints can only belong to functions that did not change.
+   */
+  if (functionIndex >= this->sections.size()) {
+    return nullptr;
+  }
+  auto F = this->sections[functionIndex].function;
+  if ((F == nullptr) || (!this->isUpToDate(*F))) {
+    return nullptr;
+  }
+  auto &values = this->getLocalValues(functionIndex);
+  if (localID >= values.size()) {
+    return nullptr;
+  }
+
+  return values[localID];
+}
+
+bool PDGCache::readEdge(const uint8_t *&cur,
+                        const uint8_t *end,
+                        uint64_t functionIndex,
+                        EdgeRecord &record) {
+  if (!readULEB(cur, end, record.flags)) {
+    return false;
+  }
+  record.src = this->readEndpoint(cur, end, functionIndex);
+  if (record.src == nullptr) {
+    return false;
+  }
+  record.dst = this->readEndpoint(cur, end, functionIndex);
+  if (record.dst == nullptr) {
+    return false;
+  }
+  record.subEdges = 0;
+  if (record.flags & SubEdgesFlag) {
+    if (!readULEB(cur, end, record.subEdges)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+DGEdge<Value, Value> *PDGCache::createEdge(PDG *pdg,
+                                           const EdgeRecord &record,
+                                           bool addToPDG) {
+  auto dataDepType = static_cast<DataDependenceType>(
+      (record.flags & DataTypeMask) >> DataTypeShift);
+  auto isMust = (record.flags & MustFlag) != 0;
+
+  /*
+   * Dependences of the PDG are added through the graph.
+   */
+  DGEdge<Value, Value> *edge = nullptr;
+  if (addToPDG) {
+    if (record.flags & ControlFlag) {
+      edge = pdg->addControlDependenceEdge(record.src, record.dst);
+    } else if (record.flags & MemoryFlag) {
+      edge = pdg->addMemoryDataDependenceEdge(record.src,
+                                              record.dst,
+                                              dataDepType,
+                                              isMust);
+    } else {
+      edge = pdg->addVariableDataDependenceEdge(record.src,
+                                                record.dst,
+                                                dataDepType);
+    }
+    edge->setLoopCarried((record.flags & LoopCarriedFlag) != 0);
+
+    return edge;
+  }
+
+  /*
+   * Sub-edges only live within their parent dependence.
+   * They are still owned by the PDG, which destroys them with its edges.
+   */
+  auto srcNode = pdg->fetchNode(record.src);
+  auto dstNode = pdg->fetchNode(record.dst);
+  if (record.flags & ControlFlag) {
+    edge = pdg->addDetachedEdge<ControlDependence<Value, Value>>(srcNode,
+                                                                 dstNode);
+  } else if (record.flags & MemoryFlag) {
+    if (isMust) {
+      edge = pdg->addDetachedEdge<MustMemoryDependence<Value, Value>>(
+          srcNode,
+          dstNode,
+          dataDepType);
+    } else {
+      edge = pdg->addDetachedEdge<MayMemoryDependence<Value, Value>>(
+          srcNode,
+          dstNode,
+          dataDepType);
+    }
+  } else {
+    edge = pdg->addDetachedEdge<VariableDependence<Value, Value>>(srcNode,
+                                                                  dstNode,
+                                                                  dataDepType);
+  }
+  edge->setLoopCarried((record.flags & LoopCarriedFlag) != 0);
+
+  return edge;
+}
+
+bool PDGCache::addDependencesOf(PDG *pdg, Function &F) {
+  if (!this->isUpToDate(F)) {
+    return false;
+  }
+  auto functionIndex = this->sectionOfFunction[&F];
+  auto &section = this->sections[functionIndex];
+  auto start =
+      reinterpret_cast<const uint8_t *>(this->buffer->getBufferStart());
+  auto cur = start + section.offset;
+  auto end = cur + section.size;
+
+  /*
+   * Decode the whole section before touching the PDG.
+   * This way a section that refers to a stale function leaves the PDG as it
+   * was.
+   *
+   * Decode the side table of sub-edges first.
+   */
+  uint64_t numberOfLists = 0;
+  if (!readULEB(cur, end, numberOfLists)) {
+    return false;
+  }
+  std::vector<std::vector<EdgeRecord>> subEdgeLists;
+  for (uint64_t i = 0; i < numberOfLists; i++) {
+    uint64_t numberOfSubEdges = 0;
+    if (!readULEB(cur, end, numberOfSubEdges)) {
+      return false;
+    }
+    std::vector<EdgeRecord> subEdges;
+    for (uint64_t j = 0; j < numberOfSubEdges; j++) {
+      EdgeRecord record;
+      if (!this->readEdge(cur, end, functionIndex, record)) {
+        return false;
+      }
+      subEdges.push_back(record);
+    }
+    subEdgeLists.push_back(std::move(subEdges));
+  }
+
+  /*
+   * Decode the dependences.
+   */
+  uint64_t numberOfEdges = 0;
+  if (!readULEB(cur, end, numberOfEdges)) {
+    return false;
+  }
+  std::vector<EdgeRecord> edges;
+  for (uint64_t i = 0; i < numberOfEdges; i++) {
+    EdgeRecord record;
+    if (!this->readEdge(cur, end, functionIndex, record)) {
+      return false;
+    }
+    if ((record.flags & SubEdgesFlag) && (record.subEdges >= numberOfLists)) {
+      return false;
+    }
+    edges.push_back(record);
+  }
+
+  /*
+   * Add the dependences to the PDG.
+   */
+  for (auto &record : edges) {
+    auto edge = this->createEdge(pdg, record, true);
+    if (record.flags & SubEdgesFlag) {
+      for (auto &subRecord : subEdgeLists[record.subEdges]) {
+        edge->addSubEdge(this->createEdge(pdg, subRecord, false));
+      }
+    }
+  }
+
+  return true;
+}
+
+uint64_t PDGCache::getFlags(DGEdge<Value, Value> *edge) {
+  uint64_t flags = 0;
+  if (isa<MemoryDependence<Value, Value>>(edge)) {
+    flags |= MemoryFlag;
+  }
+  if (isa<MustMemoryDependence<Value, Value>>(edge)) {
+    flags |= MustFlag;
+  }
+  if (isa<ControlDependence<Value, Value>>(edge)) {
+    flags |= ControlFlag;
+  }
+  if (edge->isLoopCarriedDependence()) {
+    flags |= LoopCarriedFlag;
+  }
+  if (auto dataDep = dyn_cast<DataDependence<Value, Value>>(edge)) {
+    flags |= (static_cast<uint64_t>(dataDep->getDataDependenceType())
+              << DataTypeShift);
+  }
+
+  return flags;
+}
+
+std::string PDGCache::getFileName(Module &M) {
+  auto &moduleName = M.getModuleIdentifier();
+  if (moduleName.empty() || (moduleName == "<stdin>")) {
+    return "";
+  }
+
+  return moduleName + ".pdg";
+}
+
+bool PDGCache::write(PDG *pdg,
+                     Module &M,
+                     const std::string &options,
+                     const std::string &fileName) {
+
+  /*
+   * Encode the cache before opening the file, so a failure does not leave a
+   * truncated file behind.
+   */
+  std::string data;
+  raw_string_ostream dataStream(data);
+  if (!PDGCache::write(pdg, M, options, dataStream)) {
+    return false;
+  }
+  dataStream.flush();
+
+  /*
+   * Write the file.
+   */
+  std::error_code EC;
+  raw_fd_ostream out(fileName, EC);
+  if (EC) {
+    errs() << "PDGCache: Error = cannot open " << fileName << ": "
+           << EC.message() << "\n";
+    return false;
+  }
+  out << data;
+
+  return !out.has_error();
+}
+
+bool PDGCache::write(PDG *pdg,
+                     Module &M,
+                     const std::string &options,
+                     raw_ostream &out) {
+
+  /*
+   * Assign an index to every function with a body and a local ID to their
+   * arguments and instructions.
+   */
+  std::vector<Function *> functions;
+  std::unordered_map<Function *, uint64_t> functionIndices;
+  std::unordered_map<Value *, uint64_t> localIDs;
+  for (auto &F : M) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+    functionIndices[&F] = functions.size();
+    functions.push_back(&F);
+
+    uint64_t localID = 0;
+    for (auto &arg : F.args()) {
+      localIDs[&arg] = localID++;
+    }
+    for (auto &inst : instructions(F)) {
+      localIDs[&inst] = localID++;
+    }
+  }
+
+  /*
+   * Group the memory dependences by the function of their source, as done
+   * when the PDG is embedded as metadata.
+   * Dependences with an endpoint outside functions cannot be described with
+   * local IDs, so they are skipped.
+   */
+  auto isStorable = [&functionIndices](DGEdge<Value, Value> *edge) -> bool {
+    auto srcF = getFunctionOf(edge->getSrc());
+    auto dstF = getFunctionOf(edge->getDst());
+    return (functionIndices.find(srcF) != functionIndices.end())
+           && (functionIndices.find(dstF) != functionIndices.end());
+  };
+  std::vector<std::vector<DGEdge<Value, Value> *>> edgesOfFunction(
+      functions.size());
+  for (auto edge : pdg->getSortedDependences()) {
+    if (!isa<MemoryDependence<Value, Value>>(edge)) {
+      continue;
+    }
+    if (!isStorable(edge)) {
+      continue;
+    }
+    auto F = getFunctionOf(edge->getSrc());
+    edgesOfFunction[functionIndices[F]].push_back(edge);
+  }
+
+  /*
+   * Encode the sections.
+   */
+  std::string data;
+  raw_string_ostream dataStream(data);
+  std::vector<std::pair<uint64_t, uint64_t>> sectionRanges;
+  for (uint64_t i = 0; i < functions.size(); i++) {
+    auto writeEndpoint = [&](Value *v, raw_ostream &o) {
+      auto functionIndex = functionIndices[getFunctionOf(v)];
+      auto isForeign = (functionIndex != i) ? 1 : 0;
+      encodeULEB128((localIDs[v] << 1) | isForeign, o);
+      if (isForeign) {
+        encodeULEB128(functionIndex, o);
+      }
+    };
+    auto writeEdge =
+        [&](DGEdge<Value, Value> *edge, uint64_t flags, raw_ostream &o) {
+          encodeULEB128(flags, o);
+          writeEndpoint(edge->getSrc(), o);
+          writeEndpoint(edge->getDst(), o);
+        };
+
+    std::string subEdgesData;
+    std::string edgesData;
+    raw_string_ostream subEdgesStream(subEdgesData);
+    raw_string_ostream edgesStream(edgesData);
+    uint64_t numberOfLists = 0;
+    for (auto edge : edgesOfFunction[i]) {
+      auto flags = PDGCache::getFlags(edge);
+      std::vector<DGEdge<Value, Value> *> subEdges;
+      for (auto subEdge : edge->getSubEdges()) {
+        if (isStorable(subEdge)) {
+          subEdges.push_back(subEdge);
+        }
+      }
+      if (!subEdges.empty()) {
+        flags |= SubEdgesFlag;
+      }
+      writeEdge(edge, flags, edgesStream);
+      if (subEdges.empty()) {
+        continue;
+      }
+
+      /*
+       * Store the sub-edges in the side table.
+       */
+      encodeULEB128(numberOfLists++, edgesStream);
+      encodeULEB128(subEdges.size(), subEdgesStream);
+      for (auto subEdge : subEdges) {
+        writeEdge(subEdge, PDGCache::getFlags(subEdge), subEdgesStream);
+      }
+    }
+
+    auto offset = dataStream.tell();
+    encodeULEB128(numberOfLists, dataStream);
+    dataStream << subEdgesStream.str();
+    encodeULEB128(edgesOfFunction[i].size(), dataStream);
+    dataStream << edgesStream.str();
+    sectionRanges.push_back(std::make_pair(offset, dataStream.tell() - offset));
+  }
+
+  /*
+   * Write the cache.
+   */
+  out.write(PDGCacheMagic, sizeof(PDGCacheMagic));
+  support::endian::write<uint32_t>(out, PDGCache::version, support::little);
+  encodeULEB128(options.size(), out);
+  out << options;
+  encodeULEB128(functions.size(), out);
+  for (uint64_t i = 0; i < functions.size(); i++) {
+    auto F = functions[i];
+    auto name = F->getName();
+    encodeULEB128(name.size(), out);
+    out << name;
+    encodeULEB128(F->arg_size(), out);
+    encodeULEB128(F->getInstructionCount(), out);
+    encodeULEB128(Utils::computeFingerprint(*F), out);
+    encodeULEB128(sectionRanges[i].first, out);
+    encodeULEB128(sectionRanges[i].second, out);
+  }
+  out << dataStream.str();
+
+  return true;
+}
+
+} // namespace arcana::noelle
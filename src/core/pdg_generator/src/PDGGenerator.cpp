@@ -19,11 +19,14 @@
  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include <shared_mutex>
+#include "llvm/Support/ThreadPool.h"
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/TalkDown.hpp"
 #include "arcana/noelle/core/PDGPrinter.hpp"
 #include "arcana/noelle/core/PDGGenerator.hpp"
 #include "arcana/noelle/core/Utils.hpp"
+#include "IntegrationWithSVF.hpp"
 
 namespace arcana::noelle {
 
@@ -40,7 +43,9 @@ PDGGenerator::PDGGenerator(
     bool disableSVFCallGraph,
     bool disableAllocAA,
     bool disableRA,
-    PDGVerbosity verbose)
+    bool usePDGCache,
+    PDGVerbosity verbose,
+    uint32_t numberOfJobs)
   : M{ M },
     getSCEV{ getSCEV },
     getLoopInfo{ getLoopInfo },
@@ -57,8 +62,12 @@ PDGGenerator::PDGGenerator(
     disableSVFCallGraph{ disableSVFCallGraph },
     disableAllocAA{ disableAllocAA },
     disableRA{ disableRA },
+    usePDGCache{ usePDGCache },
+    numberOfJobs{ numberOfJobs },
     printer{},
-    noelleCG{ nullptr } {
+    noelleCG{ nullptr },
+    aaQueries{},
+    svfQueries{} {
 
   /*
    * Function reachability analysis.
@@ -114,11 +123,39 @@ void PDGGenerator::printFunctionReachabilityResult() {
 }
 
 PDG *PDGGenerator::getPDG(void) {
+  auto pdg = this->fetchPDG();
+
+  /*
+   * Add the memory dependences still in the PDG cache.
+   */
+  this->addDependencesFromPDGCache();
+
+  return pdg;
+}
+
+PDG *PDGGenerator::createFunctionDependenceGraph(Function &F) {
+  auto pdg = this->fetchPDG();
+
+  /*
+   * Add the memory dependences of @F only.
+   */
+  this->addDependencesFromPDGCache(F);
+
+  return pdg->createFunctionSubgraph(F);
+}
+
+PDG *PDGGenerator::fetchPDG(void) {
 
   /*
    * Check if we have already built the PDG.
    */
   if (this->programDependenceGraph) {
+
+    /*
+     * Bring the PDG up to date with the functions modified since then.
+     */
+    this->recomputeInvalidatedFunctions();
+
     return this->programDependenceGraph;
   }
 
@@ -146,6 +183,27 @@ PDG *PDGGenerator::getPDG(void) {
       delete PDGFromAnalysis;
     }
 
+  } else if (auto cache = this->openPDGCache()) {
+
+    /*
+     * The PDG has been stored in the binary sidecar file of the program.
+     *
+     * Load the stored PDG.
+     */
+    this->programDependenceGraph =
+        constructPDGFromCache(this->M, std::move(cache));
+    if (this->performThePDGComparison) {
+      this->addDependencesFromPDGCache();
+      auto PDGFromAnalysis = this->constructPDGFromAnalysis(this->M);
+      auto arePDGsEquivalent =
+          this->comparePDGs(PDGFromAnalysis, this->programDependenceGraph);
+      if (!arePDGsEquivalent) {
+        errs() << "PDGGenerator: Error = PDGs constructed are not the same\n";
+        abort();
+      }
+      delete PDGFromAnalysis;
+    }
+
   } else {
 
     /*
@@ -155,6 +213,25 @@ PDG *PDGGenerator::getPDG(void) {
      */
     this->programDependenceGraph = constructPDGFromAnalysis(this->M);
 
+    /*
+     * Check if the PDG built with multiple threads is the same as the one
+     * built serially.
+     */
+    if ((this->performThePDGComparison) && (this->numberOfJobs > 1)) {
+      auto jobs = this->numberOfJobs;
+      this->numberOfJobs = 1;
+      auto serialPDG = this->constructPDGFromAnalysis(this->M);
+      this->numberOfJobs = jobs;
+      auto arePDGsEquivalent =
+          this->comparePDGs(serialPDG, this->programDependenceGraph);
+      if (!arePDGsEquivalent) {
+        errs()
+            << "PDGGenerator: Error = PDGs constructed serially and in parallel are not the same\n";
+        abort();
+      }
+      delete serialPDG;
+    }
+
     /*
      * Check if we should embed the PDG.
      */
@@ -170,10 +247,38 @@ PDG *PDGGenerator::getPDG(void) {
     }
   }
 
+  /*
+   * Keep track of the values of each function so the PDG can be maintained
+   * incrementally.
+   */
+  for (auto &F : this->M) {
+    if (F.empty()) {
+      continue;
+    }
+    this->indexValuesOfFunction(F);
+  }
+  this->invalidatedFunctions.clear();
+
+  /*
+   * Keep the PDG in memory if a driver asked for it.
+   */
+  this->storePDGCacheInMemory(this->programDependenceGraph);
+
+  /*
+   * Print the statistics about the alias queries.
+   */
+  if (this->verbose >= PDGVerbosity::Minimal) {
+    errs() << "PDGGenerator: LLVM alias analyses\n";
+    this->aaQueries.printStatistics(errs(), "PDGGenerator:   ");
+    errs() << "PDGGenerator: SVF\n";
+    this->svfQueries.printStatistics(errs(), "PDGGenerator:   ");
+  }
+
   /*
    * Print the PDG
    */
   if (this->dumpPDG) {
+    this->addDependencesFromPDGCache();
     llvm::CallGraph llvmCG = llvm::CallGraph(this->M);
     this->printer.printPDG(this->M,
                            llvmCG,
@@ -211,9 +316,10 @@ void PDGGenerator::trimDGUsingCustomAliasAnalysis(PDG *pdg) {
 
   /*
    * Invoke AllocAA
-   * Fetch and invoke MayPointsToAnalysis
+   * Fetch and invoke MayPointsToAnalysis, summarizing the functions bottom-up
+   * on the call graph first.
    */
-  this->mpa = MayPointsToAnalysis{};
+  this->computeFunctionSummaries();
   removeEdgesNotUsedByParSchemes(pdg);
 
   /*
@@ -224,32 +330,45 @@ void PDGGenerator::trimDGUsingCustomAliasAnalysis(PDG *pdg) {
   return;
 }
 
+void PDGGenerator::computeFunctionSummaries(void) {
+  this->mpa = MayPointsToAnalysis{};
+  this->mpa.computeFunctionSummaries(this->getProgramCallGraph(),
+                                     this->numberOfJobs);
+
+  return;
+}
+
 void PDGGenerator::constructEdgesFromUseDefs(PDG *pdg) {
 
   /*
    * Add the dependences due to variables.
    */
   for (auto node : make_range(pdg->begin_nodes(), pdg->end_nodes())) {
+    this->constructEdgesFromUseDefsOf(pdg, node->getT());
+  }
 
-    /*
-     * Check the current definition has uses.
-     * If it doesn't, then there is no variable dependence.
-     */
-    auto pdgValue = node->getT();
-    if (pdgValue->getNumUses() == 0) {
-      continue;
-    }
+  return;
+}
 
-    /*
-     * The current definition has uses.
-     * Add the uses.
-     */
-    for (auto &U : pdgValue->uses()) {
-      auto user = U.getUser();
+void PDGGenerator::constructEdgesFromUseDefsOf(PDG *pdg, Value *definition) {
 
-      if (isa<Instruction>(user) || isa<Argument>(user)) {
-        pdg->addVariableDataDependenceEdge(pdgValue, user, DG_DATA_RAW);
-      }
+  /*
+   * Check the current definition has uses.
+   * If it doesn't, then there is no variable dependence.
+   */
+  if (definition->getNumUses() == 0) {
+    return;
+  }
+
+  /*
+   * The current definition has uses.
+   * Add the uses.
+   */
+  for (auto &U : definition->uses()) {
+    auto user = U.getUser();
+
+    if (isa<Instruction>(user) || isa<Argument>(user)) {
+      pdg->addVariableDataDependenceEdge(definition, user, DG_DATA_RAW);
     }
   }
 
@@ -258,6 +377,14 @@ void PDGGenerator::constructEdgesFromUseDefs(PDG *pdg) {
 
 void PDGGenerator::constructEdgesFromAliases(PDG *pdg, Module &M) {
 
+  /*
+   * Check if we should compute the memory dependences with multiple threads.
+   */
+  if (this->numberOfJobs > 1) {
+    this->constructEdgesFromAliasesInParallel(pdg, M);
+    return;
+  }
+
   /*
    * Use alias analysis on stores, loads, and function calls to construct PDG
    * edges
@@ -279,12 +406,92 @@ void PDGGenerator::constructEdgesFromAliases(PDG *pdg, Module &M) {
   return;
 }
 
-void PDGGenerator::constructEdgesFromAliasesForFunction(PDG *pdg, Function &F) {
+void PDGGenerator::constructEdgesFromAliasesInParallel(PDG *pdg, Module &M) {
 
   /*
-   * Fetch the alias analysis.
+   * Fetch the functions with a body following the order of the module.
    */
-  auto &AA = this->getAA(F);
+  std::vector<Function *> functions;
+  for (auto &F : M) {
+    if (F.empty()) {
+      continue;
+    }
+    functions.push_back(&F);
+  }
+
+  /*
+   * Each function is handled by a single task of the pool. The task computes
+   * the reachability analysis of its function, it uses it to compute the
+   * memory dependences of that function, and it frees it. Hence, at most one
+   * reachability result per thread of the pool is alive at any time.
+   *
+   * The dependences of a function are written to the buffer of its task. Only
+   * this thread adds them to the PDG, following the order of the functions in
+   * the module, once all tasks are done. This makes the PDG identical to the
+   * one built serially.
+   *
+   * The reachability analyses only read the IR, so they run concurrently with
+   * each other. The memory-dependence queries do not: the alias analyses of a
+   * function are obtained on demand from the pass manager, which frees those
+   * of the previous function when asked for the next one; neither LLVM's
+   * alias analyses nor SVF nor the dependence analyses added to the generator
+   * can be queried concurrently; and the alias analyses write to the IR (e.g.,
+   * SCEV and BasicAA create value handles, which set flag bits of the values
+   * they track). So, the queries of a function hold @irLock exclusively, while
+   * the reachability analyses share it. This also keeps the threads from
+   * walking the IR while another one queries the alias analyses.
+   */
+  std::vector<MemoryDependenceEdges> edgesOfFunctions(functions.size());
+  std::shared_mutex irLock;
+  ThreadPool pool(hardware_concurrency(this->numberOfJobs));
+  for (auto i = 0u; i < functions.size(); i++) {
+    auto f = functions[i];
+    auto edges = &edgesOfFunctions[i];
+    pool.async([this, f, edges, &irLock]() {
+      /*
+       * Compute the reachability analysis of the function.
+       */
+      DenseDataFlowResult *dfr = nullptr;
+      {
+        std::shared_lock<std::shared_mutex> readers(irLock);
+        dfr = this->computeReachabilityOfMemoryInstructions(*f);
+      }
+
+      /*
+       * Compute the memory dependences of the function.
+       */
+      {
+        std::unique_lock<std::shared_mutex> writer(irLock);
+        this->constructEdgesFromAliasesForFunction(edges, *f, dfr);
+      }
+
+      /*
+       * Free the memory.
+       */
+      delete dfr;
+    });
+  }
+  pool.wait();
+
+  /*
+   * Add the memory dependences to the PDG.
+   */
+  for (auto &edges : edgesOfFunctions) {
+    edges.addTo(pdg);
+  }
+
+  return;
+}
+
+DenseDataFlowResult *PDGGenerator::computeReachabilityOfMemoryInstructions(
+    Function &F) {
+
+  /*
+   * Check if the reachable analysis is disabled.
+   */
+  if (this->disableRA) {
+    return this->dfa.getDenseFullSets(&F);
+  }
 
   /*
    * Run the reachable analysis.
@@ -302,9 +509,42 @@ void PDGGenerator::constructEdgesFromAliasesForFunction(PDG *pdg, Function &F) {
     return false;
   };
   auto dfr =
-      this->disableRA
-          ? this->dfa.getFullSets(&F)
-          : this->dfa.runReachableAnalysis(&F, onlyMemoryInstructionFilter);
+      this->dfa.runDenseReachableAnalysis(&F, onlyMemoryInstructionFilter);
+
+  return dfr;
+}
+
+void PDGGenerator::constructEdgesFromAliasesForFunction(PDG *pdg, Function &F) {
+
+  /*
+   * Run the reachable analysis.
+   */
+  auto dfr = this->computeReachabilityOfMemoryInstructions(F);
+
+  /*
+   * Add the edges.
+   */
+  MemoryDependenceEdges edges;
+  this->constructEdgesFromAliasesForFunction(&edges, F, dfr);
+  edges.addTo(pdg);
+
+  /*
+   * Free the memory.
+   */
+  delete dfr;
+
+  return;
+}
+
+void PDGGenerator::constructEdgesFromAliasesForFunction(
+    MemoryDependenceEdges *edges,
+    Function &F,
+    DenseDataFlowResult *dfr) {
+
+  /*
+   * Fetch the alias analysis.
+   */
+  auto &AA = this->getAA(F);
 
   for (auto &B : F) {
     for (auto &I : B) {
@@ -320,19 +560,16 @@ void PDGGenerator::constructEdgesFromAliasesForFunction(PDG *pdg, Function &F) {
        * Check the memory dependences that start from @I
        */
       if (auto store = dyn_cast<StoreInst>(&I)) {
-        iterateInstForStore(pdg, F, AA, dfr, store);
+        iterateInstForStore(edges, F, AA, dfr, store);
       } else if (auto load = dyn_cast<LoadInst>(&I)) {
-        iterateInstForLoad(pdg, F, AA, dfr, load);
+        iterateInstForLoad(edges, F, AA, dfr, load);
       } else if (auto call = dyn_cast<CallBase>(&I)) {
-        iterateInstForCall(pdg, F, AA, dfr, call);
+        iterateInstForCall(edges, F, AA, dfr, call);
       }
     }
   }
 
-  /*
-   * Free the memory.
-   */
-  delete dfr;
+  return;
 }
 
 void PDGGenerator::removeEdgesNotUsedByParSchemes(PDG *pdg) {
@@ -342,31 +579,7 @@ void PDGGenerator::removeEdgesNotUsedByParSchemes(PDG *pdg) {
    * Collect the edges in the PDG that can be safely removed.
    */
   for (auto edge : pdg->getEdges()) {
-
-    /*
-     * Fetch the source of the dependence.
-     */
-    auto source = edge->getSrc();
-    if (!isa<Instruction>(source)) {
-      continue;
-    }
-
-    /*
-     * Check if the dependence can be removed because the instructions accessing
-     * separate memory regions.
-     */
-    if (isa<MemoryDependence<Value, Value>>(edge)
-        && this->canMemoryEdgeBeRemoved(pdg, edge)) {
-      removeEdges.insert(edge);
-      continue;
-    }
-
-    /*
-     * Check if the function of the dependence destination cannot be reached
-     * from main.
-     */
-    if (edgeIsNotLoopCarriedMemoryDependency(edge)
-        || edgeIsAlongNonMemoryWritingFunctions(edge)) {
+    if (this->isEdgeNotUsedByParSchemes(pdg, edge)) {
       removeEdges.insert(edge);
     }
   }
@@ -381,6 +594,38 @@ void PDGGenerator::removeEdgesNotUsedByParSchemes(PDG *pdg) {
   return;
 }
 
+bool PDGGenerator::isEdgeNotUsedByParSchemes(PDG *pdg,
+                                             DGEdge<Value, Value> *edge) {
+
+  /*
+   * Fetch the source of the dependence.
+   */
+  auto source = edge->getSrc();
+  if (!isa<Instruction>(source)) {
+    return false;
+  }
+
+  /*
+   * Check if the dependence can be removed because the instructions accessing
+   * separate memory regions.
+   */
+  if (isa<MemoryDependence<Value, Value>>(edge)
+      && this->canMemoryEdgeBeRemoved(pdg, edge)) {
+    return true;
+  }
+
+  /*
+   * Check if the function of the dependence destination cannot be reached
+   * from main.
+   */
+  if (edgeIsNotLoopCarriedMemoryDependency(edge)
+      || edgeIsAlongNonMemoryWritingFunctions(edge)) {
+    return true;
+  }
+
+  return false;
+}
+
 bool PDGGenerator::canMemoryEdgeBeRemoved(PDG *pdg,
                                           DGEdge<Value, Value> *edge) {
   assert(pdg != nullptr);
@@ -0,0 +1,335 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/PDGGenerator.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Caches kept in memory for the modules that asked for it (see
+ * PDGGenerator::retainPDGCacheInMemory).
+ * A module that is retained but that has no PDG yet has an empty cache.
+ */
+static std::unordered_map<const Module *, std::string> &getCachesInMemory(
+    void) {
+  static std::unordered_map<const Module *, std::string> caches;
+
+  return caches;
+}
+
+void PDGGenerator::retainPDGCacheInMemory(Module &M) {
+  getCachesInMemory()[&M];
+
+  return;
+}
+
+void PDGGenerator::releasePDGCacheInMemory(Module &M) {
+  getCachesInMemory().erase(&M);
+
+  return;
+}
+
+void PDGGenerator::storePDGCacheInMemory(PDG *pdg) {
+  auto it = getCachesInMemory().find(&this->M);
+  if (it == getCachesInMemory().end()) {
+    return;
+  }
+  if (verbose >= PDGVerbosity::Maximal) {
+    errs() << "PDGGenerator: Keep the PDG in memory\n";
+  }
+
+  /*
+   * All the dependences are needed to write the cache.
+   */
+  if (pdg == this->programDependenceGraph) {
+    this->addDependencesFromPDGCache();
+  }
+
+  /*
+   * Replace the previous cache of the module.
+   */
+  std::string data;
+  raw_string_ostream dataStream(data);
+  if (!PDGCache::write(pdg, this->M, this->getPDGCacheOptions(), dataStream)) {
+    data.clear();
+  }
+  dataStream.flush();
+  it->second = std::move(data);
+
+  return;
+}
+
+bool PDGGenerator::writePDGCache(PDG *pdg) {
+  auto fileName = PDGCache::getFileName(this->M);
+  if (fileName == "") {
+    errs() << "PDGGenerator: Error = no file to cache the PDG\n";
+    return false;
+  }
+  if (verbose >= PDGVerbosity::Minimal) {
+    errs() << "PDGGenerator: Write the PDG to " << fileName << "\n";
+  }
+
+  if (pdg == this->programDependenceGraph) {
+    this->addDependencesFromPDGCache();
+  }
+
+  return PDGCache::write(pdg, this->M, this->getPDGCacheOptions(), fileName);
+}
+
+std::string PDGGenerator::getPDGCacheOptions(void) const {
+  std::string options;
+  raw_string_ostream optionsStream(options);
+  optionsStream << "svf=" << !this->disableSVF
+                << ";svf-callgraph=" << !this->disableSVFCallGraph
+                << ";allocaa=" << !this->disableAllocAA
+                << ";ra=" << !this->disableRA;
+
+  /*
+   * Add the custom dependence analyses in a stable order.
+   */
+  std::set<std::string> analyses;
+  for (auto analysis : this->ddAnalyses) {
+    analyses.insert(analysis->getName());
+  }
+  optionsStream << ";analyses=";
+  for (auto &name : analyses) {
+    optionsStream << name << ",";
+  }
+  optionsStream.flush();
+
+  return options;
+}
+
+std::unique_ptr<PDGCache> PDGGenerator::openPDGCache(void) {
+
+  /*
+   * Prefer the cache kept in memory, if any.
+   * It is copied as its sections are decoded on demand, while the cache kept
+   * in memory can be replaced or released in the meantime.
+   */
+  auto it = getCachesInMemory().find(&this->M);
+  if ((it != getCachesInMemory().end()) && (!it->second.empty())) {
+    auto buffer = MemoryBuffer::getMemBufferCopy(it->second);
+    auto cache = std::make_unique<PDGCache>(this->M,
+                                            std::move(buffer),
+                                            this->getPDGCacheOptions());
+    if (cache->isAvailable()) {
+      return cache;
+    }
+  }
+
+  /*
+   * Fetch the sidecar file, if asked.
+   */
+  if (!this->usePDGCache) {
+    return nullptr;
+  }
+  auto fileName = PDGCache::getFileName(this->M);
+  if (fileName == "") {
+    return nullptr;
+  }
+  auto cache = std::make_unique<PDGCache>(this->M,
+                                          fileName,
+                                          this->getPDGCacheOptions());
+  if (!cache->isAvailable()) {
+    if (verbose >= PDGVerbosity::Minimal) {
+      errs() << "PDGGenerator: " << fileName
+             << " is missing or it has been computed with other analyses\n";
+    }
+    return nullptr;
+  }
+
+  return cache;
+}
+
+PDG *PDGGenerator::constructPDGFromCache(Module &M,
+                                         std::unique_ptr<PDGCache> cache) {
+  if (verbose >= PDGVerbosity::Maximal) {
+    errs() << "PDGGenerator: Construct PDG from the binary cache\n";
+  }
+
+  /*
+   * Create the PDG.
+   * Dependences decoded from the cache later on are added to it.
+   */
+  auto pdg = new PDG(M);
+  this->programDependenceGraph = pdg;
+  constructEdgesFromUseDefs(pdg);
+
+  /*
+   * The memory dependences of the functions that did not change since the
+   * cache has been written are decoded when they are needed (see
+   * addDependencesFromPDGCache).
+   * Functions that changed are analyzed again.
+   */
+  std::unordered_set<Function *> staleFunctions;
+  for (auto &F : M) {
+    if (F.empty()) {
+      continue;
+    }
+    if (cache->isUpToDate(F)) {
+      this->functionsInPDGCache.insert(&F);
+      continue;
+    }
+    constructEdgesFromAliasesForFunction(pdg, F);
+    staleFunctions.insert(&F);
+  }
+  this->pdgCache = std::move(cache);
+  if (verbose >= PDGVerbosity::Maximal) {
+    errs() << "PDGGenerator:   Functions analyzed again = "
+           << staleFunctions.size() << "\n";
+  }
+
+  /*
+   * The summaries of the functions are needed to trim the dependences that
+   * do not come from the cache, and by the queries done on the PDG later on.
+   */
+  if (!this->disableAllocAA) {
+    this->computeFunctionSummaries();
+  }
+
+  /*
+   * The memory dependences of a call depend on what the callee does.
+   * Hence, the memory dependences of the calls that can invoke a function
+   * analyzed again are computed again as well.
+   * The cached dependences of their callers are needed to do so.
+   */
+  std::vector<DGEdge<Value, Value> *> edgesOfCalls;
+  auto callsToRecompute = this->fetchCallsAffectedBy(staleFunctions);
+  for (auto &F : M) {
+    auto calls = callsToRecompute.find(&F);
+    if (calls == callsToRecompute.end()) {
+      continue;
+    }
+    this->addDependencesFromPDGCache(F);
+    auto edges = this->recomputeMemoryEdgesOfCalls(pdg, F, calls->second);
+    edgesOfCalls.insert(edgesOfCalls.end(), edges.begin(), edges.end());
+  }
+
+  constructEdgesFromControl(pdg, M);
+
+  /*
+   * Dependences that come from the cache have been already trimmed, so only
+   * the new ones are trimmed.
+   */
+  if (!this->disableAllocAA) {
+    std::vector<DGEdge<Value, Value> *> edgesToRemove;
+    for (auto F : staleFunctions) {
+      for (auto &I : instructions(*F)) {
+        for (auto edge : pdg->fetchNode(&I)->getOutgoingEdges()) {
+          if (this->isEdgeNotUsedByParSchemes(pdg, edge)) {
+            edgesToRemove.push_back(edge);
+          }
+        }
+      }
+    }
+    for (auto edge : edgesOfCalls) {
+      if (this->isEdgeNotUsedByParSchemes(pdg, edge)) {
+        edgesToRemove.push_back(edge);
+      }
+    }
+    for (auto edge : edgesToRemove) {
+      pdg->removeEdge(edge);
+    }
+  }
+
+  return pdg;
+}
+
+void PDGGenerator::addDependencesFromPDGCache(Function &F) {
+
+  /*
+   * Check if the memory dependences of @F are still in the cache.
+   */
+  auto it = this->functionsInPDGCache.find(&F);
+  if (it == this->functionsInPDGCache.end()) {
+    return;
+  }
+  this->functionsInPDGCache.erase(it);
+  auto pdg = this->programDependenceGraph;
+  assert(pdg != nullptr);
+  assert(this->pdgCache != nullptr);
+
+  /*
+   * Decode the section of @F.
+   * Memory dependences are computed per function, so the section of @F
+   * includes all the memory dependences of @F.
+   */
+  if (!this->pdgCache->addDependencesOf(pdg, F)) {
+
+    /*
+     * The section cannot be used.
+     * Analyze @F again and trim its dependences as done when the PDG has been
+     * loaded.
+     */
+    if (this->verbose >= PDGVerbosity::Maximal) {
+      errs() << "PDGGenerator:   Function analyzed again = " << F.getName()
+             << "\n";
+    }
+    this->constructEdgesFromAliasesForFunction(pdg, F);
+    if (!this->disableAllocAA) {
+      std::vector<DGEdge<Value, Value> *> edgesToRemove;
+      for (auto &I : instructions(F)) {
+        for (auto edge : pdg->fetchNode(&I)->getOutgoingEdges()) {
+          if (this->isEdgeNotUsedByParSchemes(pdg, edge)) {
+            edgesToRemove.push_back(edge);
+          }
+        }
+      }
+      for (auto edge : edgesToRemove) {
+        pdg->removeEdge(edge);
+      }
+    }
+  }
+
+  /*
+   * Release the cache once it is no longer needed.
+   */
+  if (this->functionsInPDGCache.empty()) {
+    this->pdgCache.reset();
+  }
+
+  return;
+}
+
+void PDGGenerator::addDependencesFromPDGCache(void) {
+
+  /*
+   * Follow the order of the module.
+   */
+  for (auto &F : this->M) {
+    if (this->functionsInPDGCache.empty()) {
+      break;
+    }
+    this->addDependencesFromPDGCache(F);
+  }
+
+  /*
+   * Functions that are no longer part of the module are left in the cache.
+   */
+  this->functionsInPDGCache.clear();
+  this->pdgCache.reset();
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,405 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/PDGGenerator.hpp"
+
+namespace arcana::noelle {
+
+void PDGGenerator::invalidateFunction(Function &F) {
+
+  /*
+   * Check if the PDG has been built.
+   * If it hasn't, then it will be built from the current code.
+   */
+  if (this->programDependenceGraph == nullptr) {
+    return;
+  }
+
+  /*
+   * Keep track of the function.
+   * Notice that @F is not dereferenced as it could have been deleted.
+   */
+  this->invalidatedFunctions.insert(&F);
+
+  /*
+   * The memory dependences of @F stored in the PDG cache are stale.
+   */
+  if (this->pdgCache != nullptr) {
+    this->pdgCache->invalidate(F);
+    this->functionsInPDGCache.erase(&F);
+  }
+
+  return;
+}
+
+void PDGGenerator::recomputeFunction(Function &F) {
+  this->invalidateFunction(F);
+  this->recomputeInvalidatedFunctions();
+
+  return;
+}
+
+void PDGGenerator::recomputeInvalidatedFunctions(void) {
+
+  /*
+   * Check if there is something to do.
+   */
+  if (this->invalidatedFunctions.empty()) {
+    return;
+  }
+  auto pdg = this->programDependenceGraph;
+  assert(pdg != nullptr);
+  if (this->verbose >= PDGVerbosity::Minimal) {
+    errs() << "PDGGenerator: Recompute the dependences of "
+           << this->invalidatedFunctions.size() << " functions\n";
+  }
+
+  /*
+   * Fetch the functions that are still part of the program.
+   */
+  std::unordered_set<Function *> functionsOfTheProgram;
+  for (auto &F : this->M) {
+    functionsOfTheProgram.insert(&F);
+  }
+
+  /*
+   * Fetch the functions to recompute.
+   */
+  std::unordered_set<Function *> modifiedFunctions;
+  for (auto F : this->invalidatedFunctions) {
+    if (functionsOfTheProgram.find(F) == functionsOfTheProgram.end()) {
+      continue;
+    }
+    if (F->empty()) {
+      continue;
+    }
+    modifiedFunctions.insert(F);
+  }
+  std::vector<Function *> functionsToRecompute;
+  for (auto &F : this->M) {
+    if (modifiedFunctions.find(&F) != modifiedFunctions.end()) {
+      functionsToRecompute.push_back(&F);
+    }
+  }
+
+  /*
+   * Fetch the calls to recompute.
+   *
+   * The memory dependences of a call depend on what the callee does. Hence,
+   * the memory dependences of the calls that can invoke a modified function
+   * are recomputed as well. The rest of their callers is kept.
+   */
+  auto callsToRecompute = this->fetchCallsAffectedBy(modifiedFunctions);
+  if (this->verbose >= PDGVerbosity::Maximal) {
+    errs() << "PDGGenerator:   Functions recomputed = "
+           << functionsToRecompute.size() << "\n";
+    errs() << "PDGGenerator:   Callers patched = " << callsToRecompute.size()
+           << "\n";
+  }
+
+  /*
+   * SVF analyzed the original code. Hence, its answers cannot be trusted for
+   * the code that is about to be analyzed. The other functions keep using it.
+   */
+  for (auto F : functionsToRecompute) {
+    this->functionsUnknownToSVF.insert(F);
+  }
+  for (auto &pair : callsToRecompute) {
+    this->functionsUnknownToSVF.insert(pair.first);
+  }
+
+  /*
+   * Remove the nodes that the functions had when they have been analyzed.
+   * The values of the invalidated functions might have been deleted since
+   * then.
+   */
+  std::unordered_set<Function *> staleFunctions(
+      this->invalidatedFunctions.begin(),
+      this->invalidatedFunctions.end());
+  for (auto F : staleFunctions) {
+    auto values = this->valuesOfFunctions.find(F);
+    if (values != this->valuesOfFunctions.end()) {
+      pdg->removeNodes(values->second);
+      this->valuesOfFunctions.erase(values);
+    }
+    this->aaQueries.invalidate(F);
+    this->svfQueries.invalidate(F);
+  }
+  for (auto &pair : callsToRecompute) {
+    this->aaQueries.invalidate(pair.first);
+    this->svfQueries.invalidate(pair.first);
+  }
+  this->invalidatedFunctions.clear();
+
+  /*
+   * Add a node per value of the functions to recompute.
+   *
+   * Transformations might have added nodes for the new values already. These
+   * nodes are replaced so their dependences are computed from scratch.
+   */
+  for (auto F : functionsToRecompute) {
+    auto &values = this->indexValuesOfFunction(*F);
+    pdg->removeNodes(values);
+    pdg->addFunction(*F);
+  }
+
+  /*
+   * Compute the dependences of the functions.
+   */
+  for (auto F : functionsToRecompute) {
+    for (auto value : this->valuesOfFunctions[F]) {
+      this->constructEdgesFromUseDefsOf(pdg, value);
+    }
+    this->constructEdgesFromAliasesForFunction(pdg, *F);
+    this->constructEdgesFromControlForFunction(pdg, *F);
+  }
+
+  /*
+   * Compute the memory dependences of the calls, following the order of the
+   * module.
+   * The dependences of their functions still in the PDG cache are added
+   * first.
+   */
+  std::vector<DGEdge<Value, Value> *> edgesOfCalls;
+  for (auto &F : this->M) {
+    auto calls = callsToRecompute.find(&F);
+    if (calls == callsToRecompute.end()) {
+      continue;
+    }
+    this->addDependencesFromPDGCache(F);
+    auto edges = this->recomputeMemoryEdgesOfCalls(pdg, F, calls->second);
+    edgesOfCalls.insert(edgesOfCalls.end(), edges.begin(), edges.end());
+  }
+
+  /*
+   * Trim the new dependences like the ones of the PDG built from scratch.
+   *
+   * The points-to summary of a function depends on the ones of its callees.
+   * Hence, the summaries of the modified functions and of their callers,
+   * transitively, are computed again first. Only the summaries are
+   * recomputed for the callers, not their dependences.
+   */
+  if (!this->disableAllocAA) {
+    std::unordered_set<Function *> functionsToSummarize(
+        modifiedFunctions.begin(),
+        modifiedFunctions.end());
+    std::vector<Function *> worklist(modifiedFunctions.begin(),
+                                     modifiedFunctions.end());
+    while (!worklist.empty()) {
+      auto F = worklist.back();
+      worklist.pop_back();
+      for (auto &pair : this->fetchCallsAffectedBy({ F })) {
+        if (functionsToSummarize.insert(pair.first).second) {
+          worklist.push_back(pair.first);
+        }
+      }
+    }
+    std::unordered_set<Function *> summariesToDrop(
+        functionsToSummarize.begin(),
+        functionsToSummarize.end());
+    summariesToDrop.insert(staleFunctions.begin(), staleFunctions.end());
+    std::vector<Function *> functionsToSummarizeInOrder;
+    for (auto &F : this->M) {
+      if (functionsToSummarize.find(&F) != functionsToSummarize.end()) {
+        functionsToSummarizeInOrder.push_back(&F);
+      }
+    }
+    this->mpa.invalidateFunctionSummaries(summariesToDrop);
+    this->mpa.summarizeFunctions(functionsToSummarizeInOrder);
+
+    std::vector<DGEdge<Value, Value> *> edgesToRemove;
+    for (auto F : functionsToRecompute) {
+      for (auto value : this->valuesOfFunctions[F]) {
+        auto node = pdg->fetchNode(value);
+        for (auto edge : node->getOutgoingEdges()) {
+          if (this->isEdgeNotUsedByParSchemes(pdg, edge)) {
+            edgesToRemove.push_back(edge);
+          }
+        }
+      }
+    }
+    for (auto edge : edgesOfCalls) {
+      if (this->isEdgeNotUsedByParSchemes(pdg, edge)) {
+        edgesToRemove.push_back(edge);
+      }
+    }
+    for (auto edge : edgesToRemove) {
+      pdg->removeEdge(edge);
+    }
+  }
+
+  return;
+}
+
+std::vector<DGEdge<Value, Value> *> PDGGenerator::recomputeMemoryEdgesOfCalls(
+    PDG *pdg,
+    Function &F,
+    const std::unordered_set<CallBase *> &calls) {
+  std::unordered_set<Instruction *> targets(calls.begin(), calls.end());
+
+  /*
+   * Collect the memory dependences of the calls.
+   */
+  auto fetchMemoryEdgesOfCalls = [pdg, &calls](void) {
+    std::unordered_set<DGEdge<Value, Value> *> edges;
+    for (auto call : calls) {
+      auto node = pdg->fetchNode(call);
+      if (node == nullptr) {
+        continue;
+      }
+      for (auto edge : node->getOutgoingEdges()) {
+        if (isa<MemoryDependence<Value, Value>>(edge)) {
+          edges.insert(edge);
+        }
+      }
+      for (auto edge : node->getIncomingEdges()) {
+        if (isa<MemoryDependence<Value, Value>>(edge)) {
+          edges.insert(edge);
+        }
+      }
+    }
+    return edges;
+  };
+
+  /*
+   * Remove the current ones.
+   */
+  for (auto edge : fetchMemoryEdgesOfCalls()) {
+    pdg->removeEdge(edge);
+  }
+
+  /*
+   * Compute them again.
+   *
+   * The dependences from a call are computed by iterating over the call.
+   * The ones to a call are computed by iterating over the other instructions,
+   * considering only the calls as destinations.
+   */
+  auto dfr = this->computeReachabilityOfMemoryInstructions(F);
+  auto &AA = this->getAA(F);
+  MemoryDependenceEdges newEdges;
+  for (auto &I : instructions(F)) {
+    if (!PDGGenerator::canAccessMemory(&I)) {
+      continue;
+    }
+    if (auto store = dyn_cast<StoreInst>(&I)) {
+      this->iterateInstForStore(&newEdges, F, AA, dfr, store, &targets);
+    } else if (auto load = dyn_cast<LoadInst>(&I)) {
+      this->iterateInstForLoad(&newEdges, F, AA, dfr, load, &targets);
+    } else if (auto call = dyn_cast<CallBase>(&I)) {
+      if (targets.find(call) != targets.end()) {
+        this->iterateInstForCall(&newEdges, F, AA, dfr, call);
+      } else {
+        this->iterateInstForCall(&newEdges, F, AA, dfr, call, &targets);
+      }
+    }
+  }
+  delete dfr;
+  newEdges.addTo(pdg);
+
+  auto edges = fetchMemoryEdgesOfCalls();
+
+  return std::vector<DGEdge<Value, Value> *>(edges.begin(), edges.end());
+}
+
+std::unordered_map<Function *, std::unordered_set<CallBase *>> PDGGenerator::
+    fetchCallsAffectedBy(
+        const std::unordered_set<Function *> &functions) const {
+  std::unordered_map<Function *, std::unordered_set<CallBase *>> calls;
+
+  /*
+   * Fetch the direct calls, and the signatures of the functions that can be
+   * invoked indirectly.
+   */
+  std::unordered_set<FunctionType *> signaturesOfEscapingFunctions;
+  for (auto F : functions) {
+    for (auto &use : F->uses()) {
+      auto call = dyn_cast<CallBase>(use.getUser());
+      if ((call == nullptr) || (!call->isCallee(&use))) {
+
+        /*
+         * The address of @F is taken, so @F can be the callee of indirect
+         * calls with its signature.
+         */
+        signaturesOfEscapingFunctions.insert(F->getFunctionType());
+        continue;
+      }
+      auto caller = call->getFunction();
+      if (functions.find(caller) != functions.end()) {
+        continue;
+      }
+      calls[caller].insert(call);
+    }
+  }
+
+  /*
+   * Fetch the indirect calls.
+   */
+  if (signaturesOfEscapingFunctions.empty()) {
+    return calls;
+  }
+  for (auto &caller : this->M) {
+    if (functions.find(&caller) != functions.end()) {
+      continue;
+    }
+    for (auto &I : instructions(caller)) {
+      auto call = dyn_cast<CallBase>(&I);
+      if ((call == nullptr) || (!call->isIndirectCall())) {
+        continue;
+      }
+      if (signaturesOfEscapingFunctions.find(call->getFunctionType())
+          == signaturesOfEscapingFunctions.end()) {
+        continue;
+      }
+      calls[&caller].insert(call);
+    }
+  }
+
+  return calls;
+}
+
+std::vector<Value *> &PDGGenerator::indexValuesOfFunction(Function &F) {
+  auto &values = this->valuesOfFunctions[&F];
+  values.clear();
+  for (auto &arg : F.args()) {
+    values.push_back(&arg);
+  }
+  for (auto &I : instructions(F)) {
+    values.push_back(&I);
+  }
+
+  return values;
+}
+
+bool PDGGenerator::canUseSVF(const Function &F) const {
+  if (this->disableSVF) {
+    return false;
+  }
+  if (this->functionsUnknownToSVF.find(&F)
+      != this->functionsUnknownToSVF.end()) {
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace arcana::noelle
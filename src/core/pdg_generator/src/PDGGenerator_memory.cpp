@@ -77,19 +77,21 @@ std::pair<bool, bool> PDGGenerator::isThereThisMemoryDataDependenceType(
   return std::make_pair(noDep, mustExist);
 }
 
-void PDGGenerator::iterateInstForStore(PDG *pdg,
-                                       Function &F,
-                                       AAResults &AA,
-                                       DataFlowResult *dfr,
-                                       StoreInst *store) {
+void PDGGenerator::iterateInstForStore(
+    MemoryDependenceEdges *edges,
+    Function &F,
+    AAResults &AA,
+    DenseDataFlowResult *dfr,
+    StoreInst *store,
+    const std::unordered_set<Instruction *> *targets) {
 
-  for (auto I : dfr->OUT(store)) {
+  for (auto id : dfr->OUTBits(store).set_bits()) {
 
     /*
      * Check if the instruction can access memory.
      */
-    auto inst = dyn_cast<Instruction>(I);
-    if (inst == nullptr) {
+    auto inst = dfr->getInstruction(id);
+    if ((targets != nullptr) && (targets->find(inst) == targets->end())) {
       continue;
     }
     if (!PDGGenerator::canAccessMemory(inst)) {
@@ -110,7 +112,12 @@ void PDGGenerator::iterateInstForStore(PDG *pdg,
      * Check stores.
      */
     if (auto otherStore = dyn_cast<StoreInst>(inst)) {
-      this->addEdgeFromMemoryAlias(pdg, F, AA, store, otherStore, DG_DATA_WAW);
+      this->addEdgeFromMemoryAlias(edges,
+                                   F,
+                                   AA,
+                                   store,
+                                   otherStore,
+                                   DG_DATA_WAW);
       continue;
     }
 
@@ -118,7 +125,7 @@ void PDGGenerator::iterateInstForStore(PDG *pdg,
      * Check loads.
      */
     if (auto load = dyn_cast<LoadInst>(inst)) {
-      this->addEdgeFromMemoryAlias(pdg, F, AA, store, load, DG_DATA_RAW);
+      this->addEdgeFromMemoryAlias(edges, F, AA, store, load, DG_DATA_RAW);
       continue;
     }
 
@@ -129,7 +136,7 @@ void PDGGenerator::iterateInstForStore(PDG *pdg,
       if (!Utils::isActualCode(call)) {
         continue;
       }
-      this->addEdgeFromFunctionModRef(pdg, F, AA, call, store, false);
+      this->addEdgeFromFunctionModRef(edges, F, AA, call, store, false);
       continue;
     }
   }
@@ -137,19 +144,21 @@ void PDGGenerator::iterateInstForStore(PDG *pdg,
   return;
 }
 
-void PDGGenerator::iterateInstForLoad(PDG *pdg,
-                                      Function &F,
-                                      AAResults &AA,
-                                      DataFlowResult *dfr,
-                                      LoadInst *load) {
+void PDGGenerator::iterateInstForLoad(
+    MemoryDependenceEdges *edges,
+    Function &F,
+    AAResults &AA,
+    DenseDataFlowResult *dfr,
+    LoadInst *load,
+    const std::unordered_set<Instruction *> *targets) {
 
-  for (auto I : dfr->OUT(load)) {
+  for (auto id : dfr->OUTBits(load).set_bits()) {
 
     /*
      * Check if the instruction can access memory.
      */
-    auto inst = dyn_cast<Instruction>(I);
-    if (inst == nullptr) {
+    auto inst = dfr->getInstruction(id);
+    if ((targets != nullptr) && (targets->find(inst) == targets->end())) {
       continue;
     }
     if (!PDGGenerator::canAccessMemory(inst)) {
@@ -170,7 +179,7 @@ void PDGGenerator::iterateInstForLoad(PDG *pdg,
      * Check stores.
      */
     if (auto store = dyn_cast<StoreInst>(inst)) {
-      this->addEdgeFromMemoryAlias(pdg, F, AA, load, store, DG_DATA_WAR);
+      this->addEdgeFromMemoryAlias(edges, F, AA, load, store, DG_DATA_WAR);
       continue;
     }
 
@@ -178,7 +187,7 @@ void PDGGenerator::iterateInstForLoad(PDG *pdg,
      * Check calls.
      */
     if (auto call = dyn_cast<CallBase>(inst)) {
-      this->addEdgeFromFunctionModRef(pdg, F, AA, call, load, false);
+      this->addEdgeFromFunctionModRef(edges, F, AA, call, load, false);
       continue;
     }
   }
@@ -186,11 +195,13 @@ void PDGGenerator::iterateInstForLoad(PDG *pdg,
   return;
 }
 
-void PDGGenerator::iterateInstForCall(PDG *pdg,
-                                      Function &F,
-                                      AAResults &AA,
-                                      DataFlowResult *dfr,
-                                      CallBase *call) {
+void PDGGenerator::iterateInstForCall(
+    MemoryDependenceEdges *edges,
+    Function &F,
+    AAResults &AA,
+    DenseDataFlowResult *dfr,
+    CallBase *call,
+    const std::unordered_set<Instruction *> *targets) {
 
   /*
    * Check if the call instruction is not actual code.
@@ -216,13 +227,13 @@ void PDGGenerator::iterateInstForCall(PDG *pdg,
   /*
    * Identify all dependences from @call.
    */
-  for (auto I : dfr->OUT(call)) {
+  for (auto id : dfr->OUTBits(call).set_bits()) {
 
     /*
      * Check if the instruction can access memory.
      */
-    auto inst = dyn_cast<Instruction>(I);
-    if (inst == nullptr) {
+    auto inst = dfr->getInstruction(id);
+    if ((targets != nullptr) && (targets->find(inst) == targets->end())) {
       continue;
     }
     if (!PDGGenerator::canAccessMemory(inst)) {
@@ -243,7 +254,7 @@ void PDGGenerator::iterateInstForCall(PDG *pdg,
      * Check stores.
      */
     if (auto store = dyn_cast<StoreInst>(inst)) {
-      addEdgeFromFunctionModRef(pdg, F, AA, call, store, true);
+      addEdgeFromFunctionModRef(edges, F, AA, call, store, true);
       continue;
     }
 
@@ -251,7 +262,7 @@ void PDGGenerator::iterateInstForCall(PDG *pdg,
      * Check loads.
      */
     if (auto load = dyn_cast<LoadInst>(inst)) {
-      addEdgeFromFunctionModRef(pdg, F, AA, call, load, true);
+      addEdgeFromFunctionModRef(edges, F, AA, call, load, true);
       continue;
     }
 
@@ -268,9 +279,8 @@ void PDGGenerator::iterateInstForCall(PDG *pdg,
           continue;
         }
       }
-      bool isCallReachableFromOtherCall =
-          dfr->OUT(baseOtherCall).count(call) > 0 ? true : false;
-      this->addEdgeFromFunctionModRef(pdg,
+      auto isCallReachableFromOtherCall = dfr->isInOUT(baseOtherCall, call);
+      this->addEdgeFromFunctionModRef(edges,
                                       F,
                                       AA,
                                       call,
@@ -289,7 +299,7 @@ bool PDGGenerator::hasNoMemoryOperations(CallBase *call) {
   /*
    * Check if SVF is enabled.
    */
-  if (this->disableSVF) {
+  if (!this->canUseSVF(*call->getFunction())) {
     return false;
   }
 
@@ -318,7 +328,7 @@ bool PDGGenerator::hasNoMemoryOperations(CallBase *call) {
   return false;
 }
 
-void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
+void PDGGenerator::addEdgeFromFunctionModRef(MemoryDependenceEdges *edges,
                                              Function &F,
                                              AAResults &AA,
                                              CallBase *call,
@@ -338,7 +348,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
   /*
    * Query the LLVM alias analyses.
    */
-  switch (AA.getModRefInfo(call, MemoryLocation::get(store))) {
+  switch (this->queryModRefInfo(F, AA, call, MemoryLocation::get(store))) {
     case ModRefInfo::NoModRef:
     case ModRefInfo::Must:
       return;
@@ -361,7 +371,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
    *
    * Check if SVF is enabled.
    */
-  if (this->disableSVF) {
+  if (!this->canUseSVF(F)) {
 
     /*
      * SVF is disabled.
@@ -384,7 +394,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
      */
     if (this->isSafeToQueryModRefOfSVF(call, bv)) {
       auto const &loc = MemoryLocation::get(store);
-      switch (NoelleSVFIntegration::getModRefInfo(call, loc)) {
+      switch (this->querySVFModRefInfo(call, loc)) {
         case ModRefInfo::NoModRef:
         case ModRefInfo::Must:
           return;
@@ -436,7 +446,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
                                                     store,
                                                     F);
       if (!noDep) {
-        pdg->addMemoryDataDependenceEdge(call, store, DG_DATA_WAR, mustExist);
+        edges->addMemoryDataDependenceEdge(call, store, DG_DATA_WAR, mustExist);
       }
 
     } else {
@@ -459,7 +469,10 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
                                                       store,
                                                       F);
         if (!noDep) {
-          pdg->addMemoryDataDependenceEdge(store, call, DG_DATA_RAW, mustExist);
+          edges->addMemoryDataDependenceEdge(store,
+                                             call,
+                                             DG_DATA_RAW,
+                                             mustExist);
         }
       }
     }
@@ -479,7 +492,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
                                                     store,
                                                     F);
       if (!noDep) {
-        pdg->addMemoryDataDependenceEdge(call, store, DG_DATA_WAW, mustExist);
+        edges->addMemoryDataDependenceEdge(call, store, DG_DATA_WAW, mustExist);
       }
 
     } else {
@@ -502,7 +515,10 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
                                                       store,
                                                       F);
         if (!noDep) {
-          pdg->addMemoryDataDependenceEdge(store, call, DG_DATA_WAW, mustExist);
+          edges->addMemoryDataDependenceEdge(store,
+                                             call,
+                                             DG_DATA_WAW,
+                                             mustExist);
         }
       }
     }
@@ -511,7 +527,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
   return;
 }
 
-void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
+void PDGGenerator::addEdgeFromFunctionModRef(MemoryDependenceEdges *edges,
                                              Function &F,
                                              AAResults &AA,
                                              CallBase *call,
@@ -530,7 +546,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
   /*
    * Query the LLVM alias analyses.
    */
-  switch (AA.getModRefInfo(call, MemoryLocation::get(load))) {
+  switch (this->queryModRefInfo(F, AA, call, MemoryLocation::get(load))) {
     case ModRefInfo::NoModRef:
     case ModRefInfo::Must:
     case ModRefInfo::Ref:
@@ -548,7 +564,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
    *
    * Check if SVF is enabled.
    */
-  if (this->disableSVF) {
+  if (!this->canUseSVF(F)) {
 
     /*
      * SVF is disabled.
@@ -570,8 +586,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
      * correctly.
      */
     if (isSafeToQueryModRefOfSVF(call, bv)) {
-      switch (NoelleSVFIntegration::getModRefInfo(call,
-                                                  MemoryLocation::get(load))) {
+      switch (this->querySVFModRefInfo(call, MemoryLocation::get(load))) {
         case ModRefInfo::NoModRef:
         case ModRefInfo::Must:
         case ModRefInfo::Ref:
@@ -600,7 +615,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
     auto [noDep, mustExist] =
         this->isThereThisMemoryDataDependenceType(DG_DATA_RAW, call, load, F);
     if (!noDep) {
-      pdg->addMemoryDataDependenceEdge(call, load, DG_DATA_RAW, false);
+      edges->addMemoryDataDependenceEdge(call, load, DG_DATA_RAW, false);
     }
 
   } else {
@@ -620,7 +635,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
       auto [noDep, mustExist] =
           this->isThereThisMemoryDataDependenceType(DG_DATA_WAR, call, load, F);
       if (!noDep) {
-        pdg->addMemoryDataDependenceEdge(load, call, DG_DATA_WAR, false);
+        edges->addMemoryDataDependenceEdge(load, call, DG_DATA_WAR, false);
       }
     }
   }
@@ -629,7 +644,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
 }
 
 void PDGGenerator::addEdgeFromFunctionModRef(
-    PDG *pdg,
+    MemoryDependenceEdges *edges,
     Function &F,
     AAResults &AA,
     CallBase *call,
@@ -675,7 +690,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
     auto objectFreed = Utils::getFreedObject(deallocatorCall);
     assert(objectFreed != nullptr);
     auto doesAlias =
-        this->doTheyAlias(pdg, F, AA, objectAllocated, objectFreed);
+        this->doTheyAlias(edges, F, AA, objectAllocated, objectFreed);
     if (doesAlias == AliasResult::NoAlias) {
       return;
     }
@@ -684,7 +699,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
   /*
    * Query the LLVM alias analyses.
    */
-  switch (AA.getModRefInfo(otherCall, call)) {
+  switch (this->queryModRefInfo(F, AA, otherCall, call)) {
     case ModRefInfo::NoModRef:
     case ModRefInfo::Must:
       return;
@@ -699,7 +714,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
       bv[0] = true;
 
       if (isCallReachableFromOtherCall) {
-        switch (AA.getModRefInfo(call, otherCall)) {
+        switch (this->queryModRefInfo(F, AA, call, otherCall)) {
           case ModRefInfo::NoModRef:
           case ModRefInfo::Must:
           case ModRefInfo::Ref:
@@ -730,7 +745,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
       bv[1] = true;
 
       if (isCallReachableFromOtherCall) {
-        switch (AA.getModRefInfo(call, otherCall)) {
+        switch (this->queryModRefInfo(F, AA, call, otherCall)) {
           case ModRefInfo::NoModRef:
           case ModRefInfo::Must:
             return;
@@ -760,7 +775,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
       bv[2] = true;
 
       if (isCallReachableFromOtherCall) {
-        switch (AA.getModRefInfo(call, otherCall)) {
+        switch (this->queryModRefInfo(F, AA, call, otherCall)) {
           case ModRefInfo::NoModRef:
           case ModRefInfo::Must:
             return;
@@ -790,7 +805,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
    *
    * Check if SVF is enabled.
    */
-  if (this->disableSVF) {
+  if (!this->canUseSVF(F)) {
 
     /*
      * SVF is disabled.
@@ -817,7 +832,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
      */
     if (isSafeToQueryModRefOfSVF(call, bv)
         && isSafeToQueryModRefOfSVF(otherCall, bv)) {
-      switch (NoelleSVFIntegration::getModRefInfo(otherCall, call)) {
+      switch (this->querySVFModRefInfo(otherCall, call)) {
         case ModRefInfo::NoModRef:
         case ModRefInfo::Must:
           return;
@@ -826,7 +841,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
         case ModRefInfo::MustRef:
           bv[0] = true;
           if (isCallReachableFromOtherCall) {
-            switch (NoelleSVFIntegration::getModRefInfo(call, otherCall)) {
+            switch (this->querySVFModRefInfo(call, otherCall)) {
               case ModRefInfo::NoModRef:
               case ModRefInfo::Must:
               case ModRefInfo::Ref:
@@ -845,7 +860,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
         case ModRefInfo::MustMod:
           bv[1] = true;
           if (isCallReachableFromOtherCall) {
-            switch (NoelleSVFIntegration::getModRefInfo(call, otherCall)) {
+            switch (this->querySVFModRefInfo(call, otherCall)) {
               case ModRefInfo::NoModRef:
               case ModRefInfo::Must:
                 return;
@@ -869,7 +884,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
         case ModRefInfo::MustModRef:
           bv[2] = true;
           if (isCallReachableFromOtherCall) {
-            switch (NoelleSVFIntegration::getModRefInfo(call, otherCall)) {
+            switch (this->querySVFModRefInfo(call, otherCall)) {
               case ModRefInfo::NoModRef:
               case ModRefInfo::Must:
                 return;
@@ -913,7 +928,10 @@ void PDGGenerator::addEdgeFromFunctionModRef(
                                                   otherCall,
                                                   F);
     if (!noDep) {
-      pdg->addMemoryDataDependenceEdge(call, otherCall, DG_DATA_RAW, mustExist);
+      edges->addMemoryDataDependenceEdge(call,
+                                         otherCall,
+                                         DG_DATA_RAW,
+                                         mustExist);
     }
 
     /*
@@ -934,10 +952,10 @@ void PDGGenerator::addEdgeFromFunctionModRef(
                                                     otherCall,
                                                     F);
       if (!noDep) {
-        pdg->addMemoryDataDependenceEdge(call,
-                                         otherCall,
-                                         DG_DATA_WAR,
-                                         mustExist);
+        edges->addMemoryDataDependenceEdge(call,
+                                           otherCall,
+                                           DG_DATA_WAR,
+                                           mustExist);
       }
     }
 
@@ -977,10 +995,10 @@ void PDGGenerator::addEdgeFromFunctionModRef(
                                                     otherCall,
                                                     F);
       if (!noDep) {
-        pdg->addMemoryDataDependenceEdge(call,
-                                         otherCall,
-                                         DG_DATA_WAR,
-                                         mustExist);
+        edges->addMemoryDataDependenceEdge(call,
+                                           otherCall,
+                                           DG_DATA_WAR,
+                                           mustExist);
       }
 
     } else if (rbv[1]) {
@@ -1000,10 +1018,10 @@ void PDGGenerator::addEdgeFromFunctionModRef(
                                                     otherCall,
                                                     F);
       if (!noDep) {
-        pdg->addMemoryDataDependenceEdge(call,
-                                         otherCall,
-                                         DG_DATA_WAW,
-                                         mustExist);
+        edges->addMemoryDataDependenceEdge(call,
+                                           otherCall,
+                                           DG_DATA_WAW,
+                                           mustExist);
       }
 
     } else {
@@ -1035,10 +1053,10 @@ void PDGGenerator::addEdgeFromFunctionModRef(
                                                     otherCall,
                                                     F);
       if (!noDep) {
-        pdg->addMemoryDataDependenceEdge(call,
-                                         otherCall,
-                                         DG_DATA_WAR,
-                                         mustExist);
+        edges->addMemoryDataDependenceEdge(call,
+                                           otherCall,
+                                           DG_DATA_WAR,
+                                           mustExist);
       }
       auto [noDep2, mustExist2] =
           this->isThereThisMemoryDataDependenceType(DG_DATA_WAW,
@@ -1046,10 +1064,10 @@ void PDGGenerator::addEdgeFromFunctionModRef(
                                                     otherCall,
                                                     F);
       if (!noDep2) {
-        pdg->addMemoryDataDependenceEdge(call,
-                                         otherCall,
-                                         DG_DATA_WAW,
-                                         mustExist2);
+        edges->addMemoryDataDependenceEdge(call,
+                                           otherCall,
+                                           DG_DATA_WAW,
+                                           mustExist2);
       }
     }
 
@@ -1090,10 +1108,10 @@ void PDGGenerator::addEdgeFromFunctionModRef(
                                                     otherCall,
                                                     F);
       if (!noDep) {
-        pdg->addMemoryDataDependenceEdge(call,
-                                         otherCall,
-                                         DG_DATA_RAW,
-                                         mustExist);
+        edges->addMemoryDataDependenceEdge(call,
+                                           otherCall,
+                                           DG_DATA_RAW,
+                                           mustExist);
       }
       auto [noDep2, mustExist2] =
           this->isThereThisMemoryDataDependenceType(DG_DATA_WAW,
@@ -1101,10 +1119,10 @@ void PDGGenerator::addEdgeFromFunctionModRef(
                                                     otherCall,
                                                     F);
       if (!noDep2) {
-        pdg->addMemoryDataDependenceEdge(call,
-                                         otherCall,
-                                         DG_DATA_WAW,
-                                         mustExist2);
+        edges->addMemoryDataDependenceEdge(call,
+                                           otherCall,
+                                           DG_DATA_WAW,
+                                           mustExist2);
       }
 
     } else if (rbv[2]) {
@@ -1125,10 +1143,10 @@ void PDGGenerator::addEdgeFromFunctionModRef(
                                                       otherCall,
                                                       F);
         if (!noDep) {
-          pdg->addMemoryDataDependenceEdge(call,
-                                           otherCall,
-                                           DG_DATA_RAW,
-                                           mustExist);
+          edges->addMemoryDataDependenceEdge(call,
+                                             otherCall,
+                                             DG_DATA_RAW,
+                                             mustExist);
         }
       }
       {
@@ -1138,10 +1156,10 @@ void PDGGenerator::addEdgeFromFunctionModRef(
                                                       otherCall,
                                                       F);
         if (!noDep) {
-          pdg->addMemoryDataDependenceEdge(call,
-                                           otherCall,
-                                           DG_DATA_WAW,
-                                           mustExist);
+          edges->addMemoryDataDependenceEdge(call,
+                                             otherCall,
+                                             DG_DATA_WAW,
+                                             mustExist);
         }
       }
       {
@@ -1151,10 +1169,10 @@ void PDGGenerator::addEdgeFromFunctionModRef(
                                                       otherCall,
                                                       F);
         if (!noDep) {
-          pdg->addMemoryDataDependenceEdge(call,
-                                           otherCall,
-                                           DG_DATA_WAR,
-                                           mustExist);
+          edges->addMemoryDataDependenceEdge(call,
+                                             otherCall,
+                                             DG_DATA_WAR,
+                                             mustExist);
         }
       }
 
@@ -1191,10 +1209,10 @@ void PDGGenerator::addEdgeFromFunctionModRef(
                                                       otherCall,
                                                       F);
         if (!noDep) {
-          pdg->addMemoryDataDependenceEdge(call,
-                                           otherCall,
-                                           DG_DATA_RAW,
-                                           mustExist);
+          edges->addMemoryDataDependenceEdge(call,
+                                             otherCall,
+                                             DG_DATA_RAW,
+                                             mustExist);
         }
       }
       {
@@ -1204,10 +1222,10 @@ void PDGGenerator::addEdgeFromFunctionModRef(
                                                       otherCall,
                                                       F);
         if (!noDep) {
-          pdg->addMemoryDataDependenceEdge(call,
-                                           otherCall,
-                                           DG_DATA_WAW,
-                                           mustExist);
+          edges->addMemoryDataDependenceEdge(call,
+                                             otherCall,
+                                             DG_DATA_WAW,
+                                             mustExist);
         }
       }
     }
@@ -1221,7 +1239,7 @@ bool PDGGenerator::isSafeToQueryModRefOfSVF(CallBase *call, BitVector &bv) {
   /*
    * Check if SVF is enabled.
    */
-  if (this->disableSVF) {
+  if (!this->canUseSVF(*call->getFunction())) {
 
     /*
      * SVF is disabled.
@@ -1255,7 +1273,7 @@ bool PDGGenerator::isSafeToQueryModRefOfSVF(CallBase *call, BitVector &bv) {
 }
 
 void PDGGenerator::addEdgeFromMemoryAlias(
-    PDG *pdg,
+    MemoryDependenceEdges *edges,
     Function &F,
     AAResults &AA,
     Value *instI,
@@ -1265,7 +1283,7 @@ void PDGGenerator::addEdgeFromMemoryAlias(
   /*
    * Query all alias analyses that work at the program scope.
    */
-  auto aaResult = this->doTheyAlias(pdg, F, AA, instI, instJ);
+  auto aaResult = this->doTheyAlias(edges, F, AA, instI, instJ);
 
   /*
    * Translate the alias analysis result to dependences.
@@ -1285,12 +1303,12 @@ void PDGGenerator::addEdgeFromMemoryAlias(
   /*
    * There is a dependence.
    */
-  pdg->addMemoryDataDependenceEdge(instI, instJ, dataDependenceType, must);
+  edges->addMemoryDataDependenceEdge(instI, instJ, dataDependenceType, must);
 
   return;
 }
 
-AliasResult PDGGenerator::doTheyAlias(PDG *pdg,
+AliasResult PDGGenerator::doTheyAlias(MemoryDependenceEdges *edges,
                                       Function &F,
                                       AAResults &AA,
                                       Value *instI,
@@ -1320,11 +1338,11 @@ AliasResult PDGGenerator::doTheyAlias(PDG *pdg,
     if (areTheSame) {
       aaResult = AliasResult::MustAlias;
     } else {
-      aaResult = AA.alias(memI, memJ);
+      aaResult = this->queryAlias(F, AA, memI, memJ);
     }
 
   } else {
-    aaResult = AA.alias(instI, instJ);
+    aaResult = this->queryAlias(F, AA, instI, instJ);
   }
   switch (aaResult) {
     case AliasResult::NoAlias:
@@ -1341,7 +1359,7 @@ AliasResult PDGGenerator::doTheyAlias(PDG *pdg,
    *
    * Check if SVF is enabled.
    */
-  if (this->disableSVF) {
+  if (!this->canUseSVF(F)) {
 
     /*
      * SVF is disabled.
@@ -1354,11 +1372,11 @@ AliasResult PDGGenerator::doTheyAlias(PDG *pdg,
      */
     AliasResult SVFAAResult{ AliasResult::MayAlias };
     if (haveMemoryLocations) {
-      SVFAAResult =
-          NoelleSVFIntegration::alias(MemoryLocation::get(instIAsInst),
-                                      MemoryLocation::get(instJAsInst));
+      SVFAAResult = this->querySVFAlias(F,
+                                        MemoryLocation::get(instIAsInst),
+                                        MemoryLocation::get(instJAsInst));
     } else {
-      SVFAAResult = NoelleSVFIntegration::alias(instI, instJ);
+      SVFAAResult = this->querySVFAlias(F, instI, instJ);
     }
     switch (SVFAAResult) {
       case AliasResult::NoAlias:
@@ -1374,6 +1392,80 @@ AliasResult PDGGenerator::doTheyAlias(PDG *pdg,
   return AliasResult::MayAlias;
 }
 
+AliasResult PDGGenerator::queryAlias(Function &F,
+                                     AAResults &AA,
+                                     const MemoryLocation &loc1,
+                                     const MemoryLocation &loc2) {
+  return this->aaQueries.alias(&F, loc1, loc2, [&AA, &loc1, &loc2]() {
+    return AA.alias(loc1, loc2);
+  });
+}
+
+AliasResult PDGGenerator::queryAlias(Function &F,
+                                     AAResults &AA,
+                                     Value *v1,
+                                     Value *v2) {
+  return this->aaQueries.alias(&F, v1, v2, [&AA, v1, v2]() {
+    return AA.alias(v1, v2);
+  });
+}
+
+ModRefInfo PDGGenerator::queryModRefInfo(Function &F,
+                                         AAResults &AA,
+                                         CallBase *call,
+                                         const MemoryLocation &loc) {
+  return this->aaQueries.getModRefInfo(&F, call, loc, [&AA, call, &loc]() {
+    return AA.getModRefInfo(call, loc);
+  });
+}
+
+ModRefInfo PDGGenerator::queryModRefInfo(Function &F,
+                                         AAResults &AA,
+                                         CallBase *call,
+                                         CallBase *otherCall) {
+  return this->aaQueries.getModRefInfo(&F,
+                                       call,
+                                       otherCall,
+                                       [&AA, call, otherCall]() {
+                                         return AA.getModRefInfo(call,
+                                                                 otherCall);
+                                       });
+}
+
+AliasResult PDGGenerator::querySVFAlias(Function &F,
+                                        const MemoryLocation &loc1,
+                                        const MemoryLocation &loc2) {
+  return this->svfQueries.alias(&F, loc1, loc2, [&loc1, &loc2]() {
+    return NoelleSVFIntegration::alias(loc1, loc2);
+  });
+}
+
+AliasResult PDGGenerator::querySVFAlias(Function &F, Value *v1, Value *v2) {
+  return this->svfQueries.alias(&F, v1, v2, [v1, v2]() {
+    return NoelleSVFIntegration::alias(v1, v2);
+  });
+}
+
+ModRefInfo PDGGenerator::querySVFModRefInfo(CallBase *call,
+                                            const MemoryLocation &loc) {
+  auto F = call->getFunction();
+  return this->svfQueries.getModRefInfo(F, call, loc, [call, &loc]() {
+    return NoelleSVFIntegration::getModRefInfo(call, loc);
+  });
+}
+
+ModRefInfo PDGGenerator::querySVFModRefInfo(CallBase *call,
+                                            CallBase *otherCall) {
+  auto F = call->getFunction();
+  return this->svfQueries.getModRefInfo(F,
+                                        call,
+                                        otherCall,
+                                        [call, otherCall]() {
+                                          return NoelleSVFIntegration::
+                                              getModRefInfo(call, otherCall);
+                                        });
+}
+
 bool PDGGenerator::canAccessMemory(Instruction *i) {
 
   /*
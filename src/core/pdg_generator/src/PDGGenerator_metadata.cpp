@@ -196,7 +196,7 @@ void PDGGenerator::constructEdgesFromMetadata(
   if (auto edgesM = F.getMetadata("noelle.pdg.edges")) {
     for (auto &operand : edgesM->operands()) {
       if (auto edgeM = dyn_cast<MDNode>(operand)) {
-        auto edge = constructEdgeFromMetadata(pdg, edgeM, IDNodeMap);
+        auto edge = constructEdgeFromMetadata(pdg, edgeM, IDNodeMap, true);
 
         /*
          * Construct subEdges and set attributes
@@ -205,21 +205,11 @@ void PDGGenerator::constructEdgesFromMetadata(
           for (auto &subOperand : subEdgesM->operands()) {
             if (MDNode *subEdgeM = dyn_cast<MDNode>(subOperand)) {
               auto subEdge =
-                  constructEdgeFromMetadata(pdg, subEdgeM, IDNodeMap);
+                  constructEdgeFromMetadata(pdg, subEdgeM, IDNodeMap, false);
               edge->addSubEdge(subEdge);
             }
           }
         }
-
-        /*
-         * Add edge to pdg
-         */
-        pdg->copyAddEdge(*edge);
-
-        /*
-         * Free the memory.
-         */
-        delete edge;
       }
     }
   }
@@ -230,7 +220,8 @@ void PDGGenerator::constructEdgesFromMetadata(
 DGEdge<Value, Value> *PDGGenerator::constructEdgeFromMetadata(
     PDG *pdg,
     MDNode *edgeM,
-    std::unordered_map<MDNode *, Value *> &IDNodeMap) {
+    std::unordered_map<MDNode *, Value *> &IDNodeMap,
+    bool addToPDG) {
   DGEdge<Value, Value> *edge = nullptr;
 
   if (auto fromM = dyn_cast<MDNode>(edgeM->getOperand(0))) {
@@ -256,10 +247,18 @@ DGEdge<Value, Value> *PDGGenerator::constructEdgeFromMetadata(
 
       /*
        * Allocate the dependence.
+       * Sub-edges only live within their parent dependence, but they are
+       * still owned by the PDG.
        */
+      auto fromNode = pdg->fetchNode(from);
+      auto toNode = pdg->fetchNode(to);
       if (isControl) {
-        edge = new ControlDependence<Value, Value>(pdg->fetchNode(from),
-                                                   pdg->fetchNode(to));
+        if (addToPDG) {
+          edge = pdg->addControlDependenceEdge(from, to);
+        } else {
+          edge = pdg->addDetachedEdge<ControlDependence<Value, Value>>(fromNode,
+                                                                       toNode);
+        }
       } else {
 
         /*
@@ -289,20 +288,30 @@ DGEdge<Value, Value> *PDGGenerator::constructEdgeFromMetadata(
                    ->getString()
                == "true");
 
-          if (isMust) {
-            edge = new MustMemoryDependence<Value, Value>(pdg->fetchNode(from),
-                                                          pdg->fetchNode(to),
-                                                          dataDepType);
+          if (addToPDG) {
+            edge = pdg->addMemoryDataDependenceEdge(from,
+                                                    to,
+                                                    dataDepType,
+                                                    isMust);
+          } else if (isMust) {
+            edge = pdg->addDetachedEdge<MustMemoryDependence<Value, Value>>(
+                fromNode,
+                toNode,
+                dataDepType);
           } else {
-            edge = new MayMemoryDependence<Value, Value>(pdg->fetchNode(from),
-                                                         pdg->fetchNode(to),
-                                                         dataDepType);
+            edge = pdg->addDetachedEdge<MayMemoryDependence<Value, Value>>(
+                fromNode,
+                toNode,
+                dataDepType);
           }
 
+        } else if (addToPDG) {
+          edge = pdg->addVariableDataDependenceEdge(from, to, dataDepType);
         } else {
-          edge = new VariableDependence<Value, Value>(pdg->fetchNode(from),
-                                                      pdg->fetchNode(to),
-                                                      dataDepType);
+          edge = pdg->addDetachedEdge<VariableDependence<Value, Value>>(
+              fromNode,
+              toNode,
+              dataDepType);
         }
       }
       edge->setLoopCarried(isLoopCarried);
@@ -29,6 +29,15 @@ namespace arcana::noelle {
 
 /*
  * Strongly Connected Component
+ *
+ * An SCC is a view of the dependence graph it has been computed from: its
+ * nodes and edges are the ones of that graph, which must outlive the SCC and
+ * must not be modified while the SCC is used.
+ * The dependences of an internal node are all dependences of the SCC.
+ * However, an external node keeps all its dependences of the original graph;
+ * use isDependenceOfSCC to skip the ones that do not touch the SCC.
+ * Since the edges are shared, changing their attributes (e.g., setLoopCarried)
+ * changes the original graph as well.
  */
 class SCC : public DG<Value> {
 public:
@@ -78,6 +87,12 @@ public:
    */
   bool hasCycle(bool ignoreControlDep = false);
 
+  /*
+   * Check if @dependence is one of the SCC (i.e., if at least one of its
+   * nodes is internal to the SCC).
+   */
+  bool isDependenceOfSCC(DGEdge<Value, Value> *dependence) const;
+
   /*
    * Return the number of instructions that compose the SCC.
    */
@@ -101,8 +116,8 @@ public:
   ~SCC();
 
 private:
-  void copyNodesAndEdges(std::set<DGNode<Value> *> internalNodes,
-                         std::set<DGNode<Value> *> externalNodes);
+  void referenceNodesAndEdges(std::set<DGNode<Value> *> internalNodes,
+                              std::set<DGNode<Value> *> externalNodes);
 };
 
 template <>
@@ -37,6 +37,9 @@ class SCCDAG : public DG<SCC> {
 public:
   /*
    * Constructor.
+   *
+   * The SCCs are views of @dependenceGraph (see SCC): @dependenceGraph must
+   * outlive the SCCDAG, and it must not be modified while the SCCDAG is used.
    */
   SCCDAG(PDG *dependenceGraph);
 
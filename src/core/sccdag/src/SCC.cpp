@@ -53,60 +53,51 @@ SCC::SCC(std::set<DGNode<Value> *> internalNodes) {
     }
   }
 
-  copyNodesAndEdges(internalNodes, externalNodes);
+  referenceNodesAndEdges(internalNodes, externalNodes);
 }
 
 SCC::SCC(std::set<DGNode<Value> *> internalNodes,
          std::set<DGNode<Value> *> externalNodes) {
-  copyNodesAndEdges(internalNodes, externalNodes);
+  referenceNodesAndEdges(internalNodes, externalNodes);
 }
 
-void SCC::copyNodesAndEdges(std::set<DGNode<Value> *> internalNodes,
-                            std::set<DGNode<Value> *> externalNodes) {
+void SCC::referenceNodesAndEdges(std::set<DGNode<Value> *> internalNodes,
+                                 std::set<DGNode<Value> *> externalNodes) {
 
   /*
    * Add all nodes by classification. Arbitrarily choose entry node from all
    * nodes
+   *
+   * Nodes are shared with the graph the SCC has been computed from.
    */
   for (auto node : internalNodes) {
-    addNode(node->getT(), /*internal=*/true);
+    addSharedNode(node, /*inclusion=*/true);
   }
   for (auto node : externalNodes) {
-    addNode(node->getT(), /*internal=*/false);
+    addSharedNode(node, /*inclusion=*/false);
   }
   entryNode = (*allNodes.begin());
 
   /*
-   * Add internal edges on this SCC's instructions
-   * Note: to avoid edge duplication, ignore incoming edges from internal nodes
-   * (they were considered in outgoing edges)
+   * Add the dependences of the SCC.
+   * These are all the dependences of its internal nodes: either both nodes are
+   * internal, or the other one is external.
    */
   for (auto node : internalNodes) {
     for (auto edge : node->getOutgoingEdges()) {
-      auto incomingT = edge->getDst();
-      if (isExternal(incomingT))
-        continue;
-      copyAddEdge(*edge);
-    }
-  }
-
-  /*
-   * Add external edges on this SCC's instructions
-   */
-  for (auto node : internalNodes) {
-    for (auto edge : node->getOutgoingEdges()) {
-      auto incomingT = edge->getDstNode()->getT();
-      if (isInternal(incomingT))
-        continue;
-      copyAddEdge(*edge);
+      addSharedEdge(edge);
     }
     for (auto edge : node->getIncomingEdges()) {
-      auto outgoingT = edge->getSrcNode()->getT();
-      if (isInternal(outgoingT))
-        continue;
-      copyAddEdge(*edge);
+      addSharedEdge(edge);
     }
   }
+
+  return;
+}
+
+bool SCC::isDependenceOfSCC(DGEdge<Value, Value> *dependence) const {
+  return this->isInternal(dependence->getSrc())
+         || this->isInternal(dependence->getDst());
 }
 
 int64_t SCC::numberOfInstructions(void) const {
@@ -120,7 +111,7 @@ raw_ostream &SCC::print(raw_ostream &stream,
   /*
    * Print instructions that compose the SCC.
    */
-  stream << prefixToUse << "Nodes within the SCC: " << internalNodeMap.size()
+  stream << prefixToUse << "Nodes within the SCC: " << internalNodes.size()
          << "\n";
   for (auto nodePair : internalNodePairs()) {
     nodePair.second->print(stream << prefixToUse << "\t") << "\n";
@@ -132,7 +123,7 @@ raw_ostream &SCC::print(raw_ostream &stream,
   stream
       << prefixToUse
       << "Nodes outside the SCC and connected with at least one node within the SCC: "
-      << externalNodeMap.size() << "\n";
+      << externalNodes.size() << "\n";
   std::vector<DGNode<Value> *> externalNodesOfCurrentSCC{};
   for (auto nodePair : externalNodePairs()) {
     externalNodesOfCurrentSCC.push_back(nodePair.second);
@@ -170,10 +161,10 @@ raw_ostream &SCC::print(raw_ostream &stream,
 }
 
 raw_ostream &SCC::printMinimal(raw_ostream &stream, std::string prefixToUse) {
-  stream << prefixToUse << "Internal nodes: " << internalNodeMap.size() << "\n";
+  stream << prefixToUse << "Internal nodes: " << internalNodes.size() << "\n";
   for (auto nodePair : internalNodePairs())
     nodePair.second->print(stream << prefixToUse << "\t") << "\n";
-  stream << prefixToUse << "External nodes: " << externalNodeMap.size() << "\n";
+  stream << prefixToUse << "External nodes: " << externalNodes.size() << "\n";
   for (auto nodePair : externalNodePairs())
     nodePair.second->print(stream << prefixToUse << "\t") << "\n";
   stream << prefixToUse << "Edges: " << allEdges.size() << "\n";
@@ -199,6 +190,8 @@ bool SCC::hasCycle(bool ignoreControlDep) {
       for (auto edge : node->getOutgoingEdges()) {
         if (ignoreControlDep && isa<ControlDependence<Value, Value>>(edge))
           continue;
+        if (!this->isDependenceOfSCC(edge))
+          continue;
 
         auto otherNode = edge->getDstNode();
         if (nodesSeen.find(otherNode) != nodesSeen.end())
@@ -142,8 +142,20 @@ void SCCDAG::markEdgesAndSubEdges(void) {
      * Check dependences that go outside the current SCC.
      */
     for (auto externalNodePair : outgoingSCC->externalNodePairs()) {
+
+      /*
+       * Fetch the dependences from the current SCC to the external node.
+       * The external node is shared with the graph the SCCDAG has been built
+       * from, so it also has dependences that do not involve the current SCC.
+       */
       auto incomingNode = externalNodePair.second;
-      if (incomingNode->inDegree() == 0)
+      std::vector<DGEdge<Value, Value> *> subEdges;
+      for (auto edge : incomingNode->getIncomingEdges()) {
+        if (!outgoingSCC->isInternal(edge->getSrc()))
+          continue;
+        subEdges.push_back(edge);
+      }
+      if (subEdges.empty())
         continue;
 
       auto incomingSCCNode = this->valueToSCCNode[externalNodePair.first];
@@ -176,7 +188,7 @@ void SCCDAG::markEdgesAndSubEdges(void) {
         sccEdge->removeSubEdges();
         clearedEdges.insert(sccEdge);
       }
-      for (auto edge : incomingNode->getIncomingEdges())
+      for (auto edge : subEdges)
         sccEdge->addSubEdge(edge);
     }
   }
@@ -194,11 +206,8 @@ void SCCDAG::mergeSCCs(std::set<DGNode<SCC> *> &sccSet) {
   }
 
   /*
-   * Note: nodes are from 2 contexts; internal nodes will point to external
-   * nodes, some of whose values are in nodes in this list, and some of whose
-   * values are NOT in nodes in this list. However, SCC's constructor accounts
-   * for that context mismatch and properly copies edges WITHOUT duplicating any
-   * nodes or edges.
+   * Note: SCCs share the nodes of the graph the SCCDAG has been built from, so
+   * the new SCC references the same nodes and edges of the SCCs merged.
    */
   auto mergeSCC = new SCC(mergeNodes);
 
@@ -405,20 +414,6 @@ uint32_t SCCDAG::getSCCIndex(const SCC *scc) const {
 }
 
 SCCDAG::~SCCDAG() {
-  for (auto *edge : allEdges) {
-    if (edge) {
-      delete edge;
-    }
-  }
-
-  for (auto *node : allNodes) {
-    if (node) {
-      delete node;
-    }
-  }
-
-  this->clear();
-
   return;
 }
 
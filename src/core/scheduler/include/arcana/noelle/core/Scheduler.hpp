@@ -51,6 +51,12 @@ public:
    */
   Scheduler();
 
+  /*
+   * Set the function to invoke every time a scheduler created by this one
+   * modifies a function.
+   */
+  void setFunctionModifiedCallback(std::function<void(Function *)> callback);
+
   /*
    * Scheduler builder methods --- FIX
    */
@@ -88,6 +94,9 @@ public:
   std::set<Instruction *> getOutgoingDependencesInParentBasicBlock(
       Instruction *const I,
       PDG *const ThePDG) const;
+
+protected:
+  std::function<void(Function *)> functionModified;
 };
 
 /*
@@ -174,6 +183,8 @@ private:
   /*
    * Transformation methods
    */
+  bool shrinkPrologue(void);
+
   bool mergePrologueBasicBlocks(void);
 
   bool shrinkPrologueBasicBlock(BasicBlock *Block);
@@ -248,6 +248,13 @@ std::unordered_set<Instruction *> SCCPartitionScheduler::
 
     for (auto edge : node->getIncomingEdges()) {
 
+      /*
+       * Ignore the dependences that do not involve the SCC of @I (the SCC
+       * shares its external nodes with the loop dependence graph).
+       */
+      if (!sccOfI->isDependenceOfSCC(edge))
+        continue;
+
       /*
        * Ignore self edges
        */
@@ -35,7 +35,14 @@ namespace arcana::noelle {
  * ------------------------------------------------------------------
  */
 
-Scheduler::Scheduler() {
+Scheduler::Scheduler() : functionModified{} {
+  return;
+}
+
+void Scheduler::setFunctionModifiedCallback(
+    std::function<void(Function *)> callback) {
+  this->functionModified = callback;
+
   return;
 }
 
@@ -43,7 +50,10 @@ LoopScheduler Scheduler::getNewLoopScheduler(LoopStructure *const LS,
                                              DominatorSummary *const DS,
                                              PDG *const ThePDG) const {
 
-  return LoopScheduler(LS, DS, ThePDG);
+  LoopScheduler loopScheduler(LS, DS, ThePDG);
+  loopScheduler.setFunctionModifiedCallback(this->functionModified);
+
+  return loopScheduler;
 }
 
 /*
@@ -624,6 +634,23 @@ bool LoopScheduler::canQuicklyHandleLoop(void) const {
  */
 bool LoopScheduler::shrinkLoopPrologue(void) {
 
+  /*
+   * Shrink the prologue
+   */
+  auto Modified = this->shrinkPrologue();
+
+  /*
+   * Notify that the function has been modified.
+   */
+  if (Modified && this->functionModified) {
+    this->functionModified(this->TheLoop->getFunction());
+  }
+
+  return Modified;
+}
+
+bool LoopScheduler::shrinkPrologue(void) {
+
   bool Modified = false;
 
   /*
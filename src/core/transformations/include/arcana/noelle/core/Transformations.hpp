@@ -45,6 +45,12 @@ enum Transformation {
 
 enum LoopContentOptimization { MEMORY_CLONING_ID, THREAD_SAFE_LIBRARY_ID };
 
+/*
+ * Ways to combine the private copies of a reduced variable after a parallel
+ * loop.
+ */
+enum ReductionStrategy { LINEAR_REDUCTION, TREE_REDUCTION };
+
 } // namespace arcana::noelle
 
 #endif // NOELLE_SRC_CORE_TRANSFORMATIONS_H_
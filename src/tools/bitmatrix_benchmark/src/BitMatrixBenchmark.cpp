@@ -0,0 +1,93 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <chrono>
+#include <random>
+
+#include "arcana/noelle/tools/BitMatrixBenchmark.hpp"
+
+namespace arcana::noelle {
+
+BitMatrixBenchmark::BitMatrixBenchmark()
+  : ModulePass{ ID },
+    sizes{},
+    edgesPerNode{ 3 } {}
+
+bool BitMatrixBenchmark::runOnModule(Module &M) {
+  outs() << "Nodes Edges Seconds ReachablePairs\n";
+  for (auto nodes : this->sizes) {
+
+    /*
+     * Build the synthetic DAG.
+     */
+    BitMatrix m(nodes);
+    uint64_t edges = 0;
+    this->generateDAG(m, nodes, edges);
+
+    /*
+     * Compute its transitive closure.
+     */
+    auto start = std::chrono::steady_clock::now();
+    m.transitiveClosure();
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> seconds = end - start;
+
+    outs() << nodes << " " << edges << " " << seconds.count() << " "
+           << m.count() << "\n";
+  }
+
+  return false;
+}
+
+void BitMatrixBenchmark::generateDAG(BitMatrix &m,
+                                     uint32_t nodes,
+                                     uint64_t &edges) const {
+
+  /*
+   * Edges only go from a node to a later one, so the graph is acyclic.
+   * Most edges are local, like the dependences between the SCCs of a loop
+   * body; one in eight jumps anywhere later in the DAG.
+   */
+  std::mt19937 generator(nodes);
+  for (uint32_t i = 0; i + 1 < nodes; i++) {
+    for (uint32_t e = 0; e < this->edgesPerNode; e++) {
+      uint32_t distance = 0;
+      if ((generator() % 8) == 0) {
+        distance = 1 + (generator() % (nodes - i - 1));
+      } else {
+        distance = 1 + (generator() % 64);
+      }
+      auto j = i + distance;
+      if (j >= nodes) {
+        continue;
+      }
+      if (m.test(i, j)) {
+        continue;
+      }
+      m.set(i, j);
+      edges++;
+    }
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
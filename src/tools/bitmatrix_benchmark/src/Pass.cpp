@@ -0,0 +1,61 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/tools/BitMatrixBenchmark.hpp"
+
+namespace arcana::noelle {
+
+static cl::list<uint32_t> BenchmarkSizes(
+    "noelle-bitmatrix-bench-sizes",
+    cl::CommaSeparated,
+    cl::desc("Number of nodes of the synthetic DAGs to close"));
+static cl::opt<uint32_t> BenchmarkEdgesPerNode(
+    "noelle-bitmatrix-bench-edges",
+    cl::init(3),
+    cl::desc("Number of outgoing edges per node of the synthetic DAGs"));
+
+bool BitMatrixBenchmark::doInitialization(Module &M) {
+  this->sizes.clear();
+  for (auto size : BenchmarkSizes) {
+    this->sizes.push_back(size);
+  }
+  if (this->sizes.empty()) {
+    this->sizes = { 1000, 4000, 16000, 32000 };
+  }
+  this->edgesPerNode = BenchmarkEdgesPerNode;
+
+  return false;
+}
+
+void BitMatrixBenchmark::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.setPreservesAll();
+  return;
+}
+
+// Next there is code to register your pass to "opt"
+char BitMatrixBenchmark::ID = 0;
+static RegisterPass<BitMatrixBenchmark> X(
+    "BitMatrixBenchmark",
+    "Benchmark the transitive closure of BitMatrix",
+    false,
+    false);
+
+} // namespace arcana::noelle
@@ -0,0 +1,224 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <chrono>
+#include <malloc.h>
+
+#include "arcana/noelle/tools/DGBenchmark.hpp"
+
+namespace arcana::noelle {
+
+DGBenchmark::DGBenchmark() : ModulePass{ ID }, repetitions{ 1 } {}
+
+bool DGBenchmark::runOnModule(Module &M) {
+  typedef std::chrono::steady_clock Clock;
+  std::chrono::duration<double> buildTime{ 0 };
+  std::chrono::duration<double> queryTime{ 0 };
+  std::chrono::duration<double> trimTime{ 0 };
+  std::chrono::duration<double> destroyTime{ 0 };
+  uint64_t nodes = 0;
+  uint64_t edges = 0;
+  uint64_t checksum = 0;
+  uint64_t peakBytes = 0;
+
+  for (auto i = 0u; i < this->repetitions; i++) {
+
+    /*
+     * Build the graphs of all functions at once, like a whole-program PDG.
+     */
+    auto heapBefore = mallinfo2().uordblks;
+    std::vector<DG<Value> *> graphs;
+    auto start = Clock::now();
+    for (auto &F : M) {
+      if (F.isDeclaration()) {
+        continue;
+      }
+      auto dg = new DG<Value>();
+      this->buildGraph(*dg, F);
+      graphs.push_back(dg);
+    }
+    auto built = Clock::now();
+    auto heapAfter = mallinfo2().uordblks;
+    if (heapAfter > heapBefore) {
+      peakBytes = std::max(peakBytes, heapAfter - heapBefore);
+    }
+
+    /*
+     * Walk the graphs the way the analyses of NOELLE do.
+     */
+    nodes = 0;
+    edges = 0;
+    auto graphIndex = 0u;
+    for (auto &F : M) {
+      if (F.isDeclaration()) {
+        continue;
+      }
+      auto dg = graphs[graphIndex++];
+      nodes += dg->numNodes();
+      edges += dg->numEdges();
+      checksum += this->queryGraph(*dg, F);
+    }
+    auto queried = Clock::now();
+
+    /*
+     * Drop dependences like the loop dependence graph refinement does.
+     */
+    for (auto dg : graphs) {
+      this->trimGraph(*dg);
+    }
+    auto trimmed = Clock::now();
+
+    /*
+     * Destroy the graphs.
+     */
+    for (auto dg : graphs) {
+      delete dg;
+    }
+    auto destroyed = Clock::now();
+
+    buildTime += built - start;
+    queryTime += queried - built;
+    trimTime += trimmed - queried;
+    destroyTime += destroyed - trimmed;
+  }
+
+  outs() << "Nodes: " << nodes << "\n";
+  outs() << "Edges: " << edges << "\n";
+  outs() << "Heap bytes: " << peakBytes << "\n";
+  outs() << "Build seconds: " << buildTime.count() << "\n";
+  outs() << "Query seconds: " << queryTime.count() << "\n";
+  outs() << "Trim seconds: " << trimTime.count() << "\n";
+  outs() << "Destroy seconds: " << destroyTime.count() << "\n";
+  outs() << "Checksum: " << checksum << "\n";
+
+  return false;
+}
+
+void DGBenchmark::buildGraph(DG<Value> &dg, Function &F) const {
+
+  /*
+   * Add the nodes.
+   * Arguments are external, as they are for the dependence graph of a loop.
+   */
+  for (auto &arg : F.args()) {
+    dg.addNode(&arg, false);
+  }
+  std::vector<Instruction *> memoryInsts;
+  for (auto &inst : instructions(F)) {
+    dg.addNode(&inst, true);
+    if (inst.mayReadOrWriteMemory()) {
+      memoryInsts.push_back(&inst);
+    }
+  }
+
+  /*
+   * Add the variable dependences.
+   */
+  for (auto &inst : instructions(F)) {
+    for (auto &op : inst.operands()) {
+      if (!dg.isInGraph(op.get())) {
+        continue;
+      }
+      dg.addVariableDataDependenceEdge(op.get(), &inst, DG_DATA_RAW);
+    }
+  }
+
+  /*
+   * Add the memory dependences between every pair of memory instructions
+   * that includes a write, as a conservative alias analysis would.
+   */
+  for (auto i = 0u; i < memoryInsts.size(); i++) {
+    auto src = memoryInsts[i];
+    for (auto j = i + 1; j < memoryInsts.size(); j++) {
+      auto dst = memoryInsts[j];
+      if (src->mayWriteToMemory()) {
+        auto type = dst->mayWriteToMemory() ? DG_DATA_WAW : DG_DATA_RAW;
+        dg.addMemoryDataDependenceEdge(src, dst, type, false);
+      } else if (dst->mayWriteToMemory()) {
+        dg.addMemoryDataDependenceEdge(src, dst, DG_DATA_WAR, false);
+      }
+    }
+  }
+
+  /*
+   * Add the control dependences from each conditional branch to the
+   * instructions of its successors.
+   */
+  for (auto &bb : F) {
+    auto term = bb.getTerminator();
+    if ((term == nullptr) || (term->getNumSuccessors() < 2)) {
+      continue;
+    }
+    for (auto succ : successors(&bb)) {
+      for (auto &inst : *succ) {
+        dg.addControlDependenceEdge(term, &inst);
+      }
+    }
+  }
+
+  return;
+}
+
+uint64_t DGBenchmark::queryGraph(DG<Value> &dg, Function &F) const {
+  uint64_t checksum = 0;
+
+  /*
+   * Look up every operand, then follow the edges of its node.
+   */
+  for (auto &inst : instructions(F)) {
+    for (auto &op : inst.operands()) {
+      if (!dg.isInternal(op.get())) {
+        continue;
+      }
+      auto node = dg.fetchNode(op.get());
+      for (auto edge : node->getOutgoingEdges()) {
+        checksum += edge->isLoopCarriedDependence() ? 2 : 1;
+      }
+      checksum += node->inDegree();
+    }
+  }
+
+  return checksum;
+}
+
+void DGBenchmark::trimGraph(DG<Value> &dg) const {
+
+  /*
+   * Remove every other memory dependence.
+   */
+  std::vector<DGEdge<Value, Value> *> toRemove;
+  auto memoryDependences = 0u;
+  for (auto edge : dg.getEdges()) {
+    if (!isa<MemoryDependence<Value, Value>>(edge)) {
+      continue;
+    }
+    if ((memoryDependences++ % 2) == 0) {
+      toRemove.push_back(edge);
+    }
+  }
+  for (auto edge : toRemove) {
+    dg.removeEdge(edge);
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
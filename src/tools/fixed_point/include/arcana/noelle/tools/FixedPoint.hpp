@@ -0,0 +1,77 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_TOOLS_FIXEDPOINT_H_
+#define NOELLE_SRC_TOOLS_FIXEDPOINT_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Run a list of passes on a program until the program no longer changes.
+ *
+ * Every iteration normalizes the code and then runs the transformations.
+ * The fixed point is reached when the transformations leave every function
+ * and global variable unchanged, which is detected by comparing their
+ * fingerprints (see Utils::computeFingerprint) before and after them.
+ *
+ * Everything runs in the same process. The memory dependences computed by
+ * NOELLE in an iteration are kept in memory, so the next iteration analyzes
+ * again only the functions that changed (and their callers).
+ */
+class FixedPoint : public ModulePass {
+public:
+  /*
+   * Class fields
+   */
+  static char ID;
+
+  /*
+   * Methods
+   */
+  FixedPoint();
+  bool doInitialization(Module &M) override;
+  bool runOnModule(Module &M) override;
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+
+private:
+  using Fingerprint = std::map<std::string, uint64_t>;
+
+  std::vector<std::string> normalizations;
+  std::vector<std::pair<std::string, std::string>> normalizationOptions;
+  std::vector<std::string> transformations;
+  bool hasTransformations;
+  uint64_t maximumIterations;
+
+  void normalize(Module &M);
+
+  void runPasses(Module &M, const std::vector<std::string> &passes);
+
+  Fingerprint computeFingerprint(Module &M) const;
+
+  uint64_t countDifferences(const Fingerprint &before,
+                            const Fingerprint &after) const;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_TOOLS_FIXEDPOINT_H_
@@ -0,0 +1,223 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/Utils.hpp"
+#include "arcana/noelle/core/PDGGenerator.hpp"
+#include "arcana/noelle/tools/FixedPoint.hpp"
+
+namespace arcana::noelle {
+
+FixedPoint::FixedPoint() : ModulePass{ ID } {
+  return;
+}
+
+bool FixedPoint::runOnModule(Module &M) {
+  errs() << "FixedPoint: Start\n";
+
+  /*
+   * Check if there is something to do.
+   */
+  if (!this->hasTransformations) {
+    errs() << "FixedPoint:   No passes to run\n";
+    errs() << "FixedPoint: Exit\n";
+    return false;
+  }
+
+  /*
+   * Keep the PDGs computed by the iterations in memory, so the functions that
+   * do not change are not analyzed again.
+   */
+  PDGGenerator::retainPDGCacheInMemory(M);
+
+  /*
+   * Normalize the code.
+   */
+  errs() << "FixedPoint:   Normalize the code\n";
+  this->normalize(M);
+  auto before = this->computeFingerprint(M);
+
+  /*
+   * Run the passes until a fixed point is reached.
+   */
+  errs() << "FixedPoint:   Run until a fixed point is reached\n";
+  uint64_t counter = 0;
+  while (true) {
+    errs() << "FixedPoint:     Invocation " << counter << "\n";
+    this->runPasses(M, this->transformations);
+
+    /*
+     * Check if the code has been modified.
+     */
+    auto after = this->computeFingerprint(M);
+    auto differences = this->countDifferences(before, after);
+    if (differences == 0) {
+      break;
+    }
+    errs() << "FixedPoint:       There are " << differences
+           << " different functions and global variables\n";
+    counter++;
+    if ((this->maximumIterations > 0) && (counter >= this->maximumIterations)) {
+      errs() << "FixedPoint:     The maximum number of iterations has been "
+                "reached\n";
+      break;
+    }
+
+    /*
+     * Normalize the code for the next iteration.
+     */
+    errs() << "FixedPoint:       Normalize the code\n";
+    this->normalize(M);
+    before = this->computeFingerprint(M);
+  }
+  PDGGenerator::releasePDGCacheInMemory(M);
+
+  errs() << "FixedPoint:   Iteration count = " << counter << "\n";
+  errs() << "FixedPoint: Exit\n";
+
+  return true;
+}
+
+void FixedPoint::normalize(Module &M) {
+
+  /*
+   * Set the LLVM options of the normalizations, like noelle-norm does.
+   * Options set explicitly by the user are left untouched.
+   */
+  auto &registeredOptions = cl::getRegisteredOptions();
+  std::vector<cl::Option *> optionsSet;
+  for (auto &[name, value] : this->normalizationOptions) {
+    auto it = registeredOptions.find(name);
+    if (it == registeredOptions.end()) {
+      errs() << "FixedPoint: Error = the option \"" << name
+             << "\" does not exist\n";
+      abort();
+    }
+    auto option = it->second;
+    if (option->getNumOccurrences() > 0) {
+      continue;
+    }
+    if (option->addOccurrence(0, name, value)) {
+      abort();
+    }
+    optionsSet.push_back(option);
+  }
+
+  /*
+   * noelle-load disables BasicAA for the transformations, while noelle-norm
+   * normalizes the code with it. Enable it while the code is normalized.
+   */
+  auto disableBasicAA = static_cast<cl::opt<bool> *>(
+      registeredOptions.lookup("disable-basic-aa"));
+  auto wasBasicAADisabled = false;
+  if (disableBasicAA != nullptr) {
+    wasBasicAADisabled = disableBasicAA->getValue();
+    disableBasicAA->setValue(false);
+  }
+
+  /*
+   * Normalize the code.
+   */
+  this->runPasses(M, this->normalizations);
+
+  /*
+   * The transformations run with the default value of the options.
+   */
+  for (auto option : optionsSet) {
+    option->reset();
+  }
+  if (disableBasicAA != nullptr) {
+    disableBasicAA->setValue(wasBasicAADisabled);
+  }
+
+  return;
+}
+
+void FixedPoint::runPasses(Module &M, const std::vector<std::string> &passes) {
+
+  /*
+   * Create the passes.
+   * A new pass manager is used every time so no pass keeps state across
+   * iterations.
+   */
+  legacy::PassManager pm;
+  auto registry = PassRegistry::getPassRegistry();
+  for (auto &name : passes) {
+    auto info = registry->getPassInfo(name);
+    if ((info == nullptr) || (info->getNormalCtor() == nullptr)) {
+      errs() << "FixedPoint: Error = the pass \"" << name
+             << "\" does not exist. Are you missing a -load?\n";
+      abort();
+    }
+    pm.add(info->createPass());
+  }
+
+  /*
+   * Run the passes.
+   */
+  pm.run(M);
+
+  return;
+}
+
+FixedPoint::Fingerprint FixedPoint::computeFingerprint(Module &M) const {
+
+  /*
+   * Unnamed functions and global variables would all share the same name, so
+   * they are identified by their position in the module instead.
+   */
+  Fingerprint fingerprint;
+  auto keyOf = [](GlobalValue &V, uint64_t position) -> std::string {
+    if (V.hasName()) {
+      return V.getName().str();
+    }
+    return "#" + std::to_string(position);
+  };
+  uint64_t position = 0;
+  for (auto &F : M) {
+    fingerprint[keyOf(F, position++)] =
+        F.isDeclaration() ? 0 : Utils::computeFingerprint(F);
+  }
+  for (auto &G : M.globals()) {
+    fingerprint[keyOf(G, position++)] = Utils::computeFingerprint(G);
+  }
+
+  return fingerprint;
+}
+
+uint64_t FixedPoint::countDifferences(const Fingerprint &before,
+                                      const Fingerprint &after) const {
+  uint64_t differences = 0;
+  for (auto &pair : before) {
+    auto it = after.find(pair.first);
+    if ((it == after.end()) || (it->second != pair.second)) {
+      differences++;
+    }
+  }
+  for (auto &pair : after) {
+    if (before.find(pair.first) == before.end()) {
+      differences++;
+    }
+  }
+
+  return differences;
+}
+
+} // namespace arcana::noelle
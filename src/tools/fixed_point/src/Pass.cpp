@@ -0,0 +1,109 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/tools/FixedPoint.hpp"
+
+namespace arcana::noelle {
+
+static cl::list<std::string> Transformations(
+    "noelle-fixedpoint-passes",
+    cl::CommaSeparated,
+    cl::ZeroOrMore,
+    cl::desc("Passes to run until a fixed point is reached"));
+/*
+ * The default normalizations are the ones of noelle-norm, in the same order:
+ * the LLVM ones, the SVF ones (if SVF is enabled), and the NOELLE ones.
+ */
+static cl::opt<std::string> Normalizations(
+    "noelle-fixedpoint-norm",
+    cl::init("sroa,mem2reg,simplifycfg,lowerswitch,mergereturn,"
+             "break-crit-edges,loop-simplify,lcssa,indvars,function-attrs,"
+             "rpo-function-attrs,"
+#ifdef NOELLE_ENABLE_SVF
+             "break-constgeps,"
+#endif
+             "LoopMetadata"),
+    cl::desc("Passes that normalize the code before every iteration"));
+static cl::opt<std::string> NormalizationOptions(
+    "noelle-fixedpoint-norm-options",
+    cl::init("simplifycfg-sink-common=false"),
+    cl::desc("LLVM options (name=value) set while the code is normalized"));
+static cl::opt<std::string> NormalizationAliasAnalyses(
+    "noelle-fixedpoint-norm-aa",
+    cl::desc("Alias analyses available to the passes that normalize the code "
+             "(set by noelle-fixedpoint to the ones of noelle-norm)"));
+static cl::opt<std::string> AliasAnalyses(
+    "noelle-fixedpoint-aa",
+    cl::desc("Alias analyses available to the passes of every iteration (set "
+             "by noelle-fixedpoint to the ones of noelle-load)"));
+static cl::opt<uint64_t> MaximumIterations(
+    "noelle-fixedpoint-max-iterations",
+    cl::init(0),
+    cl::desc("Maximum number of iterations (0: no limit)"));
+
+static std::vector<std::string> splitPasses(StringRef aliasAnalyses,
+                                            StringRef passes) {
+  std::vector<std::string> names;
+  for (auto list : { aliasAnalyses, passes }) {
+    SmallVector<StringRef, 16> listNames;
+    list.split(listNames, ',', -1, false);
+    for (auto name : listNames) {
+      names.push_back(name.trim().str());
+    }
+  }
+
+  return names;
+}
+
+bool FixedPoint::doInitialization(Module &M) {
+  std::string transformations;
+  for (auto &name : Transformations) {
+    transformations += name + ",";
+  }
+  this->normalizations =
+      splitPasses(NormalizationAliasAnalyses, Normalizations);
+  SmallVector<StringRef, 4> options;
+  StringRef(NormalizationOptions).split(options, ',', -1, false);
+  for (auto option : options) {
+    auto nameAndValue = option.trim().split('=');
+    this->normalizationOptions.push_back(
+        std::make_pair(nameAndValue.first.str(), nameAndValue.second.str()));
+  }
+  this->transformations = splitPasses(AliasAnalyses, transformations);
+  this->hasTransformations = !Transformations.empty();
+  this->maximumIterations = MaximumIterations;
+
+  return false;
+}
+
+void FixedPoint::getAnalysisUsage(AnalysisUsage &AU) const {
+  return;
+}
+
+// Next there is code to register your pass to "opt"
+char FixedPoint::ID = 0;
+static RegisterPass<FixedPoint> X(
+    "noelle-fixedpoint",
+    "Run passes until the program reaches a fixed point",
+    false,
+    false);
+
+} // namespace arcana::noelle
@@ -84,6 +84,7 @@ void LoopStats::collectStatsOnNoelleSCCs(Hot *profiles,
                                                      environment,
                                                      llvmLoop);
   auto sccdagAttrs = SCCDAGAttrs(true,
+                                 0,
                                  loopDG,
                                  &loopInternalSCCDAG,
                                  loopHierarchy,
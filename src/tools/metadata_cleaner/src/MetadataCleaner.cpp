@@ -103,6 +103,9 @@ void MetadataCleaner::cleanProfMetadata(Module &M) {
         if (I.getMetadata("prof")) {
           I.setMetadata("prof", nullptr);
         }
+        if (I.getMetadata("noelle.prof.trip_counts")) {
+          I.setMetadata("noelle.prof.trip_counts", nullptr);
+        }
       }
     }
   }
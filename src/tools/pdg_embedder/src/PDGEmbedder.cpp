@@ -24,6 +24,12 @@
 
 namespace arcana::noelle {
 
+static cl::opt<bool> EmbedBinaryPDG(
+    "noelle-pdg-embed-binary",
+    cl::init(false),
+    cl::desc(
+        "Store the PDG in a binary file next to the bitcode instead of the IR"));
+
 PDGEmbedder::PDGEmbedder() : ModulePass(ID) {
   return;
 }
@@ -49,10 +55,20 @@ bool PDGEmbedder::runOnModule(Module &M) {
    */
   auto pdg = noelle.getProgramDependenceGraph();
 
+  /*
+   * Check if the PDG should be stored outside the IR.
+   */
+  auto &pdgGen = noelle.getPDGGenerator();
+  if (EmbedBinaryPDG.getNumOccurrences() > 0) {
+    if (!pdgGen.writePDGCache(pdg)) {
+      errs() << "PDGEmbedder: Error = the PDG could not be stored\n";
+    }
+    return false;
+  }
+
   /*
    * Embed the PDG.
    */
-  auto pdgGen = noelle.getPDGGenerator();
   pdgGen.cleanAndEmbedPDGAsMetadata(pdg);
 
   return true;
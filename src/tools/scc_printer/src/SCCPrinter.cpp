@@ -73,13 +73,9 @@ bool SCCPrinter::runOnModule(Module &M) {
   };
 
   auto LSs = noelle.getLoopStructures();
-  LoopStructure *LS = nullptr;
-  for (auto *x : *LSs) {
-    if (x->getID().value() == this->targetLoopID) {
-      LS = x;
-    }
-  }
-  assert(LS);
+  auto loopsByID = noelle.indexLoopsByID(*LSs);
+  assert(loopsByID.find(this->targetLoopID) != loopsByID.end());
+  auto LS = loopsByID.at(this->targetLoopID);
 
   auto LC = noelle.getLoopContent(LS);
   auto sccManager = LC->getSCCManager();
@@ -138,6 +134,10 @@ std::string getSCCTypeName(GenericSCC::SCCKind type) {
       return "REDUCTION";
     case GenericSCC::BINARY_REDUCTION:
       return "BINARY_REDUCTION";
+    case GenericSCC::MIN_MAX_REDUCTION:
+      return "MIN_MAX_REDUCTION";
+    case GenericSCC::ARG_MIN_MAX_REDUCTION:
+      return "ARG_MIN_MAX_REDUCTION";
     case GenericSCC::RECOMPUTABLE:
       return "RECOMPUTABLE";
     case GenericSCC::SINGLE_ACCUMULATOR_RECOMPUTABLE:
@@ -154,6 +154,8 @@ std::string getSCCTypeName(GenericSCC::SCCKind type) {
       return "MEMORY_CLONABLE";
     case GenericSCC::STACK_OBJECT_CLONABLE:
       return "STACK_OBJECT_CLONABLE";
+    case GenericSCC::ARRAY_REDUCTION:
+      return "ARRAY_REDUCTION";
     case GenericSCC::LOOP_CARRIED_UNKNOWN:
       return "LOOP_CARRIED_UNKNOWN";
     case GenericSCC::LOOP_ITERATION:
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_TOOLS_TRIPCOUNTPROFILER_H_
+#define NOELLE_SRC_TOOLS_TRIPCOUNTPROFILER_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/Hot.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Profile the trip counts of the loops of a program.
+ *
+ * By default, the pass instruments the program to record, for every loop,
+ * the number of invocations and the histogram of the iterations executed per
+ * invocation in log2 buckets (see Hot::getTripCountHistogram). The profile is
+ * appended to a text file when the program exits, so several runs accumulate.
+ *
+ * When embedding, the pass reads that file and attaches the histograms to the
+ * loops of the same program, where Hot reads them from.
+ *
+ * An invocation is recorded when it leaves the loop through an exit edge, a
+ * return, or a landing pad that can only be reached from the loop. The
+ * invocations that leave it otherwise (e.g., by unwinding to a landing pad
+ * shared with code outside the loop, by calling exit, or by longjmp) are
+ * counted but not recorded in the histogram.
+ *
+ * Loops are identified by their function and by their position in the
+ * pre-order of the loop forest of that function, so both steps must run on
+ * bitcode with the same loops (splitting edges does not change them).
+ */
+class TripCountProfiler : public ModulePass {
+public:
+  /*
+   * Class fields
+   */
+  static char ID;
+
+  /*
+   * Methods
+   */
+  TripCountProfiler();
+  bool doInitialization(Module &M) override;
+  bool runOnModule(Module &M) override;
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+
+private:
+  struct LoopToProfile {
+    Function *function;
+    uint64_t loopIndex;
+    BasicBlock *header;
+    BasicBlock *preHeader;
+    SmallPtrSet<BasicBlock *, 16> blocks;
+    SmallVector<std::pair<BasicBlock *, BasicBlock *>, 4> exitEdges;
+    SmallVector<Instruction *, 2> exitInstructions;
+  };
+
+  std::string profileFile;
+  bool embed;
+
+  std::vector<LoopToProfile> getLoops(Module &M);
+
+  bool instrument(Module &M);
+
+  void createDumper(Module &M,
+                    const std::vector<LoopToProfile> &loops,
+                    GlobalVariable *invocations,
+                    GlobalVariable *histograms);
+
+  bool embedProfiles(Module &M);
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_TOOLS_TRIPCOUNTPROFILER_H_
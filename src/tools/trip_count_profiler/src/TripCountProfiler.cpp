@@ -0,0 +1,487 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <fstream>
+
+#include "llvm/ADT/MapVector.h"
+#include "llvm/Transforms/Utils/ModuleUtils.h"
+
+#include "arcana/noelle/tools/TripCountProfiler.hpp"
+
+namespace arcana::noelle {
+
+TripCountProfiler::TripCountProfiler()
+  : ModulePass{ ID },
+    profileFile{ "noelle-trip-counts.prof" },
+    embed{ false } {}
+
+bool TripCountProfiler::runOnModule(Module &M) {
+  if (this->embed) {
+    return this->embedProfiles(M);
+  }
+
+  return this->instrument(M);
+}
+
+std::vector<TripCountProfiler::LoopToProfile> TripCountProfiler::getLoops(
+    Module &M) {
+  std::vector<LoopToProfile> loops;
+
+  for (auto &F : M) {
+    if (F.empty()) {
+      continue;
+    }
+
+    /*
+     * Fetch the loops of F in pre-order.
+     * Their position in this order identifies them in the profile.
+     */
+    auto &LI = getAnalysis<LoopInfoWrapperPass>(F).getLoopInfo();
+    uint64_t loopIndex = 0;
+    for (auto loop : LI.getLoopsInPreorder()) {
+      LoopToProfile l;
+      l.function = &F;
+      l.loopIndex = loopIndex;
+      l.header = loop->getHeader();
+      l.preHeader = loop->getLoopPreheader();
+      l.blocks.insert(loop->block_begin(), loop->block_end());
+      loop->getExitEdges(l.exitEdges);
+      for (auto bb : loop->blocks()) {
+        auto terminator = bb->getTerminator();
+        if (isa<ReturnInst>(terminator) || isa<ResumeInst>(terminator)) {
+          l.exitInstructions.push_back(terminator);
+        }
+      }
+      loops.push_back(l);
+      loopIndex++;
+    }
+  }
+
+  return loops;
+}
+
+bool TripCountProfiler::instrument(Module &M) {
+
+  /*
+   * Fetch the loops to instrument.
+   * We need a pre-header to know when a new invocation of a loop starts.
+   */
+  std::vector<LoopToProfile> loops;
+  for (auto &l : this->getLoops(M)) {
+    if (l.preHeader == nullptr) {
+      continue;
+    }
+    loops.push_back(l);
+  }
+  if (loops.empty()) {
+    return false;
+  }
+
+  /*
+   * Allocate the counters: the invocations of each loop and its histogram of
+   * trip counts.
+   */
+  auto &context = M.getContext();
+  auto int64Type = Type::getInt64Ty(context);
+  auto invocationsType = ArrayType::get(int64Type, loops.size());
+  auto histogramType =
+      ArrayType::get(int64Type, Hot::numberOfTripCountBuckets);
+  auto histogramsType = ArrayType::get(histogramType, loops.size());
+  auto invocations =
+      new GlobalVariable(M,
+                         invocationsType,
+                         false,
+                         GlobalValue::InternalLinkage,
+                         ConstantAggregateZero::get(invocationsType),
+                         "noelle.trip_counts.invocations");
+  auto histograms =
+      new GlobalVariable(M,
+                         histogramsType,
+                         false,
+                         GlobalValue::InternalLinkage,
+                         ConstantAggregateZero::get(histogramsType),
+                         "noelle.trip_counts.histograms");
+  auto zero = ConstantInt::get(int64Type, 0);
+  auto one = ConstantInt::get(int64Type, 1);
+
+  /*
+   * Count the iterations of each invocation of the loops.
+   *
+   * The counter of a loop lives in the stack frame of its function so
+   * recursive invocations do not clobber each other.
+   */
+  MapVector<std::pair<BasicBlock *, BasicBlock *>,
+            std::vector<std::pair<uint64_t, AllocaInst *>>>
+      exitEdges;
+  MapVector<Instruction *, std::vector<std::pair<uint64_t, AllocaInst *>>>
+      exitPoints;
+  for (auto loopID = 0u; loopID < loops.size(); loopID++) {
+    auto &l = loops[loopID];
+    auto loopIDValue = ConstantInt::get(int64Type, loopID);
+
+    /*
+     * Allocate the counter.
+     */
+    auto &entryBB = l.function->getEntryBlock();
+    IRBuilder<> entryBuilder(&*entryBB.getFirstInsertionPt());
+    auto counter =
+        entryBuilder.CreateAlloca(int64Type, nullptr, "noelle.trip_count");
+
+    /*
+     * Reset the counter and count the invocation in the pre-header.
+     */
+    IRBuilder<> preHeaderBuilder(l.preHeader->getTerminator());
+    preHeaderBuilder.CreateStore(zero, counter);
+    auto invocationsPtr =
+        preHeaderBuilder.CreateInBoundsGEP(invocationsType,
+                                           invocations,
+                                           { zero, loopIDValue });
+    auto oldInvocations =
+        preHeaderBuilder.CreateLoad(int64Type, invocationsPtr);
+    auto newInvocations = preHeaderBuilder.CreateAdd(oldInvocations, one);
+    preHeaderBuilder.CreateStore(newInvocations, invocationsPtr);
+
+    /*
+     * Count the iteration in the header.
+     */
+    IRBuilder<> headerBuilder(&*l.header->getFirstInsertionPt());
+    auto oldIterations = headerBuilder.CreateLoad(int64Type, counter);
+    headerBuilder.CreateStore(headerBuilder.CreateAdd(oldIterations, one),
+                              counter);
+
+    /*
+     * Keep track of the exit edges where the trip count has to be recorded.
+     *
+     * Exception edges cannot be split. Their landing pad records the trip
+     * count when it can only be reached from the loop; otherwise, the
+     * invocations that leave the loop through them are not recorded.
+     */
+    for (auto &edge : l.exitEdges) {
+      auto exitBB = edge.second;
+      if (!exitBB->isEHPad()) {
+        exitEdges[edge].push_back({ loopID, counter });
+        continue;
+      }
+      if (!isa<LandingPadInst>(exitBB->getFirstNonPHI())) {
+        continue;
+      }
+      auto onlyFromTheLoop = true;
+      for (auto predBB : predecessors(exitBB)) {
+        if (l.blocks.count(predBB) == 0) {
+          onlyFromTheLoop = false;
+          break;
+        }
+      }
+      if (!onlyFromTheLoop) {
+        continue;
+      }
+      auto &loopsOfExit = exitPoints[&*exitBB->getFirstInsertionPt()];
+      if (std::find(loopsOfExit.begin(),
+                    loopsOfExit.end(),
+                    std::make_pair((uint64_t)loopID, counter))
+          == loopsOfExit.end()) {
+        loopsOfExit.push_back({ loopID, counter });
+      }
+    }
+
+    /*
+     * Invocations that leave the function from within the loop are recorded
+     * right before they do.
+     */
+    for (auto exitInst : l.exitInstructions) {
+      exitPoints[exitInst].push_back({ loopID, counter });
+    }
+  }
+
+  /*
+   * Split the exit edges.
+   *
+   * An edge can exit several nested loops at once, so edges are split once
+   * and all the loops they exit are recorded in the new basic block.
+   */
+  for (auto &pair : exitEdges) {
+    auto exitBB = SplitEdge(pair.first.first, pair.first.second);
+    if (exitBB == nullptr) {
+      continue;
+    }
+    auto &loopsOfExit = exitPoints[&*exitBB->getFirstInsertionPt()];
+    loopsOfExit.insert(loopsOfExit.end(),
+                       pair.second.begin(),
+                       pair.second.end());
+  }
+
+  /*
+   * Record the trip counts.
+   */
+  for (auto &pair : exitPoints) {
+    IRBuilder<> exitBuilder(pair.first);
+    for (auto &loopAndCounter : pair.second) {
+      auto loopIDValue = ConstantInt::get(int64Type, loopAndCounter.first);
+
+      /*
+       * Compute the log2 bucket of the trip count: 64 - ctlz(tripCount).
+       */
+      auto tripCount = exitBuilder.CreateLoad(int64Type, loopAndCounter.second);
+      auto leadingZeros = exitBuilder.CreateBinaryIntrinsic(
+          Intrinsic::ctlz,
+          tripCount,
+          exitBuilder.getFalse());
+      auto bucket =
+          exitBuilder.CreateSub(ConstantInt::get(int64Type, 64), leadingZeros);
+
+      /*
+       * Increment the bucket.
+       */
+      auto bucketPtr =
+          exitBuilder.CreateInBoundsGEP(histogramsType,
+                                        histograms,
+                                        { zero, loopIDValue, bucket });
+      auto oldCount = exitBuilder.CreateLoad(int64Type, bucketPtr);
+      exitBuilder.CreateStore(exitBuilder.CreateAdd(oldCount, one), bucketPtr);
+    }
+  }
+
+  /*
+   * Dump the counters when the program exits.
+   */
+  this->createDumper(M, loops, invocations, histograms);
+
+  return true;
+}
+
+void TripCountProfiler::createDumper(Module &M,
+                                     const std::vector<LoopToProfile> &loops,
+                                     GlobalVariable *invocations,
+                                     GlobalVariable *histograms) {
+  auto &context = M.getContext();
+  auto int32Type = Type::getInt32Ty(context);
+  auto int64Type = Type::getInt64Ty(context);
+  auto int8PtrType = Type::getInt8PtrTy(context);
+  auto zero = ConstantInt::get(int64Type, 0);
+  auto one = ConstantInt::get(int64Type, 1);
+
+  /*
+   * Create the tables that identify the loops: their function name and their
+   * position within their function.
+   */
+  std::unordered_map<Function *, Constant *> functionNames;
+  std::vector<Constant *> loopFunctions;
+  std::vector<uint64_t> loopIndexes;
+  for (auto &l : loops) {
+    if (functionNames.find(l.function) == functionNames.end()) {
+      auto name = ConstantDataArray::getString(context, l.function->getName());
+      auto nameGlobal = new GlobalVariable(M,
+                                           name->getType(),
+                                           true,
+                                           GlobalValue::PrivateLinkage,
+                                           name,
+                                           "noelle.trip_counts.function");
+      functionNames[l.function] =
+          ConstantExpr::getPointerCast(nameGlobal, int8PtrType);
+    }
+    loopFunctions.push_back(functionNames[l.function]);
+    loopIndexes.push_back(l.loopIndex);
+  }
+  auto functionsType = ArrayType::get(int8PtrType, loops.size());
+  auto functions = new GlobalVariable(M,
+                                      functionsType,
+                                      true,
+                                      GlobalValue::PrivateLinkage,
+                                      ConstantArray::get(functionsType,
+                                                         loopFunctions),
+                                      "noelle.trip_counts.functions");
+  auto indexesArray = ConstantDataArray::get(context, loopIndexes);
+  auto indexes = new GlobalVariable(M,
+                                    indexesArray->getType(),
+                                    true,
+                                    GlobalValue::PrivateLinkage,
+                                    indexesArray,
+                                    "noelle.trip_counts.loops");
+
+  /*
+   * Declare the functions of the C library we need.
+   */
+  auto fopenF = M.getOrInsertFunction(
+      "fopen",
+      FunctionType::get(int8PtrType, { int8PtrType, int8PtrType }, false));
+  auto fprintfF = M.getOrInsertFunction(
+      "fprintf",
+      FunctionType::get(int32Type, { int8PtrType, int8PtrType }, true));
+  auto fcloseF = M.getOrInsertFunction(
+      "fclose",
+      FunctionType::get(int32Type, { int8PtrType }, false));
+
+  /*
+   * Create the dumper.
+   */
+  auto dumper =
+      Function::Create(FunctionType::get(Type::getVoidTy(context), false),
+                       GlobalValue::InternalLinkage,
+                       "noelle.trip_counts.dump",
+                       M);
+  auto entryBB = BasicBlock::Create(context, "entry", dumper);
+  auto headerBB = BasicBlock::Create(context, "header", dumper);
+  auto bodyBB = BasicBlock::Create(context, "body", dumper);
+  auto closeBB = BasicBlock::Create(context, "close", dumper);
+  auto exitBB = BasicBlock::Create(context, "exit", dumper);
+
+  /*
+   * Open the profile in append mode so several runs accumulate.
+   */
+  IRBuilder<> builder(entryBB);
+  auto fileName = builder.CreateGlobalStringPtr(this->profileFile);
+  auto mode = builder.CreateGlobalStringPtr("a");
+  auto file = builder.CreateCall(fopenF, { fileName, mode });
+  builder.CreateCondBr(builder.CreateIsNull(file), exitBB, headerBB);
+
+  /*
+   * Iterate over the loops.
+   */
+  builder.SetInsertPoint(headerBB);
+  auto loopID = builder.CreatePHI(int64Type, 2);
+  loopID->addIncoming(zero, entryBB);
+  auto numberOfLoops = ConstantInt::get(int64Type, loops.size());
+  builder.CreateCondBr(builder.CreateICmpULT(loopID, numberOfLoops),
+                       bodyBB,
+                       closeBB);
+
+  /*
+   * Print one line per loop:
+   * FUNCTION LOOP_INDEX INVOCATIONS BUCKET_0 ... BUCKET_64
+   */
+  builder.SetInsertPoint(bodyBB);
+  std::string format = "%s %llu %llu";
+  for (auto i = 0u; i < Hot::numberOfTripCountBuckets; i++) {
+    format += " %llu";
+  }
+  format += "\n";
+  std::vector<Value *> args;
+  args.push_back(file);
+  args.push_back(builder.CreateGlobalStringPtr(format));
+  auto functionPtr =
+      builder.CreateInBoundsGEP(functionsType, functions, { zero, loopID });
+  args.push_back(builder.CreateLoad(int8PtrType, functionPtr));
+  auto indexPtr = builder.CreateInBoundsGEP(indexesArray->getType(),
+                                            indexes,
+                                            { zero, loopID });
+  args.push_back(builder.CreateLoad(int64Type, indexPtr));
+  auto invocationsPtr =
+      builder.CreateInBoundsGEP(invocations->getValueType(),
+                                invocations,
+                                { zero, loopID });
+  args.push_back(builder.CreateLoad(int64Type, invocationsPtr));
+  for (auto i = 0u; i < Hot::numberOfTripCountBuckets; i++) {
+    auto bucketPtr =
+        builder.CreateInBoundsGEP(histograms->getValueType(),
+                                  histograms,
+                                  { zero, loopID, builder.getInt64(i) });
+    args.push_back(builder.CreateLoad(int64Type, bucketPtr));
+  }
+  builder.CreateCall(fprintfF, args);
+  loopID->addIncoming(builder.CreateAdd(loopID, one), bodyBB);
+  builder.CreateBr(headerBB);
+
+  /*
+   * Close the profile.
+   */
+  builder.SetInsertPoint(closeBB);
+  builder.CreateCall(fcloseF, { file });
+  builder.CreateBr(exitBB);
+  builder.SetInsertPoint(exitBB);
+  builder.CreateRetVoid();
+
+  /*
+   * Run the dumper when the program exits.
+   */
+  appendToGlobalDtors(M, dumper, 0);
+
+  return;
+}
+
+bool TripCountProfiler::embedProfiles(Module &M) {
+
+  /*
+   * Read the profile.
+   * Lines of the same loop come from different runs, so they are summed.
+   */
+  std::ifstream input(this->profileFile);
+  if (!input.is_open()) {
+    errs() << "TripCountProfiler: Cannot open " << this->profileFile << "\n";
+    return false;
+  }
+  std::map<std::pair<std::string, uint64_t>, std::vector<uint64_t>> profiles;
+  std::string line;
+  while (std::getline(input, line)) {
+    std::istringstream fields(line);
+    std::string functionName;
+    uint64_t loopIndex;
+    if (!(fields >> functionName >> loopIndex)) {
+      continue;
+    }
+    auto &counters = profiles[{ functionName, loopIndex }];
+    counters.resize(1 + Hot::numberOfTripCountBuckets, 0);
+    for (auto &counter : counters) {
+      uint64_t value;
+      if (!(fields >> value)) {
+        break;
+      }
+      counter += value;
+    }
+  }
+
+  /*
+   * Embed the histograms to the loops.
+   */
+  auto &context = M.getContext();
+  auto int64Type = Type::getInt64Ty(context);
+  auto modified = false;
+  for (auto &l : this->getLoops(M)) {
+    auto profile = profiles.find({ l.function->getName().str(), l.loopIndex });
+    if (profile == profiles.end()) {
+      continue;
+    }
+
+    /*
+     * Drop the empty buckets at the end of the histogram.
+     */
+    auto &counters = profile->second;
+    auto numberOfCounters = counters.size();
+    while ((numberOfCounters > 1) && (counters[numberOfCounters - 1] == 0)) {
+      numberOfCounters--;
+    }
+
+    /*
+     * Attach the metadata to the header.
+     */
+    std::vector<Metadata *> operands;
+    for (auto i = 0u; i < numberOfCounters; i++) {
+      auto c = ConstantInt::get(int64Type, counters[i]);
+      operands.push_back(ConstantAsMetadata::get(c));
+    }
+    auto md = MDNode::get(context, operands);
+    l.header->getTerminator()->setMetadata(Hot::tripCountsMetadataKey, md);
+    modified = true;
+  }
+
+  return modified;
+}
+
+} // namespace arcana::noelle
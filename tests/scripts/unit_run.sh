@@ -46,13 +46,28 @@ function runTest {
 
   ${CC} -std=c++14 -emit-llvm -O0 -Xclang -disable-O0-optnone -c test.cpp -o test_pre.bc
 
-  noelle-prof-coverage test_pre.bc test_pre_prof $PROFILER_LIBS
+  # A suite can ask for its loop trip counts to be profiled as well
+  local PROFILE_TRIP_COUNTS=""
+  if test -f ../../profile_trip_counts ; then
+    PROFILE_TRIP_COUNTS="-trip-counts"
+  fi
+
+  noelle-prof-coverage ${PROFILE_TRIP_COUNTS} test_pre.bc test_pre_prof $PROFILER_LIBS
   ./test_pre_prof $PROGRAM_INPUT_FOR_PROFILE &> compiler_output.txt
   llvm-profdata merge default.profraw -output=$TEST_PROFILE
 
   noelle-meta-prof-embed $TEST_PROFILE test_pre.bc -o test_prof.bc &> compiler_output.txt
+  if ! test -z "${PROFILE_TRIP_COUNTS}" ; then
+    noelle-meta-trip-count-embed noelle-trip-counts.prof test_pre.bc -o test_pre_trip_counts.bc &> compiler_output.txt
+    mv test_pre_trip_counts.bc test_pre.bc
+  fi
 
-  opt ${TRANSFORMATIONS_BEFORE_PARALLELIZATION} test_pre.bc -o test.bc &> /dev/null
+  # A test can ask for extra transformations (e.g., to turn branches into selects)
+  local TEST_TRANSFORMATIONS=""
+  if test -f transformations.txt ; then
+    TEST_TRANSFORMATIONS=`cat transformations.txt`
+  fi
+  opt ${TEST_TRANSFORMATIONS} ${TRANSFORMATIONS_BEFORE_PARALLELIZATION} test_pre.bc -o test.bc &> /dev/null
   llvm-dis test.bc -o test.ll
 
   local UNIT_TEST_PASS="-load $TEST_LIB_DIR/UnitTestHelpers.so -load $TEST_LIB_DIR/$TEST_SO -UnitTester"
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2016 - 2023  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "ArchitectureTestSuite.hpp"
+
+namespace arcana::noelle {
+
+// Register pass to "opt"
+char ArchitectureTestSuite::ID = 0;
+static RegisterPass<ArchitectureTestSuite> X("UnitTester",
+                                             "Architecture Unit Tester");
+
+// Register pass to "clang"
+static ArchitectureTestSuite *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(
+    PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new ArchitectureTestSuite());
+      }
+    }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new ArchitectureTestSuite());
+      }
+    }); // ** for -O0
+
+const char *ArchitectureTestSuite::tests[] = { "discovered topology",
+                                               "architecture descriptions",
+                                               "cgroup directories" };
+TestFunction ArchitectureTestSuite::testFns[] = {
+  ArchitectureTestSuite::discoveredTopologyIsConsistent,
+  ArchitectureTestSuite::architectureDescriptionsAreParsed,
+  ArchitectureTestSuite::cgroupDirectoriesAreFound
+};
+
+bool ArchitectureTestSuite::doInitialization(Module &M) {
+  errs() << "ArchitectureTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("ArchitectureTestSuite",
+                              tests,
+                              testFns,
+                              numTests,
+                              "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void ArchitectureTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
+  return;
+}
+
+bool ArchitectureTestSuite::runOnModule(Module &M) {
+  errs() << "ArchitectureTestSuite: Start\n";
+
+  suite->runTests((ModulePass &)*this);
+
+  return false;
+}
+
+Values ArchitectureTestSuite::discoveredTopologyIsConsistent(
+    ModulePass &pass,
+    TestSuite &suite) {
+  Values values{};
+
+  /*
+   * The values depend on the host, so only their invariants are checked.
+   */
+  auto cacheLineBytes = Architecture::getCacheLineBytes();
+  if ((cacheLineBytes >= 8) && isPowerOf2_32(cacheLineBytes)) {
+    values.insert("cache lines are a power of two of at least 8 bytes");
+  }
+  auto physicalCores = Architecture::getNumberOfPhysicalCores();
+  if (physicalCores > 0) {
+    values.insert("there is at least one physical core");
+  }
+  if (physicalCores <= Architecture::getNumberOfLogicalCores()) {
+    values.insert("physical cores do not outnumber logical cores");
+  }
+
+  return values;
+}
+
+Values ArchitectureTestSuite::architectureDescriptionsAreParsed(
+    ModulePass &pass,
+    TestSuite &suite) {
+  const std::vector<std::pair<std::string, std::string>> descriptions{
+    { "overrides",
+      "# A comment\nlogical_cores 8\n\ncache_line_bytes 128\n" },
+    { "smallest cache line", "cache_line_bytes 8" },
+    { "cache line of 4 bytes", "cache_line_bytes 4" },
+    { "cache line of 48 bytes", "cache_line_bytes 48" },
+    { "zero", "sockets 0" },
+    { "unknown key", "caches 3" }
+  };
+
+  Values values{};
+  for (const auto &[name, description] : descriptions) {
+    std::string error;
+    auto parsed =
+        Architecture::parseArchitectureDescription(description, error);
+    if (!parsed) {
+      values.insert(name + " -> " + error);
+      continue;
+    }
+    std::string result;
+    for (const auto &[key, value] : *parsed) {
+      result += (result.empty() ? "" : ", ") + key + " "
+                + std::to_string(value);
+    }
+    values.insert(name + " -> " + result);
+  }
+
+  return values;
+}
+
+Values ArchitectureTestSuite::cgroupDirectoriesAreFound(ModulePass &pass,
+                                                        TestSuite &suite) {
+  const std::vector<std::pair<std::string, std::string>> procCgroups{
+    { "v2", "0::/user.slice/user-1000.slice/session-2.scope\n" },
+    { "v2 namespace", "0::/\n" },
+    { "v1",
+      "12:memory:/docker/abc\n4:cpu,cpuacct:/docker/abc\n"
+      "3:cpuset:/docker/abc\n" },
+    { "unknown", "" }
+  };
+
+  Values values{};
+  for (const auto &[name, procCgroup] : procCgroups) {
+    auto dirs = Architecture::getCgroupDirectories(procCgroup);
+    values.insert(name + " -> "
+                  + TestSuite::combineValues(dirs,
+                                             suite.orderedValueDelimiter));
+  }
+
+  return values;
+}
+
+} // namespace arcana::noelle
@@ -65,6 +65,13 @@ private:
                                                    TestSuite &suite);
   static Values sccdagExternalNodesOfOutermostLoop(ModulePass &pass,
                                                    TestSuite &suite);
+  static Values pdgBuiltInParallelIsTheSerialOne(ModulePass &pass,
+                                                 TestSuite &suite);
+  static Values sccNodesAreTheOnesOfTheLoopDG(ModulePass &pass,
+                                              TestSuite &suite);
+  static Values sccDependencesTouchInternalNodes(ModulePass &pass,
+                                                 TestSuite &suite);
+  static Values sccViewsBehaveLikeCopies(ModulePass &pass, TestSuite &suite);
 
   Values getSCCValues(std::set<SCC *> sccs);
 
@@ -72,6 +79,7 @@ private:
   Module *M;
   Function *mainF;
   PDG *fdg;
+  PDG *ldgOutermostLoop;
   SCCDAG *sccdagOutermostLoop;
 };
 } // namespace llvm
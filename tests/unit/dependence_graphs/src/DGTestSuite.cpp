@@ -54,7 +54,11 @@ const char *DGTestSuite::tests[] = {
   "pdg leaf values",
   "pdg disjoint values",
   "sccdag internal nodes (of outermost loop)",
-  "sccdag external nodes (of outermost loop)"
+  "sccdag external nodes (of outermost loop)",
+  "pdg built in parallel",
+  "scc nodes",
+  "scc dependences",
+  "scc views"
 };
 
 TestFunction DGTestSuite::testFns[] = {
@@ -65,7 +69,11 @@ TestFunction DGTestSuite::testFns[] = {
   DGTestSuite::pdgIdentifiesLeafValues,
   DGTestSuite::pdgIdentifiesDisconnectedValueSets,
   DGTestSuite::sccdagInternalNodesOfOutermostLoop,
-  DGTestSuite::sccdagExternalNodesOfOutermostLoop
+  DGTestSuite::sccdagExternalNodesOfOutermostLoop,
+  DGTestSuite::pdgBuiltInParallelIsTheSerialOne,
+  DGTestSuite::sccNodesAreTheOnesOfTheLoopDG,
+  DGTestSuite::sccDependencesTouchInternalNodes,
+  DGTestSuite::sccViewsBehaveLikeCopies
 };
 
 bool DGTestSuite::doInitialization(Module &M) {
@@ -81,6 +89,9 @@ void DGTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
   AU.addRequired<NoellePass>();
   AU.addRequired<LoopInfoWrapperPass>();
   AU.addRequired<CallGraphWrapperPass>();
+  AU.addRequired<ScalarEvolutionWrapperPass>();
+  AU.addRequired<PostDominatorTreeWrapperPass>();
+  AU.addRequired<AAResultsWrapperPass>();
 }
 
 bool DGTestSuite::runOnModule(Module &M) {
@@ -90,8 +101,8 @@ bool DGTestSuite::runOnModule(Module &M) {
   auto pdg = getAnalysis<NoellePass>().getNoelle().getProgramDependenceGraph();
   this->fdg = pdg->createFunctionSubgraph(*mainF);
   auto &LI = getAnalysis<LoopInfoWrapperPass>(*mainF).getLoopInfo();
-  auto loopDG = fdg->createLoopsSubgraph(LI.getLoopsInPreorder()[0]);
-  this->sccdagOutermostLoop = new SCCDAG(loopDG);
+  this->ldgOutermostLoop = fdg->createLoopsSubgraph(LI.getLoopsInPreorder()[0]);
+  this->sccdagOutermostLoop = new SCCDAG(this->ldgOutermostLoop);
 
   // PDGPrinter pdgPrinter;
   // pdgPrinter.printGraphsForFunction(*mainF, fdg, LI);
@@ -206,6 +217,173 @@ Values DGTestSuite::sccdagExternalNodesOfOutermostLoop(ModulePass &pass,
   return dgPass.getSCCValues(externalSCCs);
 }
 
+Values DGTestSuite::pdgBuiltInParallelIsTheSerialOne(ModulePass &pass,
+                                                     TestSuite &suite) {
+  auto &dgPass = static_cast<DGTestSuite &>(pass);
+
+  /*
+   * Build the PDG of the program serially and with multiple threads.
+   */
+  auto getSCEV = [&dgPass](Function &F) -> ScalarEvolution & {
+    return dgPass.getAnalysis<ScalarEvolutionWrapperPass>(F).getSE();
+  };
+  auto getLoopInfo = [&dgPass](Function &F) -> LoopInfo & {
+    return dgPass.getAnalysis<LoopInfoWrapperPass>(F).getLoopInfo();
+  };
+  auto getPDT = [&dgPass](Function &F) -> PostDominatorTree & {
+    return dgPass.getAnalysis<PostDominatorTreeWrapperPass>(F)
+        .getPostDomTree();
+  };
+  auto getCallGraph = [&dgPass](void) -> CallGraph & {
+    return dgPass.getAnalysis<CallGraphWrapperPass>().getCallGraph();
+  };
+  auto getAA = [&dgPass](Function &F) -> AAResults & {
+    return dgPass.getAnalysis<AAResultsWrapperPass>(F).getAAResults();
+  };
+  auto buildPDG = [&](uint32_t jobs) -> PDGGenerator * {
+    auto generator = new PDGGenerator(*dgPass.M,
+                                      getSCEV,
+                                      getLoopInfo,
+                                      getPDT,
+                                      getCallGraph,
+                                      getAA,
+                                      false,
+                                      false,
+                                      true,
+                                      true,
+                                      false,
+                                      false,
+                                      false,
+                                      PDGVerbosity::Disabled,
+                                      jobs);
+    generator->getPDG();
+    return generator;
+  };
+  auto serialGenerator = buildPDG(1);
+  auto parallelGenerator = buildPDG(4);
+
+  /*
+   * Compare them.
+   */
+  Values result;
+  auto serialPDG = serialGenerator->getPDG();
+  auto parallelPDG = parallelGenerator->getPDG();
+  if (serialGenerator->comparePDGs(serialPDG, parallelPDG)) {
+    result.insert("equivalent");
+  } else {
+    result.insert("different");
+  }
+
+  delete parallelGenerator;
+  delete serialGenerator;
+
+  return result;
+}
+
+Values DGTestSuite::sccNodesAreTheOnesOfTheLoopDG(ModulePass &pass,
+                                                  TestSuite &suite) {
+  auto &dgPass = static_cast<DGTestSuite &>(pass);
+
+  /*
+   * SCCs are views of the loop dependence graph: they reference its nodes.
+   */
+  Values result;
+  for (auto scc : dgPass.sccdagOutermostLoop->getSCCs()) {
+    for (auto node : scc->getNodes()) {
+      auto loopNode = dgPass.ldgOutermostLoop->fetchNode(node->getT());
+      result.insert(loopNode == node ? "shared" : "copied");
+    }
+  }
+
+  return result;
+}
+
+Values DGTestSuite::sccDependencesTouchInternalNodes(ModulePass &pass,
+                                                     TestSuite &suite) {
+  auto &dgPass = static_cast<DGTestSuite &>(pass);
+
+  /*
+   * The dependences of an SCC are the ones of its internal nodes.
+   * External nodes are shared with the loop dependence graph, so their
+   * dependences that do not involve the SCC must not be part of it.
+   */
+  Values result;
+  for (auto scc : dgPass.sccdagOutermostLoop->getSCCs()) {
+    for (auto edge : scc->getEdges()) {
+      auto isOfSCC = scc->isDependenceOfSCC(edge);
+      result.insert(isOfSCC ? "consistent" : "inconsistent");
+    }
+    for (auto node : scc->getNodes()) {
+      for (auto edge : node->getAllEdges()) {
+        if (scc->isInGraph(edge) != scc->isDependenceOfSCC(edge)) {
+          result.insert("inconsistent");
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
+Values DGTestSuite::sccViewsBehaveLikeCopies(ModulePass &pass,
+                                             TestSuite &suite) {
+  auto &dgPass = static_cast<DGTestSuite &>(pass);
+
+  auto toValues = [](const std::unordered_set<DGNode<Value> *> &nodes)
+      -> std::set<Value *> {
+    std::set<Value *> values;
+    for (auto node : nodes) {
+      values.insert(node->getT());
+    }
+    return values;
+  };
+  auto toValueSets =
+      [&toValues](const std::vector<std::unordered_set<DGNode<Value> *> *>
+                      &subgraphs) -> std::set<std::set<Value *>> {
+    std::set<std::set<Value *>> valueSets;
+    for (auto subgraph : subgraphs) {
+      valueSets.insert(toValues(*subgraph));
+      delete subgraph;
+    }
+    return valueSets;
+  };
+
+  /*
+   * Compare every SCC with a copy of its nodes and dependences, which is what
+   * SCCs used to be.
+   */
+  Values result;
+  for (auto scc : dgPass.sccdagOutermostLoop->getSCCs()) {
+    DG<Value> copy;
+    for (auto nodePair : scc->internalNodePairs()) {
+      copy.addNode(nodePair.first, true);
+    }
+    for (auto nodePair : scc->externalNodePairs()) {
+      copy.addNode(nodePair.first, false);
+    }
+    for (auto edge : scc->getEdges()) {
+      copy.copyAddEdge(*edge);
+    }
+
+    auto isEquivalent =
+        (toValues(scc->getTopLevelNodes()) == toValues(copy.getTopLevelNodes()))
+        && (toValues(scc->getLeafNodes()) == toValues(copy.getLeafNodes()))
+        && (toValueSets(scc->getDisconnectedSubgraphs())
+            == toValueSets(copy.getDisconnectedSubgraphs()));
+    for (auto node : scc->getNodes()) {
+      auto copiedNode = copy.fetchNode(node->getT());
+      auto next = toValues(scc->getNextDepthNodes(node));
+      auto copiedNext = toValues(copy.getNextDepthNodes(copiedNode));
+      auto previous = toValues(scc->getPreviousDepthNodes(node));
+      auto copiedPrevious = toValues(copy.getPreviousDepthNodes(copiedNode));
+      isEquivalent &= (next == copiedNext) && (previous == copiedPrevious);
+    }
+    result.insert(isEquivalent ? "equivalent" : "different");
+  }
+
+  return result;
+}
+
 Values DGTestSuite::getSCCValues(std::set<SCC *> sccs) {
   Values sccStrings;
   for (auto scc : sccs) {
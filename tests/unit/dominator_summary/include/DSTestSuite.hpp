@@ -28,6 +28,7 @@
 #include "llvm/IR/Dominators.h"
 #include "llvm/Analysis/PostDominators.h"
 #include "llvm/Support/GenericDomTree.h"
+#include "llvm/Transforms/Utils/ValueMapper.h"
 
 #include "TestSuite.hpp"
 #include "arcana/noelle/core/Dominators.hpp"
@@ -57,6 +58,12 @@ public:
 
 private:
   static Values domTreesAreIdentical(ModulePass &pass, TestSuite &suite);
+  static Values dominanceMatchesLLVM(ModulePass &pass, TestSuite &suite);
+  static Values clonesKeepDominance(ModulePass &pass, TestSuite &suite);
+
+  static Values compareDominanceWithLLVM(DSTestSuite &pass,
+                                         arcana::noelle::DominatorSummary &ds,
+                                         ValueToValueMapTy *cloneMap);
 
   static Values domNodeIsIdentical(DSTestSuite &pass,
                                    DomTreeNodeBase<BasicBlock> &node,
@@ -19,6 +19,9 @@
  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include "llvm/IR/InstIterator.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
 #include "DSTestSuite.hpp"
 
 using namespace llvm;
@@ -46,12 +49,12 @@ static RegisterStandardPasses _RegPass2(
       }
     }); // ** for -O0
 
-const char *DSTestSuite::tests[] = {
-  "dom trees are identical",
-};
-TestFunction DSTestSuite::testFns[] = {
-  DSTestSuite::domTreesAreIdentical,
-};
+const char *DSTestSuite::tests[] = { "dom trees are identical",
+                                     "dominance matches LLVM",
+                                     "clones keep dominance" };
+TestFunction DSTestSuite::testFns[] = { DSTestSuite::domTreesAreIdentical,
+                                        DSTestSuite::dominanceMatchesLLVM,
+                                        DSTestSuite::clonesKeepDominance };
 
 bool DSTestSuite::doInitialization(Module &M) {
   errs() << "DSTestSuite: Initialize\n";
@@ -152,3 +155,117 @@ Values DSTestSuite::domTreesAreIdentical(ModulePass &pass, TestSuite &suite) {
     return errors;
   return {};
 }
+
+Values DSTestSuite::dominanceMatchesLLVM(ModulePass &pass, TestSuite &suite) {
+  auto &dsPass = static_cast<DSTestSuite &>(pass);
+  return DSTestSuite::compareDominanceWithLLVM(dsPass, *dsPass.ds, nullptr);
+}
+
+Values DSTestSuite::clonesKeepDominance(ModulePass &pass, TestSuite &suite) {
+  auto &dsPass = static_cast<DSTestSuite &>(pass);
+  auto mainFunction = dsPass.M->getFunction("main");
+
+  /*
+   * Clone the function and move a summary of its trees to the clone.
+   */
+  ValueToValueMapTy cloneMap;
+  auto clonedFunction = CloneFunction(mainFunction, cloneMap);
+  std::unordered_map<BasicBlock *, BasicBlock *> bbCloneMap;
+  for (auto &bb : *mainFunction) {
+    bbCloneMap[&bb] = cast<BasicBlock>(cloneMap.lookup(&bb));
+  }
+  bbCloneMap[nullptr] = nullptr; // The exit node of the post-dominator tree
+  arcana::noelle::DominatorSummary ds(*dsPass.dt, *dsPass.pdt);
+  ds.DT.transferToClones(bbCloneMap);
+  ds.PDT.transferToClones(bbCloneMap);
+
+  /*
+   * The original basic blocks must not be part of the summary anymore.
+   */
+  Values errors{};
+  for (auto &bb : *mainFunction) {
+    if ((ds.DT.getNode(&bb) != nullptr) || (ds.PDT.getNode(&bb) != nullptr)) {
+      errors.insert("Basic block not transferred to its clone: "
+                    + dsPass.suite->printToString(&bb));
+      break;
+    }
+  }
+  if (errors.empty()) {
+    errors = DSTestSuite::compareDominanceWithLLVM(dsPass, ds, &cloneMap);
+  }
+
+  clonedFunction->eraseFromParent();
+
+  return errors;
+}
+
+Values DSTestSuite::compareDominanceWithLLVM(
+    DSTestSuite &pass,
+    arcana::noelle::DominatorSummary &ds,
+    ValueToValueMapTy *cloneMap) {
+  auto mainFunction = pass.M->getFunction("main");
+
+  /*
+   * The summary might be about a clone of the function.
+   */
+  auto summaryValueOf = [cloneMap](Value *v) -> Value * {
+    if (cloneMap == nullptr) {
+      return v;
+    }
+    return cloneMap->lookup(v);
+  };
+
+  /*
+   * Compare the dominance between basic blocks.
+   */
+  for (auto &B1 : *mainFunction) {
+    for (auto &B2 : *mainFunction) {
+      auto summaryB1 = cast<BasicBlock>(summaryValueOf(&B1));
+      auto summaryB2 = cast<BasicBlock>(summaryValueOf(&B2));
+      if ((ds.DT.dominates(summaryB1, summaryB2)
+           != pass.dt->dominates(&B1, &B2))
+          || (ds.PDT.dominates(summaryB1, summaryB2)
+              != pass.pdt->dominates(&B1, &B2))) {
+        return { "Dominance summary is not correct for: "
+                 + pass.suite->printToString(&B1) + " and "
+                 + pass.suite->printToString(&B2) };
+      }
+    }
+  }
+
+  /*
+   * Compare the dominance between instructions.
+   * Within a basic block, an instruction dominates the ones after it and
+   * post-dominates the ones before it.
+   */
+  std::unordered_map<Instruction *, uint32_t> positions;
+  for (auto &bb : *mainFunction) {
+    auto position = 0u;
+    for (auto &inst : bb) {
+      positions[&inst] = position++;
+    }
+  }
+  for (auto &I : instructions(*mainFunction)) {
+    for (auto &J : instructions(*mainFunction)) {
+      if (&I == &J) {
+        continue;
+      }
+      auto dominates = pass.dt->dominates(I.getParent(), J.getParent());
+      auto postDominates = pass.pdt->dominates(I.getParent(), J.getParent());
+      if (I.getParent() == J.getParent()) {
+        dominates = positions.at(&I) < positions.at(&J);
+        postDominates = !dominates;
+      }
+      auto summaryI = cast<Instruction>(summaryValueOf(&I));
+      auto summaryJ = cast<Instruction>(summaryValueOf(&J));
+      if ((ds.DT.dominates(summaryI, summaryJ) != dominates)
+          || (ds.PDT.dominates(summaryI, summaryJ) != postDominates)) {
+        return { "Dominance summary is not correct for: "
+                 + pass.suite->printToString(&I) + " and "
+                 + pass.suite->printToString(&J) };
+      }
+    }
+  }
+
+  return {};
+}
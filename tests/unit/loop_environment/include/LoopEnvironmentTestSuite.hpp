@@ -0,0 +1,162 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "llvm/Pass.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+
+#include "arcana/noelle/core/Noelle.hpp"
+#include "arcana/noelle/core/LoopContent.hpp"
+#include "arcana/noelle/core/LoopEnvironmentBuilder.hpp"
+#include "arcana/noelle/core/ArrayReductionSCC.hpp"
+
+#include "TestSuite.hpp"
+
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace parallelizertests;
+
+namespace arcana::noelle {
+
+class LoopEnvironmentTestSuite : public ModulePass {
+public:
+  LoopEnvironmentTestSuite() : ModulePass{ ID } {}
+
+  /*
+   * Class fields
+   */
+  static char ID;
+  static const char *tests[];
+  static parallelizertests::TestFunction testFns[];
+
+  bool doInitialization(Module &M) override;
+  bool runOnModule(Module &M) override;
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+
+private:
+  static Values integersReducedLinearly(ModulePass &pass, TestSuite &suite);
+  static Values integersReducedWithATree(ModulePass &pass, TestSuite &suite);
+  static Values floatsReducedLinearly(ModulePass &pass, TestSuite &suite);
+  static Values floatsReducedWithATree(ModulePass &pass, TestSuite &suite);
+  static Values arraysReduced(ModulePass &pass, TestSuite &suite);
+  static Values minMaxReducedLinearly(ModulePass &pass, TestSuite &suite);
+  static Values minMaxReducedWithATree(ModulePass &pass, TestSuite &suite);
+  static Values argMinsWithAnIncreasingIndexReducedLinearly(ModulePass &pass,
+                                                            TestSuite &suite);
+  static Values argMinsWithAnIncreasingIndexReducedWithATree(
+      ModulePass &pass,
+      TestSuite &suite);
+  static Values argMinsWithADecreasingIndexReducedLinearly(ModulePass &pass,
+                                                           TestSuite &suite);
+  static Values argMinsWithADecreasingIndexReducedWithATree(
+      ModulePass &pass,
+      TestSuite &suite);
+  static Values readOnlyVariablesPacked(ModulePass &pass, TestSuite &suite);
+
+  /*
+   * Reduce the private copies of the reduction of the loop whose type is
+   * (or is not) a floating point one, for every number of reducers that ran.
+   * The private copy of reducer "i" holds "i + 1" (halved for floating point
+   * types), the copies of reducers that did not run are never written, and
+   * the initial value is 10 (0.25 for floating point types).
+   *
+   * Each reduction is generated in a function of its own, whose result is
+   * then folded to a constant and returned.
+   */
+  Values reduce(ReductionStrategy strategy, bool floatingPoint);
+
+  BinaryReductionSCC *fetchReduction(bool floatingPoint);
+
+  /*
+   * Reduce the private copies of a signed min (initial value 10), an unsigned
+   * max (initial value 5), and a float min (initial value 2), for every number
+   * of reducers that ran.
+   */
+  Values reduceMinMax(ReductionStrategy strategy);
+
+  /*
+   * Reduce the private copies of a signed min (initial value 10) and of the
+   * index where it has been reached, for every number of reducers that ran.
+   * The initial index is 100 if the index increases, -1 otherwise.
+   * Reducers "2" and "3" reach the same min, and reducer "0" reaches the
+   * initial one.
+   */
+  Values reduceArgMin(ReductionStrategy strategy, bool isIndexIncreasing);
+
+  /*
+   * Generate the reduction of the private copies @privateCopies[v][r] of the
+   * variables reduced by @reductions, and return the accumulated value of the
+   * variable @resultID once folded to a constant.
+   * The SCCs of @reductions are not used to generate the code.
+   */
+  Constant *computeReducedValue(
+      const std::vector<ReductionSCC *> &reductions,
+      const std::vector<std::vector<Constant *>> &privateCopies,
+      const std::vector<Constant *> &initialValues,
+      ReductionStrategy strategy,
+      uint64_t reducersExecuted,
+      uint32_t resultID);
+
+  Constant *computeReducedValue(BinaryReductionSCC *red,
+                                ReductionStrategy strategy,
+                                uint64_t reducersExecuted);
+
+  /*
+   * Combine the private copies of an array of 4 integers that starts as
+   * { 10, 20, 30, 40 }, for every number of reducers that ran.
+   * Reducer "i" adds "(i + 1) * (e + 1)" to element "e".
+   */
+  Constant *computeReducedElementOfArray(uint64_t element,
+                                         uint64_t reducersExecuted);
+
+  /*
+   * Optimize @f and return the constant it returns, if any.
+   * @f is then erased.
+   */
+  /*
+   * Store @value to the live-in @id of the environment of the loop, whose
+   * read-only variables are packed, and load it back through a user of the
+   * environment.
+   * Return the value loaded once folded to a constant, and set @isPacked to
+   * whether the live-in is packed.
+   */
+  Constant *readBackLiveIn(const LoopTransformationsManager &ltm,
+                           uint32_t id,
+                           Constant *value,
+                           bool *isPacked);
+
+  Constant *foldFunction(Function *f);
+
+  TestSuite *suite;
+  Module *M;
+  LoopContent *ldi;
+  Noelle *noelle;
+
+  static constexpr uint64_t numberOfReducers = 5;
+};
+} // namespace arcana::noelle
@@ -0,0 +1,820 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/NoellePass.hpp"
+#include "LoopEnvironmentTestSuite.hpp"
+
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/Transforms/Scalar.h"
+#include "llvm/Transforms/Scalar/GVN.h"
+#include "llvm/Transforms/InstCombine/InstCombine.h"
+#include "llvm/Transforms/Utils.h"
+
+namespace arcana::noelle {
+
+// Register pass to "opt"
+char LoopEnvironmentTestSuite::ID = 0;
+static RegisterPass<LoopEnvironmentTestSuite> X("UnitTester",
+                                                "Loop Environment Unit Tester");
+
+// Register pass to "clang"
+static LoopEnvironmentTestSuite *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(
+    PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new LoopEnvironmentTestSuite());
+      }
+    }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new LoopEnvironmentTestSuite());
+      }
+    }); // ** for -O0
+
+const char *LoopEnvironmentTestSuite::tests[] = {
+  "integers reduced linearly",
+  "integers reduced with a tree",
+  "floats reduced linearly",
+  "floats reduced with a tree",
+  "arrays reduced",
+  "min/max reduced linearly",
+  "min/max reduced with a tree",
+  "argmins with an increasing index reduced linearly",
+  "argmins with an increasing index reduced with a tree",
+  "argmins with a decreasing index reduced linearly",
+  "argmins with a decreasing index reduced with a tree",
+  "read-only variables packed"
+};
+TestFunction LoopEnvironmentTestSuite::testFns[] = {
+  LoopEnvironmentTestSuite::integersReducedLinearly,
+  LoopEnvironmentTestSuite::integersReducedWithATree,
+  LoopEnvironmentTestSuite::floatsReducedLinearly,
+  LoopEnvironmentTestSuite::floatsReducedWithATree,
+  LoopEnvironmentTestSuite::arraysReduced,
+  LoopEnvironmentTestSuite::minMaxReducedLinearly,
+  LoopEnvironmentTestSuite::minMaxReducedWithATree,
+  LoopEnvironmentTestSuite::argMinsWithAnIncreasingIndexReducedLinearly,
+  LoopEnvironmentTestSuite::argMinsWithAnIncreasingIndexReducedWithATree,
+  LoopEnvironmentTestSuite::argMinsWithADecreasingIndexReducedLinearly,
+  LoopEnvironmentTestSuite::argMinsWithADecreasingIndexReducedWithATree,
+  LoopEnvironmentTestSuite::readOnlyVariablesPacked
+};
+
+bool LoopEnvironmentTestSuite::doInitialization(Module &M) {
+  errs() << "LoopEnvironmentTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("LoopEnvironmentTestSuite",
+                              tests,
+                              testFns,
+                              numTests,
+                              "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void LoopEnvironmentTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<ScalarEvolutionWrapperPass>();
+  AU.addRequired<LoopInfoWrapperPass>();
+  AU.addRequired<NoellePass>();
+}
+
+bool LoopEnvironmentTestSuite::runOnModule(Module &M) {
+  errs() << "LoopEnvironmentTestSuite: Start\n";
+  this->noelle = &getAnalysis<NoellePass>().getNoelle();
+
+  auto mainFunction = M.getFunction("main");
+  auto LI = &getAnalysis<LoopInfoWrapperPass>(*mainFunction).getLoopInfo();
+  auto SE = &getAnalysis<ScalarEvolutionWrapperPass>(*mainFunction).getSE();
+  auto topLoop = LI->getLoopsInPreorder()[0];
+
+  /*
+   * Fetch the forest node of the loop
+   */
+  auto DS = this->noelle->getDominators(mainFunction);
+  auto allLoopsOfFunction = this->noelle->getLoopStructures(mainFunction, 0);
+  auto forest =
+      this->noelle->organizeLoopsInTheirNestingForest(*allLoopsOfFunction);
+  auto loopNode =
+      forest->getInnermostLoopThatContains(&*topLoop->getHeader()->begin());
+
+  /*
+   * Identify the reductions of the loop.
+   */
+  auto pdg = this->noelle->getProgramDependenceGraph();
+  auto fdg = pdg->createFunctionSubgraph(*mainFunction);
+  LDGGenerator ldg{};
+  this->ldi = new LoopContent(ldg,
+                              this->noelle->getCompilationOptionsManager(),
+                              fdg,
+                              loopNode,
+                              topLoop,
+                              *DS,
+                              *SE,
+                              true,
+                              true);
+  this->ldi->getSCCManager();
+
+  errs() << "LoopEnvironmentTestSuite: Running suite\n";
+  suite->runTests((ModulePass &)*this);
+
+  delete this->ldi;
+  delete fdg;
+
+  return false;
+}
+
+Values LoopEnvironmentTestSuite::integersReducedLinearly(ModulePass &pass,
+                                                         TestSuite &suite) {
+  auto &envPass = static_cast<LoopEnvironmentTestSuite &>(pass);
+  return envPass.reduce(LINEAR_REDUCTION, false);
+}
+
+Values LoopEnvironmentTestSuite::integersReducedWithATree(ModulePass &pass,
+                                                          TestSuite &suite) {
+  auto &envPass = static_cast<LoopEnvironmentTestSuite &>(pass);
+  return envPass.reduce(TREE_REDUCTION, false);
+}
+
+Values LoopEnvironmentTestSuite::floatsReducedLinearly(ModulePass &pass,
+                                                       TestSuite &suite) {
+  auto &envPass = static_cast<LoopEnvironmentTestSuite &>(pass);
+  return envPass.reduce(LINEAR_REDUCTION, true);
+}
+
+Values LoopEnvironmentTestSuite::floatsReducedWithATree(ModulePass &pass,
+                                                        TestSuite &suite) {
+  auto &envPass = static_cast<LoopEnvironmentTestSuite &>(pass);
+  return envPass.reduce(TREE_REDUCTION, true);
+}
+
+Values LoopEnvironmentTestSuite::arraysReduced(ModulePass &pass,
+                                               TestSuite &suite) {
+  auto &envPass = static_cast<LoopEnvironmentTestSuite &>(pass);
+  Values values{};
+
+  for (auto executed = 1u; executed <= numberOfReducers; executed++) {
+    std::string elements;
+    for (auto e = 0u; e < 4; e++) {
+      auto element = envPass.computeReducedElementOfArray(e, executed);
+      auto elementString =
+          (element == nullptr)
+              ? std::string("not a constant")
+              : std::to_string(cast<ConstantInt>(element)->getSExtValue());
+      elements += (e == 0) ? elementString : (" " + elementString);
+    }
+    values.insert(std::to_string(executed) + " -> " + elements);
+  }
+
+  return values;
+}
+
+Values LoopEnvironmentTestSuite::minMaxReducedLinearly(ModulePass &pass,
+                                                       TestSuite &suite) {
+  auto &envPass = static_cast<LoopEnvironmentTestSuite &>(pass);
+  return envPass.reduceMinMax(LINEAR_REDUCTION);
+}
+
+Values LoopEnvironmentTestSuite::minMaxReducedWithATree(ModulePass &pass,
+                                                        TestSuite &suite) {
+  auto &envPass = static_cast<LoopEnvironmentTestSuite &>(pass);
+  return envPass.reduceMinMax(TREE_REDUCTION);
+}
+
+Values LoopEnvironmentTestSuite::argMinsWithAnIncreasingIndexReducedLinearly(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &envPass = static_cast<LoopEnvironmentTestSuite &>(pass);
+  return envPass.reduceArgMin(LINEAR_REDUCTION, true);
+}
+
+Values LoopEnvironmentTestSuite::argMinsWithAnIncreasingIndexReducedWithATree(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &envPass = static_cast<LoopEnvironmentTestSuite &>(pass);
+  return envPass.reduceArgMin(TREE_REDUCTION, true);
+}
+
+Values LoopEnvironmentTestSuite::argMinsWithADecreasingIndexReducedLinearly(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &envPass = static_cast<LoopEnvironmentTestSuite &>(pass);
+  return envPass.reduceArgMin(LINEAR_REDUCTION, false);
+}
+
+Values LoopEnvironmentTestSuite::argMinsWithADecreasingIndexReducedWithATree(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &envPass = static_cast<LoopEnvironmentTestSuite &>(pass);
+  return envPass.reduceArgMin(TREE_REDUCTION, false);
+}
+
+Values LoopEnvironmentTestSuite::readOnlyVariablesPacked(ModulePass &pass,
+                                                         TestSuite &suite) {
+  auto &envPass = static_cast<LoopEnvironmentTestSuite &>(pass);
+  auto env = envPass.ldi->getEnvironment();
+  Values values{};
+
+  /*
+   * Select the packed layout through the loop transformations manager, as a
+   * parallelizer would.
+   */
+  LoopTransformationsManager ltm(
+      *envPass.ldi->getLoopTransformationsManager());
+  ltm.setReadOnlyVariablesPacked(true);
+
+  /*
+   * Every integer live-in is read-only, so it must be packed and it must be
+   * read back from where it has been stored.
+   */
+  auto arePacked = true;
+  auto areReadBack = true;
+  for (auto id : env->getEnvIDsOfLiveInVars()) {
+    auto type = env->typeOfEnvironmentLocation(id);
+    if (!type->isIntegerTy()) {
+      continue;
+    }
+    auto value = ConstantInt::get(type, id + 1);
+    auto isPacked = false;
+    auto valueRead = envPass.readBackLiveIn(ltm, id, value, &isPacked);
+    arePacked &= isPacked;
+    areReadBack &= (valueRead == value);
+  }
+  if (arePacked) {
+    values.insert("read-only variables are packed");
+  }
+  if (areReadBack) {
+    values.insert("read-only variables are read back");
+  }
+
+  /*
+   * The live-outs are written by the users, so each of them must keep a cache
+   * line of its own.
+   */
+  LoopEnvironmentBuilder envBuilder(
+      envPass.M->getContext(),
+      env,
+      [](uint32_t variableID, bool isLiveOut) -> bool { return false; },
+      [](uint32_t variableID, bool isLiveOut) -> bool { return false; },
+      ltm,
+      1);
+  auto &layout = envBuilder.getLayout();
+  auto wordsInCacheLine = LoopEnvironmentLayout::getWordsInCacheLine();
+  auto haveCacheLines = true;
+  for (auto id : env->getEnvIDsOfLiveOutVars()) {
+    auto envIndex = envBuilder.getIndexOfEnvironmentVariable(id);
+    haveCacheLines &= !layout.isPacked(envIndex);
+    haveCacheLines &=
+        ((layout.getOffsetOfVariable(envIndex) % wordsInCacheLine) == 0);
+  }
+  if (haveCacheLines) {
+    values.insert("other variables keep a cache line each");
+  }
+
+  return values;
+}
+
+Constant *LoopEnvironmentTestSuite::readBackLiveIn(
+    const LoopTransformationsManager &ltm,
+    uint32_t id,
+    Constant *value,
+    bool *isPacked) {
+  auto &CXT = this->M->getContext();
+  auto type = value->getType();
+
+  /*
+   * Create the function that stores and loads the live-in.
+   */
+  auto functionType = FunctionType::get(type, false);
+  auto f = Function::Create(functionType,
+                            GlobalValue::InternalLinkage,
+                            "noelle_unit_test_packed_environment",
+                            *this->M);
+  auto entryBB = BasicBlock::Create(CXT, "entry", f);
+  IRBuilder<> builder{ entryBB };
+
+  /*
+   * Allocate the environment.
+   */
+  LoopEnvironmentBuilder envBuilder(
+      CXT,
+      this->ldi->getEnvironment(),
+      [](uint32_t variableID, bool isLiveOut) -> bool { return false; },
+      [](uint32_t variableID, bool isLiveOut) -> bool { return false; },
+      ltm,
+      1);
+  auto envIndex = envBuilder.getIndexOfEnvironmentVariable(id);
+  *isPacked = envBuilder.getLayout().isPacked(envIndex);
+  envBuilder.allocateEnvironmentArray(builder);
+  envBuilder.generateEnvVariables(builder);
+
+  /*
+   * Store the live-in as the code before the loop does, and load it as the
+   * users do.
+   */
+  builder.CreateStore(value, envBuilder.getEnvironmentVariable(id));
+  auto user = envBuilder.getUser(0);
+  user->setEnvironmentArray(envBuilder.getEnvironmentArray());
+  auto ptr = user->createEnvironmentVariablePointer(builder, id, type);
+  builder.CreateRet(builder.CreateLoad(type, ptr));
+
+  return this->foldFunction(f);
+}
+
+BinaryReductionSCC *LoopEnvironmentTestSuite::fetchReduction(
+    bool floatingPoint) {
+  auto sccManager = this->ldi->getSCCManager();
+  for (auto node : sccManager->getSCCDAG()->getNodes()) {
+    auto sccInfo = sccManager->getSCCAttrs(node->getT());
+    if (auto binaryRed = dyn_cast<BinaryReductionSCC>(sccInfo)) {
+      auto type =
+          binaryRed->getPhiThatAccumulatesValuesBetweenLoopIterations()
+              ->getType();
+      if (type->isFloatingPointTy() == floatingPoint) {
+        return binaryRed;
+      }
+    }
+  }
+
+  return nullptr;
+}
+
+Values LoopEnvironmentTestSuite::reduceMinMax(ReductionStrategy strategy) {
+  Values values{};
+
+  /*
+   * Describe the reductions.
+   * Their SCC must include a PHI of the header of the loop, so the one of the
+   * integer reduction of the loop is used.
+   */
+  auto binaryRed = this->fetchReduction(false);
+  if (binaryRed == nullptr) {
+    return values;
+  }
+  auto &CXT = this->M->getContext();
+  auto int32 = IntegerType::get(CXT, 32);
+  auto floatType = Type::getFloatTy(CXT);
+  auto sminPHI = PHINode::Create(int32, 0);
+  auto umaxPHI = PHINode::Create(int32, 0);
+  auto fminPHI = PHINode::Create(floatType, 0);
+  auto scc = binaryRed->getSCC();
+  auto loop = this->ldi->getLoopStructure();
+  MinMaxReductionSCC smin(scc,
+                          loop,
+                          {},
+                          ConstantInt::get(int32, 10),
+                          RecurKind::SMin,
+                          sminPHI);
+  MinMaxReductionSCC umax(scc,
+                          loop,
+                          {},
+                          ConstantInt::get(int32, 5),
+                          RecurKind::UMax,
+                          umaxPHI);
+  MinMaxReductionSCC fmin(scc,
+                          loop,
+                          {},
+                          ConstantFP::get(floatType, 2.0),
+                          RecurKind::FMin,
+                          fminPHI);
+
+  /*
+   * Set the private copies.
+   */
+  auto intsOf = [int32](std::vector<int64_t> ints) {
+    std::vector<Constant *> constants;
+    for (auto v : ints) {
+      constants.push_back(ConstantInt::get(int32, v, true));
+    }
+    return constants;
+  };
+  std::vector<Constant *> fminCopies;
+  for (auto v : { 2.5, 1.5, -0.5, 3.0, -4.25 }) {
+    fminCopies.push_back(ConstantFP::get(floatType, v));
+  }
+  auto sminCopies = intsOf({ 4, -2, 9, -5, 3 });
+  auto umaxCopies = intsOf({ 3, -16, 7, 1, 2 });
+
+  /*
+   * Reduce them.
+   */
+  ReductionSCC *sminRed = &smin;
+  ReductionSCC *umaxRed = &umax;
+  ReductionSCC *fminRed = &fmin;
+  auto sminInitialValue = cast<Constant>(smin.getInitialValue());
+  auto umaxInitialValue = cast<Constant>(umax.getInitialValue());
+  auto fminInitialValue = cast<Constant>(fmin.getInitialValue());
+  for (auto executed = 1u; executed <= numberOfReducers; executed++) {
+    auto sminValue = this->computeReducedValue({ sminRed },
+                                               { sminCopies },
+                                               { sminInitialValue },
+                                               strategy,
+                                               executed,
+                                               0);
+    auto umaxValue = this->computeReducedValue({ umaxRed },
+                                               { umaxCopies },
+                                               { umaxInitialValue },
+                                               strategy,
+                                               executed,
+                                               0);
+    auto fminValue = this->computeReducedValue({ fminRed },
+                                               { fminCopies },
+                                               { fminInitialValue },
+                                               strategy,
+                                               executed,
+                                               0);
+    if ((sminValue == nullptr) || (umaxValue == nullptr)
+        || (fminValue == nullptr)) {
+      values.insert(std::to_string(executed) + " -> not a constant");
+      continue;
+    }
+    values.insert(
+        std::to_string(executed) + " -> "
+        + std::to_string(cast<ConstantInt>(sminValue)->getSExtValue()) + " "
+        + std::to_string(cast<ConstantInt>(umaxValue)->getZExtValue()) + " "
+        + std::to_string(
+            cast<ConstantFP>(fminValue)->getValueAPF().convertToFloat()));
+  }
+
+  sminPHI->deleteValue();
+  umaxPHI->deleteValue();
+  fminPHI->deleteValue();
+
+  return values;
+}
+
+Values LoopEnvironmentTestSuite::reduceArgMin(ReductionStrategy strategy,
+                                              bool isIndexIncreasing) {
+  Values values{};
+
+  /*
+   * Describe the reductions.
+   */
+  auto binaryRed = this->fetchReduction(false);
+  if (binaryRed == nullptr) {
+    return values;
+  }
+  auto &CXT = this->M->getContext();
+  auto int32 = IntegerType::get(CXT, 32);
+  auto minPHI = PHINode::Create(int32, 0);
+  auto indexPHI = PHINode::Create(int32, 0);
+  auto scc = binaryRed->getSCC();
+  auto loop = this->ldi->getLoopStructure();
+  MinMaxReductionSCC min(scc,
+                         loop,
+                         {},
+                         ConstantInt::get(int32, 10),
+                         RecurKind::SMin,
+                         minPHI);
+  ArgMinMaxReductionSCC argMin(
+      scc,
+      loop,
+      {},
+      ConstantInt::get(int32, isIndexIncreasing ? 100 : -1, true),
+      indexPHI,
+      minPHI,
+      RecurKind::SMin,
+      isIndexIncreasing);
+
+  /*
+   * Set the private copies.
+   * Reducer "3" reaches the min of reducer "2" at an earlier iteration.
+   */
+  auto intsOf = [int32](std::vector<int64_t> ints) {
+    std::vector<Constant *> constants;
+    for (auto v : ints) {
+      constants.push_back(ConstantInt::get(int32, v, true));
+    }
+    return constants;
+  };
+  auto minCopies = intsOf({ 10, 6, 3, 3, 1 });
+  auto indexCopies = isIndexIncreasing ? intsOf({ 3, 8, 5, 2, 9 })
+                                       : intsOf({ 40, 30, 20, 25, 5 });
+
+  /*
+   * Reduce them.
+   */
+  std::vector<ReductionSCC *> reductions{ &min, &argMin };
+  std::vector<Constant *> initialValues{
+    cast<Constant>(min.getInitialValue()),
+    cast<Constant>(argMin.getInitialValue())
+  };
+  for (auto executed = 1u; executed <= numberOfReducers; executed++) {
+    std::string reducedValues;
+    for (auto id = 0u; id < 2; id++) {
+      auto value = this->computeReducedValue(
+          reductions,
+          { minCopies, indexCopies },
+          initialValues,
+          strategy,
+          executed,
+          id);
+      auto valueString =
+          (value == nullptr)
+              ? std::string("not a constant")
+              : std::to_string(cast<ConstantInt>(value)->getSExtValue());
+      reducedValues += (id == 0) ? valueString : (" " + valueString);
+    }
+    values.insert(std::to_string(executed) + " -> " + reducedValues);
+  }
+
+  minPHI->deleteValue();
+  indexPHI->deleteValue();
+
+  return values;
+}
+
+Values LoopEnvironmentTestSuite::reduce(ReductionStrategy strategy,
+                                        bool floatingPoint) {
+  Values values{};
+
+  /*
+   * Fetch the reduction.
+   */
+  auto red = this->fetchReduction(floatingPoint);
+  if (red == nullptr) {
+    return values;
+  }
+
+  for (auto executed = 1u; executed <= numberOfReducers; executed++) {
+    auto reducedValue = this->computeReducedValue(red, strategy, executed);
+    if (reducedValue == nullptr) {
+      values.insert(std::to_string(executed) + " -> not a constant");
+      continue;
+    }
+    std::string reducedValueString;
+    if (auto constantFP = dyn_cast<ConstantFP>(reducedValue)) {
+      reducedValueString =
+          std::to_string(constantFP->getValueAPF().convertToFloat());
+    } else {
+      reducedValueString =
+          std::to_string(cast<ConstantInt>(reducedValue)->getSExtValue());
+    }
+    values.insert(std::to_string(executed) + " -> " + reducedValueString);
+  }
+
+  return values;
+}
+
+Constant *LoopEnvironmentTestSuite::computeReducedValue(
+    BinaryReductionSCC *red,
+    ReductionStrategy strategy,
+    uint64_t reducersExecuted) {
+  auto varType =
+      red->getPhiThatAccumulatesValuesBetweenLoopIterations()->getType();
+  auto valueOf = [varType](double v) -> Constant * {
+    if (varType->isFloatingPointTy()) {
+      return ConstantFP::get(varType, v / 2);
+    }
+    return ConstantInt::get(varType, (uint64_t)v);
+  };
+
+  /*
+   * Reduce the private copies.
+   */
+  std::vector<Constant *> privateCopies;
+  for (auto i = 0u; i < numberOfReducers; i++) {
+    privateCopies.push_back(valueOf(i + 1));
+  }
+  auto initialValue = valueOf(varType->isFloatingPointTy() ? 0.5 : 10);
+
+  return this->computeReducedValue({ red },
+                                   { privateCopies },
+                                   { initialValue },
+                                   strategy,
+                                   reducersExecuted,
+                                   0);
+}
+
+Constant *LoopEnvironmentTestSuite::computeReducedValue(
+    const std::vector<ReductionSCC *> &reductions,
+    const std::vector<std::vector<Constant *>> &privateCopies,
+    const std::vector<Constant *> &initialValues,
+    ReductionStrategy strategy,
+    uint64_t reducersExecuted,
+    uint32_t resultID) {
+  auto &CXT = this->M->getContext();
+
+  /*
+   * Create the function that reduces the private copies.
+   */
+  std::vector<Type *> varTypes;
+  std::set<uint32_t> reducableVarIDs;
+  std::unordered_map<uint32_t, ReductionSCC *> reductionOf;
+  std::unordered_map<ReductionSCC *, Value *> initialValueOf;
+  for (auto id = 0u; id < reductions.size(); id++) {
+    auto red = reductions[id];
+    varTypes.push_back(
+        red->getPhiThatAccumulatesValuesBetweenLoopIterations()->getType());
+    reducableVarIDs.insert(id);
+    reductionOf[id] = red;
+    initialValueOf[red] = initialValues[id];
+  }
+  auto functionType = FunctionType::get(varTypes[resultID], false);
+  auto f = Function::Create(functionType,
+                            GlobalValue::InternalLinkage,
+                            "noelle_unit_test_reduction",
+                            *this->M);
+  auto entryBB = BasicBlock::Create(CXT, "entry", f);
+  IRBuilder<> builder{ entryBB };
+
+  /*
+   * Allocate the environment with the reduced variables only.
+   */
+  LoopEnvironmentBuilder envBuilder(CXT,
+                                    varTypes,
+                                    {},
+                                    reducableVarIDs,
+                                    numberOfReducers,
+                                    1);
+  envBuilder.setReductionStrategy(strategy);
+  envBuilder.allocateEnvironmentArray(builder);
+  envBuilder.generateEnvVariables(builder);
+
+  /*
+   * Set the private copies of the reducers that ran.
+   */
+  for (auto id = 0u; id < reductions.size(); id++) {
+    for (auto i = 0u; i < reducersExecuted; i++) {
+      builder.CreateStore(privateCopies[id][i],
+                          envBuilder.getReducedEnvironmentVariable(id, i));
+    }
+  }
+
+  /*
+   * Reduce them.
+   */
+  auto int32 = IntegerType::get(CXT, 32);
+  auto afterReductionBB = envBuilder.reduceLiveOutVariables(
+      entryBB,
+      builder,
+      reductionOf,
+      ConstantInt::get(int32, reducersExecuted),
+      [&initialValueOf](ReductionSCC *scc) -> Value * {
+        return initialValueOf.at(scc);
+      });
+  IRBuilder<> afterReductionBuilder{ afterReductionBB };
+  afterReductionBuilder.CreateRet(
+      envBuilder.getAccumulatedReducedEnvironmentVariable(resultID));
+
+  return this->foldFunction(f);
+}
+
+Constant *LoopEnvironmentTestSuite::computeReducedElementOfArray(
+    uint64_t element,
+    uint64_t reducersExecuted) {
+  auto &CXT = this->M->getContext();
+  auto int32 = IntegerType::get(CXT, 32);
+  auto int64 = IntegerType::get(CXT, 64);
+  auto arrayType = ArrayType::get(int64, 4);
+
+  /*
+   * Create the function that reduces the private copies.
+   */
+  auto functionType = FunctionType::get(int64, false);
+  auto f = Function::Create(functionType,
+                            GlobalValue::InternalLinkage,
+                            "noelle_unit_test_array_reduction",
+                            *this->M);
+  auto entryBB = BasicBlock::Create(CXT, "entry", f);
+  IRBuilder<> builder{ entryBB };
+
+  /*
+   * Allocate the original array.
+   */
+  auto array = builder.CreateAlloca(arrayType);
+  for (auto e = 0u; e < 4; e++) {
+    auto elementPtr = builder.CreateInBoundsGEP(
+        arrayType,
+        array,
+        { ConstantInt::get(int64, 0), ConstantInt::get(int64, e) });
+    builder.CreateStore(ConstantInt::get(int64, 10 * (e + 1)), elementPtr);
+  }
+
+  /*
+   * Describe the reduction of the array.
+   * Its SCC is not used to generate the code, so any SCC of the loop will do.
+   */
+  auto sccManager = this->ldi->getSCCManager();
+  auto anySCC = (*sccManager->getSCCDAG()->begin_nodes())->getT();
+  ArrayReductionSCC red(anySCC,
+                        this->ldi->getLoopStructure(),
+                        {},
+                        array,
+                        Instruction::Add,
+                        {});
+
+  /*
+   * Privatize the array.
+   */
+  LoopEnvironmentBuilder envBuilder(CXT,
+                                    std::vector<Type *>{},
+                                    std::set<uint32_t>{},
+                                    std::set<uint32_t>{},
+                                    numberOfReducers,
+                                    1);
+  auto privateCopies = envBuilder.allocatePrivateCopiesOfArray(builder, &red);
+  auto bb = entryBB;
+  for (auto i = 0u; i < numberOfReducers; i++) {
+    IRBuilder<> bbBuilder{ bb };
+    auto privateCopy =
+        envBuilder.fetchPrivateCopyOfArray(bbBuilder,
+                                           privateCopies,
+                                           ConstantInt::get(int32, i));
+    bb = envBuilder.initializePrivateCopyOfArray(bb, &red, privateCopy);
+  }
+
+  /*
+   * Update the private copies of the reducers that ran.
+   */
+  IRBuilder<> updateBuilder{ bb };
+  for (auto i = 0u; i < reducersExecuted; i++) {
+    auto privateCopy =
+        envBuilder.fetchPrivateCopyOfArray(updateBuilder,
+                                           privateCopies,
+                                           ConstantInt::get(int32, i));
+    for (auto e = 0u; e < 4; e++) {
+      auto elementPtr = updateBuilder.CreateInBoundsGEP(
+          arrayType,
+          privateCopy,
+          { ConstantInt::get(int64, 0), ConstantInt::get(int64, e) });
+      updateBuilder.CreateStore(ConstantInt::get(int64, (i + 1) * (e + 1)),
+                                elementPtr);
+    }
+  }
+
+  /*
+   * Combine them.
+   */
+  auto afterReductionBB =
+      envBuilder.reduceArrays(bb,
+                              { &red },
+                              ConstantInt::get(int32, reducersExecuted));
+  IRBuilder<> afterReductionBuilder{ afterReductionBB };
+  auto elementPtr = afterReductionBuilder.CreateInBoundsGEP(
+      arrayType,
+      array,
+      { ConstantInt::get(int64, 0), ConstantInt::get(int64, element) });
+  afterReductionBuilder.CreateRet(
+      afterReductionBuilder.CreateLoad(int64, elementPtr));
+
+  return this->foldFunction(f);
+}
+
+Constant *LoopEnvironmentTestSuite::foldFunction(Function *f) {
+
+  /*
+   * Fold the function.
+   * Private copies of arrays are on the heap, so GVN is needed to forward
+   * their stores.
+   */
+  legacy::FunctionPassManager fpm(this->M);
+  fpm.add(createSROAPass());
+  fpm.add(createInstructionCombiningPass());
+  fpm.add(createCFGSimplificationPass());
+  fpm.add(createLoopRotatePass());
+  fpm.add(createLoopUnrollPass(3, false, false, 10000));
+  fpm.add(createSROAPass());
+  fpm.add(createInstructionCombiningPass());
+  fpm.add(createGVNPass());
+  fpm.add(createInstructionCombiningPass());
+  fpm.add(createCFGSimplificationPass());
+  fpm.add(createInstructionCombiningPass());
+  fpm.doInitialization();
+  fpm.run(*f);
+  fpm.doFinalization();
+
+  /*
+   * Fetch the value returned.
+   */
+  Constant *reducedValue = nullptr;
+  if (f->size() == 1) {
+    auto ret = cast<ReturnInst>(f->getEntryBlock().getTerminator());
+    reducedValue = dyn_cast<Constant>(ret->getReturnValue());
+  }
+  f->eraseFromParent();
+
+  return reducedValue;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,14 @@
+#include <stdio.h>
+#include <stdint.h>
+
+int main(int argc, char *argv[]) {
+  int sum = 0;
+  float fsum = 0;
+  for (int i = 0; i < argc * 100; ++i) {
+    sum += i;
+    fsum += i * 0.5f;
+  }
+
+  printf("%d, %f\n", sum, fsum);
+  return 0;
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright 2016 - 2023  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "MayPointsToTestSuite.hpp"
+
+namespace arcana::noelle {
+
+// Register pass to "opt"
+char MayPointsToTestSuite::ID = 0;
+static RegisterPass<MayPointsToTestSuite> X("UnitTester",
+                                            "May Points-to Unit Tester");
+
+// Register pass to "clang"
+static MayPointsToTestSuite *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(
+    PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new MayPointsToTestSuite());
+      }
+    }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new MayPointsToTestSuite());
+      }
+    }); // ** for -O0
+
+const char *MayPointsToTestSuite::tests[] = { "malloc wrappers",
+                                              "captured parameters",
+                                              "modified arguments",
+                                              "recursive functions" };
+TestFunction MayPointsToTestSuite::testFns[] = {
+  MayPointsToTestSuite::mallocWrappersAllocate,
+  MayPointsToTestSuite::storedParametersAreCaptured,
+  MayPointsToTestSuite::modifiedArgumentsPointToUnknown,
+  MayPointsToTestSuite::recursiveFunctionsAreConservative
+};
+
+bool MayPointsToTestSuite::doInitialization(Module &M) {
+  errs() << "MayPointsToTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("MayPointsToTestSuite",
+                              tests,
+                              testFns,
+                              numTests,
+                              "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void MayPointsToTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<NoellePass>();
+}
+
+bool MayPointsToTestSuite::runOnModule(Module &M) {
+  errs() << "MayPointsToTestSuite: Start\n";
+  auto &noelle = getAnalysis<NoellePass>().getNoelle();
+  this->mainF = M.getFunction("main");
+
+  /*
+   * Summarize the functions bottom-up.
+   */
+  auto callGraph = noelle.getFunctionsManager()->getProgramCallGraph();
+  this->mpa = new MayPointsToAnalysis();
+  this->mpa->computeFunctionSummaries(callGraph);
+
+  errs() << "MayPointsToTestSuite: Running tests\n";
+  suite->runTests((ModulePass &)*this);
+
+  delete this->mpa;
+
+  return false;
+}
+
+Values MayPointsToTestSuite::mallocWrappersAllocate(ModulePass &pass,
+                                                    TestSuite &suite) {
+  auto &mptPass = static_cast<MayPointsToTestSuite &>(pass);
+  Values values{};
+  values.insert(printSummary(mptPass, "allocate"));
+
+  /*
+   * The call to the wrapper is an allocation site of the caller.
+   */
+  auto call = getCallTo(mptPass, "allocate");
+  auto pointees = mptPass.mpa->getPointees(call, mptPass.mainF);
+  if ((pointees.size() == 1) && (pointees.count(call) == 1)) {
+    values.insert("the call to allocate is the only pointee of its result");
+  }
+
+  return values;
+}
+
+Values MayPointsToTestSuite::storedParametersAreCaptured(ModulePass &pass,
+                                                         TestSuite &suite) {
+  auto &mptPass = static_cast<MayPointsToTestSuite &>(pass);
+  Values values{};
+  values.insert(printSummary(mptPass, "capture"));
+
+  /*
+   * The variable given to capture escapes from main.
+   */
+  auto call = getCallTo(mptPass, "capture");
+  auto variable =
+      cast<Instruction>(call->getArgOperand(0)->stripPointerCasts());
+  values.insert(std::string("the variable given to capture ")
+                + (mptPass.mpa->mayEscape(variable) ? "escapes"
+                                                    : "does not escape"));
+
+  return values;
+}
+
+Values MayPointsToTestSuite::modifiedArgumentsPointToUnknown(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &mptPass = static_cast<MayPointsToTestSuite &>(pass);
+  Values values{};
+  values.insert(printSummary(mptPass, "reset"));
+
+  /*
+   * Fetch the pointer given to reset, the variable it pointed to before the
+   * call, and its value after the call.
+   */
+  auto call = getCallTo(mptPass, "reset");
+  auto slot = call->getArgOperand(0)->stripPointerCasts();
+  Instruction *variable = nullptr;
+  LoadInst *pointer = nullptr;
+  for (auto user : slot->users()) {
+    if (auto store = dyn_cast<StoreInst>(user)) {
+      variable = dyn_cast<AllocaInst>(store->getValueOperand());
+    } else if (auto load = dyn_cast<LoadInst>(user)) {
+      pointer = load;
+    }
+  }
+  assert(variable != nullptr);
+  assert(pointer != nullptr);
+
+  /*
+   * The callee only writes in the memory of its argument: the pointer may now
+   * point to memory unknown to main, while the variable it pointed to does
+   * not escape.
+   */
+  auto pointees = mptPass.mpa->getPointees(pointer, mptPass.mainF);
+  if (pointees.count(nullptr) > 0) {
+    values.insert("the pointer given to reset may point to unknown memory");
+  }
+  if (pointees.count(variable) > 0) {
+    values.insert("the pointer given to reset may point to the variable");
+  }
+  values.insert(std::string("the variable ")
+                + (mptPass.mpa->mayEscape(variable) ? "escapes"
+                                                    : "does not escape"));
+
+  return values;
+}
+
+Values MayPointsToTestSuite::recursiveFunctionsAreConservative(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &mptPass = static_cast<MayPointsToTestSuite &>(pass);
+  Values values{};
+  values.insert(printSummary(mptPass, "allocateRecursively"));
+  values.insert(printSummary(mptPass, "countDown"));
+  values.insert(printSummary(mptPass, "decrement"));
+
+  return values;
+}
+
+std::string MayPointsToTestSuite::printSummary(
+    MayPointsToTestSuite &mptPass,
+    const std::string &functionName) {
+  auto f = mptPass.M->getFunction(functionName);
+  assert(f != nullptr);
+  auto summary = mptPass.mpa->getInterproceduralSummary(f);
+  if (summary == nullptr) {
+    return functionName + " has no summary";
+  }
+
+  auto printParameters = [](const std::vector<bool> &parameters) {
+    std::string s;
+    for (auto i = 0u; i < parameters.size(); i++) {
+      if (parameters[i]) {
+        s += " " + std::to_string(i);
+      }
+    }
+    return s.empty() ? std::string(" none") : s;
+  };
+  std::string s = functionName;
+  s += " -> captured" + printParameters(summary->capturedParameters);
+  s += ", mod" + printParameters(summary->modParameters);
+  s += ", ref" + printParameters(summary->refParameters);
+  if (f->getReturnType()->isPointerTy()) {
+    s += summary->returnsFreshMemobj ? ", fresh" : ", not fresh";
+  }
+
+  return s;
+}
+
+CallBase *MayPointsToTestSuite::getCallTo(MayPointsToTestSuite &mptPass,
+                                          const std::string &functionName) {
+  for (auto &inst : instructions(mptPass.mainF)) {
+    auto call = dyn_cast<CallBase>(&inst);
+    if ((call != nullptr) && (call->getCalledFunction() != nullptr)
+        && (call->getCalledFunction()->getName() == functionName)) {
+      return call;
+    }
+  }
+  assert(false && "The call has not been found");
+
+  return nullptr;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+int *globalSlot;
+
+extern "C" {
+
+int *allocate(int elements) {
+  return (int *)malloc(elements * sizeof(int));
+}
+
+void capture(int *value, int **slot) {
+  *slot = value;
+}
+
+void reset(int **slot) {
+  *slot = NULL;
+}
+
+int *allocateRecursively(int depth) {
+  if (depth <= 0) {
+    return (int *)malloc(sizeof(int));
+  }
+  return allocateRecursively(depth - 1);
+}
+
+void countDown(int *counter, int steps);
+
+void decrement(int *counter, int steps) {
+  if (steps > 0) {
+    *counter = *counter - 1;
+    countDown(counter, steps - 1);
+  }
+}
+
+void countDown(int *counter, int steps) {
+  if (steps > 0) {
+    decrement(counter, steps);
+  }
+}
+}
+
+int main(int argc, char *argv[]) {
+
+  /*
+   * Allocate through a wrapper of malloc.
+   */
+  auto values = allocate(argc);
+  values[0] = argc;
+
+  /*
+   * Capture a local variable.
+   */
+  int captured = argc;
+  capture(&captured, &globalSlot);
+
+  /*
+   * Let a callee modify a local pointer.
+   */
+  int value = argc;
+  int *pointer = &value;
+  reset(&pointer);
+  if (pointer != NULL) {
+    values[0] += *pointer;
+  }
+
+  /*
+   * Recursive functions.
+   */
+  auto fromRecursion = allocateRecursively(argc);
+  *fromRecursion = values[0];
+  int counter = argc;
+  countDown(&counter, argc);
+
+  printf("%d %d %d\n", values[0], *globalSlot, *fromRecursion + counter);
+
+  free(fromRecursion);
+  free(values);
+
+  return 0;
+}
@@ -79,6 +79,10 @@ private:
 
   static Values loopCarriedDependencies(ModulePass &pass, TestSuite &suite);
 
+  static Values arrayReductionsAreFound(ModulePass &pass, TestSuite &suite);
+
+  static Values minMaxReductionsAreFound(ModulePass &pass, TestSuite &suite);
+
   static Values printSCCs(ModulePass &pass,
                           TestSuite &suite,
                           std::set<SCC *> sccs);
@@ -91,6 +95,7 @@ private:
   SCCDAG *sccdag;
   SCCDAGAttrs *attrs;
   LoopContent *ldi;
+  CompilationOptionsManager *om;
   Noelle *noelle;
 };
 } // namespace arcana::noelle
@@ -24,6 +24,9 @@
 #include "arcana/noelle/core/LoopIterationSCC.hpp"
 #include "arcana/noelle/core/InductionVariableSCC.hpp"
 #include "arcana/noelle/core/MemoryClonableSCC.hpp"
+#include "arcana/noelle/core/ArrayReductionSCC.hpp"
+#include "arcana/noelle/core/MinMaxReductionSCC.hpp"
+#include "arcana/noelle/core/ArgMinMaxReductionSCC.hpp"
 #include "SCCDAGAttrTestSuite.hpp"
 
 namespace arcana::noelle {
@@ -56,7 +59,9 @@ const char *SCCDAGAttrTestSuite::tests[] = {
   "reducible SCC",
   "clonable SCC",
   "clonable SCC into local memory",
-  "loop carried dependencies (top loop)"
+  "loop carried dependencies (top loop)",
+  "array reductions",
+  "min/max reductions"
 };
 TestFunction SCCDAGAttrTestSuite::testFns[] = {
   SCCDAGAttrTestSuite::sccdagHasCorrectSCCs,
@@ -64,7 +69,9 @@ TestFunction SCCDAGAttrTestSuite::testFns[] = {
   SCCDAGAttrTestSuite::reducibleSCCsAreFound,
   SCCDAGAttrTestSuite::clonableSCCsAreFound,
   SCCDAGAttrTestSuite::clonableSCCsIntoLocalMemoryAreFound,
-  SCCDAGAttrTestSuite::loopCarriedDependencies
+  SCCDAGAttrTestSuite::loopCarriedDependencies,
+  SCCDAGAttrTestSuite::arrayReductionsAreFound,
+  SCCDAGAttrTestSuite::minMaxReductionsAreFound
 };
 
 bool SCCDAGAttrTestSuite::doInitialization(Module &M) {
@@ -111,11 +118,27 @@ bool SCCDAGAttrTestSuite::runOnModule(Module &M) {
   auto loopNode =
       forest->getInnermostLoopThatContains(&*topLoop->getHeader()->begin());
 
+  /*
+   * Array reductions are disabled by default: enable them for arrays up to
+   * 16 KiB.
+   * Floating point min/max reductions are only found if floats are considered
+   * real numbers.
+   */
+  auto noelleOm = this->noelle->getCompilationOptionsManager();
+  this->om =
+      new CompilationOptionsManager(M,
+                                    noelleOm->getMaximumNumberOfCores(),
+                                    noelleOm->arePRVGsNonDeterministic(),
+                                    true,
+                                    noelleOm->shouldLoopsBeHoistToMain(),
+                                    16 * 1024,
+                                    false);
+
   auto pdg = this->noelle->getProgramDependenceGraph();
   this->fdg = pdg->createFunctionSubgraph(*mainFunction);
   LDGGenerator ldg{};
   this->ldi = new LoopContent(ldg,
-                              this->noelle->getCompilationOptionsManager(),
+                              this->om,
                               fdg,
                               loopNode,
                               topLoop,
@@ -355,4 +378,77 @@ Values SCCDAGAttrTestSuite::loopCarriedDependencies(ModulePass &pass,
   return valueNames;
 }
 
+Values SCCDAGAttrTestSuite::arrayReductionsAreFound(ModulePass &pass,
+                                                    TestSuite &suite) {
+  auto &attrPass = static_cast<SCCDAGAttrTestSuite &>(pass);
+  Values valueNames{};
+  for (auto node : attrPass.sccdag->getNodes()) {
+    auto sccAttrs = attrPass.attrs->getSCCAttrs(node->getT());
+    auto arrayReduction = dyn_cast<ArrayReductionSCC>(sccAttrs);
+    if (arrayReduction == nullptr) {
+      continue;
+    }
+    valueNames.insert(
+        arrayReduction->getArray()->getName().str() + " "
+        + Instruction::getOpcodeName(arrayReduction->getReductionOperation())
+        + " " + std::to_string(arrayReduction->getNumberOfElements()));
+  }
+
+  return valueNames;
+}
+
+static std::string getMinMaxKindName(RecurKind kind) {
+  switch (kind) {
+    case RecurKind::SMin:
+      return "smin";
+    case RecurKind::SMax:
+      return "smax";
+    case RecurKind::UMin:
+      return "umin";
+    case RecurKind::UMax:
+      return "umax";
+    case RecurKind::FMin:
+      return "fmin";
+    case RecurKind::FMax:
+      return "fmax";
+    default:
+      return "unknown";
+  }
+}
+
+Values SCCDAGAttrTestSuite::minMaxReductionsAreFound(ModulePass &pass,
+                                                     TestSuite &suite) {
+  auto &attrPass = static_cast<SCCDAGAttrTestSuite &>(pass);
+  Values valueNames{};
+  for (auto node : attrPass.sccdag->getNodes()) {
+    auto sccAttrs = attrPass.attrs->getSCCAttrs(node->getT());
+    auto reduction = dyn_cast<ReductionSCC>(sccAttrs);
+    if (reduction == nullptr) {
+      continue;
+    }
+    std::string typeName;
+    raw_string_ostream typeStream(typeName);
+    reduction->getPhiThatAccumulatesValuesBetweenLoopIterations()
+        ->getType()
+        ->print(typeStream);
+    typeStream.flush();
+
+    /*
+     * Print the kind of the min/max and the type of the accumulator.
+     * Indexes paired with a min/max also print the direction of their
+     * induction variable.
+     */
+    if (auto minMax = dyn_cast<MinMaxReductionSCC>(reduction)) {
+      valueNames.insert(getMinMaxKindName(minMax->getMinMaxKind()) + " "
+                        + typeName);
+    } else if (auto argMinMax = dyn_cast<ArgMinMaxReductionSCC>(reduction)) {
+      valueNames.insert(
+          getMinMaxKindName(argMinMax->getMinMaxKind()) + " index " + typeName
+          + (argMinMax->isIndexIncreasing() ? " increasing" : " decreasing"));
+    }
+  }
+
+  return valueNames;
+}
+
 } // namespace arcana::noelle
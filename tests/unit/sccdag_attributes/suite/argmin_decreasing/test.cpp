@@ -0,0 +1,20 @@
+#include <stdio.h>
+#include <stdint.h>
+
+int values[] = {4, -2, 9, -5, 3, -5, 1, 8};
+
+int main (int argc, char *argv[]){
+  int smallest = 100;
+  int smallestIndex = -1;
+
+  for (int i = argc * 10000 - 1; i >= 0; --i) {
+    int v = values[i % 8];
+    if (v < smallest) {
+      smallest = v;
+      smallestIndex = i;
+    }
+  }
+
+  printf("%d, %d\n", smallest, smallestIndex);
+  return 0;
+}
@@ -0,0 +1,13 @@
+#include <stdio.h>
+#include <stdint.h>
+
+int hist[64];
+
+int main (int argc, char *argv[]){
+  for (int i = 0; i < argc * 10000; ++i) {
+    hist[(i * 7) % 64] += 1;
+  }
+
+  printf("%d\n", hist[3]);
+  return 0;
+}
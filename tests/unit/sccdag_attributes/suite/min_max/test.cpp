@@ -0,0 +1,26 @@
+#include <stdio.h>
+#include <stdint.h>
+
+int values[] = {4, -2, 9, -5, 3, 7, 1, -8};
+unsigned int unsignedValues[] = {3, 4294967280, 7, 1, 2, 11, 5, 0};
+float realValues[] = {2.5, 1.5, -0.5, 3.0, -4.25, 0.5, 8.0, -1.0};
+
+int main (int argc, char *argv[]){
+  int smallest = 100;
+  unsigned int largest = 0;
+  float smallestReal = 1000.0;
+
+  for (int i = 0; i < argc * 10000; ++i) {
+    int v = values[i % 8];
+    if (v < smallest) smallest = v;
+
+    unsigned int u = unsignedValues[i % 8];
+    if (u > largest) largest = u;
+
+    float f = realValues[i % 8];
+    if (f < smallestReal) smallestReal = f;
+  }
+
+  printf("%d, %u, %f\n", smallest, largest, smallestReal);
+  return 0;
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/NoellePass.hpp"
+#include "TripCountsTestSuite.hpp"
+
+namespace arcana::noelle {
+
+// Register pass to "opt"
+char TripCountsTestSuite::ID = 0;
+static RegisterPass<TripCountsTestSuite> X("UnitTester",
+                                           "Trip Counts Unit Tester");
+
+// Register pass to "clang"
+static TripCountsTestSuite *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(
+    PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new TripCountsTestSuite());
+      }
+    }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new TripCountsTestSuite());
+      }
+    }); // ** for -O0
+
+const char *TripCountsTestSuite::tests[] = {
+  "trip count invocations",
+  "trip count histograms",
+  "trip count percentiles",
+  "invocations above a trip count"
+};
+TestFunction TripCountsTestSuite::testFns[] = {
+  TripCountsTestSuite::tripCountInvocations,
+  TripCountsTestSuite::tripCountHistograms,
+  TripCountsTestSuite::tripCountPercentiles,
+  TripCountsTestSuite::invocationsAboveATripCount
+};
+
+bool TripCountsTestSuite::doInitialization(Module &M) {
+  errs() << "TripCountsTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("TripCountsTestSuite",
+                              tests,
+                              testFns,
+                              numTests,
+                              "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void TripCountsTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<NoellePass>();
+}
+
+bool TripCountsTestSuite::runOnModule(Module &M) {
+  errs() << "TripCountsTestSuite: Start\n";
+  this->noelle = &getAnalysis<NoellePass>().getNoelle();
+
+  errs() << "TripCountsTestSuite: Running suite\n";
+  suite->runTests((ModulePass &)*this);
+
+  return false;
+}
+
+Values TripCountsTestSuite::tripCountInvocations(ModulePass &pass,
+                                                 TestSuite &suite) {
+  auto &tcPass = static_cast<TripCountsTestSuite &>(pass);
+  auto hot = tcPass.noelle->getProfiles();
+  return tcPass.describeLoops([hot](LoopStructure *loop) -> std::string {
+    return std::to_string(hot->getTripCountInvocations(loop));
+  });
+}
+
+Values TripCountsTestSuite::tripCountHistograms(ModulePass &pass,
+                                                TestSuite &suite) {
+  auto &tcPass = static_cast<TripCountsTestSuite &>(pass);
+  auto hot = tcPass.noelle->getProfiles();
+  return tcPass.describeLoops([hot](LoopStructure *loop) -> std::string {
+    std::string histogram;
+    auto buckets = hot->getTripCountHistogram(loop);
+    for (auto bucket = 0u; bucket < buckets.size(); bucket++) {
+      if (buckets[bucket] == 0) {
+        continue;
+      }
+      if (!histogram.empty()) {
+        histogram += " ";
+      }
+      histogram +=
+          std::to_string(bucket) + ":" + std::to_string(buckets[bucket]);
+    }
+    return histogram;
+  });
+}
+
+Values TripCountsTestSuite::tripCountPercentiles(ModulePass &pass,
+                                                 TestSuite &suite) {
+  auto &tcPass = static_cast<TripCountsTestSuite &>(pass);
+  auto hot = tcPass.noelle->getProfiles();
+  return tcPass.describeLoops([hot](LoopStructure *loop) -> std::string {
+    return std::to_string(hot->getTripCountPercentile(loop, 0.5));
+  });
+}
+
+Values TripCountsTestSuite::invocationsAboveATripCount(ModulePass &pass,
+                                                       TestSuite &suite) {
+  auto &tcPass = static_cast<TripCountsTestSuite &>(pass);
+  auto hot = tcPass.noelle->getProfiles();
+  return tcPass.describeLoops([hot](LoopStructure *loop) -> std::string {
+    return std::to_string(hot->getFractionOfInvocationsAbove(loop, 3));
+  });
+}
+
+Values TripCountsTestSuite::describeLoops(
+    std::function<std::string(LoopStructure *)> describe) {
+  Values values;
+  auto hot = this->noelle->getProfiles();
+
+  for (auto &F : *this->M) {
+    if (F.empty()) {
+      continue;
+    }
+    auto loops = this->noelle->getLoopStructures(&F, 0);
+    for (auto loop : *loops) {
+      if (!hot->hasTripCountHistogram(loop)) {
+        values.insert(F.getName().str() + " not profiled");
+        continue;
+      }
+      values.insert(F.getName().str() + " " + describe(loop));
+    }
+    delete loops;
+  }
+
+  return values;
+}
+
+} // namespace arcana::noelle
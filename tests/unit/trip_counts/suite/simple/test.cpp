@@ -0,0 +1,24 @@
+#include <stdio.h>
+#include <stdint.h>
+
+int sumUpTo(int n) {
+  int s = 0;
+  for (int j = 0; j < n; j++) {
+    s += j;
+  }
+  return s;
+}
+
+int main(int argc, char *argv[]) {
+  int total = 0;
+
+  /*
+   * The header of the loop of sumUpTo runs 1, 2, ..., 10 times.
+   */
+  for (int i = 0; i < 10; i++) {
+    total += sumUpTo(i);
+  }
+
+  printf("%d\n", total);
+  return 0;
+}